@@ -0,0 +1,79 @@
+/**
+ * Barnes-Hut accuracy sweep: force error vs traversal cost, monopole vs
+ * quadrupole, against the O(n²) CPU reference (src/layout/barnes-hut-cpu.ts).
+ * Use it to pick `theta` — the default should match the old monopole error
+ * at fewer node visits per thread.
+ *
+ * Run: npm run bench:bh -- [nodeCount=4000] [--csv]
+ */
+import {
+  buildQuadtree, repulsionBarnesHut, repulsionExact, relativeForceError,
+} from '../src/layout/barnes-hut-cpu';
+import { createRng } from '../src/utils/random';
+
+const args = process.argv.slice(2);
+const csv = args.includes('--csv');
+const nodeCount = Number(args.find(a => !a.startsWith('--')) ?? 4000);
+const thetas = [0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0, 1.1, 1.2, 1.3, 1.5];
+
+type Distribution = 'uniform' | 'clustered';
+
+function samplePositions(kind: Distribution, n: number, seed: number): Float32Array {
+  const rng = createRng(seed);
+  const positions = new Float32Array(n * 4);
+  const spread = Math.sqrt(n) * 10; // same spread as HyperblobEngine.setData
+  for (let i = 0; i < n; i++) {
+    if (kind === 'uniform') {
+      positions[i * 4] = (rng() - 0.5) * spread;
+      positions[i * 4 + 1] = (rng() - 0.5) * spread;
+    } else {
+      // Gaussian-ish blobs of varying size, like a settled hypergraph layout
+      const c = Math.floor(rng() * 24);
+      const r = spread * 0.05 * (1 + (c % 4));
+      positions[i * 4] = Math.cos(c * 2.4) * c * spread / 48 + (rng() + rng() - 1) * r;
+      positions[i * 4 + 1] = Math.sin(c * 2.4) * c * spread / 48 + (rng() + rng() - 1) * r;
+    }
+  }
+  return positions;
+}
+
+interface Row { distribution: Distribution; theta: number; order: 'mono' | 'quad'; error: number; visits: number }
+
+const rows: Row[] = [];
+for (const distribution of ['uniform', 'clustered'] as const) {
+  const positions = samplePositions(distribution, nodeCount, 1);
+  const exact = repulsionExact(positions, nodeCount);
+  const { tree, layout } = buildQuadtree(positions, nodeCount);
+  for (const theta of thetas) {
+    for (const quadrupole of [false, true]) {
+      const { forces, visits } = repulsionBarnesHut(tree, layout, positions, nodeCount, theta, quadrupole);
+      rows.push({
+        distribution, theta, order: quadrupole ? 'quad' : 'mono',
+        error: relativeForceError(forces, exact), visits: visits / nodeCount,
+      });
+    }
+  }
+}
+
+if (csv) {
+  console.log('distribution,theta,order,rel_rms_error,visits_per_node');
+  for (const r of rows) console.log(`${r.distribution},${r.theta},${r.order},${r.error},${r.visits}`);
+} else {
+  for (const distribution of ['uniform', 'clustered'] as const) {
+    console.log(`\n${distribution} — ${nodeCount} nodes`);
+    console.log('theta  visits  mono err   quad err   error vs cost (log10 err, ■ mono ● quad)');
+    for (const theta of thetas) {
+      const mono = rows.find(r => r.distribution === distribution && r.theta === theta && r.order === 'mono')!;
+      const quad = rows.find(r => r.distribution === distribution && r.theta === theta && r.order === 'quad')!;
+      // -5 … 0 on a 40-column axis
+      const col = (e: number) => Math.max(0, Math.min(39, Math.round((Math.log10(Math.max(e, 1e-5)) + 5) * 8)));
+      const bar = new Array(40).fill(' ');
+      bar[col(mono.error)] = '■';
+      bar[col(quad.error)] = '●';
+      console.log(
+        `${theta.toFixed(1).padStart(5)}  ${mono.visits.toFixed(0).padStart(6)}  ` +
+        `${mono.error.toExponential(2)}  ${quad.error.toExponential(2)}   |${bar.join('')}|`,
+      );
+    }
+  }
+}
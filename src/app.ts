@@ -4,18 +4,22 @@
 
 import { HyperblobEngine } from './lib';
 import { Stats } from './utils/stats';
-import type { HypergraphData } from './data/types';
+import { ProgressIndicator } from './ui/progress-indicator';
+import type { HypergraphStore } from './data/hypergraph-store';
+import type { GeneratorRequest } from './data/generator-pipeline';
 
 export class App {
   engine: HyperblobEngine;
   private stats: Stats;
+  private progress: ProgressIndicator;
   // eslint-disable-next-line @typescript-eslint/no-explicit-any
   private panelInstance: any = null;
   private disposed = false;
 
-  private constructor(engine: HyperblobEngine, stats: Stats) {
+  private constructor(engine: HyperblobEngine, stats: Stats, progress: ProgressIndicator) {
     this.engine = engine;
     this.stats = stats;
+    this.progress = progress;
   }
 
   static async create(canvas: HTMLCanvasElement): Promise<App> {
@@ -25,8 +29,9 @@ export class App {
     });
 
     const stats = new Stats(canvas.parentElement!);
+    const progress = new ProgressIndicator(canvas.parentElement!);
 
-    const app = new App(engine, stats);
+    const app = new App(engine, stats, progress);
     await app.setupPanel();
     await app.loadDefaultDataset();
 
@@ -46,24 +51,37 @@ export class App {
       const panelContainer = document.getElementById('panel');
       if (!panelContainer) return;
 
-      const generatorModule = await import(/* @vite-ignore */ './data/generator').catch(() => null);
+      const generatorModule = await import(/* @vite-ignore */ './data/generator-pipeline').catch(() => null);
 
       this.panelInstance = new panelModule.Panel(panelContainer, {
         simParams: this.engine.simParams,
         renderParams: this.engine.renderParams,
         camera: this.engine.camera,
-        onLoadFile: (data: HypergraphData) => {
-          this.engine.setData(data);
-          this.stats.setDataInfo(data.nodes.length, data.hyperedges.length);
-          this.panelInstance?.updateDataInfo(data);
+        onLoadFile: (store: HypergraphStore) => this.showStore(store),
+        onStreamFile: (file: File) => this.streamFile(file),
+        onGenerate: (request: GeneratorRequest) => {
+          generatorModule?.generateInWorker(request)
+            .then(store => this.showStore(store))
+            .catch(err => console.error('Generation failed:', err));
         },
-        onGenerate: (nodeCount: number, heCount: number, maxSize: number) => {
-          if (generatorModule) {
-            const data = generatorModule.generateRandomHypergraph(nodeCount, heCount, maxSize);
-            this.engine.setData(data);
-            this.stats.setDataInfo(data.nodes.length, data.hyperedges.length);
-            this.panelInstance?.updateDataInfo(data);
-          }
+        onLoadBinary: (buffer: ArrayBuffer) => {
+          const store = this.engine.loadBinary(buffer);
+          this.stats.setDataInfo(store.nodeCount, store.edgeCount);
+          this.panelInstance?.updateDataInfo(store);
+        },
+        onSaveBinary: async () => {
+          const buffer = await this.engine.exportBinary();
+          const url = URL.createObjectURL(new Blob([buffer], { type: 'application/octet-stream' }));
+          const link = document.createElement('a');
+          link.href = url;
+          link.download = 'hypergraph.hblob';
+          link.click();
+          URL.revokeObjectURL(url);
+        },
+        maxIncidences: this.engine.maxIncidences(),
+        selectedNodeId: () => {
+          const i = this.engine.getSelectedNode();
+          return i === null ? null : this.engine.getStore()?.nodeIds.ids[i] ?? null;
         },
         onSimulationToggle: (running: boolean) => { this.engine.simParams.running = running; },
         onSimulationReset: () => this.engine.resetSimulation(),
@@ -77,19 +95,40 @@ export class App {
 
   private async loadDefaultDataset(): Promise<void> {
     try {
-      const hifModule = await import(/* @vite-ignore */ './data/hif-loader');
+      const hifModule = await import(/* @vite-ignore */ './data/hif-stream');
       const response = await fetch('/data/got.json');
-      if (!response.ok) return;
-      const json = await response.json();
-      const data = hifModule.parseHIF(json);
-      this.engine.setData(data);
-      this.stats.setDataInfo(data.nodes.length, data.hyperedges.length);
-      this.panelInstance?.updateDataInfo(data);
+      if (!response.ok || !response.body) return;
+      this.showStore(await hifModule.parseHIFStream(response.body));
     } catch (e) {
       console.warn('Could not load default dataset:', e);
     }
   }
 
+  private showStore(store: HypergraphStore): void {
+    this.engine.setData(store);
+    this.stats.setDataInfo(store.nodeCount, store.edgeCount);
+    this.panelInstance?.updateDataInfo(store);
+  }
+
+  /** Progressive HIF import: the engine lays out batches while the progress bar tracks the bytes read. */
+  private async streamFile(file: File): Promise<void> {
+    this.progress.update(0, file.name);
+    try {
+      const store = await this.engine.loadHIFStream(file.stream(), {
+        totalBytes: file.size,
+        gzip: file.name.endsWith('.gz'),
+        onProgress: (p) => {
+          const fraction = p.totalBytes ? p.bytesRead / p.totalBytes : null;
+          this.progress.update(fraction, `${file.name} · ${p.incidences.toLocaleString()} incidences`);
+        },
+      });
+      this.stats.setDataInfo(store.nodeCount, store.edgeCount);
+      this.panelInstance?.updateDataInfo(store);
+    } finally {
+      this.progress.hide();
+    }
+  }
+
   private startStatsLoop(): void {
     const loop = () => {
       if (this.disposed) return;
@@ -102,6 +141,7 @@ export class App {
   dispose(): void {
     this.disposed = true;
     this.engine.dispose();
+    this.progress.dispose();
     this.panelInstance?.dispose();
     this.panelInstance = null;
   }
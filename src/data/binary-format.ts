@@ -0,0 +1,378 @@
+import type { HypergraphData } from './types';
+import { HypergraphStore, AttributeStore, type AttributeColumn } from './hypergraph-store';
+
+/**
+ * `.hblob` — versioned binary container for a hypergraph and its layout.
+ *
+ * Every array section is stored in the exact little-endian layout of the GPU
+ * buffer it feeds (`he-offsets`, `he-members`, `node-metadata`,
+ * `node-positions`) and aligned to 8 bytes, so the decoder returns typed-array
+ * views into the file's ArrayBuffer and the engine hands them straight to
+ * `queue.writeBuffer` — no per-node objects on the upload path.
+ *
+ * Layout (u32 words, little-endian):
+ *   [0] magic 'HBLB'  [1] version  [2] nodeCount  [3] edgeCount
+ *   [4] memberCount   [5] sectionCount
+ *   then sectionCount × { id, byteOffset, byteLength }, then section payloads.
+ */
+
+export const HBLOB_MAGIC = 0x424C4248; // 'HBLB' read as a little-endian u32
+export const HBLOB_VERSION = 1;
+export const HBLOB_EXTENSION = '.hblob';
+
+const HEADER_WORDS = 6;
+const SECTION_ALIGN = 8;
+
+// Section ids
+const SECTION_OFFSETS = 1;          // u32[edgeCount + 1]
+const SECTION_MEMBERS = 2;          // u32[memberCount]
+const SECTION_NODE_METADATA = 3;    // u32[nodeCount * 2] — [group, flags]
+const SECTION_STRINGS = 4;          // string table: node IDs, then edge IDs
+const SECTION_EDGE_ID_NUMERIC = 5;  // u8[edgeCount] — 1 where the edge ID is a number
+const SECTION_POSITIONS = 6;        // f32[nodeCount * 4] — [x, y, vx, vy]
+const SECTION_NODE_ATTRS = 7;       // attribute columns over nodes
+const SECTION_EDGE_ATTRS = 8;       // attribute columns over edges
+
+// Attribute column kinds
+const COLUMN_NUMBER = 0;            // f64 per row, NaN = missing
+const COLUMN_STRING = 1;            // presence bytes + string table
+const COLUMN_JSON = 2;              // presence bytes + string table of JSON text
+
+/** Decoded `.hblob`. Typed arrays are views into the source ArrayBuffer. */
+export interface HypergraphBinary {
+  version: number;
+  nodeCount: number;
+  edgeCount: number;
+  memberCount: number;
+  offsets: Uint32Array;
+  members: Uint32Array;
+  metadata: Uint32Array;
+  positions: Float32Array | null;
+  nodeIds: string[];
+  edgeIds: (string | number)[];
+  nodeAttrs: AttributeColumn[];
+  edgeAttrs: AttributeColumn[];
+}
+
+const LITTLE_ENDIAN = new Uint8Array(new Uint32Array([1]).buffer)[0] === 1;
+
+// ── Writer ──
+
+class ByteWriter {
+  bytes = new Uint8Array(1 << 16);
+  length = 0;
+  private encoder = new TextEncoder();
+
+  reserve(extra: number): void {
+    if (this.length + extra <= this.bytes.length) return;
+    let size = this.bytes.length * 2;
+    while (size < this.length + extra) size *= 2;
+    const grown = new Uint8Array(size);
+    grown.set(this.bytes.subarray(0, this.length));
+    this.bytes = grown;
+  }
+
+  align(n: number): void {
+    const pad = (n - (this.length % n)) % n;
+    this.reserve(pad);
+    this.length += pad; // reserve() zero-fills
+  }
+
+  u32(v: number): void {
+    this.align(4);
+    this.reserve(4);
+    new DataView(this.bytes.buffer).setUint32(this.length, v, true);
+    this.length += 4;
+  }
+
+  array(view: ArrayBufferView): void {
+    this.reserve(view.byteLength);
+    this.bytes.set(new Uint8Array(view.buffer, view.byteOffset, view.byteLength), this.length);
+    this.length += view.byteLength;
+  }
+
+  /** u32 count, u32 byte offsets[count + 1], then UTF-8 bytes. */
+  stringTable(strings: string[]): void {
+    const encoded = strings.map(s => this.encoder.encode(s));
+    const offsets = new Uint32Array(strings.length + 1);
+    for (let i = 0; i < encoded.length; i++) offsets[i + 1] = offsets[i] + encoded[i].length;
+    this.u32(strings.length);
+    this.array(offsets);
+    this.reserve(offsets[strings.length]);
+    for (const e of encoded) {
+      this.bytes.set(e, this.length);
+      this.length += e.length;
+    }
+    this.align(4);
+  }
+
+  patchU32(at: number, v: number): void {
+    new DataView(this.bytes.buffer).setUint32(at, v, true);
+  }
+}
+
+function writeAttributeBlock(w: ByteWriter, attrs: AttributeStore, rowCount: number): void {
+  const columns = attrs.toColumns();
+  w.u32(columns.length);
+  for (const column of columns) {
+    const { name } = column;
+    if (column.values instanceof Float64Array && column.values.length === rowCount) {
+      w.u32(COLUMN_NUMBER);
+      w.stringTable([name]);
+      w.align(8);
+      w.array(column.values);
+      continue;
+    }
+    const values: unknown[] = Array.from({ length: rowCount }, (_, r) => attrs.get(r, name));
+    let allNumbers = true;
+    let allStrings = true;
+    for (let r = 0; r < values.length; r++) {
+      const v = values[r];
+      if (v === undefined) continue;
+      if (typeof v !== 'number' || Number.isNaN(v)) allNumbers = false;
+      if (typeof v !== 'string') allStrings = false;
+    }
+    const kind = allNumbers ? COLUMN_NUMBER : allStrings ? COLUMN_STRING : COLUMN_JSON;
+    w.u32(kind);
+    w.stringTable([name]);
+
+    if (kind === COLUMN_NUMBER) {
+      const numbers = new Float64Array(values.length).fill(NaN);
+      for (let r = 0; r < values.length; r++) {
+        if (values[r] !== undefined) numbers[r] = values[r] as number;
+      }
+      w.align(8);
+      w.array(numbers);
+    } else {
+      const present = new Uint8Array(values.length);
+      const text: string[] = new Array(values.length);
+      for (let r = 0; r < values.length; r++) {
+        const v = values[r];
+        present[r] = v === undefined ? 0 : 1;
+        text[r] = v === undefined ? '' : kind === COLUMN_STRING ? v as string : JSON.stringify(v);
+      }
+      w.array(present);
+      w.align(4);
+      w.stringTable(text);
+    }
+  }
+}
+
+/**
+ * Encode a hypergraph (and optionally its layout, [x, y, vx, vy] per node)
+ * into a `.hblob` ArrayBuffer.
+ */
+export function encodeHypergraphBinary(graph: HypergraphStore | HypergraphData, positions?: Float32Array | null): ArrayBuffer {
+  const store = graph instanceof HypergraphStore ? graph : HypergraphStore.fromHypergraph(graph);
+  const { nodeCount, edgeCount, memberCount } = store;
+  const offsets = store.csr.offsets.subarray(0, edgeCount + 1);
+  const members = store.csr.members.subarray(0, memberCount);
+
+  const metadata = new Uint32Array(nodeCount * 2);
+  for (let i = 0; i < nodeCount; i++) metadata[i * 2] = store.groups[i];
+
+  const hasNumericEdgeIds = store.edgeIds.some(id => typeof id === 'number');
+  if (positions && positions.length < nodeCount * 4) {
+    throw new Error(`positions holds ${positions.length / 4} nodes, expected ${nodeCount}`);
+  }
+
+  const sections: { id: number; write: (w: ByteWriter) => void }[] = [
+    { id: SECTION_OFFSETS, write: w => w.array(offsets) },
+    { id: SECTION_MEMBERS, write: w => w.array(members) },
+    { id: SECTION_NODE_METADATA, write: w => w.array(metadata) },
+    {
+      id: SECTION_STRINGS,
+      write: w => w.stringTable([...store.nodeIds.ids.slice(0, nodeCount), ...store.edgeIds.map(String)]),
+    },
+  ];
+  if (hasNumericEdgeIds) {
+    sections.push({
+      id: SECTION_EDGE_ID_NUMERIC,
+      write: w => w.array(Uint8Array.from(store.edgeIds, id => (typeof id === 'number' ? 1 : 0))),
+    });
+  }
+  if (positions) {
+    sections.push({ id: SECTION_POSITIONS, write: w => w.array(positions.subarray(0, nodeCount * 4)) });
+  }
+  if (!store.nodeAttrs.names.next().done) {
+    sections.push({ id: SECTION_NODE_ATTRS, write: w => writeAttributeBlock(w, store.nodeAttrs, nodeCount) });
+  }
+  if (!store.edgeAttrs.names.next().done) {
+    sections.push({ id: SECTION_EDGE_ATTRS, write: w => writeAttributeBlock(w, store.edgeAttrs, edgeCount) });
+  }
+
+  const w = new ByteWriter();
+  for (const v of [HBLOB_MAGIC, HBLOB_VERSION, nodeCount, edgeCount, memberCount, sections.length]) w.u32(v);
+  const tableStart = w.length;
+  for (let s = 0; s < sections.length * 3; s++) w.u32(0);
+
+  sections.forEach((section, s) => {
+    w.align(SECTION_ALIGN);
+    const start = w.length;
+    section.write(w);
+    w.patchU32(tableStart + s * 12, section.id);
+    w.patchU32(tableStart + s * 12 + 4, start);
+    w.patchU32(tableStart + s * 12 + 8, w.length - start);
+  });
+  w.align(SECTION_ALIGN);
+  return w.bytes.buffer.slice(0, w.length);
+}
+
+// ── Reader ──
+
+class ByteReader {
+  private buffer: ArrayBuffer;
+  private view: DataView;
+  private decoder = new TextDecoder();
+  pos: number;
+
+  constructor(buffer: ArrayBuffer, start: number) {
+    this.buffer = buffer;
+    this.view = new DataView(buffer);
+    this.pos = start;
+  }
+
+  align(n: number): void {
+    this.pos += (n - (this.pos % n)) % n;
+  }
+
+  u32(): number {
+    this.align(4);
+    const v = this.view.getUint32(this.pos, true);
+    this.pos += 4;
+    return v;
+  }
+
+  bytes(length: number): Uint8Array {
+    const v = new Uint8Array(this.buffer, this.pos, length);
+    this.pos += length;
+    return v;
+  }
+
+  f64(count: number): Float64Array {
+    this.align(8);
+    const v = new Float64Array(this.buffer, this.pos, count);
+    this.pos += count * 8;
+    return v;
+  }
+
+  stringTable(): string[] {
+    const count = this.u32();
+    const offsets = new Uint32Array(this.buffer, this.pos, count + 1);
+    this.pos += (count + 1) * 4;
+    const blob = this.bytes(offsets[count]);
+    this.align(4);
+
+    const strings: string[] = new Array(count);
+    const text = this.decoder.decode(blob);
+    if (text.length === blob.length) {
+      // ASCII: byte offsets are char offsets, so slice one decoded string
+      for (let i = 0; i < count; i++) strings[i] = text.substring(offsets[i], offsets[i + 1]);
+    } else {
+      for (let i = 0; i < count; i++) strings[i] = this.decoder.decode(blob.subarray(offsets[i], offsets[i + 1]));
+    }
+    return strings;
+  }
+}
+
+function readAttributeBlock(r: ByteReader, rowCount: number): AttributeColumn[] {
+  const columnCount = r.u32();
+  const columns: AttributeColumn[] = [];
+  for (let c = 0; c < columnCount; c++) {
+    const kind = r.u32();
+    const name = r.stringTable()[0];
+    if (kind === COLUMN_NUMBER) {
+      columns.push({ name, values: r.f64(rowCount) });
+      continue;
+    }
+    if (kind !== COLUMN_STRING && kind !== COLUMN_JSON) throw new Error(`Unknown attribute column kind ${kind}`);
+    const present = r.bytes(rowCount);
+    r.align(4);
+    const text = r.stringTable();
+    const values: unknown[] = new Array(rowCount);
+    for (let i = 0; i < rowCount; i++) {
+      if (present[i]) values[i] = kind === COLUMN_STRING ? text[i] : JSON.parse(text[i]);
+    }
+    columns.push({ name, values });
+  }
+  return columns;
+}
+
+/** Decode a `.hblob`. Array sections are zero-copy views into `buffer`. */
+export function decodeHypergraphBinary(buffer: ArrayBuffer): HypergraphBinary {
+  if (!LITTLE_ENDIAN) throw new Error('.hblob views require a little-endian host');
+  if (buffer.byteLength < HEADER_WORDS * 4) throw new Error('Not a .hblob file: too short');
+  const header = new Uint32Array(buffer, 0, HEADER_WORDS);
+  if (header[0] !== HBLOB_MAGIC) throw new Error('Not a .hblob file: bad magic');
+  if (header[1] > HBLOB_VERSION) throw new Error(`Unsupported .hblob version ${header[1]}`);
+  const [, version, nodeCount, edgeCount, memberCount, sectionCount] = header;
+
+  if ((HEADER_WORDS + sectionCount * 3) * 4 > buffer.byteLength) throw new Error('Truncated .hblob file');
+  const table = new Uint32Array(buffer, HEADER_WORDS * 4, sectionCount * 3);
+  const sections = new Map<number, { offset: number; length: number }>();
+  for (let s = 0; s < sectionCount; s++) {
+    const offset = table[s * 3 + 1];
+    const length = table[s * 3 + 2];
+    if (offset + length > buffer.byteLength) throw new Error('Truncated .hblob file');
+    sections.set(table[s * 3], { offset, length });
+  }
+  const required = (id: number) => {
+    const section = sections.get(id);
+    if (!section) throw new Error(`.hblob is missing section ${id}`);
+    return section;
+  };
+
+  const offsets = new Uint32Array(buffer, required(SECTION_OFFSETS).offset, edgeCount + 1);
+  const members = new Uint32Array(buffer, required(SECTION_MEMBERS).offset, memberCount);
+  const metadata = new Uint32Array(buffer, required(SECTION_NODE_METADATA).offset, nodeCount * 2);
+
+  const ids = new ByteReader(buffer, required(SECTION_STRINGS).offset).stringTable();
+  const nodeIds = ids.slice(0, nodeCount);
+  const edgeIds: (string | number)[] = ids.slice(nodeCount, nodeCount + edgeCount);
+  const numeric = sections.get(SECTION_EDGE_ID_NUMERIC);
+  if (numeric) {
+    const flags = new Uint8Array(buffer, numeric.offset, edgeCount);
+    for (let e = 0; e < edgeCount; e++) {
+      if (flags[e]) edgeIds[e] = Number(edgeIds[e]);
+    }
+  }
+
+  const pos = sections.get(SECTION_POSITIONS);
+  const nodeAttrSection = sections.get(SECTION_NODE_ATTRS);
+  const edgeAttrSection = sections.get(SECTION_EDGE_ATTRS);
+
+  return {
+    version,
+    nodeCount,
+    edgeCount,
+    memberCount,
+    offsets,
+    members,
+    metadata,
+    positions: pos ? new Float32Array(buffer, pos.offset, nodeCount * 4) : null,
+    nodeIds,
+    edgeIds,
+    nodeAttrs: nodeAttrSection ? readAttributeBlock(new ByteReader(buffer, nodeAttrSection.offset), nodeCount) : [],
+    edgeAttrs: edgeAttrSection ? readAttributeBlock(new ByteReader(buffer, edgeAttrSection.offset), edgeCount) : [],
+  };
+}
+
+/** Wrap a decoded `.hblob` as a store; its CSR arrays stay views into the file buffer. */
+export function storeFromBinary(bin: HypergraphBinary): HypergraphStore {
+  const groups = new Uint32Array(bin.nodeCount);
+  for (let i = 0; i < bin.nodeCount; i++) groups[i] = bin.metadata[i * 2];
+  return HypergraphStore.fromParts({
+    nodeIds: bin.nodeIds,
+    edgeIds: bin.edgeIds,
+    offsets: bin.offsets,
+    members: bin.members,
+    groups,
+    nodeAttrs: AttributeStore.fromColumns(bin.nodeAttrs, bin.nodeCount),
+    edgeAttrs: AttributeStore.fromColumns(bin.edgeAttrs, bin.edgeCount),
+  });
+}
+
+/** Materialize a decoded `.hblob` as the object model. */
+export function hypergraphFromBinary(bin: HypergraphBinary): HypergraphData {
+  return storeFromBinary(bin).toHypergraph();
+}
@@ -0,0 +1,284 @@
+import type { HyperedgeData } from './types';
+
+/** First CSR slots whose contents changed since the previous `update`. */
+export interface CSRDirtyRange {
+  offsetsStart: number; // first index into `offsets` that must be re-uploaded
+  membersStart: number; // first index into `members` that must be re-uploaded
+}
+
+/**
+ * Hyperedge membership in compressed sparse row form, mirroring the
+ * `he-offsets` / `he-members` GPU buffers.
+ *
+ * The typed arrays are reused across updates (amortized 2× growth) and each
+ * update reports the first slot that differs from the previous contents, so
+ * appending edges or editing one edge only re-uploads the changed tail.
+ */
+export class HyperedgeCSR {
+  offsets = new Uint32Array(1);
+  members = new Uint32Array(0);
+  edgeCount = 0;
+  memberCount = 0;
+
+  /**
+   * Take prebuilt arrays (e.g. views into a loaded `.hblob`) as the current
+   * contents. They are owned from here on: later updates write into them.
+   */
+  adopt(offsets: Uint32Array, members: Uint32Array): void {
+    this.offsets = offsets;
+    this.members = members;
+    this.edgeCount = offsets.length - 1;
+    this.memberCount = offsets[this.edgeCount];
+  }
+
+  update(hyperedges: HyperedgeData[]): CSRDirtyRange {
+    const prevEdgeCount = this.edgeCount;
+    const prevMemberCount = this.memberCount;
+
+    let total = 0;
+    for (const he of hyperedges) total += he.memberIndices.length;
+
+    if (hyperedges.length + 1 > this.offsets.length) {
+      const grown = new Uint32Array(Math.max(hyperedges.length + 1, this.offsets.length * 2));
+      grown.set(this.offsets.subarray(0, prevEdgeCount + 1));
+      this.offsets = grown;
+    }
+    if (total > this.members.length) {
+      const grown = new Uint32Array(Math.max(total, this.members.length * 2));
+      grown.set(this.members.subarray(0, prevMemberCount));
+      this.members = grown;
+    }
+
+    let offsetsStart = -1;
+    let membersStart = -1;
+    let m = 0;
+    for (let e = 0; e < hyperedges.length; e++) {
+      if (offsetsStart < 0 && (e > prevEdgeCount || this.offsets[e] !== m)) offsetsStart = e;
+      this.offsets[e] = m;
+      for (const idx of hyperedges[e].memberIndices) {
+        if (membersStart < 0 && (m >= prevMemberCount || this.members[m] !== idx)) membersStart = m;
+        this.members[m++] = idx;
+      }
+    }
+    const last = hyperedges.length;
+    if (offsetsStart < 0 && (last > prevEdgeCount || this.offsets[last] !== m)) offsetsStart = last;
+    this.offsets[last] = m;
+
+    this.edgeCount = hyperedges.length;
+    this.memberCount = total;
+
+    return {
+      offsetsStart: offsetsStart < 0 ? last + 1 : offsetsStart,
+      membersStart: membersStart < 0 ? total : membersStart,
+    };
+  }
+
+  // In-place edits for CSR-native callers (HypergraphStore). Each returns the
+  // same dirty range `update` would report for the equivalent object edit.
+
+  /** Append hyperedges with the given member lists. */
+  append(lists: ArrayLike<number>[]): CSRDirtyRange {
+    const prevEdgeCount = this.edgeCount;
+    const prevMemberCount = this.memberCount;
+    let total = prevMemberCount;
+    for (const list of lists) total += list.length;
+    this.reserve(prevEdgeCount + lists.length, total);
+
+    let m = prevMemberCount;
+    let e = prevEdgeCount;
+    for (const list of lists) {
+      for (let k = 0; k < list.length; k++) this.members[m++] = list[k];
+      this.offsets[++e] = m;
+    }
+    this.edgeCount = e;
+    this.memberCount = m;
+    return { offsetsStart: prevEdgeCount + 1, membersStart: prevMemberCount };
+  }
+
+  /** Replace the member list of edge `e`, shifting the tail when its length changes. */
+  replace(e: number, list: ArrayLike<number>): CSRDirtyRange {
+    const start = this.offsets[e];
+    const oldLen = this.offsets[e + 1] - start;
+    const delta = list.length - oldLen;
+    let firstDiff = 0;
+    const common = Math.min(oldLen, list.length);
+    while (firstDiff < common && this.members[start + firstDiff] === list[firstDiff]) firstDiff++;
+    if (delta === 0 && firstDiff === common) {
+      return { offsetsStart: this.edgeCount + 1, membersStart: this.memberCount };
+    }
+
+    this.reserve(this.edgeCount, this.memberCount + Math.max(delta, 0));
+    this.members.copyWithin(start + list.length, start + oldLen, this.memberCount);
+    for (let k = firstDiff; k < list.length; k++) this.members[start + k] = list[k];
+    if (delta !== 0) {
+      for (let i = e + 1; i <= this.edgeCount; i++) this.offsets[i] += delta;
+    }
+    this.memberCount += delta;
+    return { offsetsStart: delta !== 0 ? e + 1 : this.edgeCount + 1, membersStart: start + firstDiff };
+  }
+
+  /**
+   * Append members to several edges (`edges` ascending and distinct, one
+   * list each). The tail is shifted once, back to front, so the cost is one
+   * pass over the members after the first extended edge however many edges grow.
+   */
+  extend(edges: ArrayLike<number>, lists: ArrayLike<number>[]): CSRDirtyRange {
+    let added = 0;
+    for (const list of lists) added += list.length;
+    if (added === 0) return { offsetsStart: this.edgeCount + 1, membersStart: this.memberCount };
+
+    this.reserve(this.edgeCount, this.memberCount + added);
+    const { offsets, members } = this;
+    const membersStart = offsets[edges[0] + 1];
+    let shift = added;
+    let tail = this.memberCount;
+    for (let j = edges.length - 1; j >= 0; j--) {
+      const end = offsets[edges[j] + 1];
+      members.copyWithin(end + shift, end, tail);
+      shift -= lists[j].length;
+      for (let k = 0; k < lists[j].length; k++) members[end + shift + k] = lists[j][k];
+      tail = end;
+    }
+    let grown = 0;
+    for (let e = edges[0] + 1, j = 0; e <= this.edgeCount; e++) {
+      while (j < edges.length && edges[j] < e) grown += lists[j++].length;
+      offsets[e] += grown;
+    }
+    this.memberCount += added;
+    return { offsetsStart: edges[0] + 1, membersStart };
+  }
+
+  /** Drop edges whose `remap` entry is -1, compacting the rest in order. */
+  removeEdges(remap: Int32Array): CSRDirtyRange {
+    const { offsets, members } = this;
+    let first = -1;
+    let m = 0;
+    let w = 0;
+    for (let e = 0; e < this.edgeCount; e++) {
+      const start = offsets[e];
+      const end = offsets[e + 1];
+      if (remap[e] < 0) {
+        if (first < 0) first = e;
+        continue;
+      }
+      if (first >= 0) members.copyWithin(m, start, end);
+      offsets[w++] = m;
+      m += end - start;
+    }
+    offsets[w] = m;
+    const membersStart = first < 0 ? m : offsets[first];
+    this.edgeCount = w;
+    this.memberCount = m;
+    return { offsetsStart: first < 0 ? w + 1 : first, membersStart };
+  }
+
+  /** Rewrite members through a node remap (-1 = removed node, dropped from its edges). */
+  remapMembers(remap: Int32Array): CSRDirtyRange {
+    const { offsets, members } = this;
+    let offsetsStart = -1;
+    let membersStart = -1;
+    let w = 0;
+    for (let e = 0; e < this.edgeCount; e++) {
+      const start = offsets[e];
+      const end = offsets[e + 1];
+      if (offsetsStart < 0 && start !== w) offsetsStart = e;
+      offsets[e] = w;
+      for (let r = start; r < end; r++) {
+        const mapped = remap[members[r]];
+        if (mapped < 0) continue;
+        if (membersStart < 0 && (w !== r || mapped !== members[r])) membersStart = w;
+        members[w++] = mapped;
+      }
+    }
+    const last = this.edgeCount;
+    if (offsetsStart < 0 && offsets[last] !== w) offsetsStart = last;
+    offsets[last] = w;
+    this.memberCount = w;
+    return {
+      offsetsStart: offsetsStart < 0 ? last + 1 : offsetsStart,
+      membersStart: membersStart < 0 ? w : membersStart,
+    };
+  }
+
+  private reserve(edgeCount: number, memberCount: number): void {
+    if (edgeCount + 1 > this.offsets.length) {
+      const grown = new Uint32Array(Math.max(edgeCount + 1, this.offsets.length * 2));
+      grown.set(this.offsets.subarray(0, this.edgeCount + 1));
+      this.offsets = grown;
+    }
+    if (memberCount > this.members.length) {
+      const grown = new Uint32Array(Math.max(memberCount, this.members.length * 2));
+      grown.set(this.members.subarray(0, this.memberCount));
+      this.members = grown;
+    }
+  }
+}
+
+/**
+ * Pack (edge, node) incidence pairs into CSR in linear time: a counting sort
+ * by edge (stable, so members keep incidence order) followed by one
+ * de-duplication sweep. `seen` is stamped with edge index + 1, so a repeated
+ * member costs one Int32Array probe instead of a scan of the edge so far.
+ */
+export function packIncidences(
+  incEdge: Uint32Array, incNode: Uint32Array, count: number, edgeCount: number, nodeCount: number,
+): { offsets: Uint32Array; members: Uint32Array } {
+  const offsets = new Uint32Array(edgeCount + 1);
+  for (let k = 0; k < count; k++) offsets[incEdge[k] + 1]++;
+  for (let e = 0; e < edgeCount; e++) offsets[e + 1] += offsets[e];
+  const cursor = offsets.slice(0, edgeCount);
+  const sorted = new Uint32Array(count);
+  for (let k = 0; k < count; k++) sorted[cursor[incEdge[k]]++] = incNode[k];
+
+  const seen = new Int32Array(nodeCount);
+  let m = 0;
+  for (let e = 0; e < edgeCount; e++) {
+    const start = offsets[e];
+    const end = offsets[e + 1];
+    offsets[e] = m;
+    for (let k = start; k < end; k++) {
+      const ni = sorted[k];
+      if (seen[ni] === e + 1) continue;
+      seen[ni] = e + 1;
+      sorted[m++] = ni; // m <= k, so compacting in place never overwrites unread slots
+    }
+  }
+  offsets[edgeCount] = m;
+  return { offsets, members: sorted.subarray(0, m) };
+}
+
+/**
+ * Transpose of a HyperedgeCSR: for each node, the hyperedges it belongs to in
+ * ascending edge order. Mirrors the `node-edge-offsets` / `node-edge-ids` GPU
+ * buffers used by the deterministic attraction gather. Arrays are reused
+ * across builds.
+ */
+export class NodeIncidenceCSR {
+  offsets = new Uint32Array(1);
+  edges = new Uint32Array(0);
+  nodeCount = 0;
+
+  build(csr: HyperedgeCSR, nodeCount: number): void {
+    const { offsets: heOffsets, members, edgeCount, memberCount } = csr;
+
+    if (nodeCount + 1 > this.offsets.length) {
+      this.offsets = new Uint32Array(Math.max(nodeCount + 1, this.offsets.length * 2));
+    }
+    if (memberCount > this.edges.length) {
+      this.edges = new Uint32Array(Math.max(memberCount, this.edges.length * 2));
+    }
+    const offsets = this.offsets;
+    offsets.fill(0, 0, nodeCount + 1);
+
+    // Counting sort by node; walking edges in order keeps each node's list sorted
+    for (let m = 0; m < memberCount; m++) offsets[members[m] + 1]++;
+    for (let i = 0; i < nodeCount; i++) offsets[i + 1] += offsets[i];
+    const cursor = offsets.slice(0, nodeCount);
+    for (let e = 0; e < edgeCount; e++) {
+      for (let m = heOffsets[e]; m < heOffsets[e + 1]; m++) {
+        this.edges[cursor[members[m]]++] = e;
+      }
+    }
+    this.nodeCount = nodeCount;
+  }
+}
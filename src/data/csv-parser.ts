@@ -1,55 +0,0 @@
-export interface ParsedCSV {
-  headers: string[];
-  rows: string[][];
-}
-
-export function parseCSV(text: string): ParsedCSV {
-  const lines = text.split(/\r?\n/);
-  if (lines.length === 0) return { headers: [], rows: [] };
-
-  const headers = parseLine(lines[0]);
-  const rows: string[][] = [];
-
-  for (let i = 1; i < lines.length; i++) {
-    const line = lines[i].trim();
-    if (line === '') continue;
-    const row = parseLine(line);
-    while (row.length < headers.length) row.push('');
-    rows.push(row.slice(0, headers.length));
-  }
-
-  return { headers, rows };
-}
-
-function parseLine(line: string): string[] {
-  const fields: string[] = [];
-  let current = '';
-  let inQuotes = false;
-
-  for (let i = 0; i < line.length; i++) {
-    const ch = line[i];
-    if (inQuotes) {
-      if (ch === '"') {
-        if (i + 1 < line.length && line[i + 1] === '"') {
-          current += '"';
-          i++;
-        } else {
-          inQuotes = false;
-        }
-      } else {
-        current += ch;
-      }
-    } else {
-      if (ch === '"') {
-        inQuotes = true;
-      } else if (ch === ',') {
-        fields.push(current.trim());
-        current = '';
-      } else {
-        current += ch;
-      }
-    }
-  }
-  fields.push(current.trim());
-  return fields;
-}
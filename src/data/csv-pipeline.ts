@@ -0,0 +1,99 @@
+/**
+ * Main-thread side of CSV ingestion: scanning and per-column grouping run in
+ * workers (src/data/csv-worker.ts) so a multi-hundred-MB upload never blocks
+ * the page. Only dictionary-encoded columns and CSR arrays cross the worker
+ * boundary, as transferables.
+ */
+import CSVWorker from './csv-worker?worker&inline';
+import { csvTableToStore, type CSVTable, type ColumnMapping, type ColumnPostings } from './csv-stream';
+import type { HypergraphStore } from './hypergraph-store';
+
+export type CSVWorkerRequest =
+  | { type: 'scan'; source: Blob; delimiter?: ',' | '\t' }
+  | { type: 'postings'; nodeCodes: Uint32Array; groupCodes: Uint32Array; nodeCount: number; groupCount: number };
+
+export type CSVWorkerResponse =
+  | { type: 'progress'; bytesRead: number; rows: number }
+  | { type: 'table'; table: CSVTable }
+  | { type: 'postings'; postings: ColumnPostings }
+  | { type: 'error'; message: string };
+
+export interface CSVScanProgress {
+  bytesRead: number;
+  totalBytes: number;
+  rows: number;
+}
+
+/** Run one request on a fresh worker; resolves with its final (non-progress) response. */
+function runWorker(
+  request: CSVWorkerRequest,
+  onProgress?: (bytesRead: number, rows: number) => void,
+): Promise<CSVWorkerResponse> {
+  return new Promise((resolve, reject) => {
+    const worker = new CSVWorker();
+    worker.onmessage = (event: MessageEvent<CSVWorkerResponse>) => {
+      const response = event.data;
+      if (response.type === 'progress') {
+        onProgress?.(response.bytesRead, response.rows);
+        return;
+      }
+      worker.terminate();
+      if (response.type === 'error') reject(new Error(response.message));
+      else resolve(response);
+    };
+    worker.onerror = (event) => {
+      worker.terminate();
+      reject(new Error(event.message || 'CSV worker failed'));
+    };
+    worker.postMessage(request);
+  });
+}
+
+/**
+ * Tokenize and dictionary-encode a CSV/TSV file (or pasted text wrapped in a
+ * Blob) off the main thread. The delimiter is detected from the header line.
+ */
+export async function scanCSV(
+  source: Blob,
+  options: { delimiter?: ',' | '\t'; onProgress?: (p: CSVScanProgress) => void } = {},
+): Promise<CSVTable> {
+  const response = await runWorker(
+    { type: 'scan', source, delimiter: options.delimiter },
+    (bytesRead, rows) => options.onProgress?.({ bytesRead, totalBytes: source.size, rows }),
+  );
+  if (response.type !== 'table') throw new Error(`Unexpected CSV worker response: ${response.type}`);
+  return response.table;
+}
+
+/**
+ * Build the hypergraph for a column mapping. Each edge column is grouped in
+ * its own worker (at most `hardwareConcurrency` at once); the table stays on
+ * the main thread so other mappings can be tried without rescanning.
+ */
+export async function buildCSVHypergraph(table: CSVTable, mapping: ColumnMapping): Promise<HypergraphStore> {
+  const nodeColumn = table.columns[mapping.nodeColumn];
+  const nodeCount = nodeColumn.values.length - 1;
+  const maxWorkers = Math.max(1, Math.min(mapping.edgeColumns.length, navigator.hardwareConcurrency || 4));
+
+  const postings: ColumnPostings[] = new Array(mapping.edgeColumns.length);
+  let next = 0;
+  const lane = async (): Promise<void> => {
+    while (next < mapping.edgeColumns.length) {
+      const k = next++;
+      const column = table.columns[mapping.edgeColumns[k]];
+      // Codes are structured-cloned (copied), not transferred: the table is reused
+      const response = await runWorker({
+        type: 'postings',
+        nodeCodes: nodeColumn.codes,
+        groupCodes: column.codes,
+        nodeCount,
+        groupCount: column.values.length,
+      });
+      if (response.type !== 'postings') throw new Error(`Unexpected CSV worker response: ${response.type}`);
+      postings[k] = response.postings;
+    }
+  };
+  await Promise.all(Array.from({ length: maxWorkers }, lane));
+
+  return csvTableToStore(table, mapping, postings);
+}
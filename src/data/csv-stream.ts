@@ -0,0 +1,364 @@
+/**
+ * Streaming CSV/TSV ingestion, split into worker-friendly stages:
+ *
+ * 1. `CSVTokenizer` — byte-level state machine over arbitrary chunks
+ *    (quoted fields may span lines and chunk boundaries).
+ * 2. `CSVTableBuilder` — dictionary-encodes every column as it streams in:
+ *    each distinct value gets a code (first-appearance order, 0 = empty) and
+ *    each row stores one u32 per column. Node IDs and groups are then just
+ *    codes, so no row of strings is ever kept.
+ * 3. `columnPostings` — for one edge column, the nodes of each group as CSR
+ *    (counting sort, stamped de-dup). Columns are independent, so
+ *    src/data/csv-pipeline.ts runs them in parallel workers.
+ * 4. `csvTableToStore` — stitches the per-column CSRs into a HypergraphStore.
+ *
+ * Semantics match the previous parser: fields are trimmed, blank lines
+ * skipped, rows padded/truncated to the header, singleton groups dropped.
+ */
+import { HypergraphStore, AttributeStore, type AttributeColumn } from './hypergraph-store';
+
+export interface ColumnMapping {
+  nodeColumn: number;     // index of column used as node ID
+  edgeColumns: number[];  // indices of columns used as hyperedge groupings
+}
+
+/** One dictionary-encoded column: `values[codes[row]]` is the cell (values[0] = ''). */
+export interface CSVColumn {
+  values: string[];
+  codes: Uint32Array;     // rowCount entries
+}
+
+export interface CSVTable {
+  headers: string[];
+  rowCount: number;
+  columns: CSVColumn[];
+}
+
+/** Nodes of each non-singleton group in one edge column. */
+export interface ColumnPostings {
+  offsets: Uint32Array;   // edgeCount + 1
+  members: Uint32Array;   // node indices (node column code - 1)
+  groupCodes: Uint32Array; // per edge: code into the edge column's `values`
+}
+
+const QUOTE = 0x22;
+const CR = 0x0d;
+const LF = 0x0a;
+const COMMA = 0x2c;
+const TAB = 0x09;
+
+const STATE_FIELD = 0;        // unquoted
+const STATE_QUOTED = 1;       // inside quotes
+const STATE_QUOTE_IN_QUOTED = 2; // saw `"` inside quotes: `""` escape or closing quote
+
+/**
+ * Incremental CSV/TSV tokenizer. Feed byte chunks with `push`, then `end`;
+ * `onRow` receives each record's trimmed fields. Unless given, the delimiter
+ * is whichever of comma or tab comes first on the header line.
+ */
+export class CSVTokenizer {
+  private onRow: (fields: string[]) => void;
+  private delimiter: number;
+  private state = STATE_FIELD;
+  private field = new Uint8Array(256);
+  private fieldLength = 0;
+  private fieldAscii = true;
+  private fields: string[] = [];
+  private decoder = new TextDecoder();
+
+  constructor(onRow: (fields: string[]) => void, delimiter?: ',' | '\t') {
+    this.onRow = onRow;
+    this.delimiter = delimiter === undefined ? -1 : delimiter.charCodeAt(0);
+  }
+
+  push(chunk: Uint8Array): void {
+    if (this.delimiter < 0) this.detectDelimiter(chunk);
+    const delimiter = this.delimiter;
+    const n = chunk.length;
+    let i = 0;
+    while (i < n) {
+      const state = this.state;
+      if (state === STATE_QUOTE_IN_QUOTED) {
+        if (chunk[i] === QUOTE) {
+          this.append(chunk, i, i + 1); // `""` → literal quote
+          this.state = STATE_QUOTED;
+          i++;
+        } else {
+          this.state = STATE_FIELD; // closing quote; byte is handled unquoted
+        }
+        continue;
+      }
+      if (state === STATE_QUOTED) {
+        let j = i;
+        while (j < n && chunk[j] !== QUOTE) j++;
+        this.append(chunk, i, j);
+        if (j < n) this.state = STATE_QUOTE_IN_QUOTED;
+        i = j + 1;
+        continue;
+      }
+      // Unquoted: copy the run up to the next special byte
+      let j = i;
+      while (j < n) {
+        const b = chunk[j];
+        if (b === delimiter || b === LF || b === CR || b === QUOTE) break;
+        j++;
+      }
+      this.append(chunk, i, j);
+      if (j === n) break;
+      const b = chunk[j];
+      if (b === QUOTE) this.state = STATE_QUOTED;
+      else if (b === delimiter) this.endField();
+      else if (b === LF) this.endRecord();
+      // CR outside quotes is dropped (CRLF line endings)
+      i = j + 1;
+    }
+  }
+
+  /** Flush the last record (files without a trailing newline). */
+  end(): void {
+    if (this.state === STATE_QUOTE_IN_QUOTED) this.state = STATE_FIELD;
+    if (this.fieldLength > 0 || this.fields.length > 0) this.endRecord();
+  }
+
+  /** Scan the rest of the header line; stays undecided until a delimiter or newline shows up. */
+  private detectDelimiter(chunk: Uint8Array): void {
+    for (let i = 0; i < chunk.length; i++) {
+      const b = chunk[i];
+      if (b === COMMA || b === TAB) { this.delimiter = b; return; }
+      if (b === LF) { this.delimiter = COMMA; return; }
+    }
+  }
+
+  private append(chunk: Uint8Array, start: number, end: number): void {
+    const len = end - start;
+    if (len <= 0) return;
+    if (this.fieldLength + len > this.field.length) {
+      const grown = new Uint8Array(Math.max(this.fieldLength + len, this.field.length * 2));
+      grown.set(this.field.subarray(0, this.fieldLength));
+      this.field = grown;
+    }
+    for (let k = start; k < end && this.fieldAscii; k++) {
+      if (chunk[k] >= 0x80) this.fieldAscii = false;
+    }
+    this.field.set(chunk.subarray(start, end), this.fieldLength);
+    this.fieldLength += len;
+  }
+
+  private endField(): void {
+    const bytes = this.field.subarray(0, this.fieldLength);
+    // Short ASCII fields skip TextDecoder — it dominates on narrow columns
+    const text = this.fieldAscii && bytes.length <= 1024
+      ? String.fromCharCode.apply(null, bytes as unknown as number[])
+      : this.decoder.decode(bytes);
+    this.fields.push(text.trim());
+    this.fieldLength = 0;
+    this.fieldAscii = true;
+  }
+
+  private endRecord(): void {
+    this.endField();
+    const fields = this.fields;
+    this.fields = [];
+    if (fields.length === 1 && fields[0] === '') return; // blank line
+    this.onRow(fields);
+  }
+}
+
+/** Dictionary-encodes rows as they arrive; the first row is the header. */
+export class CSVTableBuilder {
+  headers: string[] = [];
+  rowCount = 0;
+  private dicts: Map<string, number>[] = [];
+  private values: string[][] = [];
+  private codes: Uint32Array[] = [];
+
+  addRow(fields: string[]): void {
+    if (this.headers.length === 0) {
+      this.headers = fields;
+      for (let c = 0; c < fields.length; c++) {
+        this.dicts.push(new Map([['', 0]]));
+        this.values.push(['']);
+        this.codes.push(new Uint32Array(1024));
+      }
+      return;
+    }
+    const r = this.rowCount;
+    if (r === this.codes[0]?.length) {
+      for (let c = 0; c < this.codes.length; c++) {
+        const grown = new Uint32Array(r * 2);
+        grown.set(this.codes[c]);
+        this.codes[c] = grown;
+      }
+    }
+    for (let c = 0; c < this.headers.length; c++) {
+      const value = c < fields.length ? fields[c] : '';
+      const dict = this.dicts[c];
+      let code = dict.get(value);
+      if (code === undefined) {
+        code = this.values[c].length;
+        dict.set(value, code);
+        this.values[c].push(value);
+      }
+      this.codes[c][r] = code;
+    }
+    this.rowCount = r + 1;
+  }
+
+  finish(): CSVTable {
+    return {
+      headers: this.headers,
+      rowCount: this.rowCount,
+      columns: this.values.map((values, c) => ({ values, codes: this.codes[c].slice(0, this.rowCount) })),
+    };
+  }
+}
+
+/** Tokenize and dictionary-encode a whole byte stream. */
+export async function scanCSVStream(
+  source: ReadableStream<Uint8Array>,
+  options: { delimiter?: ',' | '\t'; onProgress?: (bytesRead: number, rows: number) => void } = {},
+): Promise<CSVTable> {
+  const builder = new CSVTableBuilder();
+  const tokenizer = new CSVTokenizer(fields => builder.addRow(fields), options.delimiter);
+  const reader = source.getReader();
+  let bytesRead = 0;
+  for (;;) {
+    const { done, value } = await reader.read();
+    if (done) break;
+    tokenizer.push(value);
+    bytesRead += value.byteLength;
+    options.onProgress?.(bytesRead, builder.rowCount);
+  }
+  tokenizer.end();
+  return builder.finish();
+}
+
+/**
+ * Group one edge column's rows into hyperedges. Nodes are the node column's
+ * codes minus one (code order = first appearance = node index); rows with an
+ * empty node or group are skipped, groups keep first-appearance order among
+ * the remaining rows, and members keep row order without repeats.
+ */
+export function columnPostings(
+  nodeCodes: Uint32Array, groupCodes: Uint32Array, nodeCount: number, groupCount: number,
+): ColumnPostings {
+  const rows = nodeCodes.length;
+
+  // Rank groups by first appearance and count their rows
+  const rank = new Int32Array(groupCount).fill(-1);
+  const rankToCode: number[] = [];
+  const counts: number[] = [];
+  for (let r = 0; r < rows; r++) {
+    const g = groupCodes[r];
+    if (g === 0 || nodeCodes[r] === 0) continue;
+    if (rank[g] < 0) {
+      rank[g] = rankToCode.length;
+      rankToCode.push(g);
+      counts.push(0);
+    }
+    counts[rank[g]]++;
+  }
+  const ranked = rankToCode.length;
+
+  // Counting sort rows by group rank (stable → row order)
+  const start = new Uint32Array(ranked + 1);
+  for (let k = 0; k < ranked; k++) start[k + 1] = start[k] + counts[k];
+  const cursor = start.slice(0, ranked);
+  const sorted = new Uint32Array(start[ranked]);
+  for (let r = 0; r < rows; r++) {
+    const g = groupCodes[r];
+    if (g === 0 || nodeCodes[r] === 0) continue;
+    sorted[cursor[rank[g]]++] = nodeCodes[r] - 1;
+  }
+
+  // De-dup per group (stamped with rank + 1) and drop singletons
+  const seen = new Int32Array(nodeCount);
+  const offsets = new Uint32Array(ranked + 1);
+  const groupOf = new Uint32Array(ranked);
+  let edges = 0;
+  let m = 0;
+  for (let k = 0; k < ranked; k++) {
+    const first = m;
+    for (let s = start[k]; s < start[k + 1]; s++) {
+      const ni = sorted[s];
+      if (seen[ni] === k + 1) continue;
+      seen[ni] = k + 1;
+      sorted[m++] = ni;
+    }
+    if (m - first < 2) { m = first; continue; }
+    groupOf[edges] = rankToCode[k];
+    offsets[++edges] = m;
+  }
+
+  return {
+    offsets: offsets.slice(0, edges + 1),
+    members: sorted.slice(0, m),
+    groupCodes: groupOf.slice(0, edges),
+  };
+}
+
+/**
+ * Assemble the hypergraph: one node per distinct node-column value, the edge
+ * columns' postings in mapping order, and each node's other cells (from its
+ * first row) as attributes.
+ */
+export function csvTableToStore(table: CSVTable, mapping: ColumnMapping, postings: ColumnPostings[]): HypergraphStore {
+  const nodeColumn = table.columns[mapping.nodeColumn];
+  const nodeIds = nodeColumn.values.slice(1);
+  const nodeCount = nodeIds.length;
+
+  // First row of each node
+  const firstRow = new Int32Array(nodeCount).fill(-1);
+  for (let r = 0; r < table.rowCount; r++) {
+    const code = nodeColumn.codes[r];
+    if (code !== 0 && firstRow[code - 1] < 0) firstRow[code - 1] = r;
+  }
+  const nodeAttrColumns: AttributeColumn[] = [];
+  for (let c = 0; c < table.headers.length; c++) {
+    if (c === mapping.nodeColumn) continue;
+    const { values: dict, codes } = table.columns[c];
+    const values: unknown[] = new Array(nodeCount);
+    for (let i = 0; i < nodeCount; i++) values[i] = dict[codes[firstRow[i]]];
+    nodeAttrColumns.push({ name: table.headers[c], values });
+  }
+
+  // Concatenate per-column CSRs
+  let edgeCount = 0;
+  let memberCount = 0;
+  for (const p of postings) {
+    edgeCount += p.groupCodes.length;
+    memberCount += p.members.length;
+  }
+  const offsets = new Uint32Array(edgeCount + 1);
+  const members = new Uint32Array(memberCount);
+  const edgeIds: string[] = [];
+  const names: unknown[] = [];
+  const columnNames: unknown[] = [];
+  let e = 0;
+  let m = 0;
+  for (let k = 0; k < postings.length; k++) {
+    const p = postings[k];
+    const header = table.headers[mapping.edgeColumns[k]];
+    const dict = table.columns[mapping.edgeColumns[k]].values;
+    members.set(p.members, m);
+    for (let local = 0; local < p.groupCodes.length; local++) {
+      const value = dict[p.groupCodes[local]];
+      edgeIds.push(`${header}:${value}`);
+      names.push(value);
+      columnNames.push(header);
+      offsets[++e] = m + p.offsets[local + 1];
+    }
+    m += p.members.length;
+  }
+
+  return HypergraphStore.fromParts({
+    nodeIds,
+    edgeIds,
+    offsets,
+    members,
+    nodeAttrs: AttributeStore.fromColumns(nodeAttrColumns, nodeCount),
+    edgeAttrs: AttributeStore.fromColumns(
+      [{ name: 'name', values: names }, { name: 'column', values: columnNames }], edgeCount,
+    ),
+  });
+}
@@ -0,0 +1,33 @@
+// CSV ingestion worker: scans a Blob into a dictionary-encoded table, or
+// builds one edge column's postings. Results go back as transferables.
+import { scanCSVStream, columnPostings } from './csv-stream';
+import type { CSVWorkerRequest, CSVWorkerResponse } from './csv-pipeline';
+
+function reply(message: CSVWorkerResponse, transfer: Transferable[] = []): void {
+  // The options form types under the DOM lib and is the same call in a worker
+  self.postMessage(message, { transfer });
+}
+
+self.onmessage = async (event: MessageEvent<CSVWorkerRequest>) => {
+  const request = event.data;
+  try {
+    if (request.type === 'scan') {
+      let lastReport = 0;
+      const table = await scanCSVStream(request.source.stream(), {
+        delimiter: request.delimiter,
+        onProgress: (bytesRead, rows) => {
+          // Throttle to ~1% steps so progress messages don't flood the main thread
+          if (bytesRead - lastReport < request.source.size / 100) return;
+          lastReport = bytesRead;
+          reply({ type: 'progress', bytesRead, rows });
+        },
+      });
+      reply({ type: 'table', table }, table.columns.map(c => c.codes.buffer));
+    } else {
+      const postings = columnPostings(request.nodeCodes, request.groupCodes, request.nodeCount, request.groupCount);
+      reply({ type: 'postings', postings }, [postings.offsets.buffer, postings.members.buffer, postings.groupCodes.buffer]);
+    }
+  } catch (err) {
+    reply({ type: 'error', message: err instanceof Error ? err.message : String(err) });
+  }
+};
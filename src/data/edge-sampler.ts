@@ -0,0 +1,100 @@
+/**
+ * Hyperedge sampling under an incidence budget, for previews of datasets
+ * whose incidence buffers would not fit the GPU.
+ *
+ * Bottom-k reservoir: every hyperedge gets a pseudo-random priority in
+ * [0, 1) hashed from its ID and the seed, and the sample is the set of
+ * lowest-priority edges whose sizes fit the budget. An incidence is admitted
+ * while its edge's priority is below the current threshold; once admitted
+ * incidences exceed the budget the highest-priority edges are evicted (a
+ * max-heap) and the threshold drops to the last evicted priority. Because
+ * the decision only depends on the edge ID, the sample is reproducible and
+ * independent of incidence order, and an edge is kept whole or not at all.
+ */
+export class EdgeSampler {
+  readonly budget: number;
+  private seed: number;
+  private threshold = 1;
+  private kept = 0;
+  private sizes: number[] = [];      // per admitted edge (dense caller index)
+  private priorities: number[] = [];
+  private evicted: boolean[] = [];
+  private heap: number[] = [];       // admitted edges, max-heap on priority
+
+  constructor(budget: number, seed = 1) {
+    if (!(budget > 0)) throw new Error(`Incidence budget must be positive, got ${budget}`);
+    this.budget = budget;
+    this.seed = seed;
+  }
+
+  /** Priority of an edge ID: seeded FNV-1a over its UTF-16 units, finalized with murmur3 mixing. */
+  priority(edgeKey: string): number {
+    let h = (0x811c9dc5 ^ Math.imul(this.seed, 0x9e3779b1)) >>> 0;
+    for (let i = 0; i < edgeKey.length; i++) h = Math.imul(h ^ edgeKey.charCodeAt(i), 0x01000193);
+    h = Math.imul(h ^ (h >>> 16), 0x85ebca6b);
+    h = Math.imul(h ^ (h >>> 13), 0xc2b2ae35);
+    return ((h ^ (h >>> 16)) >>> 0) / 4294967296;
+  }
+
+  /** Whether an incidence of an edge with this priority belongs in the sample so far. */
+  admits(priority: number): boolean {
+    return priority < this.threshold;
+  }
+
+  /** Record an admitted incidence of edge `e` (dense index, first seen with `priority`). */
+  add(e: number, priority: number): void {
+    if (this.sizes[e] === undefined) {
+      this.sizes[e] = 0;
+      this.priorities[e] = priority;
+      this.evicted[e] = false;
+      this.push(e);
+    }
+    this.sizes[e]++;
+    this.kept++;
+    while (this.kept > this.budget && this.heap.length > 0) {
+      const top = this.pop();
+      this.kept -= this.sizes[top];
+      this.evicted[top] = true;
+      this.threshold = this.priorities[top];
+    }
+  }
+
+  /** Whether edge `e` is still in the sample. */
+  keeps(e: number): boolean {
+    return this.sizes[e] !== undefined && !this.evicted[e];
+  }
+
+  /** Incidences currently in the sample. */
+  get incidences(): number { return this.kept; }
+
+  private push(e: number): void {
+    const { heap, priorities } = this;
+    let i = heap.length;
+    heap.push(e);
+    while (i > 0) {
+      const parent = (i - 1) >> 1;
+      if (priorities[heap[parent]] >= priorities[e]) break;
+      heap[i] = heap[parent];
+      i = parent;
+    }
+    heap[i] = e;
+  }
+
+  private pop(): number {
+    const { heap, priorities } = this;
+    const top = heap[0];
+    const last = heap.pop()!;
+    if (heap.length === 0) return top;
+    let i = 0;
+    for (;;) {
+      let child = i * 2 + 1;
+      if (child >= heap.length) break;
+      if (child + 1 < heap.length && priorities[heap[child + 1]] > priorities[heap[child]]) child++;
+      if (priorities[heap[child]] <= priorities[last]) break;
+      heap[i] = heap[child];
+      i = child;
+    }
+    heap[i] = last;
+    return top;
+  }
+}
@@ -0,0 +1,35 @@
+/**
+ * Main-thread side of graph generation: the generators in
+ * src/data/generator.ts run in a worker (src/data/generator-worker.ts) and
+ * hand back typed CSR arrays as transferables, so generating millions of
+ * incidences never stalls rendering.
+ */
+import GeneratorWorker from './generator-worker?worker&inline';
+import { syntheticToStore, type SyntheticOptions, type SyntheticCSR } from './generator';
+import type { HypergraphStore } from './hypergraph-store';
+
+export type GeneratorRequest =
+  | { type: 'synthetic'; options: SyntheticOptions }
+  | { type: 'uniform'; nodeCount: number; edgeCount: number; maxEdgeSize: number; seed?: number };
+
+export type GeneratorResponse =
+  | { type: 'csr'; csr: SyntheticCSR }
+  | { type: 'error'; message: string };
+
+/** Run a generator request on a fresh worker. */
+export function generateInWorker(request: GeneratorRequest): Promise<HypergraphStore> {
+  return new Promise((resolve, reject) => {
+    const worker = new GeneratorWorker();
+    worker.onmessage = (event: MessageEvent<GeneratorResponse>) => {
+      worker.terminate();
+      const response = event.data;
+      if (response.type === 'error') reject(new Error(response.message));
+      else resolve(syntheticToStore(response.csr));
+    };
+    worker.onerror = (event) => {
+      worker.terminate();
+      reject(new Error(event.message || 'Generator worker failed'));
+    };
+    worker.postMessage(request);
+  });
+}
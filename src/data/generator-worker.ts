@@ -0,0 +1,28 @@
+// Generator worker: builds a synthetic hypergraph as typed CSR and transfers it back.
+import { generateSynthetic, generateRandomHypergraphStore, type SyntheticCSR } from './generator';
+import type { GeneratorRequest, GeneratorResponse } from './generator-pipeline';
+
+function reply(message: GeneratorResponse, transfer: Transferable[] = []): void {
+  self.postMessage(message, { transfer });
+}
+
+self.onmessage = (event: MessageEvent<GeneratorRequest>) => {
+  const request = event.data;
+  try {
+    let csr: SyntheticCSR;
+    if (request.type === 'synthetic') {
+      csr = generateSynthetic(request.options);
+    } else {
+      const store = generateRandomHypergraphStore(request.nodeCount, request.edgeCount, request.maxEdgeSize, request.seed);
+      csr = {
+        nodeCount: store.nodeCount,
+        offsets: store.csr.offsets,
+        members: store.csr.members,
+        groups: store.groups,
+      };
+    }
+    reply({ type: 'csr', csr }, [csr.offsets.buffer, csr.members.buffer, csr.groups.buffer]);
+  } catch (err) {
+    reply({ type: 'error', message: err instanceof Error ? err.message : String(err) });
+  }
+};
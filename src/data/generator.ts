@@ -1,4 +1,6 @@
-import type { HypergraphData, NodeData, HyperedgeData } from './types';
+import type { HypergraphData } from './types';
+import { HypergraphStore } from './hypergraph-store';
+import { createRng, rngFor } from '../utils/random';
 
 /**
  * Generate a random hypergraph for stress testing.
@@ -6,45 +8,47 @@ import type { HypergraphData, NodeData, HyperedgeData } from './types';
  * - Random hyperedge sizes between 2 and maxEdgeSize
  * - Every node appears in at least one hyperedge
  * - Group assigned based on first hyperedge membership (mod 16)
+ * - Passing `seed` makes the output reproducible
  */
 export function generateRandomHypergraph(
   nodeCount: number,
   edgeCount: number,
   maxEdgeSize: number,
+  seed?: number,
 ): HypergraphData {
+  return generateRandomHypergraphStore(nodeCount, edgeCount, maxEdgeSize, seed).toHypergraph();
+}
+
+/** `generateRandomHypergraph` without the object model (same output for the same seed). */
+export function generateRandomHypergraphStore(
+  nodeCount: number,
+  edgeCount: number,
+  maxEdgeSize: number,
+  seed?: number,
+): HypergraphStore {
+  const random = rngFor(seed);
+
   // Clamp inputs
   nodeCount = Math.max(1, nodeCount);
   edgeCount = Math.max(1, edgeCount);
   maxEdgeSize = Math.max(2, maxEdgeSize);
 
-  const nodeIdToIndex = new Map<string, number>();
-  const nodes: NodeData[] = [];
-  const hyperedges: HyperedgeData[] = [];
-
-  // Create nodes
-  for (let i = 0; i < nodeCount; i++) {
-    const id = `n${i}`;
-    nodeIdToIndex.set(id, i);
-    nodes.push({
-      id,
-      index: i,
-      group: 0,
-      attrs: {},
-    });
-  }
+  const nodeIds: string[] = new Array(nodeCount);
+  for (let i = 0; i < nodeCount; i++) nodeIds[i] = `n${i}`;
+  const lists: number[][] = [];
 
   // Track which nodes have been assigned to at least one edge
   const nodeInEdge = new Uint8Array(nodeCount);
 
   // Create random hyperedges
   for (let e = 0; e < edgeCount; e++) {
-    const size = 2 + Math.floor(Math.random() * (maxEdgeSize - 1));
+    const size = 2 + Math.floor(random() * (maxEdgeSize - 1));
     const clampedSize = Math.min(size, nodeCount);
     const memberSet = new Set<number>();
 
     // Pick random unique members
     while (memberSet.size < clampedSize) {
-      memberSet.add(Math.floor(Math.random() * nodeCount));
+      memberSet.add(Math.floor(random() * nodeCount));
     }
 
     const memberIndices = Array.from(memberSet);
@@ -52,12 +56,7 @@ export function generateRandomHypergraph(
       nodeInEdge[idx] = 1;
     }
 
-    hyperedges.push({
-      id: e,
-      index: e,
-      memberIndices,
-      attrs: {},
-    });
+    lists.push(memberIndices);
   }
 
   // Ensure every node is in at least one hyperedge.
@@ -72,31 +71,182 @@ export function generateRandomHypergraph(
   for (let i = 0; i < nodeCount; i++) {
     if (!nodeInEdge[i]) {
       // Find an edge that hasn't reached maxEdgeSize yet.
-      let heIdx = Math.floor(Math.random() * edgeCount);
+      let heIdx = Math.floor(random() * edgeCount);
       for (let attempt = 0; attempt < edgeCount; attempt++) {
         const candidate = (heIdx + attempt) % edgeCount;
-        if (hyperedges[candidate].memberIndices.length < maxEdgeSize) {
+        if (lists[candidate].length < maxEdgeSize) {
           heIdx = candidate;
           break;
         }
       }
-      hyperedges[heIdx].memberIndices.push(i);
+      lists[heIdx].push(i);
       nodeInEdge[i] = 1;
     }
   }
 
-  // Assign group to each node based on first hyperedge membership (mod 16)
-  const nodeFirstEdge = new Int32Array(nodeCount).fill(-1);
-  for (const he of hyperedges) {
-    for (const ni of he.memberIndices) {
-      if (nodeFirstEdge[ni] === -1) {
-        nodeFirstEdge[ni] = he.index;
-      }
+  // Pack into CSR; groups default to first hyperedge membership (mod 16)
+  const offsets = new Uint32Array(edgeCount + 1);
+  for (let e = 0; e < edgeCount; e++) offsets[e + 1] = offsets[e] + lists[e].length;
+  const members = new Uint32Array(offsets[edgeCount]);
+  for (let e = 0; e < edgeCount; e++) members.set(lists[e], offsets[e]);
+
+  return HypergraphStore.fromParts({
+    nodeIds,
+    edgeIds: Array.from({ length: edgeCount }, (_, e) => e),
+    offsets,
+    members,
+  });
+}
+
+// ── Realistic synthetic graphs ──
+
+/**
+ * Parameters for `generateSynthetic`. Hyperedge sizes follow a Zipf law,
+ * node degrees a power law (Chung–Lu style weights) and members are drawn
+ * mostly from the hyperedge's home community, so the result has the skewed,
+ * clustered shape of real data rather than uniform noise.
+ */
+export interface SyntheticOptions {
+  nodeCount: number;
+  edgeCount: number;
+  seed: number;
+  minEdgeSize?: number;     // default 2
+  maxEdgeSize?: number;     // default 64
+  sizeExponent?: number;    // Zipf exponent of hyperedge sizes, default 2
+  degreeExponent?: number;  // power-law exponent γ of node degrees, default 2.5
+  communities?: number;     // planted communities (= node groups), default 16
+  mixing?: number;          // share of members drawn outside the home community, default 0.1
+}
+
+/** Typed CSR output — cheap to transfer out of a worker. */
+export interface SyntheticCSR {
+  nodeCount: number;
+  offsets: Uint32Array;
+  members: Uint32Array;
+  groups: Uint32Array;      // community per node
+}
+
+/** Standard benchmark fixtures (fixed seeds, so every run sees the same graph). */
+export const SYNTHETIC_FIXTURES = {
+  small: { nodeCount: 10_000, edgeCount: 2_000, seed: 1 },         // ~12K incidences
+  medium: { nodeCount: 100_000, edgeCount: 40_000, seed: 2 },      // ~240K incidences
+  large: { nodeCount: 1_000_000, edgeCount: 1_700_000, seed: 3 },  // ~10M incidences
+} as const satisfies Record<string, SyntheticOptions>;
+
+/**
+ * Generate a community-structured hypergraph straight into CSR arrays:
+ * O(incidences) with O(1) alias-table sampling per member and a stamped
+ * de-dup, no per-edge Sets or per-node objects. Same options → same graph.
+ */
+export function generateSynthetic(options: SyntheticOptions): SyntheticCSR {
+  const random = createRng(options.seed);
+  const nodeCount = Math.max(1, Math.floor(options.nodeCount));
+  const edgeCount = Math.max(0, Math.floor(options.edgeCount));
+  const minSize = Math.max(2, Math.floor(options.minEdgeSize ?? 2));
+  const maxSize = Math.max(minSize, Math.floor(options.maxEdgeSize ?? 64));
+  const communities = Math.max(1, Math.min(nodeCount, Math.floor(options.communities ?? 16)));
+  const mixing = options.mixing ?? 0.1;
+
+  // Communities are contiguous node ranges; group = community
+  const start = new Uint32Array(communities + 1);
+  for (let c = 0; c <= communities; c++) start[c] = Math.floor((c * nodeCount) / communities);
+  const groups = new Uint32Array(nodeCount);
+  for (let c = 0; c < communities; c++) groups.fill(c, start[c], start[c + 1]);
+
+  // Power-law weights by rank inside each community, sampled via alias tables
+  const alpha = 1 / Math.max((options.degreeExponent ?? 2.5) - 1, 0.01);
+  const prob = new Float64Array(nodeCount);
+  const alias = new Uint32Array(nodeCount);
+  for (let c = 0; c < communities; c++) {
+    buildAliasTable(start[c], start[c + 1], j => Math.pow(j + 1, -alpha), prob, alias);
+  }
+
+  // Zipf size CDF over [minSize, maxSize]
+  const sizeExponent = options.sizeExponent ?? 2;
+  const cdf = new Float64Array(maxSize - minSize + 1);
+  let total = 0;
+  for (let k = minSize; k <= maxSize; k++) cdf[k - minSize] = total += Math.pow(k, -sizeExponent);
+  for (let k = 0; k < cdf.length; k++) cdf[k] /= total;
+
+  const sizes = new Uint32Array(edgeCount);
+  let capacity = 0;
+  for (let e = 0; e < edgeCount; e++) {
+    const u = random();
+    let lo = 0, hi = cdf.length - 1;
+    while (lo < hi) {
+      const mid = (lo + hi) >>> 1;
+      if (cdf[mid] < u) lo = mid + 1; else hi = mid;
     }
+    sizes[e] = Math.min(minSize + lo, nodeCount);
+    capacity += sizes[e];
   }
-  for (let i = 0; i < nodeCount; i++) {
-    nodes[i].group = nodeFirstEdge[i] >= 0 ? nodeFirstEdge[i] % 16 : 0;
+
+  const offsets = new Uint32Array(edgeCount + 1);
+  const members = new Uint32Array(capacity);
+  const seen = new Int32Array(nodeCount);
+  let m = 0;
+  for (let e = 0; e < edgeCount; e++) {
+    const home = Math.floor(random() * communities);
+    const size = sizes[e];
+    let added = 0;
+    // Repeats are re-drawn; the attempt cap only bites when a community is smaller than the edge
+    for (let attempt = 0; added < size && attempt < size * 4; attempt++) {
+      const c = random() < mixing ? Math.floor(random() * communities) : home;
+      const base = start[c];
+      const k = base + Math.floor(random() * (start[c + 1] - base));
+      const node = random() < prob[k] ? k : alias[k];
+      if (seen[node] === e + 1) continue;
+      seen[node] = e + 1;
+      members[m++] = node;
+      added++;
+    }
+    offsets[e + 1] = m;
   }
 
-  return { nodes, hyperedges, nodeIdToIndex };
+  return { nodeCount, offsets, members: members.subarray(0, m), groups };
+}
+
+/** Wrap generator output as a store (node IDs `n0…`, edge IDs = indices). */
+export function syntheticToStore(csr: SyntheticCSR): HypergraphStore {
+  const nodeIds: string[] = new Array(csr.nodeCount);
+  for (let i = 0; i < csr.nodeCount; i++) nodeIds[i] = `n${i}`;
+  const edgeCount = csr.offsets.length - 1;
+  const edgeIds: number[] = new Array(edgeCount);
+  for (let e = 0; e < edgeCount; e++) edgeIds[e] = e;
+  return HypergraphStore.fromParts({
+    nodeIds, edgeIds, offsets: csr.offsets, members: csr.members, groups: csr.groups,
+  });
+}
+
+/**
+ * Vose alias table for slots [from, to) with weight(j) for the j-th slot.
+ * Sampling slot k (uniform) then keeping it with probability prob[k], else
+ * taking alias[k], draws slots proportionally to their weight.
+ */
+function buildAliasTable(
+  from: number, to: number, weight: (j: number) => number, prob: Float64Array, alias: Uint32Array,
+): void {
+  const n = to - from;
+  if (n === 0) return;
+  let sum = 0;
+  for (let j = 0; j < n; j++) sum += prob[from + j] = weight(j);
+  const small: number[] = [];
+  const large: number[] = [];
+  for (let k = from; k < to; k++) {
+    prob[k] = (prob[k] * n) / sum;
+    alias[k] = k;
+    (prob[k] < 1 ? small : large).push(k);
+  }
+  while (small.length > 0 && large.length > 0) {
+    const s = small.pop()!;
+    const l = large[large.length - 1];
+    alias[s] = l;
+    prob[l] -= 1 - prob[s];
+    if (prob[l] < 1) {
+      large.pop();
+      small.push(l);
+    }
+  }
+  for (const k of large) prob[k] = 1;
+  for (const k of small) prob[k] = 1;
 }
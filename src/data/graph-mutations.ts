@@ -0,0 +1,154 @@
+import type { HypergraphData, NodeData, HyperedgeData } from './types';
+
+// In-place edits of a HypergraphData. Indices stay dense: removals compact
+// the arrays and return an old→new remap (-1 = removed) so callers can patch
+// GPU buffers and any index-keyed state they hold.
+
+export interface NodeInput {
+  id: string;
+  group?: number;
+  attrs?: Record<string, unknown>;
+}
+
+export interface HyperedgeInput {
+  id: number | string;
+  memberIndices: number[];
+  attrs?: Record<string, unknown>;
+}
+
+export interface HyperedgeExtension {
+  index: number;           // existing hyperedge
+  memberIndices: number[]; // members to append (ones already present are skipped)
+}
+
+/**
+ * A batch of additions applied as one unit, e.g. the part of a streamed file
+ * parsed since the previous batch. Node indices continue the current count;
+ * `nodeAttrs` / `edgeAttrs` replace the attributes of items added earlier.
+ */
+export interface GraphDelta {
+  nodes: NodeInput[];
+  edges: HyperedgeInput[];
+  extendedEdges: HyperedgeExtension[]; // ascending, distinct indices
+  nodeAttrs: { index: number; attrs: Record<string, unknown> }[];
+  edgeAttrs: { index: number; attrs: Record<string, unknown> }[];
+}
+
+/** Append nodes. Throws on IDs that already exist. Returns the new indices. */
+export function insertNodes(data: HypergraphData, inputs: NodeInput[]): number[] {
+  const added: number[] = [];
+  for (const input of inputs) {
+    if (data.nodeIdToIndex.has(input.id)) {
+      throw new Error(`Node "${input.id}" already exists`);
+    }
+    const index = data.nodes.length;
+    data.nodeIdToIndex.set(input.id, index);
+    data.nodes.push({
+      id: input.id,
+      index,
+      group: input.group ?? 0,
+      attrs: input.attrs ?? {},
+    });
+    added.push(index);
+  }
+  return added;
+}
+
+/** Append hyperedges. Member lists are validated and de-duplicated. Returns the new indices. */
+export function insertHyperedges(data: HypergraphData, inputs: HyperedgeInput[]): number[] {
+  const added: number[] = [];
+  for (const input of inputs) {
+    const index = data.hyperedges.length;
+    data.hyperedges.push({
+      id: input.id,
+      index,
+      memberIndices: sanitizeMembers(data, input.memberIndices),
+      attrs: input.attrs ?? {},
+    });
+    added.push(index);
+  }
+  return added;
+}
+
+/** Replace the member list of one hyperedge. */
+export function setHyperedgeMembers(data: HypergraphData, edgeIndex: number, memberIndices: number[]): void {
+  const he = data.hyperedges[edgeIndex];
+  if (!he) throw new Error(`Hyperedge index ${edgeIndex} out of range`);
+  he.memberIndices = sanitizeMembers(data, memberIndices);
+}
+
+/**
+ * Remove nodes and strip them from every hyperedge. Hyperedges left empty are
+ * kept (remove them explicitly with deleteHyperedges). Returns the node remap.
+ */
+export function deleteNodes(data: HypergraphData, indices: Iterable<number>): Int32Array {
+  const remap = buildRemap(data.nodes.length, indices);
+
+  const kept: NodeData[] = [];
+  for (let i = 0; i < data.nodes.length; i++) {
+    const node = data.nodes[i];
+    if (remap[i] < 0) {
+      data.nodeIdToIndex.delete(node.id);
+      continue;
+    }
+    node.index = remap[i];
+    data.nodeIdToIndex.set(node.id, node.index);
+    kept.push(node);
+  }
+  if (kept.length === data.nodes.length) return remap;
+  data.nodes = kept;
+
+  for (const he of data.hyperedges) {
+    let w = 0;
+    const members = he.memberIndices;
+    for (let r = 0; r < members.length; r++) {
+      const mapped = remap[members[r]];
+      if (mapped >= 0) members[w++] = mapped;
+    }
+    members.length = w;
+  }
+  return remap;
+}
+
+/** Remove hyperedges. Returns the hyperedge remap. */
+export function deleteHyperedges(data: HypergraphData, indices: Iterable<number>): Int32Array {
+  const remap = buildRemap(data.hyperedges.length, indices);
+
+  const kept: HyperedgeData[] = [];
+  for (let i = 0; i < data.hyperedges.length; i++) {
+    if (remap[i] < 0) continue;
+    const he = data.hyperedges[i];
+    he.index = remap[i];
+    kept.push(he);
+  }
+  data.hyperedges = kept;
+  return remap;
+}
+
+/** Old→new index map for removing `removed` from `count` dense slots (-1 = removed). */
+export function buildRemap(count: number, removed: Iterable<number>): Int32Array {
+  const remap = new Int32Array(count);
+  for (const idx of removed) {
+    if (idx >= 0 && idx < count) remap[idx] = -1;
+  }
+  let next = 0;
+  for (let i = 0; i < count; i++) {
+    if (remap[i] === 0) remap[i] = next++;
+  }
+  return remap;
+}
+
+function sanitizeMembers(data: HypergraphData, memberIndices: number[]): number[] {
+  const count = data.nodes.length;
+  const seen = new Set<number>();
+  const out: number[] = [];
+  for (const idx of memberIndices) {
+    if (!Number.isInteger(idx) || idx < 0 || idx >= count) {
+      throw new Error(`Member index ${idx} out of range [0, ${count})`);
+    }
+    if (seen.has(idx)) continue;
+    seen.add(idx);
+    out.push(idx);
+  }
+  return out;
+}
@@ -1,4 +1,6 @@
-import type { HIFDocument, HypergraphData, NodeData, HyperedgeData } from './types';
+import type { HIFDocument, HypergraphData } from './types';
+import { HypergraphStore, AttributeStore } from './hypergraph-store';
+import { packIncidences } from './csr';
 
 /**
  * Parse a HIF (Hypergraph Interchange Format) JSON document into our internal
@@ -10,107 +12,70 @@ import type { HIFDocument, HypergraphData, NodeData, HyperedgeData } from './typ
  * - Handles empty incidences, duplicate nodes in same edge, missing nodes/edges arrays
  */
 export function parseHIF(doc: HIFDocument): HypergraphData {
-  const nodeIdToIndex = new Map<string, number>();
-  const nodes: NodeData[] = [];
-  const hyperedges: HyperedgeData[] = [];
-
-  // Collect node attrs from optional nodes array for later merging
-  const nodeAttrMap = new Map<string, Record<string, unknown>>();
-  if (doc.nodes) {
-    for (const entry of doc.nodes) {
-      nodeAttrMap.set(entry.node, entry.attrs ?? {});
-    }
-  }
-
-  // Collect edge attrs from optional edges array for later merging
-  const edgeAttrMap = new Map<string | number, Record<string, unknown>>();
-  if (doc.edges) {
-    for (const entry of doc.edges) {
-      edgeAttrMap.set(entry.edge, entry.attrs ?? {});
-    }
-  }
-
-  // Group incidences by edge to build membership lists
-  // Use string key for consistent map lookup (edge can be number or string)
-  const edgeMembersMap = new Map<string, { edgeId: number | string; nodeIds: string[] }>();
-  const edgeOrder: string[] = []; // preserve insertion order
+  return parseHIFStore(doc).materialize();
+}
 
-  for (const inc of doc.incidences ?? []) {
-    const edgeKey = String(inc.edge);
+/**
+ * `parseHIF` straight into a HypergraphStore, in time linear in the number of
+ * incidences: one hashed ID lookup per incidence, then `packIncidences`
+ * (two counting passes plus a stamped de-duplication sweep).
+ */
+export function parseHIFStore(doc: HIFDocument): HypergraphStore {
+  const incidences = doc.incidences ?? [];
+  const count = incidences.length;
 
-    // Ensure node exists
-    if (!nodeIdToIndex.has(inc.node)) {
-      const index = nodes.length;
-      nodeIdToIndex.set(inc.node, index);
-      nodes.push({
-        id: inc.node,
-        index,
-        group: 0, // will be assigned after hyperedges are built
-        attrs: nodeAttrMap.get(inc.node) ?? {},
-      });
-    }
+  const nodeIds: string[] = [];
+  const nodeIndex = new Map<string, number>();
+  const edgeIds: (string | number)[] = [];
+  // String key for consistent lookup (edge can be number or string)
+  const edgeIndex = new Map<string, number>();
 
-    // Add to edge membership
-    let entry = edgeMembersMap.get(edgeKey);
-    if (!entry) {
-      entry = { edgeId: inc.edge, nodeIds: [] };
-      edgeMembersMap.set(edgeKey, entry);
-      edgeOrder.push(edgeKey);
+  // Intern IDs in first-appearance order, recording each incidence as an index pair
+  const incEdge = new Uint32Array(count);
+  const incNode = new Uint32Array(count);
+  for (let k = 0; k < count; k++) {
+    const inc = incidences[k];
+    let ni = nodeIndex.get(inc.node);
+    if (ni === undefined) {
+      ni = nodeIds.length;
+      nodeIndex.set(inc.node, ni);
+      nodeIds.push(inc.node);
     }
-
-    // Prevent duplicate node in same edge
-    const nodeIndex = nodeIdToIndex.get(inc.node)!;
-    if (!entry.nodeIds.includes(inc.node)) {
-      entry.nodeIds.push(inc.node);
-    } else {
-      // Node already in this edge — skip duplicate but nodeIndex is valid
-      void nodeIndex;
+    const edgeKey = String(inc.edge);
+    let ei = edgeIndex.get(edgeKey);
+    if (ei === undefined) {
+      ei = edgeIds.length;
+      edgeIndex.set(edgeKey, ei);
+      edgeIds.push(inc.edge);
     }
+    incNode[k] = ni;
+    incEdge[k] = ei;
   }
 
-  // Also ensure nodes from the nodes array that aren't in any incidence get created
-  if (doc.nodes) {
-    for (const entry of doc.nodes) {
-      if (!nodeIdToIndex.has(entry.node)) {
-        const index = nodes.length;
-        nodeIdToIndex.set(entry.node, index);
-        nodes.push({
-          id: entry.node,
-          index,
-          group: 0,
-          attrs: entry.attrs ?? {},
-        });
-      }
+  // Nodes from the nodes array that aren't in any incidence come last
+  const nodeAttrs = new AttributeStore();
+  for (const entry of doc.nodes ?? []) {
+    let ni = nodeIndex.get(entry.node);
+    if (ni === undefined) {
+      ni = nodeIds.length;
+      nodeIndex.set(entry.node, ni);
+      nodeIds.push(entry.node);
     }
+    nodeAttrs.setRow(ni, entry.attrs ?? {});
   }
+  nodeAttrs.rowCount = nodeIds.length;
 
-  // Build hyperedges
-  for (let i = 0; i < edgeOrder.length; i++) {
-    const edgeKey = edgeOrder[i];
-    const entry = edgeMembersMap.get(edgeKey)!;
-    const memberIndices = entry.nodeIds.map((nid) => nodeIdToIndex.get(nid)!);
-
-    hyperedges.push({
-      id: entry.edgeId,
-      index: i,
-      memberIndices,
-      attrs: edgeAttrMap.get(entry.edgeId) ?? {},
-    });
-  }
-
-  // Assign group to each node based on first hyperedge membership (mod 16)
-  // Build a lookup: nodeIndex -> first hyperedge index
-  const nodeFirstEdge = new Int32Array(nodes.length).fill(-1);
-  for (const he of hyperedges) {
-    for (const ni of he.memberIndices) {
-      if (nodeFirstEdge[ni] === -1) {
-        nodeFirstEdge[ni] = he.index;
-      }
-    }
-  }
-  for (let i = 0; i < nodes.length; i++) {
-    nodes[i].group = nodeFirstEdge[i] >= 0 ? nodeFirstEdge[i] % 16 : 0;
+  // Edge attrs are keyed by the edge's original ID (not its string key)
+  const edgeAttrMap = new Map<string | number, Record<string, unknown>>();
+  for (const entry of doc.edges ?? []) edgeAttrMap.set(entry.edge, entry.attrs ?? {});
+  const edgeAttrs = new AttributeStore();
+  for (let e = 0; e < edgeIds.length; e++) {
+    const attrs = edgeAttrMap.get(edgeIds[e]);
+    if (attrs) edgeAttrs.setRow(e, attrs);
   }
+  edgeAttrs.rowCount = edgeIds.length;
 
-  return { nodes, hyperedges, nodeIdToIndex };
+  const { offsets, members } = packIncidences(incEdge, incNode, count, edgeIds.length, nodeIds.length);
+  // Groups default to first hyperedge membership (mod 16)
+  return HypergraphStore.fromParts({ nodeIds, edgeIds, offsets, members, nodeAttrs, edgeAttrs });
 }
@@ -0,0 +1,781 @@
+import { HypergraphStore, AttributeStore } from './hypergraph-store';
+import { packIncidences } from './csr';
+import { EdgeSampler } from './edge-sampler';
+import { DistinctCounter } from './distinct-counter';
+import type { GraphDelta, NodeInput, HyperedgeExtension } from './graph-mutations';
+
+/**
+ * Streaming HIF (Hypergraph Interchange Format) loader.
+ *
+ * Consumes a `ReadableStream` of bytes chunk by chunk (optionally through
+ * `DecompressionStream('gzip')`), tokenizes the JSON incrementally and interns
+ * node/edge IDs as incidences arrive. The document is never materialized:
+ * memory is the ID tables, two u32 per incidence and the attrs of `nodes` /
+ * `edges` entries. Output is a HypergraphStore whose CSR is built directly by
+ * a counting sort over the incidence pairs.
+ *
+ * Semantics match `parseHIF`: node indices follow first appearance in
+ * `incidences` (nodes only listed in `nodes` are appended), edges are created
+ * by incidences only, and duplicate members of an edge are dropped.
+ *
+ * `streamHIFBatches` instead hands the graph out as deltas while the stream
+ * is still being read (progressive loading), without building a store of its
+ * own. Batches grow geometrically — the first follows the first chunk, later
+ * ones wait until the backlog is a quarter of what was already emitted — so a
+ * consumer that re-syncs per batch does linear total work. Applying every
+ * delta in order to an empty store yields the graph `parseHIFStream` returns.
+ *
+ * `sampleHIFStream` keeps a reproducible sample of whole hyperedges within an
+ * incidence budget (src/data/edge-sampler.ts) for datasets larger than the
+ * GPU buffers, and `loadHIFNeighborhood` re-reads a source for the
+ * hyperedges around chosen nodes at full detail.
+ */
+
+export interface HIFStreamProgress {
+  bytesRead: number;          // bytes consumed from the source (compressed bytes for .gz)
+  totalBytes: number | null;  // from options.totalBytes, when known
+  incidences: number;         // incidences parsed so far
+}
+
+export interface HIFStreamOptions {
+  totalBytes?: number;        // e.g. File.size or Content-Length, for progress
+  gzip?: boolean;             // decompress with DecompressionStream('gzip')
+  onProgress?: (progress: HIFStreamProgress) => void;
+  signal?: AbortSignal;
+}
+
+export interface HIFBatchOptions extends HIFStreamOptions {
+  onBatch: (delta: GraphDelta) => void; // progressive loading; throwing aborts the parse
+}
+
+// Emit a batch once the unemitted incidences reach this share of the emitted ones
+const BATCH_GROWTH = 0.25;
+
+/** Parse a HIF byte stream into a HypergraphStore without materializing the JSON document. */
+export async function parseHIFStream(
+  source: ReadableStream<Uint8Array>,
+  options: HIFStreamOptions = {},
+): Promise<HypergraphStore> {
+  const builder = new HIFBuilder(null);
+  await readInto(builder, source, options, null);
+  return builder.finish();
+}
+
+/**
+ * Parse a HIF byte stream into `onBatch` deltas only; the last one also
+ * carries the nodes listed only in `nodes`. No store is built here, so the
+ * consumer's replay is the only copy of the graph.
+ */
+export async function streamHIFBatches(
+  source: ReadableStream<Uint8Array>,
+  options: HIFBatchOptions,
+): Promise<void> {
+  const builder = new HIFBuilder(null);
+  await readInto(builder, source, options, options.onBatch);
+  builder.checkComplete();
+  options.onBatch(builder.takeDelta(true));
+}
+
+export interface HIFSampleOptions extends HIFStreamOptions {
+  incidenceBudget: number;  // most incidences the sample may hold
+  seed?: number;            // edge priority seed (same seed → same sample)
+}
+
+export interface HIFSample {
+  store: HypergraphStore;
+  sampled: boolean; // hyperedges were left out to fit the budget
+  // Whole dataset: distinct nodes / hyperedges appearing in incidences (approximate, see
+  // DistinctCounter — exact only for small counts), and incidence entries (exact)
+  total: { nodes: number; edges: number; incidences: number };
+}
+
+/**
+ * Parse a HIF byte stream keeping only a sample of whole hyperedges that fits
+ * `incidenceBudget`, while counting the full dataset. Nodes appear in the
+ * sample only through its hyperedges.
+ */
+export async function sampleHIFStream(
+  source: ReadableStream<Uint8Array>,
+  options: HIFSampleOptions,
+): Promise<HIFSample> {
+  const filter = new SampleFilter(new EdgeSampler(options.incidenceBudget, options.seed), null);
+  const builder = new HIFBuilder(filter);
+  await readInto(builder, source, options, null);
+  return filter.result(builder.finish());
+}
+
+/**
+ * Load the hyperedges that contain any of `nodeIds` with all their members,
+ * by reading the source twice (`open` must return a fresh stream each call,
+ * e.g. `() => file.stream()`). A neighborhood larger than the budget is
+ * sampled like `sampleHIFStream`.
+ */
+export async function loadHIFNeighborhood(
+  open: () => ReadableStream<Uint8Array>,
+  nodeIds: Iterable<string>,
+  options: HIFSampleOptions,
+): Promise<HIFSample> {
+  const scan = new FocusScan(new Set(nodeIds));
+  await readInto(new HIFBuilder(scan), open(), options, null);
+  const filter = new SampleFilter(new EdgeSampler(options.incidenceBudget, options.seed), scan.edges);
+  const builder = new HIFBuilder(filter);
+  await readInto(builder, open(), options, null);
+  return filter.result(builder.finish());
+}
+
+/** Tokenize a byte stream into `builder`, reporting progress and emitting batches per chunk. */
+async function readInto(
+  builder: HIFBuilder,
+  source: ReadableStream<Uint8Array>,
+  options: HIFStreamOptions,
+  onBatch: ((delta: GraphDelta) => void) | null,
+): Promise<void> {
+  const progress: HIFStreamProgress = { bytesRead: 0, totalBytes: options.totalBytes ?? null, incidences: 0 };
+
+  // Count raw bytes before decompression so progress tracks File.size / Content-Length
+  let stream = source.pipeThrough(new TransformStream<Uint8Array, Uint8Array>({
+    transform(chunk, controller) {
+      progress.bytesRead += chunk.byteLength;
+      controller.enqueue(chunk);
+    },
+  }));
+  if (options.gzip) {
+    stream = stream.pipeThrough(new DecompressionStream('gzip') as unknown as TransformStream<Uint8Array, Uint8Array>);
+  }
+
+  const tokenizer = new JSONTokenizer(builder);
+  const reader = stream.getReader();
+  try {
+    for (;;) {
+      if (options.signal?.aborted) throw new Error('HIF stream aborted');
+      const { done, value } = await reader.read();
+      if (done) break;
+      tokenizer.write(value);
+      progress.incidences = builder.incidencesSeen;
+      options.onProgress?.(progress);
+      if (onBatch && builder.backlog > 0 && builder.backlog >= builder.emittedIncidences * BATCH_GROWTH) {
+        onBatch(builder.takeDelta(false));
+      }
+    }
+  } finally {
+    reader.releaseLock();
+  }
+  tokenizer.end();
+}
+
+// ── Incidence filters (sampling, neighborhoods) ──
+
+/**
+ * Decides which incidences enter a builder; edges are the builder's dense
+ * indices. Attributes are kept only for admitted items, plus items that may
+ * still be admitted while the incidences have not all been read.
+ */
+interface IncidenceFilter {
+  readonly attrs: boolean;          // whether the load keeps attributes at all
+  admit(node: string, edgeKey: string): boolean;
+  added(edge: number): void;        // an admitted incidence of `edge` was stored
+  keeps(edge: number): boolean;     // at finish: whether `edge` is in the result
+  rejects(edgeKey: string): boolean; // no incidence of this edge can be admitted any more
+}
+
+/** Budgeted edge sample (optionally restricted to `only`), counting every incidence it sees. */
+class SampleFilter implements IncidenceFilter {
+  readonly attrs = true;
+  private sampler: EdgeSampler;
+  private only: Set<string> | null;
+  private priority = 0;
+  private nodes = new DistinctCounter();
+  private edges = new DistinctCounter();
+  private incidences = 0;
+  private rejected = false;
+
+  constructor(sampler: EdgeSampler, only: Set<string> | null) {
+    this.sampler = sampler;
+    this.only = only;
+  }
+
+  admit(node: string, edgeKey: string): boolean {
+    this.incidences++;
+    this.nodes.add(node);
+    this.edges.add(edgeKey);
+    if (this.only && !this.only.has(edgeKey)) return false;
+    this.priority = this.sampler.priority(edgeKey);
+    if (this.sampler.admits(this.priority)) return true;
+    this.rejected = true;
+    return false;
+  }
+
+  added(edge: number): void {
+    this.sampler.add(edge, this.priority);
+  }
+
+  keeps(edge: number): boolean {
+    const kept = this.sampler.keeps(edge);
+    if (!kept) this.rejected = true;
+    return kept;
+  }
+
+  rejects(edgeKey: string): boolean {
+    if (this.only && !this.only.has(edgeKey)) return true;
+    return !this.sampler.admits(this.sampler.priority(edgeKey)); // the threshold only drops
+  }
+
+  result(store: HypergraphStore): HIFSample {
+    return {
+      store,
+      sampled: this.rejected,
+      total: { nodes: this.nodes.estimate(), edges: this.edges.estimate(), incidences: this.incidences },
+    };
+  }
+}
+
+/** First neighborhood pass: records the edges touching the focus nodes, stores nothing. */
+class FocusScan implements IncidenceFilter {
+  readonly attrs = false;
+  private focus: Set<string>;
+  edges = new Set<string>();
+
+  constructor(focus: Set<string>) {
+    this.focus = focus;
+  }
+
+  admit(node: string, edgeKey: string): boolean {
+    if (this.focus.has(node)) this.edges.add(edgeKey);
+    return false;
+  }
+
+  added(): void {}
+  keeps(): boolean { return false; }
+  rejects(): boolean { return true; }
+}
+
+// ── Incremental JSON tokenizer ──
+
+type JSONScalar = string | number | boolean | null;
+
+interface TokenSink {
+  startObject(): void;
+  endObject(): void;
+  startArray(): void;
+  endArray(): void;
+  key(name: string): void;
+  value(v: JSONScalar): void;
+}
+
+const CH_QUOTE = 0x22;
+const CH_BACKSLASH = 0x5C;
+const CH_COMMA = 0x2C;
+const CH_COLON = 0x3A;
+const CH_LBRACE = 0x7B;
+const CH_RBRACE = 0x7D;
+const CH_LBRACKET = 0x5B;
+const CH_RBRACKET = 0x5D;
+
+const MODE_BETWEEN = 0;
+const MODE_STRING = 1;
+const MODE_SCALAR = 2;
+
+function isWhitespace(c: number): boolean {
+  return c === 0x20 || c === 0x0A || c === 0x0D || c === 0x09;
+}
+
+/**
+ * Byte-level JSON tokenizer that accepts input in arbitrary chunks. Strings
+ * are buffered as raw UTF-8 and decoded once complete, so multi-byte
+ * characters split across chunks are handled.
+ */
+export class JSONTokenizer {
+  private sink: TokenSink;
+  private decoder = new TextDecoder();
+  private mode = MODE_BETWEEN;
+  private containers: boolean[] = []; // true = object
+  private expectKey = false;
+
+  private strBuf = new Uint8Array(256);
+  private strLen = 0;
+  private strEscaped = false;
+  private escapePending = false;
+  private scalar = '';
+
+  constructor(sink: TokenSink) {
+    this.sink = sink;
+  }
+
+  write(chunk: Uint8Array): void {
+    const n = chunk.length;
+    let i = 0;
+    while (i < n) {
+      if (this.mode === MODE_STRING) {
+        if (this.escapePending) {
+          this.pushString(chunk, i, i + 1);
+          this.escapePending = false;
+          i++;
+          continue;
+        }
+        // Copy the run up to the next quote or backslash in one go
+        let k = i;
+        while (k < n && chunk[k] !== CH_QUOTE && chunk[k] !== CH_BACKSLASH) k++;
+        this.pushString(chunk, i, k);
+        if (k === n) return;
+        if (chunk[k] === CH_BACKSLASH) {
+          this.pushString(chunk, k, k + 1);
+          this.strEscaped = true;
+          this.escapePending = true;
+          i = k + 1;
+          continue;
+        }
+        this.finishString();
+        i = k + 1;
+        continue;
+      }
+
+      const c = chunk[i];
+      if (this.mode === MODE_SCALAR) {
+        if (!isWhitespace(c) && c !== CH_COMMA && c !== CH_RBRACE && c !== CH_RBRACKET) {
+          this.scalar += String.fromCharCode(c);
+          i++;
+          continue;
+        }
+        this.finishScalar();
+      }
+
+      i++;
+      if (isWhitespace(c) || c === CH_COLON) continue;
+      switch (c) {
+        case CH_COMMA:
+          if (this.containers[this.containers.length - 1]) this.expectKey = true;
+          break;
+        case CH_LBRACE:
+          this.containers.push(true);
+          this.expectKey = true;
+          this.sink.startObject();
+          break;
+        case CH_RBRACE:
+          this.containers.pop();
+          this.expectKey = false;
+          this.sink.endObject();
+          break;
+        case CH_LBRACKET:
+          this.containers.push(false);
+          this.expectKey = false;
+          this.sink.startArray();
+          break;
+        case CH_RBRACKET:
+          this.containers.pop();
+          this.sink.endArray();
+          break;
+        case CH_QUOTE:
+          this.mode = MODE_STRING;
+          this.strLen = 0;
+          this.strEscaped = false;
+          break;
+        default:
+          this.mode = MODE_SCALAR;
+          this.scalar = String.fromCharCode(c);
+      }
+    }
+  }
+
+  /** Flush a trailing scalar and check the document was complete. */
+  end(): void {
+    if (this.mode === MODE_SCALAR) this.finishScalar();
+    if (this.mode === MODE_STRING || this.containers.length > 0) {
+      throw new Error('Unexpected end of JSON input');
+    }
+  }
+
+  private pushString(chunk: Uint8Array, start: number, end: number): void {
+    const len = end - start;
+    if (len <= 0) return;
+    if (this.strLen + len > this.strBuf.length) {
+      const grown = new Uint8Array(Math.max(this.strLen + len, this.strBuf.length * 2));
+      grown.set(this.strBuf.subarray(0, this.strLen));
+      this.strBuf = grown;
+    }
+    this.strBuf.set(chunk.subarray(start, end), this.strLen);
+    this.strLen += len;
+  }
+
+  private finishString(): void {
+    this.mode = MODE_BETWEEN;
+    let text = this.decoder.decode(this.strBuf.subarray(0, this.strLen));
+    if (this.strEscaped) text = JSON.parse(`"${text}"`) as string;
+    if (this.expectKey) {
+      this.expectKey = false;
+      this.sink.key(text);
+    } else {
+      this.sink.value(text);
+    }
+  }
+
+  private finishScalar(): void {
+    this.mode = MODE_BETWEEN;
+    const s = this.scalar;
+    let v: JSONScalar;
+    if (s === 'true') v = true;
+    else if (s === 'false') v = false;
+    else if (s === 'null') v = null;
+    else {
+      v = Number(s);
+      if (Number.isNaN(v)) throw new Error(`Invalid JSON token "${s}"`);
+    }
+    this.sink.value(v);
+  }
+}
+
+// ── HIF assembly ──
+
+const SECTION_NONE = 0;
+const SECTION_INCIDENCES = 1;
+const SECTION_NODES = 2;
+const SECTION_EDGES = 3;
+
+/** Rebuilds one JSON value (attrs, metadata) from tokens. */
+class ValueCapture {
+  private stack: (Record<string, unknown> | unknown[])[] = [];
+  private pendingKey: string | null = null;
+  result: unknown = undefined;
+
+  get active(): boolean { return this.stack.length > 0; }
+
+  begin(container: Record<string, unknown> | unknown[]): void {
+    this.result = undefined;
+    this.pendingKey = null;
+    this.stack.push(container);
+  }
+
+  open(container: Record<string, unknown> | unknown[]): void {
+    this.attach(container);
+    this.stack.push(container);
+  }
+
+  /** Returns true when the outermost container closed. */
+  close(): boolean {
+    const done = this.stack.pop()!;
+    if (this.stack.length === 0) {
+      this.result = done;
+      return true;
+    }
+    return false;
+  }
+
+  key(name: string): void {
+    this.pendingKey = name;
+  }
+
+  attach(v: unknown): void {
+    const top = this.stack[this.stack.length - 1];
+    if (Array.isArray(top)) top.push(v);
+    else top[this.pendingKey ?? ''] = v;
+    this.pendingKey = null;
+  }
+}
+
+class HIFBuilder implements TokenSink {
+  private filter: IncidenceFilter | null;
+  private depth = 0;
+  private section = SECTION_NONE;
+  private topKey = '';
+  private entryKey = '';
+  private entryNode: string | null = null;
+  private entryEdge: string | number | null = null;
+  private entryAttrs: Record<string, unknown> | undefined = undefined;
+  private capture = new ValueCapture();
+  private captureKey = ''; // entry key the capture belongs to ('' = discard)
+
+  // Interned IDs
+  private nodeIndex = new Map<string, number>();
+  private nodeIds: string[] = [];
+  private edgeIndex = new Map<string, number>();
+  private edgeIds: (string | number)[] = [];
+
+  // Incidence pairs (edge, node), grown by doubling
+  private incEdge = new Uint32Array(1024);
+  private incNode = new Uint32Array(1024);
+  incidenceCount = 0;
+  incidencesSeen = 0; // including ones the filter rejected
+
+  private nodeAttrMap = new Map<string, Record<string, unknown>>();
+  private edgeAttrMap = new Map<string | number, Record<string, unknown>>();
+  private incidencesRead = false; // filtered loads admit nothing after the incidences section
+
+  // Progressive loading: how much has been handed out through takeDelta
+  private emittedNodes = 0;
+  private emittedEdges = 0;
+  emittedIncidences = 0;
+  private lateNodeAttrs: number[] = []; // emitted nodes whose `nodes` entry came afterwards
+  private lateEdgeAttrs: number[] = [];
+
+  constructor(filter: IncidenceFilter | null) {
+    this.filter = filter;
+  }
+
+  get backlog(): number { return this.incidenceCount - this.emittedIncidences; }
+
+  startObject(): void {
+    if (this.capture.active) { this.capture.open({}); return; }
+    if (this.depth === 0) { this.depth = 1; return; }
+    if (this.depth === 2 && this.section !== SECTION_NONE) {
+      this.depth = 3;
+      this.entryNode = null;
+      this.entryEdge = null;
+      this.entryAttrs = undefined;
+      return;
+    }
+    this.beginCapture({});
+  }
+
+  endObject(): void {
+    if (this.capture.active) {
+      if (this.capture.close()) this.endCapture();
+      return;
+    }
+    if (this.depth === 3) {
+      this.depth = 2;
+      this.commitEntry();
+    } else {
+      this.depth--;
+    }
+  }
+
+  startArray(): void {
+    if (this.capture.active) { this.capture.open([]); return; }
+    if (this.depth === 0) throw new Error('HIF document must be a JSON object');
+    if (this.depth === 1) {
+      this.section = this.topKey === 'incidences' ? SECTION_INCIDENCES
+        : this.topKey === 'nodes' ? SECTION_NODES
+          : this.topKey === 'edges' ? SECTION_EDGES
+            : SECTION_NONE;
+      if (this.section !== SECTION_NONE) { this.depth = 2; return; }
+    }
+    this.beginCapture([]);
+  }
+
+  endArray(): void {
+    if (this.capture.active) {
+      if (this.capture.close()) this.endCapture();
+      return;
+    }
+    if (this.section === SECTION_INCIDENCES && this.filter) this.dropPendingAttrs();
+    this.depth = 1;
+    this.section = SECTION_NONE;
+  }
+
+  key(name: string): void {
+    if (this.capture.active) { this.capture.key(name); return; }
+    if (this.depth === 1) this.topKey = name;
+    else if (this.depth === 3) this.entryKey = name;
+  }
+
+  value(v: JSONScalar): void {
+    if (this.capture.active) { this.capture.attach(v); return; }
+    if (this.depth === 0) throw new Error('HIF document must be a JSON object');
+    if (this.depth !== 3 || v === null) return;
+    if (this.entryKey === 'node') this.entryNode = String(v);
+    else if (this.entryKey === 'edge' && typeof v !== 'boolean') this.entryEdge = v;
+  }
+
+  private beginCapture(container: Record<string, unknown> | unknown[]): void {
+    this.captureKey = this.depth === 3 ? this.entryKey : '';
+    this.capture.begin(container);
+  }
+
+  private endCapture(): void {
+    if (this.captureKey === 'attrs' && this.capture.result && !Array.isArray(this.capture.result)) {
+      this.entryAttrs = this.capture.result as Record<string, unknown>;
+    }
+    this.capture.result = undefined;
+  }
+
+  private commitEntry(): void {
+    if (this.section === SECTION_INCIDENCES) {
+      if (this.entryNode !== null && this.entryEdge !== null) this.addIncidence(this.entryNode, this.entryEdge);
+    } else if (this.section === SECTION_NODES) {
+      if (this.entryNode === null || !this.keepsNodeAttrs(this.entryNode)) return;
+      this.nodeAttrMap.set(this.entryNode, this.entryAttrs ?? {});
+      const i = this.nodeIndex.get(this.entryNode);
+      if (i !== undefined && i < this.emittedNodes) this.lateNodeAttrs.push(i);
+    } else if (this.section === SECTION_EDGES) {
+      if (this.entryEdge === null || !this.keepsEdgeAttrs(String(this.entryEdge))) return;
+      this.edgeAttrMap.set(this.entryEdge, this.entryAttrs ?? {});
+      const e = this.edgeIndex.get(String(this.entryEdge));
+      if (e !== undefined && e < this.emittedEdges && this.edgeIds[e] === this.entryEdge) this.lateEdgeAttrs.push(e);
+    }
+  }
+
+  private keepsNodeAttrs(id: string): boolean {
+    const filter = this.filter;
+    return !filter || (filter.attrs && (!this.incidencesRead || this.nodeIndex.has(id)));
+  }
+
+  private keepsEdgeAttrs(edgeKey: string): boolean {
+    const filter = this.filter;
+    if (!filter) return true;
+    if (!filter.attrs) return false;
+    if (this.edgeIndex.has(edgeKey)) return true;
+    return !this.incidencesRead && !filter.rejects(edgeKey);
+  }
+
+  /** Once every incidence is read, attrs of items the filter never admitted can go. */
+  private dropPendingAttrs(): void {
+    this.incidencesRead = true;
+    for (const id of this.nodeAttrMap.keys()) if (!this.nodeIndex.has(id)) this.nodeAttrMap.delete(id);
+    for (const id of this.edgeAttrMap.keys()) if (!this.edgeIndex.has(String(id))) this.edgeAttrMap.delete(id);
+  }
+
+  private internNode(id: string): number {
+    let index = this.nodeIndex.get(id);
+    if (index === undefined) {
+      index = this.nodeIds.length;
+      this.nodeIndex.set(id, index);
+      this.nodeIds.push(id);
+    }
+    return index;
+  }
+
+  private addIncidence(node: string, edge: string | number): void {
+    this.incidencesSeen++;
+    const edgeKey = String(edge);
+    if (this.filter && !this.filter.admit(node, edgeKey)) return;
+    const nodeIdx = this.internNode(node);
+    let edgeIdx = this.edgeIndex.get(edgeKey);
+    if (edgeIdx === undefined) {
+      edgeIdx = this.edgeIds.length;
+      this.edgeIndex.set(edgeKey, edgeIdx);
+      this.edgeIds.push(edge);
+    }
+
+    const k = this.incidenceCount;
+    if (k === this.incEdge.length) {
+      const grownEdge = new Uint32Array(k * 2);
+      grownEdge.set(this.incEdge);
+      this.incEdge = grownEdge;
+      const grownNode = new Uint32Array(k * 2);
+      grownNode.set(this.incNode);
+      this.incNode = grownNode;
+    }
+    this.incEdge[k] = edgeIdx;
+    this.incNode[k] = nodeIdx;
+    this.incidenceCount = k + 1;
+    this.filter?.added(edgeIdx);
+  }
+
+  /**
+   * Drop incidences of edges the filter let go (sampler evictions), then
+   * renumber the surviving edges and nodes in first-appearance order.
+   */
+  private applyFilter(filter: IncidenceFilter): void {
+    const edgeRemap = new Int32Array(this.edgeIds.length);
+    const edgeIds: (string | number)[] = [];
+    for (let e = 0; e < this.edgeIds.length; e++) {
+      edgeRemap[e] = filter.keeps(e) ? edgeIds.push(this.edgeIds[e]) - 1 : -1;
+    }
+    const nodeRemap = new Int32Array(this.nodeIds.length).fill(-1);
+    const nodeIds: string[] = [];
+    let w = 0;
+    for (let k = 0; k < this.incidenceCount; k++) {
+      const e = edgeRemap[this.incEdge[k]];
+      if (e < 0) continue;
+      const i = this.incNode[k];
+      if (nodeRemap[i] < 0) nodeRemap[i] = nodeIds.push(this.nodeIds[i]) - 1;
+      this.incEdge[w] = e;
+      this.incNode[w] = nodeRemap[i];
+      w++;
+    }
+    this.incidenceCount = w;
+    this.edgeIds = edgeIds;
+    this.nodeIds = nodeIds;
+    this.nodeIndex = new Map(nodeIds.map((id, i) => [id, i]));
+    this.edgeIndex = new Map(edgeIds.map((id, e) => [String(id), e]));
+  }
+
+  /**
+   * Everything parsed since the previous call: new nodes and edges, members
+   * that arrived for edges already emitted, and attrs whose entry followed
+   * the item's first incidence. `final` also appends nodes listed only in
+   * `nodes`, as `finish` does.
+   */
+  takeDelta(final: boolean): GraphDelta {
+    if (final) for (const id of this.nodeAttrMap.keys()) this.internNode(id);
+
+    const nodes: NodeInput[] = [];
+    for (let i = this.emittedNodes; i < this.nodeIds.length; i++) {
+      const id = this.nodeIds[i];
+      nodes.push({ id, attrs: this.nodeAttrMap.get(id) });
+    }
+    const firstEdge = this.emittedEdges;
+    const fresh: number[][] = [];
+    for (let e = firstEdge; e < this.edgeIds.length; e++) fresh.push([]);
+    const grown = new Map<number, number[]>();
+    for (let k = this.emittedIncidences; k < this.incidenceCount; k++) {
+      const e = this.incEdge[k];
+      if (e >= firstEdge) {
+        fresh[e - firstEdge].push(this.incNode[k]);
+      } else {
+        let list = grown.get(e);
+        if (!list) grown.set(e, list = []);
+        list.push(this.incNode[k]);
+      }
+    }
+    const extendedEdges: HyperedgeExtension[] = [];
+    for (const [index, memberIndices] of grown) extendedEdges.push({ index, memberIndices });
+    extendedEdges.sort((a, b) => a.index - b.index);
+
+    const delta: GraphDelta = {
+      nodes,
+      edges: fresh.map((memberIndices, r) => {
+        const id = this.edgeIds[firstEdge + r];
+        return { id, memberIndices, attrs: this.edgeAttrMap.get(id) };
+      }),
+      extendedEdges,
+      nodeAttrs: this.lateNodeAttrs.map(index => ({ index, attrs: this.nodeAttrMap.get(this.nodeIds[index])! })),
+      edgeAttrs: this.lateEdgeAttrs.map(index => ({ index, attrs: this.edgeAttrMap.get(this.edgeIds[index])! })),
+    };
+    this.emittedNodes = this.nodeIds.length;
+    this.emittedEdges = this.edgeIds.length;
+    this.emittedIncidences = this.incidenceCount;
+    this.lateNodeAttrs = [];
+    this.lateEdgeAttrs = [];
+    return delta;
+  }
+
+  checkComplete(): void {
+    if (this.depth !== 1 && this.depth !== 0) throw new Error('Unexpected end of HIF document');
+  }
+
+  finish(): HypergraphStore {
+    this.checkComplete();
+
+    // Nodes listed only in `nodes` come after every incidence node (filtered loads keep incidence nodes only)
+    if (this.filter) this.applyFilter(this.filter);
+    else for (const id of this.nodeAttrMap.keys()) this.internNode(id);
+
+    const nodeCount = this.nodeIds.length;
+    const edgeCount = this.edgeIds.length;
+    const count = this.incidenceCount;
+
+    const { offsets, members } = packIncidences(this.incEdge, this.incNode, count, edgeCount, nodeCount);
+
+    const nodeAttrs = new AttributeStore();
+    for (const [id, attrs] of this.nodeAttrMap) {
+      const i = this.nodeIndex.get(id);
+      if (i !== undefined) nodeAttrs.setRow(i, attrs);
+    }
+    nodeAttrs.rowCount = nodeCount;
+    const edgeAttrs = new AttributeStore();
+    for (let e = 0; e < edgeCount; e++) {
+      const attrs = this.edgeAttrMap.get(this.edgeIds[e]);
+      if (attrs) edgeAttrs.setRow(e, attrs);
+    }
+    edgeAttrs.rowCount = edgeCount;
+
+    return HypergraphStore.fromParts({
+      nodeIds: this.nodeIds,
+      edgeIds: this.edgeIds,
+      offsets,
+      members,
+      nodeAttrs,
+      edgeAttrs,
+    });
+  }
+}
@@ -0,0 +1,491 @@
+import type { HypergraphData, NodeData, HyperedgeData, EdgeMembers } from './types';
+import { HyperedgeCSR, NodeIncidenceCSR, type CSRDirtyRange } from './csr';
+import {
+  type NodeInput, type HyperedgeInput, type HyperedgeExtension,
+  insertNodes, insertHyperedges, setHyperedgeMembers, deleteNodes, deleteHyperedges, buildRemap,
+} from './graph-mutations';
+
+/**
+ * CSR-native hypergraph: the engine's source of truth.
+ *
+ * Membership lives in a HyperedgeCSR (the `he-offsets` / `he-members` GPU
+ * layout), node IDs in an interned table, groups in a Uint32Array and
+ * attributes in per-key columns — no per-node or per-edge objects. The
+ * `HypergraphData` object model is a lazy view (`toHypergraph()`) built on
+ * first access; once built, the store's mutations are mirrored into it so
+ * objects held by API consumers stay valid.
+ */
+
+/** One attribute column: numbers as Float64Array (NaN = missing), anything else per row. */
+export interface AttributeColumn {
+  name: string;
+  values: Float64Array | unknown[];
+}
+
+/** String IDs ↔ dense indices. The reverse map is built on first lookup. */
+export class IdTable {
+  ids: string[];
+  private lookup: Map<string, number> | null = null;
+
+  constructor(ids: string[] = []) {
+    this.ids = ids;
+  }
+
+  get size(): number { return this.ids.length; }
+
+  get index(): Map<string, number> {
+    if (!this.lookup) {
+      this.lookup = new Map();
+      for (let i = 0; i < this.ids.length; i++) this.lookup.set(this.ids[i], i);
+    }
+    return this.lookup;
+  }
+
+  /** Index of `id`, or -1. */
+  indexOf(id: string): number {
+    return this.index.get(id) ?? -1;
+  }
+
+  /** Append `id`. Throws if it already exists. */
+  add(id: string): number {
+    if (this.index.has(id)) throw new Error(`Node "${id}" already exists`);
+    const i = this.ids.length;
+    this.ids.push(id);
+    this.index.set(id, i);
+    return i;
+  }
+
+  remap(remap: Int32Array): void {
+    const kept: string[] = [];
+    for (let i = 0; i < this.ids.length; i++) {
+      if (remap[i] >= 0) kept.push(this.ids[i]);
+    }
+    this.ids = kept;
+    this.lookup = null;
+  }
+}
+
+/** Columnar attribute storage: one column per key, rows indexed like nodes/edges. */
+export class AttributeStore {
+  private columns = new Map<string, Float64Array | unknown[]>();
+  rowCount = 0;
+
+  static fromColumns(columns: AttributeColumn[], rowCount: number): AttributeStore {
+    const store = new AttributeStore();
+    for (const { name, values } of columns) store.columns.set(name, values);
+    store.rowCount = rowCount;
+    return store;
+  }
+
+  static fromRows(rows: ArrayLike<Record<string, unknown> | undefined>): AttributeStore {
+    const store = new AttributeStore();
+    for (let r = 0; r < rows.length; r++) store.setRow(r, rows[r]);
+    store.rowCount = rows.length;
+    return store;
+  }
+
+  get names(): IterableIterator<string> { return this.columns.keys(); }
+
+  /** Value of `name` at `row`, or undefined. */
+  get(row: number, name: string): unknown {
+    const column = this.columns.get(name);
+    if (!column) return undefined;
+    const v = column[row];
+    return typeof v === 'number' && Number.isNaN(v) ? undefined : v;
+  }
+
+  /** Materialize one row as a record. */
+  row(row: number): Record<string, unknown> {
+    const attrs: Record<string, unknown> = {};
+    for (const name of this.columns.keys()) {
+      const v = this.get(row, name);
+      if (v !== undefined) attrs[name] = v;
+    }
+    return attrs;
+  }
+
+  /** Replace a row (appending when `row >= rowCount`). */
+  setRow(row: number, attrs: Record<string, unknown> | undefined): void {
+    for (const [name, column] of this.columns) {
+      if (row < column.length && (attrs === undefined || !(name in attrs))) {
+        if (column instanceof Float64Array) column[row] = NaN;
+        else column[row] = undefined;
+      }
+    }
+    if (attrs) {
+      for (const name in attrs) {
+        const v = attrs[name];
+        const column = this.columns.get(name);
+        if (column instanceof Float64Array && typeof v === 'number' && row < column.length) {
+          column[row] = v;
+          continue;
+        }
+        const values = column instanceof Float64Array ? this.toArray(name, column) : column ?? [];
+        if (!column) this.columns.set(name, values);
+        values[row] = v;
+      }
+    }
+    this.rowCount = Math.max(this.rowCount, row + 1);
+  }
+
+  /** Compact rows through a remap (-1 = removed). */
+  remap(remap: Int32Array, newCount: number): void {
+    for (const [name, column] of this.columns) {
+      const n = Math.min(column.length, remap.length);
+      if (column instanceof Float64Array) {
+        const next = new Float64Array(newCount).fill(NaN);
+        for (let r = 0; r < n; r++) if (remap[r] >= 0) next[remap[r]] = column[r];
+        this.columns.set(name, next);
+      } else {
+        const next: unknown[] = new Array(newCount);
+        for (let r = 0; r < n; r++) if (remap[r] >= 0) next[remap[r]] = column[r];
+        this.columns.set(name, next);
+      }
+    }
+    this.rowCount = newCount;
+  }
+
+  toColumns(): AttributeColumn[] {
+    return [...this.columns].map(([name, values]) => ({ name, values }));
+  }
+
+  private toArray(name: string, column: Float64Array): unknown[] {
+    const values: unknown[] = new Array(column.length);
+    for (let r = 0; r < column.length; r++) {
+      if (!Number.isNaN(column[r])) values[r] = column[r];
+    }
+    this.columns.set(name, values);
+    return values;
+  }
+}
+
+/** Inputs for building a store from already-packed arrays (loaders). */
+export interface HypergraphStoreParts {
+  nodeIds: string[];
+  edgeIds: (string | number)[];
+  offsets: Uint32Array;        // edgeCount + 1; adopted, not copied
+  members: Uint32Array;        // adopted, not copied
+  groups?: Uint32Array;        // default: first hyperedge membership (mod 16)
+  nodeAttrs?: AttributeStore;
+  edgeAttrs?: AttributeStore;
+}
+
+const NO_DIRTY: CSRDirtyRange = { offsetsStart: Infinity, membersStart: Infinity };
+
+export class HypergraphStore {
+  readonly nodeIds: IdTable;
+  edgeIds: (string | number)[];
+  readonly csr: HyperedgeCSR;
+  groups: Uint32Array;         // per node; capacity may exceed nodeCount
+  readonly nodeAttrs: AttributeStore;
+  readonly edgeAttrs: AttributeStore;
+
+  private objects: HypergraphData | null = null;
+  private incidence = new NodeIncidenceCSR();
+  private incidenceStale = true;
+  private dirty: CSRDirtyRange = { ...NO_DIRTY };
+
+  private constructor(parts: HypergraphStoreParts) {
+    this.nodeIds = new IdTable(parts.nodeIds);
+    this.edgeIds = parts.edgeIds;
+    this.csr = new HyperedgeCSR();
+    this.csr.adopt(parts.offsets, parts.members);
+    this.groups = parts.groups ?? groupsByFirstEdge(parts.offsets, parts.members, parts.edgeIds.length, parts.nodeIds.length);
+    this.nodeAttrs = parts.nodeAttrs ?? new AttributeStore();
+    this.edgeAttrs = parts.edgeAttrs ?? new AttributeStore();
+  }
+
+  static empty(): HypergraphStore {
+    return new HypergraphStore({ nodeIds: [], edgeIds: [], offsets: new Uint32Array(1), members: new Uint32Array(0) });
+  }
+
+  static fromParts(parts: HypergraphStoreParts): HypergraphStore {
+    return new HypergraphStore(parts);
+  }
+
+  /** Pack an object-model graph. `data` itself becomes the store's object view. */
+  static fromHypergraph(data: HypergraphData): HypergraphStore {
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    const groups = new Uint32Array(data.nodes.length);
+    for (let i = 0; i < data.nodes.length; i++) groups[i] = data.nodes[i].group;
+    const store = new HypergraphStore({
+      nodeIds: data.nodes.map(n => n.id),
+      edgeIds: data.hyperedges.map(he => he.id),
+      offsets: csr.offsets.subarray(0, csr.edgeCount + 1),
+      members: csr.members.subarray(0, csr.memberCount),
+      groups,
+      nodeAttrs: AttributeStore.fromRows(data.nodes.map(n => n.attrs)),
+      edgeAttrs: AttributeStore.fromRows(data.hyperedges.map(he => he.attrs)),
+    });
+    store.objects = data;
+    return store;
+  }
+
+  get nodeCount(): number { return this.nodeIds.size; }
+  get edgeCount(): number { return this.csr.edgeCount; }
+  get memberCount(): number { return this.csr.memberCount; }
+
+  /** Members of edge `e` — a view into the CSR, valid until the next mutation. */
+  members(e: number): Uint32Array {
+    return this.csr.members.subarray(this.csr.offsets[e], this.csr.offsets[e + 1]);
+  }
+
+  edgeSize(e: number): number {
+    return this.csr.offsets[e + 1] - this.csr.offsets[e];
+  }
+
+  /** Lightweight per-edge views for renderers (all edges, or the given subset in edge order). */
+  edgeMembers(subset: Set<number> | null = null): EdgeMembers[] {
+    const out: EdgeMembers[] = [];
+    for (let e = 0; e < this.edgeCount; e++) {
+      if (subset !== null && !subset.has(e)) continue;
+      out.push({ index: e, memberIndices: this.members(e) });
+    }
+    return out;
+  }
+
+  /** Node → hyperedges transpose, rebuilt lazily after topology changes. */
+  nodeEdges(): NodeIncidenceCSR {
+    if (this.incidenceStale) {
+      this.incidence.build(this.csr, this.nodeCount);
+      this.incidenceStale = false;
+    }
+    return this.incidence;
+  }
+
+  /** Hyperedges containing node `i`, ascending. */
+  edgesOf(i: number): Uint32Array {
+    const { offsets, edges } = this.nodeEdges();
+    return edges.subarray(offsets[i], offsets[i + 1]);
+  }
+
+  /** First CSR slots changed since the last call (for incremental GPU upload). */
+  takeCSRDirty(): CSRDirtyRange {
+    const dirty = {
+      offsetsStart: Math.min(this.dirty.offsetsStart, this.edgeCount + 1),
+      membersStart: Math.min(this.dirty.membersStart, this.memberCount),
+    };
+    this.dirty = { ...NO_DIRTY };
+    return dirty;
+  }
+
+  // ── Object view ──
+
+  /** Object model for API consumers; materialized on first property access. */
+  toHypergraph(): HypergraphData {
+    return this.objects ?? new LazyHypergraphView(this);
+  }
+
+  /** One node as an object (the view's object once materialized, else a fresh one). */
+  node(i: number): NodeData {
+    if (this.objects) return this.objects.nodes[i];
+    return { id: this.nodeIds.ids[i], index: i, group: this.groups[i], attrs: this.nodeAttrs.row(i) };
+  }
+
+  /** One hyperedge as an object (the view's object once materialized, else a fresh one). */
+  hyperedge(e: number): HyperedgeData {
+    if (this.objects) return this.objects.hyperedges[e];
+    return { id: this.edgeIds[e], index: e, memberIndices: Array.from(this.members(e)), attrs: this.edgeAttrs.row(e) };
+  }
+
+  /** Build the object view now (LazyHypergraphView calls this on first access). */
+  materialize(): HypergraphData {
+    if (this.objects) return this.objects;
+    const n = this.nodeCount;
+    const nodes: NodeData[] = new Array(n);
+    for (let i = 0; i < n; i++) {
+      nodes[i] = { id: this.nodeIds.ids[i], index: i, group: this.groups[i], attrs: this.nodeAttrs.row(i) };
+    }
+    const hyperedges: HyperedgeData[] = new Array(this.edgeCount);
+    for (let e = 0; e < this.edgeCount; e++) {
+      hyperedges[e] = {
+        id: this.edgeIds[e], index: e, memberIndices: Array.from(this.members(e)), attrs: this.edgeAttrs.row(e),
+      };
+    }
+    this.objects = { nodes, hyperedges, nodeIdToIndex: new Map(this.nodeIds.index) };
+    return this.objects;
+  }
+
+  // ── Mutations (mirrored into the object view when it exists) ──
+
+  setGroup(i: number, group: number): void {
+    this.groups[i] = group;
+    if (this.objects) this.objects.nodes[i].group = group;
+  }
+
+  /** Append nodes. Throws on IDs that already exist. Returns the new indices. */
+  insertNodes(inputs: NodeInput[]): number[] {
+    for (const input of inputs) {
+      if (this.nodeIds.indexOf(input.id) >= 0) throw new Error(`Node "${input.id}" already exists`);
+    }
+    const prevCount = this.nodeCount;
+    if (prevCount + inputs.length > this.groups.length) {
+      const grown = new Uint32Array(Math.max(prevCount + inputs.length, this.groups.length * 2));
+      grown.set(this.groups.subarray(0, prevCount));
+      this.groups = grown;
+    }
+    const added: number[] = [];
+    for (const input of inputs) {
+      const i = this.nodeIds.add(input.id);
+      this.groups[i] = input.group ?? 0;
+      this.nodeAttrs.setRow(i, input.attrs);
+      added.push(i);
+    }
+    if (this.objects) insertNodes(this.objects, inputs);
+    this.incidenceStale = true;
+    return added;
+  }
+
+  /** Append hyperedges. Member lists are validated and de-duplicated. Returns the new indices. */
+  insertHyperedges(inputs: HyperedgeInput[]): number[] {
+    const lists = inputs.map(input => this.sanitizeMembers(input.memberIndices));
+    const first = this.edgeCount;
+    this.markDirty(this.csr.append(lists));
+    const added: number[] = [];
+    for (let k = 0; k < inputs.length; k++) {
+      this.edgeIds.push(inputs[k].id);
+      this.edgeAttrs.setRow(first + k, inputs[k].attrs);
+      added.push(first + k);
+    }
+    if (this.objects) insertHyperedges(this.objects, inputs);
+    this.incidenceStale = true;
+    return added;
+  }
+
+  /** Replace the member list of one hyperedge. */
+  setHyperedgeMembers(edgeIndex: number, memberIndices: number[]): void {
+    if (edgeIndex < 0 || edgeIndex >= this.edgeCount) throw new Error(`Hyperedge index ${edgeIndex} out of range`);
+    this.markDirty(this.csr.replace(edgeIndex, this.sanitizeMembers(memberIndices)));
+    if (this.objects) setHyperedgeMembers(this.objects, edgeIndex, memberIndices);
+    this.incidenceStale = true;
+  }
+
+  /** Append members to existing hyperedges with one shift of the CSR tail. Members already present are skipped. */
+  extendHyperedges(extensions: HyperedgeExtension[]): void {
+    if (extensions.length === 0) return;
+    const sorted = [...extensions].sort((a, b) => a.index - b.index);
+    const edges: number[] = [];
+    const lists: number[][] = [];
+    for (const { index, memberIndices } of sorted) {
+      if (index < 0 || index >= this.edgeCount) throw new Error(`Hyperedge index ${index} out of range`);
+      if (index === edges[edges.length - 1]) throw new Error(`Hyperedge ${index} extended twice`);
+      const size = this.edgeSize(index);
+      edges.push(index);
+      lists.push(this.sanitizeMembers([...this.members(index), ...memberIndices]).slice(size));
+    }
+    this.markDirty(this.csr.extend(edges, lists));
+    if (this.objects) {
+      for (let j = 0; j < edges.length; j++) this.objects.hyperedges[edges[j]].memberIndices.push(...lists[j]);
+    }
+    this.incidenceStale = true;
+  }
+
+  /** Replace the attributes of node `i`. */
+  setNodeAttrs(i: number, attrs: Record<string, unknown>): void {
+    this.nodeAttrs.setRow(i, attrs);
+    if (this.objects) this.objects.nodes[i].attrs = attrs;
+  }
+
+  /** Replace the attributes of hyperedge `e`. */
+  setEdgeAttrs(e: number, attrs: Record<string, unknown>): void {
+    this.edgeAttrs.setRow(e, attrs);
+    if (this.objects) this.objects.hyperedges[e].attrs = attrs;
+  }
+
+  /** Remove nodes and strip them from every hyperedge. Returns the old→new node remap. */
+  deleteNodes(indices: Iterable<number>): Int32Array {
+    const removed = [...indices];
+    const remap = buildRemap(this.nodeCount, removed);
+    const kept = remapCount(remap);
+    if (kept === this.nodeCount) return remap;
+
+    const prevCount = this.nodeCount;
+    for (let i = 0; i < prevCount; i++) {
+      if (remap[i] >= 0) this.groups[remap[i]] = this.groups[i];
+    }
+    this.nodeIds.remap(remap);
+    this.nodeAttrs.remap(remap, kept);
+    this.markDirty(this.csr.remapMembers(remap));
+    if (this.objects) deleteNodes(this.objects, removed);
+    this.incidenceStale = true;
+    return remap;
+  }
+
+  /** Remove hyperedges. Returns the old→new hyperedge remap. */
+  deleteHyperedges(indices: Iterable<number>): Int32Array {
+    const removed = [...indices];
+    const remap = buildRemap(this.edgeCount, removed);
+    const kept = remapCount(remap);
+    if (kept === this.edgeCount) return remap;
+
+    this.edgeIds = this.edgeIds.filter((_, e) => remap[e] >= 0);
+    this.edgeAttrs.remap(remap, kept);
+    this.markDirty(this.csr.removeEdges(remap));
+    if (this.objects) deleteHyperedges(this.objects, removed);
+    this.incidenceStale = true;
+    return remap;
+  }
+
+  private markDirty(range: CSRDirtyRange): void {
+    this.dirty.offsetsStart = Math.min(this.dirty.offsetsStart, range.offsetsStart);
+    this.dirty.membersStart = Math.min(this.dirty.membersStart, range.membersStart);
+  }
+
+  private sanitizeMembers(memberIndices: ArrayLike<number>): number[] {
+    const count = this.nodeCount;
+    const seen = new Set<number>();
+    const out: number[] = [];
+    for (let k = 0; k < memberIndices.length; k++) {
+      const idx = memberIndices[k];
+      if (!Number.isInteger(idx) || idx < 0 || idx >= count) {
+        throw new Error(`Member index ${idx} out of range [0, ${count})`);
+      }
+      if (seen.has(idx)) continue;
+      seen.add(idx);
+      out.push(idx);
+    }
+    return out;
+  }
+}
+
+/**
+ * `HypergraphData` whose arrays are built from the store on first access.
+ * Until then a 1M-node graph costs nothing beyond its typed arrays.
+ */
+class LazyHypergraphView implements HypergraphData {
+  private store: HypergraphStore;
+
+  constructor(store: HypergraphStore) {
+    this.store = store;
+  }
+
+  get nodes(): NodeData[] { return this.store.materialize().nodes; }
+  set nodes(nodes: NodeData[]) { this.store.materialize().nodes = nodes; }
+  get hyperedges(): HyperedgeData[] { return this.store.materialize().hyperedges; }
+  set hyperedges(hyperedges: HyperedgeData[]) { this.store.materialize().hyperedges = hyperedges; }
+  get nodeIdToIndex(): Map<string, number> { return this.store.materialize().nodeIdToIndex; }
+}
+
+/** Group = first hyperedge membership (mod 16), the loaders' default coloring. */
+export function groupsByFirstEdge(
+  offsets: Uint32Array, members: Uint32Array, edgeCount: number, nodeCount: number,
+): Uint32Array {
+  const groups = new Uint32Array(nodeCount);
+  const assigned = new Uint8Array(nodeCount);
+  for (let e = 0; e < edgeCount; e++) {
+    for (let m = offsets[e]; m < offsets[e + 1]; m++) {
+      const i = members[m];
+      if (assigned[i]) continue;
+      assigned[i] = 1;
+      groups[i] = e % 16;
+    }
+  }
+  return groups;
+}
+
+function remapCount(remap: Int32Array): number {
+  let kept = 0;
+  for (let i = 0; i < remap.length; i++) if (remap[i] >= 0) kept++;
+  return kept;
+}
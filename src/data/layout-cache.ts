@@ -0,0 +1,217 @@
+/**
+ * Persistent cache of converged layouts, keyed by a hash of the incidence
+ * structure. Reloading an identical dataset restores its positions instead
+ * of re-running the force layout.
+ *
+ * Entries hold x/y per node (velocities are zero after convergence) and are
+ * evicted least-recently-used once the total exceeds `maxBytes`. Storage goes
+ * through a small backend interface: IndexedDB in the browser, an in-memory
+ * map elsewhere (tests, environments without IndexedDB).
+ */
+import type { HypergraphStore } from './hypergraph-store';
+
+export interface LayoutCacheEntry {
+  key: string;
+  bytes: number;
+  lastUsed: number; // ms since epoch
+}
+
+export interface LayoutCacheBackend {
+  get(key: string): Promise<Float32Array | null>;
+  put(entry: LayoutCacheEntry, xy: Float32Array): Promise<void>;
+  touch(key: string, lastUsed: number): Promise<void>;
+  delete(key: string): Promise<void>;
+  entries(): Promise<LayoutCacheEntry[]>;
+  clear(): Promise<void>;
+}
+
+export interface LayoutCacheOptions {
+  backend?: LayoutCacheBackend;
+  maxBytes?: number; // default 256 MB
+}
+
+/**
+ * Content key of a graph's structure: node count plus the CSR offsets and
+ * members, hashed with two independent 32-bit lanes (murmur3 mixing).
+ * IDs and attributes are ignored — they don't affect the layout.
+ */
+export function layoutKey(store: HypergraphStore): string {
+  const edgeCount = store.edgeCount;
+  const offsets = store.csr.offsets.subarray(0, edgeCount + 1);
+  const members = store.csr.members.subarray(0, store.memberCount);
+  let h1 = 0x9747b28c ^ store.nodeCount;
+  let h2 = 0x2545f491 ^ edgeCount;
+  const mix = (words: Uint32Array) => {
+    for (let i = 0; i < words.length; i++) {
+      let k = Math.imul(words[i], 0xcc9e2d51);
+      k = Math.imul((k << 15) | (k >>> 17), 0x1b873593);
+      h1 ^= k;
+      h1 = Math.imul((h1 << 13) | (h1 >>> 19), 5) + 0xe6546b64;
+      h2 = Math.imul(h2 ^ words[i], 0x85ebca6b) + (h1 >>> 7);
+    }
+  };
+  mix(offsets);
+  mix(members);
+  const fmix = (h: number) => {
+    h = Math.imul(h ^ (h >>> 16), 0x85ebca6b);
+    h = Math.imul(h ^ (h >>> 13), 0xc2b2ae35);
+    return (h ^ (h >>> 16)) >>> 0;
+  };
+  const hex = (h: number) => fmix(h).toString(16).padStart(8, '0');
+  return `${store.nodeCount}.${store.memberCount}.${hex(h1)}${hex(h2)}`;
+}
+
+export class LayoutCache {
+  private backend: LayoutCacheBackend;
+  readonly maxBytes: number;
+
+  constructor(options: LayoutCacheOptions = {}) {
+    this.backend = options.backend
+      ?? (typeof indexedDB !== 'undefined' ? new IndexedDBLayoutBackend() : new MemoryLayoutBackend());
+    this.maxBytes = options.maxBytes ?? 256 * 1024 * 1024;
+  }
+
+  /** Cached positions ([x, y, vx, vy] per node, zero velocity) or null on a miss. */
+  async load(key: string, nodeCount: number): Promise<Float32Array | null> {
+    const xy = await this.backend.get(key);
+    if (!xy || xy.length !== nodeCount * 2) return null;
+    await this.backend.touch(key, Date.now());
+    const positions = new Float32Array(nodeCount * 4);
+    for (let i = 0; i < nodeCount; i++) {
+      positions[i * 4] = xy[i * 2];
+      positions[i * 4 + 1] = xy[i * 2 + 1];
+    }
+    return positions;
+  }
+
+  /** Store positions ([x, y, vx, vy] per node), evicting old entries to stay under `maxBytes`. */
+  async save(key: string, positions: Float32Array): Promise<void> {
+    const nodeCount = positions.length >> 2;
+    const xy = new Float32Array(nodeCount * 2);
+    for (let i = 0; i < nodeCount; i++) {
+      xy[i * 2] = positions[i * 4];
+      xy[i * 2 + 1] = positions[i * 4 + 1];
+    }
+    if (xy.byteLength > this.maxBytes) return;
+
+    const entries = (await this.backend.entries()).filter(e => e.key !== key);
+    entries.sort((a, b) => a.lastUsed - b.lastUsed);
+    let total = xy.byteLength;
+    for (const e of entries) total += e.bytes;
+    for (const e of entries) {
+      if (total <= this.maxBytes) break;
+      await this.backend.delete(e.key);
+      total -= e.bytes;
+    }
+    await this.backend.put({ key, bytes: xy.byteLength, lastUsed: Date.now() }, xy);
+  }
+
+  delete(key: string): Promise<void> { return this.backend.delete(key); }
+  entries(): Promise<LayoutCacheEntry[]> { return this.backend.entries(); }
+  clear(): Promise<void> { return this.backend.clear(); }
+}
+
+export class MemoryLayoutBackend implements LayoutCacheBackend {
+  private data = new Map<string, { entry: LayoutCacheEntry; xy: Float32Array }>();
+
+  async get(key: string): Promise<Float32Array | null> {
+    return this.data.get(key)?.xy ?? null;
+  }
+  async put(entry: LayoutCacheEntry, xy: Float32Array): Promise<void> {
+    this.data.set(entry.key, { entry: { ...entry }, xy });
+  }
+  async touch(key: string, lastUsed: number): Promise<void> {
+    const item = this.data.get(key);
+    if (item) item.entry.lastUsed = lastUsed;
+  }
+  async delete(key: string): Promise<void> {
+    this.data.delete(key);
+  }
+  async entries(): Promise<LayoutCacheEntry[]> {
+    return Array.from(this.data.values(), item => ({ ...item.entry }));
+  }
+  async clear(): Promise<void> {
+    this.data.clear();
+  }
+}
+
+const DB_NAME = 'hyperblob-layouts';
+const POSITIONS = 'positions'; // key → ArrayBuffer of x/y floats
+const ENTRIES = 'entries';     // key → LayoutCacheEntry (sizes and LRU stamps, read without the payloads)
+
+function settle<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+function committed(tx: IDBTransaction): Promise<void> {
+  return new Promise((resolve, reject) => {
+    tx.oncomplete = () => resolve();
+    tx.onerror = () => reject(tx.error);
+    tx.onabort = () => reject(tx.error ?? new Error('Layout cache transaction aborted'));
+  });
+}
+
+export class IndexedDBLayoutBackend implements LayoutCacheBackend {
+  private db: Promise<IDBDatabase> | null = null;
+
+  private open(): Promise<IDBDatabase> {
+    return this.db ??= new Promise((resolve, reject) => {
+      const request = indexedDB.open(DB_NAME, 1);
+      request.onupgradeneeded = () => {
+        request.result.createObjectStore(POSITIONS);
+        request.result.createObjectStore(ENTRIES, { keyPath: 'key' });
+      };
+      request.onsuccess = () => resolve(request.result);
+      request.onerror = () => reject(request.error);
+    });
+  }
+
+  async get(key: string): Promise<Float32Array | null> {
+    const db = await this.open();
+    const buffer = await settle<ArrayBuffer | undefined>(
+      db.transaction(POSITIONS, 'readonly').objectStore(POSITIONS).get(key),
+    );
+    return buffer ? new Float32Array(buffer) : null;
+  }
+
+  async put(entry: LayoutCacheEntry, xy: Float32Array): Promise<void> {
+    const db = await this.open();
+    const tx = db.transaction([POSITIONS, ENTRIES], 'readwrite');
+    tx.objectStore(POSITIONS).put(xy.buffer.slice(xy.byteOffset, xy.byteOffset + xy.byteLength), entry.key);
+    tx.objectStore(ENTRIES).put(entry);
+    await committed(tx);
+  }
+
+  async touch(key: string, lastUsed: number): Promise<void> {
+    const db = await this.open();
+    const tx = db.transaction(ENTRIES, 'readwrite');
+    const store = tx.objectStore(ENTRIES);
+    const entry = await settle<LayoutCacheEntry | undefined>(store.get(key));
+    if (entry) store.put({ ...entry, lastUsed });
+    await committed(tx);
+  }
+
+  async delete(key: string): Promise<void> {
+    const db = await this.open();
+    const tx = db.transaction([POSITIONS, ENTRIES], 'readwrite');
+    tx.objectStore(POSITIONS).delete(key);
+    tx.objectStore(ENTRIES).delete(key);
+    await committed(tx);
+  }
+
+  async entries(): Promise<LayoutCacheEntry[]> {
+    const db = await this.open();
+    return settle<LayoutCacheEntry[]>(db.transaction(ENTRIES, 'readonly').objectStore(ENTRIES).getAll());
+  }
+
+  async clear(): Promise<void> {
+    const db = await this.open();
+    const tx = db.transaction([POSITIONS, ENTRIES], 'readwrite');
+    tx.objectStore(POSITIONS).clear();
+    tx.objectStore(ENTRIES).clear();
+    await committed(tx);
+  }
+}
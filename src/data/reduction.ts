@@ -0,0 +1,222 @@
+/**
+ * Structural reduction: collapse hyperedges with identical member sets and
+ * nodes with identical (de-duplicated) edge memberships into weighted
+ * representatives before layout.
+ *
+ * The reduced store keeps each class's first member as representative (its
+ * ID, group and attributes). Classes of more than one item carry the
+ * original IDs in a `collapsedNodes` / `collapsedEdges` attribute column, so
+ * the mapping survives later store mutations and tooltips can expand a
+ * representative back to its originals. The weight of an item is its class
+ * size (`collapsedWeights`). Nodes without edges are left alone.
+ *
+ * Both passes are linear apart from sorting each edge's members: classes
+ * are found by hashing a canonical key (sorted members / ascending edge
+ * list) and confirming candidates element by element.
+ */
+import { HypergraphStore, AttributeStore, type AttributeColumn } from './hypergraph-store';
+import { NodeIncidenceCSR, HyperedgeCSR } from './csr';
+
+export const COLLAPSED_NODES = 'collapsedNodes';
+export const COLLAPSED_EDGES = 'collapsedEdges';
+
+export interface StructuralReduction {
+  store: HypergraphStore;
+  nodeClass: Uint32Array;   // original node → reduced node
+  edgeClass: Uint32Array;   // original edge → reduced edge
+  nodeWeights: Uint32Array; // originals per reduced node
+  edgeWeights: Uint32Array; // originals per reduced edge
+}
+
+export interface ReductionOptions {
+  edges?: boolean; // collapse duplicate hyperedges (default true)
+  nodes?: boolean; // collapse equivalent nodes (default true)
+}
+
+export function reduceHypergraph(source: HypergraphStore, options: ReductionOptions = {}): StructuralReduction {
+  const nodeCount = source.nodeCount;
+  const edgeCount = source.edgeCount;
+  const { offsets, members } = source.csr;
+
+  // ── 1. Duplicate hyperedges: bucket by hash of the sorted member list ──
+  const sorted = members.slice(0, source.memberCount);
+  for (let e = 0; e < edgeCount; e++) sorted.subarray(offsets[e], offsets[e + 1]).sort();
+  const edgeClass = new Uint32Array(edgeCount);
+  const edgeReps: number[] = [];
+  if (options.edges === false) {
+    for (let e = 0; e < edgeCount; e++) edgeClass[e] = edgeReps.push(e) - 1;
+  } else {
+    const slices = (e: number) => sorted.subarray(offsets[e], offsets[e + 1]);
+    classify(edgeCount, e => hashWords(slices(e)), (a, b) => sameWords(slices(a), slices(b)), edgeClass, edgeReps);
+  }
+
+  // ── 2. Equivalent nodes: bucket by hash of the ascending list of distinct edges ──
+  const distinct = new HyperedgeCSR();
+  distinct.adopt(...packSubset(offsets, members, edgeReps));
+  const incidence = new NodeIncidenceCSR();
+  incidence.build(distinct, nodeCount);
+  const edgesOf = (i: number) => incidence.edges.subarray(incidence.offsets[i], incidence.offsets[i + 1]);
+  const nodeClass = new Uint32Array(nodeCount);
+  const nodeReps: number[] = [];
+  if (options.nodes === false) {
+    for (let i = 0; i < nodeCount; i++) nodeClass[i] = nodeReps.push(i) - 1;
+  } else {
+    classify(
+      nodeCount,
+      i => incidence.offsets[i] === incidence.offsets[i + 1] ? -1 : hashWords(edgesOf(i)),
+      (a, b) => sameWords(edgesOf(a), edgesOf(b)),
+      nodeClass, nodeReps,
+    );
+  }
+
+  // ── 3. Reduced CSR: each distinct edge over node classes (first occurrence order) ──
+  const reducedEdges = edgeReps.length;
+  const outOffsets = new Uint32Array(reducedEdges + 1);
+  const outMembers = new Uint32Array(distinct.memberCount);
+  const seen = new Int32Array(nodeReps.length);
+  let m = 0;
+  for (let r = 0; r < reducedEdges; r++) {
+    const e = edgeReps[r];
+    for (let k = offsets[e]; k < offsets[e + 1]; k++) {
+      const c = nodeClass[members[k]];
+      if (seen[c] === r + 1) continue;
+      seen[c] = r + 1;
+      outMembers[m++] = c;
+    }
+    outOffsets[r + 1] = m;
+  }
+
+  const nodeWeights = countClasses(nodeClass, nodeReps.length);
+  const edgeWeights = countClasses(edgeClass, reducedEdges);
+  const nodeIds = source.nodeIds.ids;
+  const groups = new Uint32Array(nodeReps.length);
+  for (let c = 0; c < nodeReps.length; c++) groups[c] = source.groups[nodeReps[c]];
+
+  const store = HypergraphStore.fromParts({
+    nodeIds: nodeReps.map(i => nodeIds[i]),
+    edgeIds: edgeReps.map(e => source.edgeIds[e]),
+    offsets: outOffsets,
+    members: outMembers.slice(0, m),
+    groups,
+    nodeAttrs: selectRows(source.nodeAttrs, nodeReps,
+      collapsedColumn(COLLAPSED_NODES, nodeClass, nodeWeights, i => nodeIds[i])),
+    edgeAttrs: selectRows(source.edgeAttrs, edgeReps,
+      collapsedColumn(COLLAPSED_EDGES, edgeClass, edgeWeights, e => source.edgeIds[e])),
+  });
+  return { store, nodeClass, edgeClass, nodeWeights, edgeWeights };
+}
+
+/**
+ * Per-row weights from a collapsed-ID column (class size, 1 for uncollapsed
+ * rows), or null when the store was never reduced.
+ */
+export function collapsedWeights(attrs: AttributeStore, column: string, rowCount: number): Float32Array | null {
+  let found = false;
+  for (const name of attrs.names) if (name === column) found = true;
+  if (!found) return null;
+  const weights = new Float32Array(rowCount);
+  for (let r = 0; r < rowCount; r++) {
+    const ids = attrs.get(r, column);
+    weights[r] = Array.isArray(ids) ? ids.length : 1;
+  }
+  return weights;
+}
+
+/**
+ * Assign each item a class in first-appearance order. Items with key -1 are
+ * singletons; colliding keys are split by `same`.
+ */
+function classify(
+  count: number,
+  key: (item: number) => number,
+  same: (a: number, b: number) => boolean,
+  classOf: Uint32Array,
+  reps: number[],
+): void {
+  const buckets = new Map<number, number[]>(); // key → classes with that key
+  for (let item = 0; item < count; item++) {
+    const k = key(item);
+    if (k < 0) {
+      classOf[item] = reps.push(item) - 1;
+      continue;
+    }
+    let bucket = buckets.get(k);
+    if (!bucket) buckets.set(k, bucket = []);
+    let c = -1;
+    for (const candidate of bucket) {
+      if (same(reps[candidate], item)) { c = candidate; break; }
+    }
+    if (c < 0) {
+      c = reps.push(item) - 1;
+      bucket.push(c);
+    }
+    classOf[item] = c;
+  }
+}
+
+/** Non-negative 31-bit hash of a word list (murmur3 mixing). */
+function hashWords(words: Uint32Array): number {
+  let h = 0x9747b28c ^ words.length;
+  for (let i = 0; i < words.length; i++) {
+    let k = Math.imul(words[i], 0xcc9e2d51);
+    k = Math.imul((k << 15) | (k >>> 17), 0x1b873593);
+    h ^= k;
+    h = Math.imul((h << 13) | (h >>> 19), 5) + 0xe6546b64;
+  }
+  h = Math.imul(h ^ (h >>> 16), 0x85ebca6b);
+  h = Math.imul(h ^ (h >>> 13), 0xc2b2ae35);
+  return (h ^ (h >>> 16)) >>> 1;
+}
+
+function sameWords(a: Uint32Array, b: Uint32Array): boolean {
+  if (a.length !== b.length) return false;
+  for (let i = 0; i < a.length; i++) if (a[i] !== b[i]) return false;
+  return true;
+}
+
+/** CSR of the listed edges only, renumbered 0..edges.length-1. */
+function packSubset(offsets: Uint32Array, members: Uint32Array, edges: number[]): [Uint32Array, Uint32Array] {
+  const outOffsets = new Uint32Array(edges.length + 1);
+  for (let r = 0; r < edges.length; r++) {
+    outOffsets[r + 1] = outOffsets[r] + offsets[edges[r] + 1] - offsets[edges[r]];
+  }
+  const outMembers = new Uint32Array(outOffsets[edges.length]);
+  for (let r = 0; r < edges.length; r++) {
+    outMembers.set(members.subarray(offsets[edges[r]], offsets[edges[r] + 1]), outOffsets[r]);
+  }
+  return [outOffsets, outMembers];
+}
+
+function countClasses(classOf: Uint32Array, classCount: number): Uint32Array {
+  const counts = new Uint32Array(classCount);
+  for (let i = 0; i < classOf.length; i++) counts[classOf[i]]++;
+  return counts;
+}
+
+/** Original IDs per class, only for classes that merged more than one item. */
+function collapsedColumn<T>(
+  name: string, classOf: Uint32Array, weights: Uint32Array, idOf: (item: number) => T,
+): AttributeColumn | null {
+  const values: unknown[] = new Array(weights.length);
+  let any = false;
+  for (let item = 0; item < classOf.length; item++) {
+    const c = classOf[item];
+    if (weights[c] < 2) continue;
+    any = true;
+    ((values[c] ??= []) as T[]).push(idOf(item));
+  }
+  return any ? { name, values } : null;
+}
+
+function selectRows(attrs: AttributeStore, rows: number[], extra: AttributeColumn | null): AttributeStore {
+  const columns: AttributeColumn[] = attrs.toColumns().map(({ name, values }) => {
+    if (values instanceof Float64Array) {
+      const picked = new Float64Array(rows.length);
+      for (let r = 0; r < rows.length; r++) picked[r] = rows[r] < values.length ? values[rows[r]] : NaN;
+      return { name, values: picked };
+    }
+    return { name, values: rows.map(i => values[i]) };
+  });
+  if (extra) columns.push(extra);
+  return AttributeStore.fromColumns(columns, rows.length);
+}
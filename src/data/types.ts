@@ -40,6 +40,12 @@ export interface HyperedgeData {
   attrs: Record<string, unknown>;
 }
 
+/** Minimal hyperedge shape the renderers need — HyperedgeData or a CSR view from HypergraphStore. */
+export interface EdgeMembers {
+  index: number;
+  memberIndices: ArrayLike<number> & Iterable<number>;
+}
+
 export interface HypergraphData {
   nodes: NodeData[];
   hyperedges: HyperedgeData[];
@@ -59,6 +65,7 @@ export interface SimulationParams {
   coolingRate: number;
   stopThreshold: number;
   theta: number; // Barnes-Hut opening angle
+  deterministic: boolean; // ordered reductions instead of atomics — reproducible layouts, slower ticks
   running: boolean;
 }
 
@@ -73,7 +80,8 @@ export function defaultSimulationParams(): SimulationParams {
     idleEnergy: 0.02,
     coolingRate: 0.0228, // ~300 iterations to stopThreshold
     stopThreshold: 0.001,
-    theta: 0.9,
+    theta: 1.0, // quadrupole far field: ~ the old monopole error at 0.9, ~13% fewer visits (scripts/bh-sweep.ts)
+    deterministic: false,
     running: true,
   };
 }
@@ -88,9 +96,10 @@ export interface RenderParams {
   hullAlpha: number;
   hullOutline: boolean;
   hullMargin: number;
-  hullSmoothing: number;
   hullMode: HullMode;
   hullMetaballThreshold: number;
+  /** Metaball field resolution: 1 = full, 0.5 / 0.25 = half / quarter, upsampled with contour refinement */
+  hullMetaballScale: number;
   nodeDarkMode: boolean;
   backgroundColor: [number, number, number, number];
 }
@@ -102,9 +111,9 @@ export function defaultRenderParams(): RenderParams {
     hullAlpha: 0.25,
     hullOutline: false,
     hullMargin: 3,
-    hullSmoothing: 4,
     hullMode: 'metaball',
     hullMetaballThreshold: 0.5,
+    hullMetaballScale: 1,
     nodeDarkMode: true,
     backgroundColor: [0.97, 0.97, 0.98, 1.0],
   };
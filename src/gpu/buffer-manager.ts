@@ -82,16 +82,97 @@ export class BufferManager {
     return buffer;
   }
 
-  uploadData(name: string, data: ArrayBuffer | ArrayBufferView, offset = 0): void {
+  /**
+   * Make sure `name` holds at least `size` bytes. Buffers are allocated in
+   * power-of-two size classes and only ever grow, so work buffers are pooled
+   * across dataset loads and repeated small additions amortize. The first
+   * `preserveBytes` of the old contents are copied on the GPU (old buffer
+   * needs COPY_SRC). Returns true when the GPUBuffer was replaced — bind
+   * groups referencing it must be rebuilt.
+   */
+  ensureCapacity(name: string, size: number, usage: GPUBufferUsageFlags, label?: string, preserveBytes = 0): boolean {
+    const existing = this.buffers.get(name);
+    if (existing && existing.size >= size && (existing.usage & usage) === usage) return false;
+
+    const buffer = this.device.createBuffer({
+      label: label ?? name,
+      size: this.sizeClass(size, usage),
+      usage,
+    });
+
+    if (existing) {
+      const copyBytes = Math.floor(Math.min(preserveBytes, existing.size) / 4) * 4;
+      if (copyBytes > 0) {
+        const encoder = this.device.createCommandEncoder();
+        encoder.copyBufferToBuffer(existing, 0, buffer, 0, copyBytes);
+        this.device.queue.submit([encoder.finish()]);
+      }
+      existing.destroy();
+    }
+    this.buffers.set(name, buffer);
+    return true;
+  }
+
+  /** Power-of-two size class for `size`, clamped to what the device can bind. */
+  private sizeClass(size: number, usage: GPUBufferUsageFlags): number {
+    const limits = this.device.limits;
+    const max = (usage & GPUBufferUsage.STORAGE) !== 0
+      ? Math.min(limits.maxStorageBufferBindingSize, limits.maxBufferSize)
+      : (usage & GPUBufferUsage.UNIFORM) !== 0
+        ? Math.min(limits.maxUniformBufferBindingSize, limits.maxBufferSize)
+        : limits.maxBufferSize;
+    const pow2 = 2 ** Math.ceil(Math.log2(Math.max(size, 16)));
+    return alignUp(Math.max(Math.min(pow2, max), size, 4), 4);
+  }
+
+  /** Number of live buffers and their total size in bytes (for leak checks / stats). */
+  getStats(): { count: number; bytes: number } {
+    let bytes = 0;
+    for (const buffer of this.buffers.values()) bytes += buffer.size;
+    return { count: this.buffers.size, bytes };
+  }
+
+  /**
+   * Copy `[srcOffset, dstOffset, byteLength]` ranges of `name` into a fresh
+   * buffer of the same size and swap it in. Used to compact per-element
+   * buffers after removals without a CPU round-trip. Always replaces the buffer.
+   */
+  compactRanges(name: string, ranges: ReadonlyArray<readonly [number, number, number]>): void {
+    const existing = this.getBuffer(name);
+    const buffer = this.device.createBuffer({
+      label: existing.label,
+      size: existing.size,
+      usage: existing.usage,
+    });
+
+    const encoder = this.device.createCommandEncoder();
+    for (const [src, dst, size] of ranges) {
+      if (size > 0) encoder.copyBufferToBuffer(existing, src, buffer, dst, size);
+    }
+    this.device.queue.submit([encoder.finish()]);
+
+    existing.destroy();
+    this.buffers.set(name, buffer);
+  }
+
+  /** Write `data` at byte `offset`; `byteLength` limits a view to its leading bytes (no subarray needed). */
+  uploadData(name: string, data: ArrayBuffer | ArrayBufferView, offset = 0, byteLength?: number): void {
     const buffer = this.buffers.get(name);
     if (!buffer) throw new Error(`Buffer "${name}" not found`);
     if (ArrayBuffer.isView(data)) {
-      this.device.queue.writeBuffer(buffer, offset, data.buffer, data.byteOffset, data.byteLength);
+      this.device.queue.writeBuffer(buffer, offset, data.buffer, data.byteOffset, byteLength ?? data.byteLength);
     } else {
       this.device.queue.writeBuffer(buffer, offset, data);
     }
   }
 
+  /** Write bytes [offset, offset + byteLength) of `data` to the same range of `name` (patching from a CPU mirror). */
+  uploadRange(name: string, data: ArrayBufferView, offset: number, byteLength: number): void {
+    const buffer = this.buffers.get(name);
+    if (!buffer) throw new Error(`Buffer "${name}" not found`);
+    this.device.queue.writeBuffer(buffer, offset, data.buffer, data.byteOffset + offset, byteLength);
+  }
+
   getBuffer(name: string): GPUBuffer {
     const buffer = this.buffers.get(name);
     if (!buffer) throw new Error(`Buffer "${name}" not found`);
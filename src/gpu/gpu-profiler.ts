@@ -1,4 +1,4 @@
-// GPU timestamp profiler — per-stage compute pass timing
+// GPU timestamp profiler — per-stage compute (or render) pass timing
 // No-ops when timestamp-query feature is unavailable (zero overhead)
 
 export interface GPUStageTiming {
@@ -54,6 +54,7 @@ export class GPUProfiler {
     this.stages.length = 0;
   }
 
+  /** Timestamp writes for one pass of `stage` (compute and render passes take the same shape). */
   timestampWrites(stage: string): GPUComputePassTimestampWrites | undefined {
     if (!this.enabled || !this.querySet) return undefined;
     if (this.queryIndex + 2 > MAX_QUERIES) return undefined;
@@ -73,6 +74,7 @@ export class GPUProfiler {
   resolve(encoder: GPUCommandEncoder): void {
     if (!this.enabled || !this.querySet || !this.resolveBuffer || !this.readbackBuffer) return;
     if (this.queryIndex === 0) return;
+    if (this.mapping) return; // readback buffer is mapped; this frame goes unmeasured
 
     encoder.resolveQuerySet(this.querySet, 0, this.queryIndex, this.resolveBuffer, 0);
     encoder.copyBufferToBuffer(this.resolveBuffer, 0, this.readbackBuffer, 0, this.queryIndex * 8);
@@ -0,0 +1,68 @@
+/**
+ * Per-device cache of shader modules, bind group layouts and compute
+ * pipelines. Simulation sub-systems are rebuilt on every dataset switch;
+ * going through this cache means their pipelines are compiled once per
+ * device instead of once per load.
+ *
+ * Entries are keyed by label, so every distinct shader/layout/pipeline must
+ * carry a distinct label (already the convention across this codebase).
+ */
+export class PipelineCache {
+  private device: GPUDevice;
+  private modules = new Map<string, GPUShaderModule>();
+  private layouts = new Map<string, GPUBindGroupLayout>();
+  private pipelines = new Map<string, GPUComputePipeline>();
+
+  constructor(device: GPUDevice) {
+    this.device = device;
+  }
+
+  shaderModule(label: string, code: string): GPUShaderModule {
+    let module = this.modules.get(label);
+    if (!module) {
+      module = this.device.createShaderModule({ label, code });
+      this.modules.set(label, module);
+    }
+    return module;
+  }
+
+  bindGroupLayout(label: string, entries: GPUBindGroupLayoutEntry[]): GPUBindGroupLayout {
+    let layout = this.layouts.get(label);
+    if (!layout) {
+      layout = this.device.createBindGroupLayout({ label, entries });
+      this.layouts.set(label, layout);
+    }
+    return layout;
+  }
+
+  /** Compute pipeline for `module`/`entryPoint` with a single bind group layout. */
+  computePipeline(label: string, module: GPUShaderModule, entryPoint: string, layout: GPUBindGroupLayout): GPUComputePipeline {
+    const key = `${label}|${module.label}|${entryPoint}`;
+    let pipeline = this.pipelines.get(key);
+    if (!pipeline) {
+      pipeline = this.device.createComputePipeline({
+        label,
+        layout: this.device.createPipelineLayout({ bindGroupLayouts: [layout] }),
+        compute: { module, entryPoint },
+      });
+      this.pipelines.set(key, pipeline);
+    }
+    return pipeline;
+  }
+
+  get pipelineCount(): number {
+    return this.pipelines.size;
+  }
+}
+
+const caches = new WeakMap<GPUDevice, PipelineCache>();
+
+/** Shared cache for `device`; created on first use and dropped with the device. */
+export function getPipelineCache(device: GPUDevice): PipelineCache {
+  let cache = caches.get(device);
+  if (!cache) {
+    cache = new PipelineCache(device);
+    caches.set(device, cache);
+  }
+  return cache;
+}
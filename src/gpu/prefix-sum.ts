@@ -0,0 +1,141 @@
+import type { BufferManager } from './buffer-manager';
+import { getPipelineCache } from './pipeline-cache';
+import prefixSumShader from '../shaders/prefix-sum.wgsl?raw';
+
+const BLOCK = 512;       // elements per workgroup (256 threads × 2)
+const PARAMS_SLOT = 256; // minUniformBufferOffsetAlignment
+const MAX_GROUPS_X = 65535;
+
+interface Level {
+  groups: number;
+  bindGroup: GPUBindGroup; // this level's data + block sums + params slot
+}
+
+/**
+ * In-place exclusive prefix sum of a u32 storage buffer, for any length.
+ *
+ * Each level scans 512-element blocks and writes the block totals to a
+ * smaller buffer, which the next level scans in turn; offsets are then
+ * added back down the levels. The single value left at the top is the total
+ * of the input, exposed as `totalBuffer` (e.g. to derive indirect draw
+ * counts without a readback).
+ *
+ * Buffers are named `${name}-sums-${level}` / `${name}-params` in the
+ * BufferManager and only grow, so re-configuring each frame is cheap.
+ */
+export class PrefixSum {
+  private device: GPUDevice;
+  private bufferManager: BufferManager;
+  private name: string;
+
+  private scanPipeline: GPUComputePipeline;
+  private addPipeline: GPUComputePipeline;
+  private bindGroupLayout: GPUBindGroupLayout;
+
+  private levels: Level[] = [];
+  private configuredData: GPUBuffer | null = null;
+  private configuredCount = -1;
+
+  constructor(device: GPUDevice, bufferManager: BufferManager, name: string) {
+    this.device = device;
+    this.bufferManager = bufferManager;
+    this.name = name;
+
+    const cache = getPipelineCache(device);
+    const shaderModule = cache.shaderModule('prefix-sum-shader', prefixSumShader);
+    this.bindGroupLayout = cache.bindGroupLayout('prefix-sum-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+    this.scanPipeline = cache.computePipeline('prefix-sum-scan', shaderModule, 'scan_blocks', this.bindGroupLayout);
+    this.addPipeline = cache.computePipeline('prefix-sum-add', shaderModule, 'add_offsets', this.bindGroupLayout);
+  }
+
+  /** Buffer whose first u32 holds the sum of all input elements after `encode`. */
+  get totalBuffer(): GPUBuffer {
+    return this.bufferManager.getBuffer(`${this.name}-sums-${Math.max(this.levels.length - 1, 0)}`);
+  }
+
+  /** Scan the first `count` u32s of `data` (STORAGE usage) on subsequent `encode` calls. */
+  configure(data: GPUBuffer, count: number): void {
+    if (data === this.configuredData && count === this.configuredCount) return;
+    this.configuredData = data;
+    this.configuredCount = count;
+
+    const counts: number[] = [];
+    for (let n = count; n > 0; n = Math.ceil(n / BLOCK)) {
+      counts.push(n);
+      if (n <= BLOCK) break;
+    }
+
+    const storage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST;
+    const paramsName = `${this.name}-params`;
+    this.bufferManager.ensureCapacity(paramsName, PARAMS_SLOT * Math.max(counts.length, 1), GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST);
+    const params = new Uint32Array((PARAMS_SLOT / 4) * Math.max(counts.length, 1));
+    for (let level = 0; level < counts.length; level++) params[level * (PARAMS_SLOT / 4)] = counts[level];
+    this.bufferManager.uploadData(paramsName, params);
+
+    // Empty input still gets a (cleared) total
+    if (counts.length === 0) this.bufferManager.ensureCapacity(`${this.name}-sums-0`, 4, storage);
+
+    this.levels = [];
+    let input = data;
+    for (let level = 0; level < counts.length; level++) {
+      const groups = Math.ceil(counts[level] / BLOCK);
+      const sumsName = `${this.name}-sums-${level}`;
+      this.bufferManager.ensureCapacity(sumsName, groups * 4, storage);
+      const sums = this.bufferManager.getBuffer(sumsName);
+      this.levels.push({
+        groups,
+        bindGroup: this.device.createBindGroup({
+          label: `${this.name}-prefix-sum-${level}`,
+          layout: this.bindGroupLayout,
+          entries: [
+            { binding: 0, resource: { buffer: input } },
+            { binding: 1, resource: { buffer: sums } },
+            { binding: 2, resource: { buffer: this.bufferManager.getBuffer(paramsName), offset: level * PARAMS_SLOT, size: 16 } },
+          ],
+        }),
+      });
+      input = sums;
+    }
+  }
+
+  encode(encoder: GPUCommandEncoder): void {
+    if (this.levels.length === 0) {
+      encoder.clearBuffer(this.totalBuffer, 0, 4);
+      return;
+    }
+
+    const pass = encoder.beginComputePass({ label: `${this.name}-prefix-sum` });
+    pass.setPipeline(this.scanPipeline);
+    for (const level of this.levels) {
+      pass.setBindGroup(0, level.bindGroup);
+      dispatchBlocks(pass, level.groups);
+    }
+    // The top level fits one block, so its scan needs no offsets
+    pass.setPipeline(this.addPipeline);
+    for (let level = this.levels.length - 2; level >= 0; level--) {
+      pass.setBindGroup(0, this.levels[level].bindGroup);
+      dispatchBlocks(pass, this.levels[level].groups);
+    }
+    pass.end();
+  }
+
+  destroy(): void {
+    for (let level = 0; this.bufferManager.hasBuffer(`${this.name}-sums-${level}`); level++) {
+      this.bufferManager.destroyBuffer(`${this.name}-sums-${level}`);
+    }
+    if (this.bufferManager.hasBuffer(`${this.name}-params`)) this.bufferManager.destroyBuffer(`${this.name}-params`);
+    this.levels = [];
+    this.configuredData = null;
+    this.configuredCount = -1;
+  }
+}
+
+/** Dispatch `groups` workgroups, spilling into y past the per-dimension limit. */
+function dispatchBlocks(pass: GPUComputePassEncoder, groups: number): void {
+  const x = Math.min(groups, MAX_GROUPS_X);
+  pass.dispatchWorkgroups(x, Math.ceil(groups / x));
+}
@@ -0,0 +1,232 @@
+// GPU ID-buffer picking — what lies under the cursor, for hover and click
+// After the cursor moves, the next frame renders node IDs (red) and the
+// top-most hyperedge ID (green: hulls or metaballs, drawn by their renderer)
+// into a 1×1 rg32uint target, and that one texel is read back asynchronously.
+// The pass draws through a pick projection that blows the cursor pixel up to
+// the whole target (WebGPU viewports cannot start off the attachment), so the
+// target costs 8 bytes whatever the canvas size. The CPU cost of a pick is
+// O(1) at any graph size; results arrive a frame or two later through `onPick`.
+
+import type { Camera } from '../render/camera';
+import nodePickShaderCode from '../shaders/node-pick.wgsl?raw';
+
+/** Pick target format: node ID + 1 in red, hyperedge ID + 1 in green (0 = none). */
+export const PICK_FORMAT: GPUTextureFormat = 'rg32uint';
+
+export interface PickResult {
+  node: number | null;
+  edge: number | null;
+  screenX: number; // CSS pixels the pick was requested at
+  screenY: number;
+}
+
+export class GPUPicker {
+  private device: GPUDevice;
+  private pipeline: GPURenderPipeline;
+  private bindGroup: GPUBindGroup | null = null;
+  private drawArgs: GPUBuffer | null = null; // culled node draw (see gpu-culling.ts)
+  private texture: GPUTexture;
+  private readBuffer: GPUBuffer;
+
+  // Pick camera: projection to the cursor pixel, then the clip-space scale of
+  // one view pixel (screen-sized offsets such as node quads are multiplied by it)
+  private cameraBuffer: GPUBuffer;
+  private cameraData = new Float32Array(20);
+
+  // Latest request (only the newest position is picked), and the one being read back
+  private requested = false;
+  private requestX = 0;
+  private requestY = 0;
+  private encoded = false;
+  private encodedX = 0;
+  private encodedY = 0;
+  private mapping = false;
+
+  /** Receives every completed pick. */
+  onPick: ((result: PickResult) => void) | null = null;
+
+  constructor(device: GPUDevice) {
+    this.device = device;
+
+    const shaderModule = device.createShaderModule({
+      label: 'node-pick-shader',
+      code: nodePickShaderCode,
+    });
+
+    const bindGroupLayout = device.createBindGroupLayout({
+      label: 'node-pick-bind-group-layout',
+      entries: [
+        { binding: 0, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },           // pick camera
+        { binding: 1, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } }, // positions
+        { binding: 2, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } }, // metadata
+        { binding: 3, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },           // render params
+        { binding: 4, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } }, // node weights
+        { binding: 5, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } }, // visible nodes
+      ],
+    });
+
+    this.pipeline = device.createRenderPipeline({
+      label: 'node-pick-pipeline',
+      layout: device.createPipelineLayout({
+        label: 'node-pick-pipeline-layout',
+        bindGroupLayouts: [bindGroupLayout],
+      }),
+      vertex: { module: shaderModule, entryPoint: 'vs_main' },
+      fragment: {
+        module: shaderModule,
+        entryPoint: 'fs_main',
+        targets: [{ format: PICK_FORMAT, writeMask: GPUColorWrite.RED }],
+      },
+      primitive: { topology: 'triangle-list' },
+    });
+
+    this.texture = device.createTexture({
+      label: 'pick-texture',
+      size: [1, 1],
+      format: PICK_FORMAT,
+      usage: GPUTextureUsage.RENDER_ATTACHMENT | GPUTextureUsage.COPY_SRC,
+    });
+    this.cameraBuffer = device.createBuffer({
+      label: 'pick-camera',
+      size: this.cameraData.byteLength,
+      usage: GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+    });
+
+    // One texel (8 bytes) per pick; texture copies pad rows to 256 bytes
+    this.readBuffer = device.createBuffer({
+      label: 'pick-read-buffer',
+      size: 256,
+      usage: GPUBufferUsage.MAP_READ | GPUBufferUsage.COPY_DST,
+    });
+  }
+
+  /**
+   * Bind the node buffers the pick pass reads, including the culled draw list
+   * and its indirect arguments; call again after any of them is replaced.
+   */
+  setNodeBuffers(
+    positions: GPUBuffer, metadata: GPUBuffer, params: GPUBuffer, weights: GPUBuffer,
+    visible: GPUBuffer, drawArgs: GPUBuffer,
+  ): void {
+    this.drawArgs = drawArgs;
+    this.bindGroup = this.device.createBindGroup({
+      label: 'node-pick-bind-group',
+      layout: this.pipeline.getBindGroupLayout(0),
+      entries: [
+        { binding: 0, resource: { buffer: this.cameraBuffer } },
+        { binding: 1, resource: { buffer: positions } },
+        { binding: 2, resource: { buffer: metadata } },
+        { binding: 3, resource: { buffer: params } },
+        { binding: 4, resource: { buffer: weights } },
+        { binding: 5, resource: { buffer: visible } },
+      ],
+    });
+  }
+
+  /** Pick at CSS pixel (screenX, screenY) on the next frame; supersedes an earlier request. */
+  request(screenX: number, screenY: number): void {
+    this.requested = true;
+    this.requestX = screenX;
+    this.requestY = screenY;
+  }
+
+  /**
+   * Encode the pick pass for the pending request, if any and the read buffer
+   * is free: hyperedges through `drawEdges` (pipelines targeting PICK_FORMAT,
+   * writing green, bound to the given pick camera in place of their own),
+   * then the culled nodes (none when `nodeCount` is 0), for the cursor pixel
+   * of a `width`×`height` view of `camera`. Call `readback` once the encoder
+   * is submitted.
+   */
+  encode(
+    encoder: GPUCommandEncoder,
+    camera: Camera,
+    width: number,
+    height: number,
+    nodeCount: number,
+    drawEdges: (pass: GPURenderPassEncoder, pickCamera: GPUBuffer) => void,
+  ): void {
+    if (!this.requested || this.mapping || this.encoded) return;
+    this.requested = false;
+
+    const dpr = window.devicePixelRatio || 1;
+    const px = Math.min(Math.max(Math.floor(this.requestX * dpr), 0), width - 1);
+    const py = Math.min(Math.max(Math.floor(this.requestY * dpr), 0), height - 1);
+    this.writeCamera(camera.getProjection(), px, py, width, height);
+
+    const pass = encoder.beginRenderPass({
+      label: 'pick',
+      colorAttachments: [{
+        view: this.texture.createView(),
+        clearValue: { r: 0, g: 0, b: 0, a: 0 },
+        loadOp: 'clear',
+        storeOp: 'store',
+      }],
+    });
+    drawEdges(pass, this.cameraBuffer);
+    if (this.bindGroup && this.drawArgs && nodeCount > 0) {
+      pass.setPipeline(this.pipeline);
+      pass.setBindGroup(0, this.bindGroup);
+      pass.drawIndirect(this.drawArgs, 0);
+    }
+    pass.end();
+
+    encoder.copyTextureToBuffer(
+      { texture: this.texture },
+      { buffer: this.readBuffer, bytesPerRow: 256 },
+      [1, 1, 1],
+    );
+    this.encoded = true;
+    this.encodedX = this.requestX;
+    this.encodedY = this.requestY;
+  }
+
+  /** Map the texel copied by `encode` (after submit) and hand it to `onPick`. */
+  async readback(): Promise<void> {
+    if (!this.encoded || this.mapping) return;
+    this.encoded = false;
+    this.mapping = true;
+    const screenX = this.encodedX;
+    const screenY = this.encodedY;
+    try {
+      await this.readBuffer.mapAsync(GPUMapMode.READ, 0, 8);
+      const ids = new Uint32Array(this.readBuffer.getMappedRange(0, 8));
+      const node = ids[0] > 0 ? ids[0] - 1 : null;
+      const edge = ids[1] > 0 ? ids[1] - 1 : null;
+      this.readBuffer.unmap();
+      this.onPick?.({ node, edge, screenX, screenY });
+    } catch {
+      // mapAsync fails if the device is lost; the pick is dropped
+    } finally {
+      this.mapping = false;
+    }
+  }
+
+  /**
+   * Scale clip space about the center of pixel (px, py) so that the pixel
+   * covers the 1×1 target: x' = width·(x − cx·w), y' = height·(y − cy·w).
+   */
+  private writeCamera(projection: Float32Array, px: number, py: number, width: number, height: number): void {
+    const cx = (2 * (px + 0.5)) / width - 1;
+    const cy = 1 - (2 * (py + 0.5)) / height;
+    const m = this.cameraData;
+    for (let c = 0; c < 4; c++) {
+      const k = c * 4; // column-major
+      m[k] = width * (projection[k] - cx * projection[k + 3]);
+      m[k + 1] = height * (projection[k + 1] - cy * projection[k + 3]);
+      m[k + 2] = projection[k + 2];
+      m[k + 3] = projection[k + 3];
+    }
+    m[16] = width;
+    m[17] = height;
+    this.device.queue.writeBuffer(this.cameraBuffer, 0, m);
+  }
+
+  destroy(): void {
+    this.texture.destroy();
+    this.cameraBuffer.destroy();
+    this.readBuffer.destroy();
+    this.bindGroup = null;
+    this.drawArgs = null;
+  }
+}
@@ -9,6 +9,9 @@ export interface NodeDragCallbacks {
   onHoverNode?(nodeIndex: number | null, screenX: number, screenY: number): void;
   hitTestEdge?(worldX: number, worldY: number): number | null;
   onHoverEdge?(edgeIndex: number | null, screenX: number, screenY: number): void;
+  // Asynchronous picking: when set, hover and press ask for a pick at a CSS
+  // pixel instead of calling the hit tests, answered through `applyPick`
+  requestPick?(screenX: number, screenY: number): void;
 }
 
 export class InputHandler {
@@ -19,6 +22,12 @@ export class InputHandler {
   private nodeDrag: NodeDragCallbacks | null;
   private mousedownPos: { x: number; y: number } | null = null;
   private mousedownNodeIndex: number | null = null;
+  // Press waiting for its pick (requestPick): where, and whether it was already released
+  private pressPending = false;
+  private pressX = 0;
+  private pressY = 0;
+  private pressReleased = false;
+  private pressWasClick = false;
   private lastTouchDist = 0;
   private lastTouchCenter: [number, number] = [0, 0];
   private boundHandlers: Array<[string, EventListener, EventListenerOptions?]> = [];
@@ -45,32 +54,38 @@ export class InputHandler {
     on('mousedown', (e: MouseEvent) => {
       if (e.button === 0) {
         this.mousedownPos = { x: e.offsetX, y: e.offsetY };
+        if (this.nodeDrag?.requestPick) {
+          // Node drag or pan is decided once the pick under the press is back
+          this.pressPending = true;
+          this.pressX = e.offsetX;
+          this.pressY = e.offsetY;
+          this.pressReleased = false;
+          this.nodeDrag.requestPick(e.offsetX, e.offsetY);
+          return;
+        }
         // Try node hit test first
+        let nodeIndex: number | null = null;
         if (this.nodeDrag) {
           const dpr = window.devicePixelRatio || 1;
           const [wx, wy] = this.camera.screenToWorld(e.offsetX * dpr, e.offsetY * dpr);
-          const nodeIndex = this.nodeDrag.hitTest(wx, wy);
-          if (nodeIndex !== null) {
-            this.draggedNode = nodeIndex;
-            this.mousedownNodeIndex = nodeIndex;
-            this.nodeDrag.onDragStart(nodeIndex);
-            this.canvas.style.cursor = 'grabbing';
-            return;
-          }
+          nodeIndex = this.nodeDrag.hitTest(wx, wy);
         }
-        this.mousedownNodeIndex = null;
-        this.dragging = true;
+        this.beginPress(nodeIndex);
       }
     });
 
     on('mousemove', (e: MouseEvent) => {
-      if (this.draggedNode !== null && this.nodeDrag) {
+      if (this.pressPending) {
+        return; // neither dragging nor panning until the press is resolved
+      } else if (this.draggedNode !== null && this.nodeDrag) {
         const dpr = window.devicePixelRatio || 1;
         const [wx, wy] = this.camera.screenToWorld(e.offsetX * dpr, e.offsetY * dpr);
         this.nodeDrag.onDrag(this.draggedNode, wx, wy);
       } else if (this.dragging) {
         const dpr = window.devicePixelRatio || 1;
         this.camera.pan(e.movementX * dpr, e.movementY * dpr);
+      } else if (this.nodeDrag?.requestPick) {
+        this.nodeDrag.requestPick(e.offsetX, e.offsetY);
       } else if (this.nodeDrag) {
         // Hover cursor feedback
         const dpr = window.devicePixelRatio || 1;
@@ -96,7 +111,11 @@ export class InputHandler {
         Math.abs(e.offsetX - this.mousedownPos.x) < 4 &&
         Math.abs(e.offsetY - this.mousedownPos.y) < 4;
 
-      if (this.draggedNode !== null && this.nodeDrag) {
+      if (this.pressPending) {
+        // Released before the press's pick came back: settled in applyPick
+        this.pressReleased = true;
+        this.pressWasClick = isClick;
+      } else if (this.draggedNode !== null && this.nodeDrag) {
         this.nodeDrag.onDragEnd(this.draggedNode);
         if (isClick) {
           this.nodeDrag.onClick?.(this.mousedownNodeIndex);
@@ -113,6 +132,7 @@ export class InputHandler {
     });
 
     on('mouseleave', () => {
+      this.pressPending = false;
       if (this.draggedNode !== null && this.nodeDrag) {
         this.nodeDrag.onDragEnd(this.draggedNode);
         this.draggedNode = null;
@@ -198,6 +218,59 @@ export class InputHandler {
     return [(a.clientX + b.clientX) / 2, (a.clientY + b.clientY) / 2];
   }
 
+  /** Start a press on `nodeIndex` (node drag) or on empty space (pan). */
+  private beginPress(nodeIndex: number | null): void {
+    this.mousedownNodeIndex = nodeIndex;
+    if (nodeIndex !== null && this.nodeDrag) {
+      this.draggedNode = nodeIndex;
+      this.nodeDrag.onDragStart(nodeIndex);
+      this.canvas.style.cursor = 'grabbing';
+    } else {
+      this.dragging = true;
+    }
+  }
+
+  /**
+   * Answer a `requestPick` at CSS pixel (screenX, screenY) with the node and
+   * top-most hyperedge found there. Settles a pending press (drag, pan or
+   * click); otherwise gives hover feedback as for a synchronous hit test,
+   * unless a drag or pan is in progress.
+   */
+  applyPick(node: number | null, edge: number | null, screenX: number, screenY: number): void {
+    if (!this.nodeDrag) return;
+    if (this.pressPending) {
+      if (screenX !== this.pressX || screenY !== this.pressY) return; // a hover pick from before the press
+      this.pressPending = false;
+      if (!this.pressReleased) {
+        this.beginPress(node);
+      } else if (this.pressWasClick) {
+        this.nodeDrag.onClick?.(node);
+      }
+      return;
+    }
+    if (this.draggedNode !== null || this.dragging) return;
+
+    if (node !== null) {
+      this.canvas.style.cursor = 'grab';
+      this.nodeDrag.onHoverNode?.(node, screenX, screenY);
+      this.nodeDrag.onHoverEdge?.(null, screenX, screenY);
+    } else {
+      this.nodeDrag.onHoverNode?.(null, screenX, screenY);
+      this.canvas.style.cursor = edge !== null ? 'pointer' : '';
+      this.nodeDrag.onHoverEdge?.(edge, screenX, screenY);
+    }
+  }
+
+  /** Abandon an in-progress node drag without firing onDragEnd (e.g. node indices changed). */
+  cancelDrag(): void {
+    this.pressPending = false;
+    if (this.draggedNode === null) return;
+    this.draggedNode = null;
+    this.mousedownNodeIndex = null;
+    this.dragging = false;
+    this.canvas.style.cursor = '';
+  }
+
   dispose(): void {
     for (const [type, handler, opts] of this.boundHandlers) {
       this.canvas.removeEventListener(type, handler, opts);
@@ -0,0 +1,74 @@
+/**
+ * Main-thread side of the spatial index: each refresh of the CPU position
+ * cache is snapshotted and bucketed in a long-lived worker
+ * (src/interaction/spatial-index-worker.ts), so rebuilding the index for
+ * millions of nodes never stalls rendering. At most one build is in flight;
+ * a newer snapshot requested meanwhile replaces any queued one.
+ */
+import SpatialIndexWorker from './spatial-index-worker?worker&inline';
+import { SpatialIndex, type SpatialGrid } from './spatial-index';
+
+export interface SpatialIndexRequest {
+  positions: Float32Array; // [x, y, vx, vy] per node (a snapshot is transferred)
+  count: number;
+  epoch: number;
+}
+
+export type SpatialIndexResponse =
+  | { type: 'grid'; grid: SpatialGrid; epoch: number }
+  | { type: 'error'; message: string; epoch: number };
+
+export class SpatialIndexBuilder {
+  private worker: Worker | null = null;
+  private busy = false;
+  private queued: SpatialIndexRequest | null = null;
+
+  /** Receives each finished index with the epoch it was requested under. */
+  onIndex: ((index: SpatialIndex, epoch: number) => void) | null = null;
+
+  /** Index the first `count` nodes of `positions` (snapshotted when posted, so the caller keeps its array). */
+  build(positions: Float32Array, count: number, epoch: number): void {
+    const request = { positions, count, epoch };
+    if (this.busy) {
+      this.queued = request;
+      return;
+    }
+    this.post(request);
+  }
+
+  private post({ positions, count, epoch }: SpatialIndexRequest): void {
+    if (!this.worker) {
+      this.worker = new SpatialIndexWorker();
+      this.worker.onmessage = (event: MessageEvent<SpatialIndexResponse>) => {
+        const response = event.data;
+        if (response.type === 'grid') this.onIndex?.(new SpatialIndex(response.grid), response.epoch);
+        else console.warn('Spatial index build failed:', response.message);
+        this.next();
+      };
+      this.worker.onerror = (event) => {
+        console.warn('Spatial index worker failed:', event.message);
+        this.worker?.terminate();
+        this.worker = null;
+        this.next();
+      };
+    }
+    this.busy = true;
+    const snapshot = positions.slice(0, count * 4);
+    this.worker.postMessage({ positions: snapshot, count, epoch }, [snapshot.buffer]);
+  }
+
+  private next(): void {
+    this.busy = false;
+    const queued = this.queued;
+    this.queued = null;
+    if (queued) this.post(queued);
+  }
+
+  dispose(): void {
+    this.worker?.terminate();
+    this.worker = null;
+    this.queued = null;
+    this.busy = false;
+    this.onIndex = null;
+  }
+}
@@ -0,0 +1,17 @@
+// Spatial index worker: buckets a positions snapshot into a uniform grid and transfers it back.
+import { buildSpatialGrid } from './spatial-index';
+import type { SpatialIndexRequest, SpatialIndexResponse } from './spatial-index-pipeline';
+
+function reply(message: SpatialIndexResponse, transfer: Transferable[] = []): void {
+  self.postMessage(message, { transfer });
+}
+
+self.onmessage = (event: MessageEvent<SpatialIndexRequest>) => {
+  const { positions, count, epoch } = event.data;
+  try {
+    const grid = buildSpatialGrid(positions, count);
+    reply({ type: 'grid', grid, epoch }, [grid.cellStart.buffer, grid.items.buffer, grid.coords.buffer]);
+  } catch (err) {
+    reply({ type: 'error', message: err instanceof Error ? err.message : String(err), epoch });
+  }
+};
@@ -0,0 +1,209 @@
+/**
+ * Uniform-grid spatial index over node positions ([x, y, vx, vy] per node)
+ * for range and nearest-neighbour queries: lasso / rectangle selection,
+ * "nodes within radius", label placement. Nodes are counting-sorted into
+ * about one cell per two nodes over their bounds (CSR: `cellStart` per cell,
+ * node indices and coordinates in cell order), so a query touches only the
+ * cells it overlaps. The grid is plain typed arrays, built in a worker by
+ * src/interaction/spatial-index-worker.ts and transferred back.
+ */
+
+export interface SpatialGrid {
+  count: number;           // nodes indexed
+  minX: number;            // grid origin
+  minY: number;
+  cellSize: number;
+  cols: number;
+  rows: number;
+  cellStart: Uint32Array;  // cols × rows + 1 offsets into items / coords
+  items: Uint32Array;      // node indices, in cell order
+  coords: Float32Array;    // x, y per item
+}
+
+const NODES_PER_CELL = 2;
+const MAX_CELLS_PER_AXIS = 4096;
+
+/** Bucket the first `count` nodes of `positions` into a uniform grid. O(n). */
+export function buildSpatialGrid(positions: Float32Array, count: number): SpatialGrid {
+  let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+  for (let i = 0; i < count; i++) {
+    const x = positions[i * 4];
+    const y = positions[i * 4 + 1];
+    if (!Number.isFinite(x) || !Number.isFinite(y)) continue;
+    if (x < minX) minX = x;
+    if (y < minY) minY = y;
+    if (x > maxX) maxX = x;
+    if (y > maxY) maxY = y;
+  }
+  if (!(minX <= maxX && minY <= maxY)) {
+    minX = minY = maxX = maxY = 0; // no (finite) positions
+  }
+
+  // Square cells: about NODES_PER_CELL nodes each when spread evenly, with
+  // a bounded axis for degenerate (collinear) layouts
+  const width = maxX - minX;
+  const height = maxY - minY;
+  const targetCells = Math.max(count / NODES_PER_CELL, 1);
+  const cellSize = Math.max(
+    Math.sqrt((width * height) / targetCells),
+    Math.max(width, height) / MAX_CELLS_PER_AXIS,
+    1e-6,
+  );
+  const cols = Math.min(Math.floor(width / cellSize) + 1, MAX_CELLS_PER_AXIS);
+  const rows = Math.min(Math.floor(height / cellSize) + 1, MAX_CELLS_PER_AXIS);
+
+  const grid: SpatialGrid = {
+    count, minX, minY, cellSize, cols, rows,
+    cellStart: new Uint32Array(cols * rows + 1),
+    items: new Uint32Array(count),
+    coords: new Float32Array(count * 2),
+  };
+
+  // Counting sort by cell
+  const cellOf = new Uint32Array(count);
+  const { cellStart } = grid;
+  for (let i = 0; i < count; i++) {
+    const c = cellIndex(grid, positions[i * 4], positions[i * 4 + 1]);
+    cellOf[i] = c;
+    cellStart[c + 1]++;
+  }
+  for (let c = 0; c < cols * rows; c++) cellStart[c + 1] += cellStart[c];
+  const fill = cellStart.slice(0, cols * rows);
+  for (let i = 0; i < count; i++) {
+    const slot = fill[cellOf[i]]++;
+    grid.items[slot] = i;
+    grid.coords[slot * 2] = positions[i * 4];
+    grid.coords[slot * 2 + 1] = positions[i * 4 + 1];
+  }
+  return grid;
+}
+
+/** Cell holding (x, y), clamped to the grid (NaN lands in cell 0, where no query matches it). */
+function cellIndex(grid: SpatialGrid, x: number, y: number): number {
+  return cellRow(grid, y) * grid.cols + cellCol(grid, x);
+}
+
+function cellCol(grid: SpatialGrid, x: number): number {
+  return Math.min(Math.max(Math.floor((x - grid.minX) / grid.cellSize), 0), grid.cols - 1) | 0;
+}
+
+function cellRow(grid: SpatialGrid, y: number): number {
+  return Math.min(Math.max(Math.floor((y - grid.minY) / grid.cellSize), 0), grid.rows - 1) | 0;
+}
+
+export class SpatialIndex {
+  readonly grid: SpatialGrid;
+
+  // Grow-only k-nearest candidates, sorted by distance
+  private bestIndex = new Uint32Array(0);
+  private bestDistSq = new Float64Array(0);
+
+  constructor(grid: SpatialGrid) {
+    this.grid = grid;
+  }
+
+  static fromPositions(positions: Float32Array, count: number): SpatialIndex {
+    return new SpatialIndex(buildSpatialGrid(positions, count));
+  }
+
+  get count(): number { return this.grid.count; }
+
+  /** Nodes with minX ≤ x ≤ maxX and minY ≤ y ≤ maxY, appended to `out`. */
+  queryRect(minX: number, minY: number, maxX: number, maxY: number, out: number[] = []): number[] {
+    const grid = this.grid;
+    if (grid.count === 0 || !(minX <= maxX && minY <= maxY)) return out;
+    const { cellStart, items, coords } = grid;
+    const c0 = cellCol(grid, minX), c1 = cellCol(grid, maxX);
+    const r0 = cellRow(grid, minY), r1 = cellRow(grid, maxY);
+    for (let r = r0; r <= r1; r++) {
+      for (let c = c0; c <= c1; c++) {
+        const cell = r * grid.cols + c;
+        for (let k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+          const x = coords[k * 2], y = coords[k * 2 + 1];
+          if (x >= minX && x <= maxX && y >= minY && y <= maxY) out.push(items[k]);
+        }
+      }
+    }
+    return out;
+  }
+
+  /** Nodes within `radius` of (x, y), appended to `out`. */
+  queryRadius(x: number, y: number, radius: number, out: number[] = []): number[] {
+    const grid = this.grid;
+    if (grid.count === 0 || !(radius >= 0)) return out;
+    const { cellStart, items, coords } = grid;
+    const rSq = radius * radius;
+    const c0 = cellCol(grid, x - radius), c1 = cellCol(grid, x + radius);
+    const r0 = cellRow(grid, y - radius), r1 = cellRow(grid, y + radius);
+    for (let r = r0; r <= r1; r++) {
+      for (let c = c0; c <= c1; c++) {
+        const cell = r * grid.cols + c;
+        for (let k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+          const dx = coords[k * 2] - x, dy = coords[k * 2 + 1] - y;
+          if (dx * dx + dy * dy <= rSq) out.push(items[k]);
+        }
+      }
+    }
+    return out;
+  }
+
+  /**
+   * The `k` nodes nearest (x, y), closest first, at most `maxDistance` away.
+   * Searches rings of cells outward from the query's cell until no unvisited
+   * cell can hold a closer node.
+   */
+  nearest(x: number, y: number, k = 1, maxDistance = Infinity): number[] {
+    const grid = this.grid;
+    k = Math.min(Math.floor(k), grid.count);
+    if (k <= 0 || !(maxDistance >= 0) || Number.isNaN(x) || Number.isNaN(y)) return [];
+    if (this.bestIndex.length < k) {
+      this.bestIndex = new Uint32Array(k);
+      this.bestDistSq = new Float64Array(k);
+    }
+    const { cellStart, items, coords, cols, rows, cellSize, minX, minY } = grid;
+    const bestIndex = this.bestIndex;
+    const bestDistSq = this.bestDistSq;
+    const limitSq = maxDistance * maxDistance;
+    let found = 0;
+
+    const cx = cellCol(grid, x);
+    const cy = cellRow(grid, y);
+    for (let ring = 0; ; ring++) {
+      const r0 = cy - ring, r1 = cy + ring;
+      const c0 = cx - ring, c1 = cx + ring;
+      for (let r = Math.max(r0, 0); r <= Math.min(r1, rows - 1); r++) {
+        // Interior rows of the ring only have its two side cells
+        const step = r === r0 || r === r1 ? 1 : Math.max(c1 - c0, 1);
+        for (let c = c0; c <= c1; c += step) {
+          if (c < 0 || c >= cols) continue;
+          const cell = r * cols + c;
+          for (let i = cellStart[cell]; i < cellStart[cell + 1]; i++) {
+            const dx = coords[i * 2] - x, dy = coords[i * 2 + 1] - y;
+            const dSq = dx * dx + dy * dy;
+            if (!(dSq <= limitSq) || (found === k && dSq >= bestDistSq[k - 1])) continue;
+            // Insertion into the sorted candidates
+            let j = found < k ? found++ : k - 1;
+            while (j > 0 && bestDistSq[j - 1] > dSq) {
+              bestDistSq[j] = bestDistSq[j - 1];
+              bestIndex[j] = bestIndex[j - 1];
+              j--;
+            }
+            bestDistSq[j] = dSq;
+            bestIndex[j] = items[i];
+          }
+        }
+      }
+
+      // Cells outside the searched square lie beyond one of its sides that
+      // has not reached the grid border, so at least this far away
+      let bound = Infinity;
+      if (c0 > 0) bound = Math.min(bound, Math.max(x - (minX + c0 * cellSize), 0));
+      if (c1 < cols - 1) bound = Math.min(bound, Math.max(minX + (c1 + 1) * cellSize - x, 0));
+      if (r0 > 0) bound = Math.min(bound, Math.max(y - (minY + r0 * cellSize), 0));
+      if (r1 < rows - 1) bound = Math.min(bound, Math.max(minY + (r1 + 1) * cellSize - y, 0));
+      if (bound === Infinity || bound * bound > limitSq) break; // whole grid searched, or out of range
+      if (found === k && bound * bound >= bestDistSq[k - 1]) break;
+    }
+    return Array.from(bestIndex.subarray(0, found));
+  }
+}
@@ -0,0 +1,262 @@
+/**
+ * CPU reference for the GPU Barnes-Hut pipeline (morton.wgsl → radix sort →
+ * quadtree-build/summarize.wgsl → force-repulsion.wgsl).
+ *
+ * Mirrors the GPU tree exactly — same Morton quantization, same complete
+ * 4-ary layout over sorted leaves, same opening criterion — so force error
+ * and traversal cost measured here carry over to the shaders. Also provides
+ * the O(n²) exact sum the approximation is measured against. Used by unit
+ * tests and scripts/bh-sweep.ts; not on the runtime path.
+ */
+
+/** Floats per tree node — must match quadtree-build/summarize.wgsl. */
+export const TREE_STRIDE = 12;
+// [0] com_x  [1] com_y  [2] mass  [3] cell_size  [4] node_index (-1 = internal)
+// [5] child_mask  [6] min_x  [7] min_y  [8] sxx  [9] sxy  [10] syy  [11] pad
+// s** are second moments of mass about the COM (zero for leaves).
+
+export interface TreeLayout {
+  numLevels: number;
+  leafOffset: number;
+  treeSize: number;
+}
+
+/** Complete 4-ary tree with at least `nodeCount` leaves (shared with GPUQuadtree). */
+export function treeLayout(nodeCount: number): TreeLayout {
+  let levels = 1;
+  let leafCapacity = 1;
+  while (leafCapacity < nodeCount) {
+    levels++;
+    leafCapacity *= 4;
+  }
+  if (levels === 1) {
+    return { numLevels: 1, leafOffset: 0, treeSize: Math.max(nodeCount, 1) };
+  }
+  // Internal nodes (levels 0 to L-2): (4^(L-1) - 1) / 3
+  const leafOffset = (leafCapacity - 1) / 3;
+  return { numLevels: levels, leafOffset, treeSize: leafOffset + leafCapacity };
+}
+
+function expandBits(v: number): number {
+  v &= 0xFFFF;
+  v = (v | (v << 8)) & 0x00FF00FF;
+  v = (v | (v << 4)) & 0x0F0F0F0F;
+  v = (v | (v << 2)) & 0x33333333;
+  v = (v | (v << 1)) & 0x55555555;
+  return v >>> 0;
+}
+
+/** Node indices in Morton order over the given bounds (stable, like the GPU sort). */
+export function mortonOrder(
+  positions: Float32Array, nodeCount: number,
+  minX: number, minY: number, maxX: number, maxY: number,
+): Uint32Array {
+  const codes = new Uint32Array(nodeCount);
+  const rangeX = maxX - minX;
+  const rangeY = maxY - minY;
+  for (let i = 0; i < nodeCount; i++) {
+    const nx = rangeX > 1e-10 ? Math.min(Math.max((positions[i * 4] - minX) / rangeX, 0), 1) : 0.5;
+    const ny = rangeY > 1e-10 ? Math.min(Math.max((positions[i * 4 + 1] - minY) / rangeY, 0), 1) : 0.5;
+    codes[i] = (expandBits(Math.floor(nx * 65535)) | (expandBits(Math.floor(ny * 65535)) << 1)) >>> 0;
+  }
+  const order = new Uint32Array(nodeCount);
+  for (let i = 0; i < nodeCount; i++) order[i] = i;
+  // Array.prototype.sort is stable; ties keep index order like the LSD radix sort
+  return Uint32Array.from(Array.from(order).sort((a, b) => codes[a] - codes[b]));
+}
+
+/** Build + summarize the tree for `positions` ([x, y, vx, vy] per node); leaf mass is the node weight (default 1). */
+export function buildQuadtree(
+  positions: Float32Array, nodeCount: number, weights?: Float32Array,
+): { tree: Float64Array; layout: TreeLayout } {
+  let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+  for (let i = 0; i < nodeCount; i++) {
+    minX = Math.min(minX, positions[i * 4]);
+    maxX = Math.max(maxX, positions[i * 4]);
+    minY = Math.min(minY, positions[i * 4 + 1]);
+    maxY = Math.max(maxY, positions[i * 4 + 1]);
+  }
+  const order = mortonOrder(positions, nodeCount, minX, minY, maxX, maxY);
+  const layout = treeLayout(nodeCount);
+  const tree = new Float64Array(layout.treeSize * TREE_STRIDE);
+
+  // Leaves (quadtree-build.wgsl)
+  for (let t = 0; t < nodeCount; t++) {
+    const node = order[t];
+    const b = (layout.leafOffset + t) * TREE_STRIDE;
+    tree[b + 0] = positions[node * 4];
+    tree[b + 1] = positions[node * 4 + 1];
+    tree[b + 2] = weights ? weights[node] : 1;
+    tree[b + 4] = node;
+    tree[b + 6] = positions[node * 4];
+    tree[b + 7] = positions[node * 4 + 1];
+  }
+
+  // Internal nodes bottom-up, level by level (quadtree-summarize.wgsl)
+  for (let level = layout.numLevels - 2; level >= 0; level--) {
+    const count = 4 ** level;
+    const start = (count - 1) / 3;
+    for (let node = start; node < start + count; node++) {
+      summarizeNode(tree, node, layout.treeSize);
+    }
+  }
+  return { tree, layout };
+}
+
+function summarizeNode(tree: Float64Array, node: number, treeSize: number): void {
+  const first = 4 * node + 1;
+  let mass = 0, comX = 0, comY = 0, mask = 0;
+  let minX = 1e20, minY = 1e20, maxX = -1e20, maxY = -1e20;
+  for (let c = 0; c < 4; c++) {
+    const child = first + c;
+    if (child >= treeSize) continue;
+    const b = child * TREE_STRIDE;
+    const m = tree[b + 2];
+    if (m <= 0) continue;
+    mask |= 1 << c;
+    comX += tree[b] * m;
+    comY += tree[b + 1] * m;
+    mass += m;
+    minX = Math.min(minX, tree[b + 6]);
+    minY = Math.min(minY, tree[b + 7]);
+    maxX = Math.max(maxX, tree[b + 6] + tree[b + 3]);
+    maxY = Math.max(maxY, tree[b + 7] + tree[b + 3]);
+  }
+  if (mass > 0) {
+    comX /= mass;
+    comY /= mass;
+  }
+
+  // Parallel-axis theorem: child moments shifted to the parent COM
+  let sxx = 0, sxy = 0, syy = 0;
+  for (let c = 0; c < 4; c++) {
+    if ((mask & (1 << c)) === 0) continue;
+    const b = (first + c) * TREE_STRIDE;
+    const m = tree[b + 2];
+    const dx = tree[b] - comX;
+    const dy = tree[b + 1] - comY;
+    sxx += tree[b + 8] + m * dx * dx;
+    sxy += tree[b + 9] + m * dx * dy;
+    syy += tree[b + 10] + m * dy * dy;
+  }
+
+  const b = node * TREE_STRIDE;
+  tree[b + 0] = comX;
+  tree[b + 1] = comY;
+  tree[b + 2] = mass;
+  tree[b + 3] = Math.max(maxX - minX, maxY - minY);
+  tree[b + 4] = -1;
+  tree[b + 5] = mask;
+  tree[b + 6] = mass > 0 ? minX : 0;
+  tree[b + 7] = mass > 0 ? minY : 0;
+  tree[b + 8] = sxx;
+  tree[b + 9] = sxy;
+  tree[b + 10] = syy;
+}
+
+/**
+ * Barnes-Hut repulsion per node (force-repulsion.wgsl with strength 1).
+ * `quadrupole` adds the second-order far-field term. `visits` counts tree
+ * nodes with mass that were popped — the per-thread traversal cost.
+ */
+export function repulsionBarnesHut(
+  tree: Float64Array, layout: TreeLayout,
+  positions: Float32Array, nodeCount: number,
+  theta: number, quadrupole: boolean,
+): { forces: Float64Array; visits: number } {
+  const forces = new Float64Array(nodeCount * 2);
+  const stack: number[] = [];
+  const thetaSq = theta * theta;
+  let visits = 0;
+
+  for (let i = 0; i < nodeCount; i++) {
+    const px = positions[i * 4];
+    const py = positions[i * 4 + 1];
+    let fx = 0, fy = 0;
+    stack.length = 0;
+    stack.push(0);
+
+    while (stack.length > 0) {
+      const node = stack.pop()!;
+      if (node >= layout.treeSize) continue;
+      const b = node * TREE_STRIDE;
+      const mass = tree[b + 2];
+      if (mass <= 0) continue;
+      visits++;
+
+      const dx = px - tree[b];
+      const dy = py - tree[b + 1];
+      const distSq = dx * dx + dy * dy;
+      const cellSize = tree[b + 3];
+
+      if (tree[b + 4] >= 0) {
+        if (tree[b + 4] === i) continue;
+        const dist = Math.max(Math.sqrt(distSq), 1);
+        const f = mass / (dist * dist * dist);
+        fx += dx * f;
+        fy += dy * f;
+        continue;
+      }
+
+      if (cellSize * cellSize < thetaSq * distSq) {
+        const dist = Math.max(Math.sqrt(distSq), 1);
+        const invD2 = 1 / (dist * dist);
+        const invD3 = invD2 / dist;
+        fx += dx * mass * invD3;
+        fy += dy * mass * invD3;
+        if (quadrupole) {
+          const sxx = tree[b + 8], sxy = tree[b + 9], syy = tree[b + 10];
+          const srx = sxx * dx + sxy * dy;
+          const sry = sxy * dx + syy * dy;
+          const rsr = dx * srx + dy * sry;
+          const invD5 = invD3 * invD2;
+          const radial = 7.5 * rsr * invD5 * invD2 - 1.5 * (sxx + syy) * invD5;
+          fx += dx * radial - 3 * srx * invD5;
+          fy += dy * radial - 3 * sry * invD5;
+        }
+      } else {
+        const mask = tree[b + 5];
+        for (let c = 0; c < 4; c++) {
+          if ((mask & (1 << c)) !== 0) stack.push(4 * node + 1 + c);
+        }
+      }
+    }
+    forces[i * 2] = fx;
+    forces[i * 2 + 1] = fy;
+  }
+  return { forces, visits };
+}
+
+/** O(n²) reference: every pair, same kernel and distance clamp as the shader. */
+export function repulsionExact(positions: Float32Array, nodeCount: number): Float64Array {
+  const forces = new Float64Array(nodeCount * 2);
+  for (let i = 0; i < nodeCount; i++) {
+    const px = positions[i * 4];
+    const py = positions[i * 4 + 1];
+    let fx = 0, fy = 0;
+    for (let j = 0; j < nodeCount; j++) {
+      if (j === i) continue;
+      const dx = px - positions[j * 4];
+      const dy = py - positions[j * 4 + 1];
+      const dist = Math.max(Math.sqrt(dx * dx + dy * dy), 1);
+      const f = 1 / (dist * dist * dist);
+      fx += dx * f;
+      fy += dy * f;
+    }
+    forces[i * 2] = fx;
+    forces[i * 2 + 1] = fy;
+  }
+  return forces;
+}
+
+/** RMS force error relative to the RMS reference force magnitude. */
+export function relativeForceError(approx: Float64Array, exact: Float64Array): number {
+  let err = 0;
+  let ref = 0;
+  for (let k = 0; k < exact.length; k++) {
+    const d = approx[k] - exact[k];
+    err += d * d;
+    ref += exact[k] * exact[k];
+  }
+  return ref > 0 ? Math.sqrt(err / ref) : 0;
+}
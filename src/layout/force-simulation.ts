@@ -1,13 +1,17 @@
 import type { BufferManager } from '../gpu/buffer-manager';
-import type { HypergraphData, SimulationParams } from '../data/types';
+import type { SimulationParams } from '../data/types';
 import type { GPUProfiler } from '../gpu/gpu-profiler';
 import { RadixSort } from './radix-sort';
 import { GPUQuadtree } from './quadtree';
+import { getPipelineCache } from '../gpu/pipeline-cache';
+import { PIN_FOLLOW } from './node-pins';
 
 import mortonShader from '../shaders/morton.wgsl?raw';
 import forceRepulsionShader from '../shaders/force-repulsion.wgsl?raw';
 import forceAttractionShader from '../shaders/force-attraction.wgsl?raw';
 import forceCenterShader from '../shaders/force-center.wgsl?raw';
+import forceAttractionOrderedShader from '../shaders/force-attraction-ordered.wgsl?raw';
+import forceCenterOrderedShader from '../shaders/force-center-ordered.wgsl?raw';
 import integrateShader from '../shaders/integrate.wgsl?raw';
 
 /**
@@ -23,6 +27,14 @@ import integrateShader from '../shaders/integrate.wgsl?raw';
  * 7. Link attraction — Parallel over edges
  * 8. Center force — Prevents drift
  * 9. Velocity Verlet integration — Update positions with damping
+ *
+ * With `params.deterministic`, attraction and center use ordered reductions
+ * instead of atomics and bounds refreshes stall the tick until the readback
+ * lands, so identical inputs give identical layouts tick for tick.
+ *
+ * Expects the caller to keep the `pin-flags` / `pin-targets` buffers (see
+ * NodePins) and the `node-weights` / `edge-weights` buffers (see GraphWeights)
+ * sized to the graph before construction and setGraphSize.
  */
 export class ForceSimulation {
   private device: GPUDevice;
@@ -43,12 +55,19 @@ export class ForceSimulation {
   private centerApplyPipeline: GPUComputePipeline;
   private integratePipeline: GPUComputePipeline;
 
+  // Deterministic-mode pipelines (ordered reductions, no atomics)
+  private orderedCentroidPipeline: GPUComputePipeline;
+  private orderedGatherPipeline: GPUComputePipeline;
+  private orderedCenterAccumPipeline: GPUComputePipeline;
+  private orderedCenterApplyPipeline: GPUComputePipeline;
+
   // Bind group layouts
   private mortonBGL: GPUBindGroupLayout;
   private repulsionBGL: GPUBindGroupLayout;
   private attractionBGL: GPUBindGroupLayout;
   private centerBGL: GPUBindGroupLayout;
   private integrateBGL: GPUBindGroupLayout;
+  private orderedAttractionBGL: GPUBindGroupLayout;
 
   // Cached bind groups (rebuilt only when buffers change)
   private mortonBindGroup!: GPUBindGroup;
@@ -56,6 +75,7 @@ export class ForceSimulation {
   private attractionBindGroup!: GPUBindGroup;
   private centerBindGroup!: GPUBindGroup;
   private integrateBindGroup!: GPUBindGroup;
+  private orderedAttractionBindGroup: GPUBindGroup | null = null; // null until the node→edge CSR is uploaded
 
   // Pre-allocated param arrays with dual views (zero per-frame allocations)
   private mortonParams = new ArrayBuffer(32);
@@ -85,19 +105,21 @@ export class ForceSimulation {
   private bounds = { minX: -500, minY: -500, maxX: 500, maxY: 500 };
   private boundsFrameCounter = 0;
   private boundsUpdateInterval = 5; // update bounds every N frames
+  private boundsEpoch = 0;            // bumped on reset so stale readbacks are dropped
+  private boundsPending: Promise<void> | null = null;
 
   constructor(
     device: GPUDevice,
     bufferManager: BufferManager,
-    data: HypergraphData,
+    size: { nodeCount: number; edgeCount: number },
     _params: SimulationParams,
     profiler?: GPUProfiler,
     features: ReadonlySet<string> = new Set(),
   ) {
     this.device = device;
     this.bufferManager = bufferManager;
-    this.nodeCount = data.nodes.length;
-    this.edgeCount = data.hyperedges.length;
+    this.nodeCount = size.nodeCount;
+    this.edgeCount = size.edgeCount;
 
     // Allocate work buffers
     this.allocateBuffers();
@@ -109,94 +131,83 @@ export class ForceSimulation {
     this.quadtree = new GPUQuadtree(device, bufferManager, profiler);
     this.quadtree.ensureBuffers(this.nodeCount);
 
-    // Create pipelines
+    // Pipelines come from the per-device cache — compiled once, reused across dataset loads
+    const cache = getPipelineCache(device);
+
     // Morton code pipeline
-    const mortonModule = device.createShaderModule({ label: 'morton-shader', code: mortonShader });
-    this.mortonBGL = device.createBindGroupLayout({
-      label: 'morton-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-    this.mortonPipeline = device.createComputePipeline({
-      label: 'morton-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.mortonBGL] }),
-      compute: { module: mortonModule, entryPoint: 'main' },
-    });
+    const mortonModule = cache.shaderModule('morton-shader', mortonShader);
+    this.mortonBGL = cache.bindGroupLayout('morton-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+    this.mortonPipeline = cache.computePipeline('morton-pipeline', mortonModule, 'main', this.mortonBGL);
 
     // Repulsion pipeline
-    const repulsionModule = device.createShaderModule({ label: 'repulsion-shader', code: forceRepulsionShader });
-    this.repulsionBGL = device.createBindGroupLayout({
-      label: 'repulsion-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-    this.repulsionPipeline = device.createComputePipeline({
-      label: 'repulsion-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.repulsionBGL] }),
-      compute: { module: repulsionModule, entryPoint: 'main' },
-    });
+    const repulsionModule = cache.shaderModule('repulsion-shader', forceRepulsionShader);
+    this.repulsionBGL = cache.bindGroupLayout('repulsion-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+    this.repulsionPipeline = cache.computePipeline('repulsion-pipeline', repulsionModule, 'main', this.repulsionBGL);
 
     // Attraction pipeline
-    const attractionModule = device.createShaderModule({ label: 'attraction-shader', code: forceAttractionShader });
-    this.attractionBGL = device.createBindGroupLayout({
-      label: 'attraction-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-    this.attractionPipeline = device.createComputePipeline({
-      label: 'attraction-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.attractionBGL] }),
-      compute: { module: attractionModule, entryPoint: 'main' },
-    });
+    const attractionModule = cache.shaderModule('attraction-shader', forceAttractionShader);
+    this.attractionBGL = cache.bindGroupLayout('attraction-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+      { binding: 5, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 6, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+    ]);
+    this.attractionPipeline = cache.computePipeline('attraction-pipeline', attractionModule, 'main', this.attractionBGL);
 
     // Center force pipeline (two entry points)
-    const centerModule = device.createShaderModule({ label: 'center-shader', code: forceCenterShader });
-    this.centerBGL = device.createBindGroupLayout({
-      label: 'center-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-    this.centerAccumPipeline = device.createComputePipeline({
-      label: 'center-accum-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.centerBGL] }),
-      compute: { module: centerModule, entryPoint: 'accumulate' },
-    });
-    this.centerApplyPipeline = device.createComputePipeline({
-      label: 'center-apply-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.centerBGL] }),
-      compute: { module: centerModule, entryPoint: 'apply' },
-    });
+    const centerModule = cache.shaderModule('center-shader', forceCenterShader);
+    this.centerBGL = cache.bindGroupLayout('center-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+    this.centerAccumPipeline = cache.computePipeline('center-accum-pipeline', centerModule, 'accumulate', this.centerBGL);
+    this.centerApplyPipeline = cache.computePipeline('center-apply-pipeline', centerModule, 'apply', this.centerBGL);
 
     // Integration pipeline
-    const integrateModule = device.createShaderModule({ label: 'integrate-shader', code: integrateShader });
-    this.integrateBGL = device.createBindGroupLayout({
-      label: 'integrate-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-    this.integratePipeline = device.createComputePipeline({
-      label: 'integrate-pipeline',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.integrateBGL] }),
-      compute: { module: integrateModule, entryPoint: 'main' },
-    });
+    const integrateModule = cache.shaderModule('integrate-shader', integrateShader);
+    this.integrateBGL = cache.bindGroupLayout('integrate-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+    ]);
+    this.integratePipeline = cache.computePipeline('integrate-pipeline', integrateModule, 'main', this.integrateBGL);
+
+    // Deterministic attraction: per-edge centroids, then per-node ordered gather
+    const orderedAttractionModule = cache.shaderModule('attraction-ordered-shader', forceAttractionOrderedShader);
+    this.orderedAttractionBGL = cache.bindGroupLayout('attraction-ordered-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+      { binding: 5, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 6, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 7, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 8, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 9, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+    ]);
+    this.orderedCentroidPipeline = cache.computePipeline('attraction-ordered-centroids', orderedAttractionModule, 'centroids', this.orderedAttractionBGL);
+    this.orderedGatherPipeline = cache.computePipeline('attraction-ordered-gather', orderedAttractionModule, 'gather', this.orderedAttractionBGL);
+
+    // Deterministic center: single-workgroup tree reduction (same bindings as the atomic version)
+    const orderedCenterModule = cache.shaderModule('center-ordered-shader', forceCenterOrderedShader);
+    this.orderedCenterAccumPipeline = cache.computePipeline('center-ordered-accum', orderedCenterModule, 'accumulate', this.centerBGL);
+    this.orderedCenterApplyPipeline = cache.computePipeline('center-ordered-apply', orderedCenterModule, 'apply', this.centerBGL);
 
     // Cache bind groups (all buffers are created and stable)
     this.rebuildBindGroups();
@@ -205,35 +216,37 @@ export class ForceSimulation {
   private allocateBuffers(): void {
     const n = this.nodeCount;
     const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC;
+    const uniform = GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST;
+
+    // Work buffers are pooled: ensureCapacity keeps any existing buffer that is
+    // already large enough (e.g. left by a previous dataset) and grows by size class.
 
     // Morton codes and sorted indices
-    this.bufferManager.createBuffer('morton-codes', n * 4, usage, 'morton-codes');
-    this.bufferManager.createBuffer('sorted-indices', n * 4, usage, 'sorted-indices');
+    this.bufferManager.ensureCapacity('morton-codes', n * 4, usage, 'morton-codes');
+    this.bufferManager.ensureCapacity('sorted-indices', n * 4, usage, 'sorted-indices');
 
     // Morton params uniform
-    this.bufferManager.createBuffer('morton-params', 32,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'morton-params');
+    this.bufferManager.ensureCapacity('morton-params', 32, uniform, 'morton-params');
 
     // Attraction force accumulation buffer (fixed-point, 2 i32 per node)
-    this.bufferManager.createBuffer('attraction-forces', Math.max(n * 8, 4), usage, 'attraction-forces');
+    this.bufferManager.ensureCapacity('attraction-forces', Math.max(n * 8, 4), usage, 'attraction-forces');
 
     // Attraction params uniform
-    this.bufferManager.createBuffer('attraction-params', 32,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'attraction-params');
+    this.bufferManager.ensureCapacity('attraction-params', 32, uniform, 'attraction-params');
+
+    // Per-hyperedge centroids for the deterministic attraction gather (vec2 f32)
+    this.bufferManager.ensureCapacity('edge-centroids', Math.max(this.edgeCount * 8, 8), usage, 'edge-centroids');
 
     // Repulsion params uniform (SimParams struct = 12 floats = 48 bytes, pad to 48)
-    this.bufferManager.createBuffer('repulsion-params', 48,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'repulsion-params');
+    this.bufferManager.ensureCapacity('repulsion-params', 48, uniform, 'repulsion-params');
 
     // Center force buffers
-    this.bufferManager.createBuffer('center-sum', 8,
+    this.bufferManager.ensureCapacity('center-sum', 8,
       GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'center-sum');
-    this.bufferManager.createBuffer('center-params', 16,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'center-params');
+    this.bufferManager.ensureCapacity('center-params', 16, uniform, 'center-params');
 
     // Integration params uniform
-    this.bufferManager.createBuffer('integrate-params', 16,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'integrate-params');
+    this.bufferManager.ensureCapacity('integrate-params', 16, uniform, 'integrate-params');
   }
 
   private rebuildBindGroups(): void {
@@ -264,6 +277,8 @@ export class ForceSimulation {
         { binding: 2, resource: { buffer: this.bufferManager.getBuffer('he-offsets') } },
         { binding: 3, resource: { buffer: this.bufferManager.getBuffer('he-members') } },
         { binding: 4, resource: { buffer: this.bufferManager.getBuffer('attraction-params') } },
+        { binding: 5, resource: { buffer: this.bufferManager.getBuffer('node-weights') } },
+        { binding: 6, resource: { buffer: this.bufferManager.getBuffer('edge-weights') } },
       ],
     });
 
@@ -282,28 +297,86 @@ export class ForceSimulation {
         { binding: 0, resource: { buffer: this.bufferManager.getBuffer('node-positions') } },
         { binding: 1, resource: { buffer: this.bufferManager.getBuffer('attraction-forces') } },
         { binding: 2, resource: { buffer: this.bufferManager.getBuffer('integrate-params') } },
+        { binding: 3, resource: { buffer: this.bufferManager.getBuffer('pin-flags') } },
+        { binding: 4, resource: { buffer: this.bufferManager.getBuffer('pin-targets') } },
       ],
     });
+
+    this.orderedAttractionBindGroup = null;
+    if (this.bufferManager.hasBuffer('node-edge-offsets')) {
+      this.orderedAttractionBindGroup = this.device.createBindGroup({
+        layout: this.orderedAttractionBGL,
+        entries: [
+          { binding: 0, resource: { buffer: this.bufferManager.getBuffer('node-positions') } },
+          { binding: 1, resource: { buffer: this.bufferManager.getBuffer('attraction-forces') } },
+          { binding: 2, resource: { buffer: this.bufferManager.getBuffer('he-offsets') } },
+          { binding: 3, resource: { buffer: this.bufferManager.getBuffer('he-members') } },
+          { binding: 4, resource: { buffer: this.bufferManager.getBuffer('attraction-params') } },
+          { binding: 5, resource: { buffer: this.bufferManager.getBuffer('node-edge-offsets') } },
+          { binding: 6, resource: { buffer: this.bufferManager.getBuffer('node-edge-ids') } },
+          { binding: 7, resource: { buffer: this.bufferManager.getBuffer('edge-centroids') } },
+          { binding: 8, resource: { buffer: this.bufferManager.getBuffer('node-weights') } },
+          { binding: 9, resource: { buffer: this.bufferManager.getBuffer('edge-weights') } },
+        ],
+      });
+    }
+  }
+
+  /** Rebind after the caller replaced a buffer the passes read (e.g. the node→edge CSR). */
+  refreshBindGroups(): void {
+    this.rebuildBindGroups();
   }
 
   /**
-   * Perform one simulation tick. Dispatches all compute passes.
+   * Adopt a new node/edge count after an incremental graph mutation.
+   * Work buffers grow by doubling; bind groups are rebuilt because the caller
+   * may have replaced node-positions or the hyperedge CSR buffers.
    */
-  tick(params: SimulationParams): void {
-    if (this.nodeCount === 0) return;
+  setGraphSize(nodeCount: number, edgeCount: number): void {
+    this.nodeCount = nodeCount;
+    this.edgeCount = edgeCount;
 
-    const encoder = this.device.createCommandEncoder({ label: 'force-simulation-tick' });
-    const workgroups = Math.ceil(this.nodeCount / 256);
+    this.allocateBuffers();
+    this.quadtree.ensureBuffers(nodeCount);
+    this.rebuildBindGroups();
+  }
 
-    this.profiler?.beginFrame();
+  /** Forget the tracked bounding box — used when a different dataset is loaded. */
+  resetBounds(): void {
+    this.bounds = { minX: -500, minY: -500, maxX: 500, maxY: 500 };
+    this.boundsFrameCounter = 0;
+    this.boundsEpoch++;
+    this.boundsPending = null;
+  }
+
+  /** Resolves once no bounds readback is in flight (deterministic ticks can proceed). */
+  whenReady(): Promise<void> {
+    return this.boundsPending ?? Promise.resolve();
+  }
+
+  /**
+   * Perform one simulation tick. Dispatches all compute passes.
+   * Returns false when no step was taken: in deterministic mode the tick
+   * waits for the bounds readback so every run sees bounds from the same tick.
+   */
+  tick(params: SimulationParams): boolean {
+    if (this.nodeCount === 0) return false;
+    const deterministic = params.deterministic;
+    if (deterministic && this.boundsPending) return false;
 
     // --- Periodically update bounding box from CPU ---
     this.boundsFrameCounter++;
     if (this.boundsFrameCounter >= this.boundsUpdateInterval) {
       this.boundsFrameCounter = 0;
       this.updateBoundsAsync();
+      if (deterministic) return false;
     }
 
+    const encoder = this.device.createCommandEncoder({ label: 'force-simulation-tick' });
+    const workgroups = Math.ceil(this.nodeCount / 256);
+
+    this.profiler?.beginFrame();
+
     // Ensure bounds have non-zero extent
     const bMinX = this.bounds.minX;
     const bMinY = this.bounds.minY;
@@ -367,7 +440,7 @@ export class ForceSimulation {
       this.attractionParamsF32[0] = params.attractionStrength;
       this.attractionParamsF32[1] = params.linkDistance;
       this.attractionParamsF32[2] = params.energy;
-      this.attractionParamsU32[3] = 0;
+      this.attractionParamsU32[3] = this.nodeCount;
       this.attractionParamsU32[4] = this.edgeCount;
       this.attractionParamsU32[5] = 0;
       this.attractionParamsU32[6] = 0;
@@ -375,11 +448,26 @@ export class ForceSimulation {
       this.device.queue.writeBuffer(this.bufferManager.getBuffer('attraction-params'), 0, this.attractionParams);
 
       const edgeWorkgroups = Math.ceil(this.edgeCount / 256);
-      const pass = encoder.beginComputePass({ label: 'attraction', timestampWrites: this.profiler?.timestampWrites('attraction') });
-      pass.setPipeline(this.attractionPipeline);
-      pass.setBindGroup(0, this.attractionBindGroup);
-      pass.dispatchWorkgroups(edgeWorkgroups);
-      pass.end();
+      if (deterministic) {
+        if (!this.orderedAttractionBindGroup) throw new Error('Deterministic attraction needs the node-edge CSR buffers');
+        const centroidPass = encoder.beginComputePass({ label: 'attraction-centroids', timestampWrites: this.profiler?.timestampWrites('attraction') });
+        centroidPass.setPipeline(this.orderedCentroidPipeline);
+        centroidPass.setBindGroup(0, this.orderedAttractionBindGroup);
+        centroidPass.dispatchWorkgroups(edgeWorkgroups);
+        centroidPass.end();
+
+        const gatherPass = encoder.beginComputePass({ label: 'attraction-gather', timestampWrites: this.profiler?.timestampWrites('attraction') });
+        gatherPass.setPipeline(this.orderedGatherPipeline);
+        gatherPass.setBindGroup(0, this.orderedAttractionBindGroup);
+        gatherPass.dispatchWorkgroups(workgroups);
+        gatherPass.end();
+      } else {
+        const pass = encoder.beginComputePass({ label: 'attraction', timestampWrites: this.profiler?.timestampWrites('attraction') });
+        pass.setPipeline(this.attractionPipeline);
+        pass.setBindGroup(0, this.attractionBindGroup);
+        pass.dispatchWorkgroups(edgeWorkgroups);
+        pass.end();
+      }
     }
 
     // --- 7. Center force ---
@@ -394,13 +482,13 @@ export class ForceSimulation {
 
     {
       const accumPass = encoder.beginComputePass({ label: 'center-accumulate', timestampWrites: this.profiler?.timestampWrites('center') });
-      accumPass.setPipeline(this.centerAccumPipeline);
+      accumPass.setPipeline(deterministic ? this.orderedCenterAccumPipeline : this.centerAccumPipeline);
       accumPass.setBindGroup(0, this.centerBindGroup);
-      accumPass.dispatchWorkgroups(workgroups);
+      accumPass.dispatchWorkgroups(deterministic ? 1 : workgroups);
       accumPass.end();
 
       const applyPass = encoder.beginComputePass({ label: 'center-apply', timestampWrites: this.profiler?.timestampWrites('center') });
-      applyPass.setPipeline(this.centerApplyPipeline);
+      applyPass.setPipeline(deterministic ? this.orderedCenterApplyPipeline : this.centerApplyPipeline);
       applyPass.setBindGroup(0, this.centerBindGroup);
       applyPass.dispatchWorkgroups(workgroups);
       applyPass.end();
@@ -410,7 +498,7 @@ export class ForceSimulation {
     this.integrateParamsF32[0] = params.velocityDecay;
     this.integrateParamsF32[1] = params.energy;
     this.integrateParamsU32[2] = this.nodeCount;
-    this.integrateParamsU32[3] = 0;
+    this.integrateParamsF32[3] = PIN_FOLLOW;
     this.device.queue.writeBuffer(this.bufferManager.getBuffer('integrate-params'), 0, this.integrateParams);
 
     {
@@ -429,6 +517,7 @@ export class ForceSimulation {
 
     // Kick off async readback (non-blocking)
     this.profiler?.readback();
+    return true;
   }
 
   /**
@@ -438,8 +527,10 @@ export class ForceSimulation {
   private updateBoundsAsync(): void {
     const n = this.nodeCount;
     if (n === 0) return;
+    const epoch = this.boundsEpoch;
 
-    this.bufferManager.readBuffer('node-positions', n * 16).then((data) => {
+    const pending = this.bufferManager.readBuffer('node-positions', n * 16).then((data) => {
+      if (epoch !== this.boundsEpoch) return;
       let minX = Infinity;
       let minY = Infinity;
       let maxX = -Infinity;
@@ -469,7 +560,10 @@ export class ForceSimulation {
       }
     }).catch(() => {
       // GPU readback can fail if device is lost; ignore
+    }).finally(() => {
+      if (this.boundsPending === pending) this.boundsPending = null;
     });
+    this.boundsPending = pending;
   }
 
   destroy(): void {
@@ -478,7 +572,7 @@ export class ForceSimulation {
 
     const names = [
       'morton-codes', 'sorted-indices', 'morton-params',
-      'attraction-forces', 'attraction-params',
+      'attraction-forces', 'attraction-params', 'edge-centroids',
       'repulsion-params', 'center-sum', 'center-params',
       'integrate-params',
     ];
@@ -0,0 +1,46 @@
+import type { BufferManager } from '../gpu/buffer-manager';
+
+/**
+ * Per-node and per-hyperedge weights, mirrored on the GPU as `node-weights`
+ * and `edge-weights` (f32 each). A weight is how many original items a
+ * representative stands for after structural reduction (src/data/reduction.ts)
+ * and 1 otherwise. Node weights are the Barnes-Hut leaf mass and scale the
+ * rendered node; edge weights scale the attraction spring and the stroke.
+ *
+ * Unreduced graphs keep all-ones buffers, and growing them within the
+ * allocated size only uploads the new tail, so mutations stay incremental.
+ */
+export class GraphWeights {
+  private buffers: BufferManager;
+  // Leading slots known to hold 1.0 (valid while no explicit weights are set)
+  private onesNodes = 0;
+  private onesEdges = 0;
+
+  constructor(buffers: BufferManager) {
+    this.buffers = buffers;
+  }
+
+  /** Size both buffers for the graph and upload its weights (null = all 1). */
+  update(
+    nodeWeights: Float32Array | null, nodeCount: number,
+    edgeWeights: Float32Array | null, edgeCount: number,
+  ): void {
+    this.onesNodes = this.upload('node-weights', nodeWeights, nodeCount, this.onesNodes);
+    this.onesEdges = this.upload('edge-weights', edgeWeights, edgeCount, this.onesEdges);
+  }
+
+  /** Returns the new count of leading all-ones slots. */
+  private upload(name: string, weights: Float32Array | null, count: number, ones: number): number {
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST;
+    if (weights) {
+      this.buffers.ensureCapacity(name, Math.max(count * 4, 4), usage, name);
+      if (count > 0) this.buffers.uploadData(name, weights.subarray(0, count));
+      return 0;
+    }
+    // A replaced buffer starts zeroed, so it takes the ones again from slot 0
+    const grew = this.buffers.ensureCapacity(name, Math.max(count * 4, 4), usage, name);
+    const known = grew ? 0 : Math.min(ones, count);
+    if (count > known) this.buffers.uploadData(name, new Float32Array(count - known).fill(1), known * 4);
+    return count;
+  }
+}
@@ -0,0 +1,132 @@
+import type { BufferManager } from '../gpu/buffer-manager';
+
+/** Bit 0 of a pin-flags entry: node follows its pin target instead of the forces. */
+export const PIN_FLAG = 1;
+
+/** Fraction of the remaining distance to its target a pinned node covers per tick. */
+export const PIN_FOLLOW = 0.55;
+
+/**
+ * Per-node pin mask + target positions, mirrored on the GPU as `pin-flags`
+ * (u32 per node) and `pin-targets` (vec2<f32> per node). integrate.wgsl moves
+ * pinned nodes toward their target, so drags and anchored layouts cost one
+ * small upload per change rather than per-frame position writes.
+ */
+export class NodePins {
+  private buffers: BufferManager;
+  private flags = new Uint32Array(0);
+  private targets = new Float32Array(0);
+  private nodeCount = 0;
+  private pinned = 0;
+
+  constructor(buffers: BufferManager) {
+    this.buffers = buffers;
+  }
+
+  get pinnedCount(): number { return this.pinned; }
+
+  /** Grow/shrink to `nodeCount` nodes. New slots are unpinned; existing pins survive. */
+  resize(nodeCount: number): void {
+    const prevCount = this.nodeCount;
+    if (nodeCount > this.flags.length) {
+      const cap = Math.max(nodeCount, this.flags.length * 2);
+      const flags = new Uint32Array(cap);
+      flags.set(this.flags.subarray(0, this.nodeCount));
+      const targets = new Float32Array(cap * 2);
+      targets.set(this.targets.subarray(0, this.nodeCount * 2));
+      this.flags = flags;
+      this.targets = targets;
+    }
+    if (nodeCount < this.nodeCount) {
+      for (let i = nodeCount; i < this.nodeCount; i++) {
+        if (this.flags[i] & PIN_FLAG) this.pinned--;
+      }
+      this.flags.fill(0, nodeCount, this.nodeCount);
+    }
+    this.nodeCount = nodeCount;
+
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST;
+    const flagsGrew = this.buffers.ensureCapacity('pin-flags', Math.max(nodeCount * 4, 4), usage, 'pin-flags');
+    const targetsGrew = this.buffers.ensureCapacity('pin-targets', Math.max(nodeCount * 8, 8), usage, 'pin-targets');
+    this.uploadRange(flagsGrew || targetsGrew ? 0 : prevCount, nodeCount);
+  }
+
+  /** Drop every pin (new dataset). */
+  reset(nodeCount: number): void {
+    this.flags.fill(0);
+    this.pinned = 0;
+    this.nodeCount = 0;
+    this.resize(nodeCount);
+  }
+
+  /** Apply an old→new index remap (-1 = removed) after node removal. */
+  remap(remap: Int32Array, nodeCount: number): void {
+    this.pinned = 0;
+    for (let i = 0; i < remap.length; i++) {
+      const j = remap[i];
+      if (j < 0) continue;
+      this.flags[j] = this.flags[i];
+      this.targets[j * 2] = this.targets[i * 2];
+      this.targets[j * 2 + 1] = this.targets[i * 2 + 1];
+      if (this.flags[j] & PIN_FLAG) this.pinned++;
+    }
+    this.flags.fill(0, nodeCount, this.nodeCount);
+    this.resize(nodeCount);
+    this.uploadRange(0, nodeCount);
+  }
+
+  /** Pin nodes at (or move their pins to) the interleaved [x0, y0, x1, y1, ...] targets. */
+  pin(indices: ArrayLike<number>, xy: ArrayLike<number>): void {
+    this.write(indices, xy, true);
+  }
+
+  unpin(indices: ArrayLike<number>): void {
+    this.write(indices, null, false);
+  }
+
+  clear(): void {
+    if (this.pinned === 0) return;
+    this.flags.fill(0, 0, this.nodeCount);
+    this.pinned = 0;
+    this.uploadRange(0, this.nodeCount);
+  }
+
+  isPinned(index: number): boolean {
+    return index < this.nodeCount && (this.flags[index] & PIN_FLAG) !== 0;
+  }
+
+  pinnedIndices(): number[] {
+    const out: number[] = [];
+    for (let i = 0; i < this.nodeCount; i++) {
+      if (this.flags[i] & PIN_FLAG) out.push(i);
+    }
+    return out;
+  }
+
+  private write(indices: ArrayLike<number>, xy: ArrayLike<number> | null, pin: boolean): void {
+    let lo = Infinity;
+    let hi = -1;
+    for (let k = 0; k < indices.length; k++) {
+      const i = indices[k];
+      if (i < 0 || i >= this.nodeCount) continue;
+      const was = (this.flags[i] & PIN_FLAG) !== 0;
+      if (pin && !was) this.pinned++;
+      if (!pin && was) this.pinned--;
+      this.flags[i] = pin ? PIN_FLAG : 0;
+      if (xy) {
+        this.targets[i * 2] = xy[k * 2];
+        this.targets[i * 2 + 1] = xy[k * 2 + 1];
+      }
+      if (i < lo) lo = i;
+      if (i > hi) hi = i;
+    }
+    if (hi >= 0) this.uploadRange(lo, hi + 1);
+  }
+
+  /** One write per buffer covering [start, end) — bulk edits stay a single upload. */
+  private uploadRange(start: number, end: number): void {
+    if (end <= start) return;
+    this.buffers.uploadData('pin-flags', this.flags.subarray(start, end), start * 4);
+    this.buffers.uploadData('pin-targets', this.targets.subarray(start * 2, end * 2), start * 8);
+  }
+}
@@ -1,8 +1,12 @@
 import type { BufferManager } from '../gpu/buffer-manager';
 import type { GPUProfiler } from '../gpu/gpu-profiler';
+import { getPipelineCache } from '../gpu/pipeline-cache';
+import { TREE_STRIDE, treeLayout } from './barnes-hut-cpu';
 import quadtreeBuildShader from '../shaders/quadtree-build.wgsl?raw';
 import quadtreeSummarizeShader from '../shaders/quadtree-summarize.wgsl?raw';
 
+const PARAMS_SLOT = 256; // minUniformBufferOffsetAlignment
+
 /**
  * GPU Quadtree for Barnes-Hut force approximation.
  *
@@ -19,7 +23,8 @@ import quadtreeSummarizeShader from '../shaders/quadtree-summarize.wgsl?raw';
  * - Children of node i: 4*i+1, 4*i+2, 4*i+3, 4*i+4
  *
  * We compute the number of levels needed to hold all nodes as leaves,
- * then build bottom-up.
+ * then build bottom-up. Each node carries mass, COM and second moments
+ * (TREE_STRIDE floats) so repulsion can use a quadrupole far field.
  */
 export class GPUQuadtree {
   private device: GPUDevice;
@@ -32,15 +37,18 @@ export class GPUQuadtree {
   private summarizeBGL: GPUBindGroupLayout;
   private profiler: GPUProfiler | null = null;
 
-  // Cached bind groups
+  // Cached bind groups (one summarize bind group per level, each with its own params slot)
   private buildBindGroup: GPUBindGroup | null = null;
-  private summarizeBindGroup: GPUBindGroup | null = null;
+  private summarizeBindGroups: GPUBindGroup[] = [];
 
-  // Pre-allocated param arrays with dual views
+  // Pre-allocated param arrays with dual views. Summarize params live in
+  // 256-byte slots, one per level: queue.writeBuffer lands before the whole
+  // encoder runs, so a single shared slot would give every level the last
+  // level's params.
   private buildParamsArray = new Uint32Array(4);
-  private summarizeParamsBuf = new ArrayBuffer(16);
-  private summarizeParamsU32 = new Uint32Array(this.summarizeParamsBuf);
-  private summarizeParamsF32 = new Float32Array(this.summarizeParamsBuf);
+  private summarizeParamsBuf = new ArrayBuffer(0);
+  private summarizeParamsU32 = new Uint32Array(0);
+  private summarizeParamsF32 = new Float32Array(0);
 
   // Tree parameters
   treeSize = 0;       // total nodes in tree
@@ -52,47 +60,27 @@ export class GPUQuadtree {
     this.bufferManager = bufferManager;
     this.profiler = profiler ?? null;
 
-    // Build pipeline
-    const buildModule = device.createShaderModule({
-      label: 'quadtree-build-shader',
-      code: quadtreeBuildShader,
-    });
-
-    this.buildBGL = device.createBindGroupLayout({
-      label: 'quadtree-build-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
+    // Pipelines are shared per device
+    const cache = getPipelineCache(device);
 
-    this.buildPipeline = device.createComputePipeline({
-      label: 'quadtree-build',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.buildBGL] }),
-      compute: { module: buildModule, entryPoint: 'main' },
-    });
+    // Build pipeline
+    const buildModule = cache.shaderModule('quadtree-build-shader', quadtreeBuildShader);
+    this.buildBGL = cache.bindGroupLayout('quadtree-build-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+      { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+    ]);
+    this.buildPipeline = cache.computePipeline('quadtree-build', buildModule, 'main', this.buildBGL);
 
     // Summarize pipeline
-    const summarizeModule = device.createShaderModule({
-      label: 'quadtree-summarize-shader',
-      code: quadtreeSummarizeShader,
-    });
-
-    this.summarizeBGL = device.createBindGroupLayout({
-      label: 'quadtree-summarize-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-
-    this.summarizePipeline = device.createComputePipeline({
-      label: 'quadtree-summarize',
-      layout: device.createPipelineLayout({ bindGroupLayouts: [this.summarizeBGL] }),
-      compute: { module: summarizeModule, entryPoint: 'main' },
-    });
+    const summarizeModule = cache.shaderModule('quadtree-summarize-shader', quadtreeSummarizeShader);
+    this.summarizeBGL = cache.bindGroupLayout('quadtree-summarize-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+    this.summarizePipeline = cache.computePipeline('quadtree-summarize', summarizeModule, 'main', this.summarizeBGL);
   }
 
   /**
@@ -100,39 +88,23 @@ export class GPUQuadtree {
    * We choose a number of levels such that 4^L >= nodeCount for the leaf level.
    */
   computeTreeLayout(nodeCount: number): void {
-    // Determine levels: we need at least enough leaves to hold all nodes
-    // A complete 4-ary tree with L levels has 4^(L-1) leaves at the bottom level
-    // Total nodes = (4^L - 1) / 3
-    let levels = 1;
-    let leafCapacity = 1;
-    while (leafCapacity < nodeCount) {
-      levels++;
-      leafCapacity *= 4;
-    }
-
-    this.numLevels = levels;
-
-    // Internal nodes (levels 0 to L-2): (4^(L-1) - 1) / 3
-    // Leaf level (level L-1): 4^(L-1)
-    if (levels === 1) {
-      this.leafOffset = 0;
-      this.treeSize = Math.max(nodeCount, 1);
-    } else {
-      // Sum of 4^0 + 4^1 + ... + 4^(L-2) = (4^(L-1) - 1) / 3
-      this.leafOffset = (leafCapacity - 1) / 3;
-      this.treeSize = this.leafOffset + leafCapacity;
-    }
+    // Shared with the CPU reference so both build the same tree
+    const layout = treeLayout(nodeCount);
+    this.numLevels = layout.numLevels;
+    this.leafOffset = layout.leafOffset;
+    this.treeSize = layout.treeSize;
   }
 
   /**
-   * Allocate/resize tree buffer.
+   * Allocate/resize tree buffer. The tree buffer only ever grows; bind groups
+   * are always rebuilt since node-positions / sorted-indices may have been
+   * replaced by the caller.
    */
   ensureBuffers(nodeCount: number): void {
     this.computeTreeLayout(nodeCount);
 
-    // 8 floats per tree node
-    const treeBufSize = this.treeSize * 8 * 4;
-    this.bufferManager.createBuffer(
+    const treeBufSize = this.treeSize * TREE_STRIDE * 4;
+    this.bufferManager.ensureCapacity(
       'quadtree',
       treeBufSize,
       GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC,
@@ -140,18 +112,26 @@ export class GPUQuadtree {
     );
 
     // Build params uniform
-    this.bufferManager.createBuffer(
-      'quadtree-build-params', 16,
-      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
-      'quadtree-build-params',
-    );
+    if (!this.bufferManager.hasBuffer('quadtree-build-params')) {
+      this.bufferManager.createBuffer(
+        'quadtree-build-params', 16,
+        GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
+        'quadtree-build-params',
+      );
+    }
 
-    // Summarize params uniform
-    this.bufferManager.createBuffer(
-      'quadtree-summarize-params', 16,
+    // Summarize params uniform: one slot per internal level
+    const slots = Math.max(this.numLevels - 1, 1);
+    this.bufferManager.ensureCapacity(
+      'quadtree-summarize-params', slots * PARAMS_SLOT,
       GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST,
       'quadtree-summarize-params',
     );
+    if (this.summarizeParamsBuf.byteLength < slots * PARAMS_SLOT) {
+      this.summarizeParamsBuf = new ArrayBuffer(slots * PARAMS_SLOT);
+      this.summarizeParamsU32 = new Uint32Array(this.summarizeParamsBuf);
+      this.summarizeParamsF32 = new Float32Array(this.summarizeParamsBuf);
+    }
 
     this.rebuildBindGroups();
   }
@@ -167,17 +147,22 @@ export class GPUQuadtree {
         { binding: 1, resource: { buffer: this.bufferManager.getBuffer('sorted-indices') } },
         { binding: 2, resource: { buffer: treeBuffer } },
         { binding: 3, resource: { buffer: this.bufferManager.getBuffer('quadtree-build-params') } },
+        { binding: 4, resource: { buffer: this.bufferManager.getBuffer('node-weights') } },
       ],
     });
 
-    this.summarizeBindGroup = this.device.createBindGroup({
-      label: 'quadtree-summarize-bg',
-      layout: this.summarizeBGL,
-      entries: [
-        { binding: 0, resource: { buffer: treeBuffer } },
-        { binding: 1, resource: { buffer: this.bufferManager.getBuffer('quadtree-summarize-params') } },
-      ],
-    });
+    const summarizeParams = this.bufferManager.getBuffer('quadtree-summarize-params');
+    this.summarizeBindGroups = [];
+    for (let level = 0; level < Math.max(this.numLevels - 1, 1); level++) {
+      this.summarizeBindGroups.push(this.device.createBindGroup({
+        label: `quadtree-summarize-bg-${level}`,
+        layout: this.summarizeBGL,
+        entries: [
+          { binding: 0, resource: { buffer: treeBuffer } },
+          { binding: 1, resource: { buffer: summarizeParams, offset: level * PARAMS_SLOT, size: 16 } },
+        ],
+      }));
+    }
   }
 
   /**
@@ -205,26 +190,31 @@ export class GPUQuadtree {
     buildPass.dispatchWorkgroups(Math.ceil(nodeCount / 256));
     buildPass.end();
 
+    if (this.numLevels < 2) return;
+
     // Step 2: Summarize bottom-up, level by level
-    // Process from level (numLevels-2) up to level 0
-    for (let level = this.numLevels - 2; level >= 0; level--) {
+    // Params for every level go up in one write, each in its own slot
+    for (let level = 0; level <= this.numLevels - 2; level++) {
       // Nodes at this level start at index (4^level - 1) / 3
       // and there are 4^level of them
       const nodesAtLevel = Math.pow(4, level);
-      const levelStart = level === 0 ? 0 : (nodesAtLevel - 1) / 3;
-
-      this.summarizeParamsU32[0] = levelStart;
-      this.summarizeParamsU32[1] = nodesAtLevel;
-      this.summarizeParamsU32[2] = this.treeSize;
-      this.summarizeParamsF32[3] = rootSize;
-
-      this.device.queue.writeBuffer(
-        this.bufferManager.getBuffer('quadtree-summarize-params'), 0, this.summarizeParamsBuf,
-      );
+      const slot = (level * PARAMS_SLOT) / 4;
+      this.summarizeParamsU32[slot + 0] = (nodesAtLevel - 1) / 3;
+      this.summarizeParamsU32[slot + 1] = nodesAtLevel;
+      this.summarizeParamsU32[slot + 2] = this.treeSize;
+      this.summarizeParamsF32[slot + 3] = rootSize;
+    }
+    this.device.queue.writeBuffer(
+      this.bufferManager.getBuffer('quadtree-summarize-params'), 0,
+      this.summarizeParamsBuf, 0, (this.numLevels - 1) * PARAMS_SLOT,
+    );
 
+    // Process from level (numLevels-2) up to level 0
+    for (let level = this.numLevels - 2; level >= 0; level--) {
+      const nodesAtLevel = Math.pow(4, level);
       const sumPass = encoder.beginComputePass({ label: `quadtree-summarize-${level}`, timestampWrites: this.profiler?.timestampWrites('quadtree') });
       sumPass.setPipeline(this.summarizePipeline);
-      sumPass.setBindGroup(0, this.summarizeBindGroup!);
+      sumPass.setBindGroup(0, this.summarizeBindGroups[level]);
       sumPass.dispatchWorkgroups(Math.ceil(nodesAtLevel / 256));
       sumPass.end();
     }
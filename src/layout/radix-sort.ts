@@ -1,8 +1,12 @@
 import type { BufferManager } from '../gpu/buffer-manager';
 import type { GPUProfiler } from '../gpu/gpu-profiler';
+import { getPipelineCache } from '../gpu/pipeline-cache';
 import radixSortShader from '../shaders/radix-sort.wgsl?raw';
 import radixSortSubgroupShader from '../shaders/radix-sort-subgroup.wgsl?raw';
 
+const PASSES = 4;
+const PARAMS_SLOT = 256; // minUniformBufferOffsetAlignment
+
 /**
  * GPU Radix Sort for 32-bit unsigned integer keys with associated values.
  * Sorts by performing 4 passes of 8-bit radix sort (LSB to MSB).
@@ -22,12 +26,13 @@ export class RadixSort {
   private profiler: GPUProfiler | null = null;
   private _hasSubgroups: boolean;
 
-  // Pre-allocated to avoid per-frame GC pressure
-  private paramsArray = new Uint32Array(4);
+  // One 256-byte-aligned params slot per pass. queue.writeBuffer lands before
+  // the whole encoder executes, so a single shared slot would leave every
+  // pass reading the last pass's bit offset.
+  private paramsArray = new Uint32Array((PARAMS_SLOT / 4) * PASSES);
 
-  // Cached bind groups for even/odd passes (ping→pong vs pong→ping)
-  private evenBindGroup: GPUBindGroup | null = null;
-  private oddBindGroup: GPUBindGroup | null = null;
+  // Cached bind group per pass (even: ping→pong, odd: pong→ping; own params slot)
+  private passBindGroups: GPUBindGroup[] = [];
 
   get hasSubgroups(): boolean { return this._hasSubgroups; }
 
@@ -38,46 +43,24 @@ export class RadixSort {
     this.profiler = profiler ?? null;
     this._hasSubgroups = features.has('subgroups');
 
-    const shaderCode = this._hasSubgroups ? radixSortSubgroupShader : radixSortShader;
-    const shaderModule = device.createShaderModule({
-      label: this._hasSubgroups ? 'radix-sort-subgroup-shader' : 'radix-sort-shader',
-      code: shaderCode,
-    });
-
-    this.bindGroupLayout = device.createBindGroupLayout({
-      label: 'radix-sort-bgl',
-      entries: [
-        { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
-        { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
-        { binding: 5, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
-      ],
-    });
-
-    const pipelineLayout = device.createPipelineLayout({
-      label: 'radix-sort-pipeline-layout',
-      bindGroupLayouts: [this.bindGroupLayout],
-    });
-
-    this.histogramPipeline = device.createComputePipeline({
-      label: 'radix-sort-histogram',
-      layout: pipelineLayout,
-      compute: { module: shaderModule, entryPoint: 'histogram' },
-    });
-
-    this.prefixSumPipeline = device.createComputePipeline({
-      label: 'radix-sort-prefix-sum',
-      layout: pipelineLayout,
-      compute: { module: shaderModule, entryPoint: 'prefix_sum' },
-    });
-
-    this.scatterPipeline = device.createComputePipeline({
-      label: 'radix-sort-scatter',
-      layout: pipelineLayout,
-      compute: { module: shaderModule, entryPoint: 'scatter' },
-    });
+    // Shader module, layout and pipelines are shared per device
+    const cache = getPipelineCache(device);
+    const shaderModule = this._hasSubgroups
+      ? cache.shaderModule('radix-sort-subgroup-shader', radixSortSubgroupShader)
+      : cache.shaderModule('radix-sort-shader', radixSortShader);
+
+    this.bindGroupLayout = cache.bindGroupLayout('radix-sort-bgl', [
+      { binding: 0, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 1, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'read-only-storage' } },
+      { binding: 2, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 3, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 4, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'storage' } },
+      { binding: 5, visibility: GPUShaderStage.COMPUTE, buffer: { type: 'uniform' } },
+    ]);
+
+    this.histogramPipeline = cache.computePipeline('radix-sort-histogram', shaderModule, 'histogram', this.bindGroupLayout);
+    this.prefixSumPipeline = cache.computePipeline('radix-sort-prefix-sum', shaderModule, 'prefix_sum', this.bindGroupLayout);
+    this.scatterPipeline = cache.computePipeline('radix-sort-scatter', shaderModule, 'scatter', this.bindGroupLayout);
 
     // Create ping-pong buffers for keys and values
     this.createBuffers(maxNodeCount);
@@ -90,47 +73,39 @@ export class RadixSort {
     const bufferSize = nodeCount * 4;
     const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC;
 
-    this.bufferManager.createBuffer('sort-keys-ping', bufferSize, usage, 'sort-keys-ping');
-    this.bufferManager.createBuffer('sort-vals-ping', bufferSize, usage, 'sort-vals-ping');
-    this.bufferManager.createBuffer('sort-keys-pong', bufferSize, usage, 'sort-keys-pong');
-    this.bufferManager.createBuffer('sort-vals-pong', bufferSize, usage, 'sort-vals-pong');
-    this.bufferManager.createBuffer('sort-histograms', Math.max(histogramSize, 4), usage, 'sort-histograms');
-    this.bufferManager.createBuffer('sort-params', 16, GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'sort-params');
+    // Pooled: existing buffers that are already large enough are kept
+    this.bufferManager.ensureCapacity('sort-keys-ping', bufferSize, usage, 'sort-keys-ping');
+    this.bufferManager.ensureCapacity('sort-vals-ping', bufferSize, usage, 'sort-vals-ping');
+    this.bufferManager.ensureCapacity('sort-keys-pong', bufferSize, usage, 'sort-keys-pong');
+    this.bufferManager.ensureCapacity('sort-vals-pong', bufferSize, usage, 'sort-vals-pong');
+    this.bufferManager.ensureCapacity('sort-histograms', Math.max(histogramSize, 4), usage, 'sort-histograms');
+    this.bufferManager.ensureCapacity('sort-params', PARAMS_SLOT * PASSES, GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'sort-params');
 
     // Rebuild cached bind groups when buffers change
     this.rebuildBindGroups(numWorkgroups);
   }
 
   private rebuildBindGroups(numWorkgroups: number): void {
-    const histSize = 256 * numWorkgroups * 4;
-
-    // Even passes: read ping → write pong
-    this.evenBindGroup = this.device.createBindGroup({
-      label: 'radix-sort-bg-even',
-      layout: this.bindGroupLayout,
-      entries: [
-        { binding: 0, resource: { buffer: this.bufferManager.getBuffer('sort-keys-ping') } },
-        { binding: 1, resource: { buffer: this.bufferManager.getBuffer('sort-vals-ping') } },
-        { binding: 2, resource: { buffer: this.bufferManager.getBuffer('sort-keys-pong') } },
-        { binding: 3, resource: { buffer: this.bufferManager.getBuffer('sort-vals-pong') } },
-        { binding: 4, resource: { buffer: this.bufferManager.getBuffer('sort-histograms'), size: Math.max(histSize, 4) } },
-        { binding: 5, resource: { buffer: this.bufferManager.getBuffer('sort-params') } },
-      ],
-    });
-
-    // Odd passes: read pong → write ping
-    this.oddBindGroup = this.device.createBindGroup({
-      label: 'radix-sort-bg-odd',
-      layout: this.bindGroupLayout,
-      entries: [
-        { binding: 0, resource: { buffer: this.bufferManager.getBuffer('sort-keys-pong') } },
-        { binding: 1, resource: { buffer: this.bufferManager.getBuffer('sort-vals-pong') } },
-        { binding: 2, resource: { buffer: this.bufferManager.getBuffer('sort-keys-ping') } },
-        { binding: 3, resource: { buffer: this.bufferManager.getBuffer('sort-vals-ping') } },
-        { binding: 4, resource: { buffer: this.bufferManager.getBuffer('sort-histograms'), size: Math.max(histSize, 4) } },
-        { binding: 5, resource: { buffer: this.bufferManager.getBuffer('sort-params') } },
-      ],
-    });
+    const histSize = Math.max(256 * numWorkgroups * 4, 4);
+    const ping = [this.bufferManager.getBuffer('sort-keys-ping'), this.bufferManager.getBuffer('sort-vals-ping')];
+    const pong = [this.bufferManager.getBuffer('sort-keys-pong'), this.bufferManager.getBuffer('sort-vals-pong')];
+
+    this.passBindGroups = [];
+    for (let pass = 0; pass < PASSES; pass++) {
+      const [src, dst] = pass % 2 === 0 ? [ping, pong] : [pong, ping];
+      this.passBindGroups.push(this.device.createBindGroup({
+        label: `radix-sort-bg-${pass}`,
+        layout: this.bindGroupLayout,
+        entries: [
+          { binding: 0, resource: { buffer: src[0] } },
+          { binding: 1, resource: { buffer: src[1] } },
+          { binding: 2, resource: { buffer: dst[0] } },
+          { binding: 3, resource: { buffer: dst[1] } },
+          { binding: 4, resource: { buffer: this.bufferManager.getBuffer('sort-histograms'), size: histSize } },
+          { binding: 5, resource: { buffer: this.bufferManager.getBuffer('sort-params'), offset: pass * PARAMS_SLOT, size: 16 } },
+        ],
+      }));
+    }
   }
 
   /**
@@ -145,8 +120,9 @@ export class RadixSort {
     if (nodeCount <= 1) return;
 
     if (nodeCount > this.maxNodeCount) {
-      this.maxNodeCount = nodeCount;
-      this.createBuffers(nodeCount);
+      // Double so incremental node additions don't reallocate every frame
+      this.maxNodeCount = Math.max(nodeCount, this.maxNodeCount * 2);
+      this.createBuffers(this.maxNodeCount);
     }
 
     const numWorkgroups = Math.ceil(nodeCount / 256);
@@ -165,19 +141,19 @@ export class RadixSort {
 
     const histBuffer = this.bufferManager.getBuffer('sort-histograms');
 
-    // 4 passes for 32-bit keys (8 bits per pass)
-    for (let pass = 0; pass < 4; pass++) {
-      const bitOffset = pass * 8;
-
-      // Upload params for this pass (reuse pre-allocated array)
-      this.paramsArray[0] = nodeCount;
-      this.paramsArray[1] = bitOffset;
-      this.device.queue.writeBuffer(this.bufferManager.getBuffer('sort-params'), 0, this.paramsArray);
+    // Params for all passes in one upload (reuse pre-allocated array)
+    for (let pass = 0; pass < PASSES; pass++) {
+      this.paramsArray[pass * (PARAMS_SLOT / 4) + 0] = nodeCount;
+      this.paramsArray[pass * (PARAMS_SLOT / 4) + 1] = pass * 8;
+    }
+    this.device.queue.writeBuffer(this.bufferManager.getBuffer('sort-params'), 0, this.paramsArray);
 
+    // 4 passes for 32-bit keys (8 bits per pass)
+    for (let pass = 0; pass < PASSES; pass++) {
       // Clear histogram buffer on GPU (no CPU allocation needed)
       encoder.clearBuffer(histBuffer);
 
-      const bindGroup = pass % 2 === 0 ? this.evenBindGroup! : this.oddBindGroup!;
+      const bindGroup = this.passBindGroups[pass];
 
       // Pass 1: Histogram
       const histPass = encoder.beginComputePass({ label: `radix-histogram-${pass}`, timestampWrites: this.profiler?.timestampWrites('sort') });
@@ -5,30 +5,51 @@
 import { initWebGPU, type GPUContext } from './gpu/device';
 import { BufferManager } from './gpu/buffer-manager';
 import { GPUProfiler, type GPUStageTiming } from './gpu/gpu-profiler';
+import { getPipelineCache } from './gpu/pipeline-cache';
 import { Camera } from './render/camera';
 import { getPaletteColors } from './utils/color';
+import { rngFor, type Rng } from './utils/random';
 import { Tooltip } from './ui/tooltip';
 import {
   type HypergraphData, type NodeData, type HyperedgeData,
   type SimulationParams, type RenderParams,
   defaultSimulationParams, defaultRenderParams,
 } from './data/types';
+import { HypergraphStore } from './data/hypergraph-store';
+import { decodeHypergraphBinary, encodeHypergraphBinary, storeFromBinary } from './data/binary-format';
+import { LayoutCache, layoutKey } from './data/layout-cache';
+import { collapsedWeights, COLLAPSED_NODES, COLLAPSED_EDGES } from './data/reduction';
+import type { NodeInput, HyperedgeInput, GraphDelta } from './data/graph-mutations';
+import type { HIFStreamOptions } from './data/hif-stream';
 import nodeShaderCode from './shaders/node-render.wgsl?raw';
 
 // Static imports for all engine-required modules (bundled into library)
 import { ForceSimulation } from './layout/force-simulation';
+import { NodePins } from './layout/node-pins';
+import { GraphWeights } from './layout/graph-weights';
 import { InputHandler } from './interaction/input-handler';
+import { GPUPicker } from './interaction/gpu-picker';
+import { SpatialIndex } from './interaction/spatial-index';
+import { SpatialIndexBuilder } from './interaction/spatial-index-pipeline';
 import { EdgeRenderer } from './render/edge-renderer';
 import { HullRenderer } from './render/hull-renderer';
 import { BoundaryRenderer } from './render/boundary-renderer';
+import { GPUCuller, NODE_CULL } from './render/gpu-culling';
+
+// Energy above idle at which a cooling layout counts as converged (~230 ticks from a cold start)
+const SETTLED_ENERGY = 0.005;
 
 // ── Public option types ──
 
+export type { NodeInput, HyperedgeInput } from './data/graph-mutations';
+
 export interface HyperblobOptions {
   tooltip?: boolean;
   palette?: Float32Array;
   simParams?: Partial<SimulationParams>;
   renderParams?: Partial<RenderParams>;
+  seed?: number; // seeds initial placement — same seed + same data → same starting layout
+  layoutCache?: LayoutCache | false; // converged layouts persisted per dataset (default: IndexedDB); false opts out
   onNodeClick?: (nodeIndex: number, node: NodeData) => void;
   onNodeHover?: (nodeIndex: number | null, node: NodeData | null, screenX: number, screenY: number) => void;
   onEdgeClick?: (edgeIndex: number, edge: HyperedgeData) => void;
@@ -44,9 +65,24 @@ export class HyperblobEngine {
   simParams: SimulationParams;
   renderParams: RenderParams;
 
-  private graphData: HypergraphData | null = null;
+  // CSR-native graph; the HypergraphData object model is only built if a consumer asks for it
+  private store: HypergraphStore | null = null;
   private nodeCount = 0;
 
+  // Incremental mutation state
+  // GPU copy of the node→edge transpose (deterministic attraction) is behind the store's topology
+  private incidenceStale = true;
+  private rng: Rng = Math.random;
+  // Nodes added without hyperedges yet: index → whether group is auto-assigned on first edge
+  private pendingNodes = new Map<number, boolean>();
+
+  // Layout cache: content key of the loaded structure (null once mutated), whether its
+  // converged layout has been written, and a token that invalidates in-flight restores
+  private layoutCache: LayoutCache | null;
+  private layoutKey: string | null = null;
+  private layoutSaved = false;
+  private layoutRequest = 0;
+
   // Selection state (neighborhood filter — default click behavior)
   private selectedNode: number | null = null;
   private visibleNodes: Set<number> | null = null;
@@ -60,26 +96,38 @@ export class HyperblobEngine {
   // Node drag state
   private cpuPositions: Float32Array | null = null;
   private cpuPositionsPending = false;
+  private positionsEpoch = 0; // bumped whenever positions are replaced from the CPU side
   private positionCacheCounter = 0;
   private draggedNodeIndex: number | null = null;
-  private dragTargetPos: [number, number] | null = null;
-  private dragSmoothPos: [number, number] | null = null;
-  private dragPrevPos: [number, number] | null = null;
+  // Uniform grid over the position cache for range / nearest queries, rebuilt in a worker
+  private spatialIndex: SpatialIndex | null = null;
+  private spatialIndexEpoch = -1; // positionsEpoch the index was built under
+  private indexedPositions: Float32Array | null = null;
+  private indexBuilder = new SpatialIndexBuilder();
+  private dragWasPinned = false; // dragged node was pinned before the drag — keep it pinned on release
+
+  // Pinned nodes (GPU mask consumed by integrate.wgsl)
+  private pins: NodePins;
+  // Node/edge weights of a structurally reduced graph (all 1 otherwise)
+  private weights: GraphWeights;
 
   // Render pipeline state
   private nodeRenderPipeline: GPURenderPipeline | null = null;
   private nodeBindGroup: GPUBindGroup | null = null;
+  private nodeCuller: GPUCuller; // on-screen, unhidden nodes → indirect node draw (main and pick pass)
+  private nodeCullVersion = -1;  // survivor buffer the node bind groups were built with
   private cameraBuffer: GPUBuffer | null = null;
   private paramsBuffer: GPUBuffer | null = null;
   private paletteBuffer: GPUBuffer | null = null;
 
   // Pre-allocated typed arrays for per-frame GPU uploads (avoid GC pressure)
-  private dragUploadArray = new Float32Array(4);
+  private dragTargetArray = new Float32Array(2);
   private renderParamsArray = new Float32Array(4);
   private lastCameraVersion = -1;
 
   // Sub-module instances (statically imported, instantiated on setData)
   private inputHandlerInstance: InputHandler | null = null;
+  private picker: GPUPicker; // hover/press hit tests, answered from the frame's pick pass
   private edgeRendererInstance: EdgeRenderer | null = null;
   private hullRendererInstance: HullRenderer | null = null;
   private boundaryRendererInstance: BoundaryRenderer | null = null;
@@ -89,6 +137,7 @@ export class HyperblobEngine {
   private lastHoveredEdge: number | null = null;
 
   private profiler: GPUProfiler;
+  private renderProfiler: GPUProfiler; // render passes, separate from the simulation's compute stages
 
   private running = false;
   private disposed = false;
@@ -105,11 +154,23 @@ export class HyperblobEngine {
   private constructor(gpu: GPUContext, options: HyperblobOptions) {
     this.gpu = gpu;
     this.buffers = new BufferManager(gpu.device);
+    this.pins = new NodePins(this.buffers);
+    this.weights = new GraphWeights(this.buffers);
     this.camera = new Camera();
     this.options = options;
     this.profiler = new GPUProfiler(gpu.device, gpu.supportsTimestampQuery);
+    this.renderProfiler = new GPUProfiler(gpu.device, gpu.supportsTimestampQuery);
+    this.picker = new GPUPicker(gpu.device);
+    this.nodeCuller = new GPUCuller(gpu.device, this.buffers, NODE_CULL);
+    this.indexBuilder.onIndex = (index, epoch) => {
+      // Positions replaced since the snapshot: keep whatever matches them
+      if (epoch !== this.positionsEpoch) return;
+      this.spatialIndex = index;
+      this.spatialIndexEpoch = epoch;
+    };
     this.simParams = { ...defaultSimulationParams(), ...options.simParams };
     this.renderParams = { ...defaultRenderParams(), ...options.renderParams };
+    this.layoutCache = options.layoutCache === false ? null : options.layoutCache ?? new LayoutCache();
 
     if (options.tooltip !== false) {
       this.tooltip = new Tooltip(gpu.canvas.parentElement!);
@@ -145,16 +206,26 @@ export class HyperblobEngine {
   private setupInputHandler(): void {
     const opts = this.options;
 
+    this.picker.onPick = ({ node, edge, screenX, screenY }) => {
+      // Indices from before a reload or mutation may no longer exist
+      const edgeCount = this.store?.edgeCount ?? 0;
+      this.inputHandlerInstance?.applyPick(
+        node !== null && node < this.nodeCount ? node : null,
+        edge !== null && edge < edgeCount ? edge : null,
+        screenX, screenY,
+      );
+    };
+
     this.inputHandlerInstance = new InputHandler(this.gpu.canvas, this.camera, {
       hitTest: (wx: number, wy: number) => this.hitTestNode(wx, wy),
       onDragStart: (nodeIndex: number) => {
         this.draggedNodeIndex = nodeIndex;
+        this.layoutRequest++;
+        this.dragWasPinned = this.pins.isPinned(nodeIndex);
         if (this.cpuPositions) {
-          const x = this.cpuPositions[nodeIndex * 4];
-          const y = this.cpuPositions[nodeIndex * 4 + 1];
-          this.dragSmoothPos = [x, y];
-          this.dragTargetPos = [x, y];
-          this.dragPrevPos = [x, y];
+          this.dragTargetArray[0] = this.cpuPositions[nodeIndex * 4];
+          this.dragTargetArray[1] = this.cpuPositions[nodeIndex * 4 + 1];
+          this.pins.pin([nodeIndex], this.dragTargetArray);
         }
         if (this.simParams.energy < 0.08) {
           this.simParams.energy = 0.08;
@@ -162,28 +233,29 @@ export class HyperblobEngine {
         this.simParams.running = true;
       },
       onDrag: (_nodeIndex: number, wx: number, wy: number) => {
-        this.dragTargetPos = [wx, wy];
-        if (this.cpuPositions && this.draggedNodeIndex !== null) {
-          this.cpuPositions[this.draggedNodeIndex * 4] = wx;
-          this.cpuPositions[this.draggedNodeIndex * 4 + 1] = wy;
+        const i = this.draggedNodeIndex;
+        if (i === null) return;
+        // The integrate pass eases the node toward its pin target — one 8-byte write per pointer event
+        this.dragTargetArray[0] = wx;
+        this.dragTargetArray[1] = wy;
+        this.pins.pin([i], this.dragTargetArray);
+        if (this.cpuPositions) {
+          this.cpuPositions[i * 4] = wx;
+          this.cpuPositions[i * 4 + 1] = wy;
         }
       },
       onDragEnd: () => {
-        if (this.draggedNodeIndex !== null && this.dragSmoothPos && this.dragPrevPos && this.buffers.hasBuffer('node-positions')) {
-          const vx = (this.dragSmoothPos[0] - this.dragPrevPos[0]) * 4;
-          const vy = (this.dragSmoothPos[1] - this.dragPrevPos[1]) * 4;
-          const data = new Float32Array([this.dragSmoothPos[0], this.dragSmoothPos[1], vx, vy]);
-          this.buffers.uploadData('node-positions', data, this.draggedNodeIndex * 16);
+        // The pinned step left the node's velocity at its last displacement, so it flings on release
+        if (this.draggedNodeIndex !== null && !this.dragWasPinned) {
+          this.pins.unpin([this.draggedNodeIndex]);
         }
         this.draggedNodeIndex = null;
-        this.dragTargetPos = null;
-        this.dragSmoothPos = null;
-        this.dragPrevPos = null;
+        this.dragWasPinned = false;
       },
       onClick: (nodeIndex: number | null) => {
-        if (opts.onNodeClick && nodeIndex !== null && this.graphData) {
+        if (opts.onNodeClick && nodeIndex !== null && this.store) {
           // Custom callback — let consumer handle selection
-          opts.onNodeClick(nodeIndex, this.graphData.nodes[nodeIndex]);
+          opts.onNodeClick(nodeIndex, this.store.node(nodeIndex));
         } else if (opts.onEdgeClick && nodeIndex === null) {
           // Click on empty space — consumer might want to clear
           // (no action needed — consumer handles via onNodeClick(null))
@@ -207,47 +279,47 @@ export class HyperblobEngine {
         this.lastHoveredNode = nodeIndex;
 
         // Fire custom callback if provided
-        if (opts.onNodeHover && this.graphData) {
-          const node = nodeIndex !== null ? this.graphData.nodes[nodeIndex] : null;
+        if (opts.onNodeHover && this.store) {
+          const node = nodeIndex !== null ? this.store.node(nodeIndex) : null;
           opts.onNodeHover(nodeIndex, node, screenX, screenY);
         }
 
         // Built-in tooltip
         if (this.tooltip) {
-          if (nodeIndex === null || !this.graphData) {
+          const store = this.store;
+          if (nodeIndex === null || !store) {
             if (this.lastHoveredEdge === null) this.tooltip.hide();
             return;
           }
-          const node = this.graphData.nodes[nodeIndex];
-          const edgeLabels = this.graphData.hyperedges
-            .filter(he => he.memberIndices.includes(nodeIndex))
-            .map(he => String(he.attrs?.name ?? he.attrs?.label ?? `Edge ${he.id}`));
-          const nodeLabel = String(node?.attrs?.name ?? node?.attrs?.label ?? node?.id ?? `#${nodeIndex}`);
-          this.tooltip.showNode(screenX, screenY, nodeLabel, edgeLabels);
+          const edgeLabels = Array.from(store.edgesOf(nodeIndex), e => this.edgeLabel(e));
+          const { nodeAttrs } = store;
+          const nodeLabel = String(
+            nodeAttrs.get(nodeIndex, 'name') ?? nodeAttrs.get(nodeIndex, 'label') ?? store.nodeIds.ids[nodeIndex] ?? `#${nodeIndex}`,
+          );
+          this.tooltip.showNode(screenX, screenY, nodeLabel, edgeLabels, this.originalNodeIds(nodeIndex));
         }
       },
-      hitTestEdge: (wx: number, wy: number) => this.hitTestEdge(wx, wy),
+      requestPick: (screenX: number, screenY: number) => this.picker.request(screenX, screenY),
       onHoverEdge: (edgeIndex: number | null, screenX: number, screenY: number) => {
         if (edgeIndex === this.lastHoveredEdge) return;
         this.lastHoveredEdge = edgeIndex;
 
         // Fire custom callback if provided
-        if (opts.onEdgeHover && this.graphData) {
-          const edge = edgeIndex !== null ? this.graphData.hyperedges[edgeIndex] : null;
+        if (opts.onEdgeHover && this.store) {
+          const edge = edgeIndex !== null && edgeIndex < this.store.edgeCount ? this.store.hyperedge(edgeIndex) : null;
           opts.onEdgeHover(edgeIndex, edge, screenX, screenY);
         }
 
         // Built-in tooltip
         if (this.tooltip) {
-          if (edgeIndex === null || !this.graphData) {
+          const store = this.store;
+          if (edgeIndex === null || !store) {
             if (this.lastHoveredNode === null) this.tooltip.hide();
             return;
           }
-          const he = this.graphData.hyperedges[edgeIndex];
-          if (!he) { this.tooltip.hide(); return; }
-          const label = String(he.attrs?.name ?? he.attrs?.label ?? `Edge ${he.id}`);
-          const members = he.memberIndices.map(i => this.graphData!.nodes[i]?.id ?? `#${i}`);
-          this.tooltip.show(screenX, screenY, label, members);
+          if (edgeIndex >= store.edgeCount) { this.tooltip.hide(); return; }
+          const members = Array.from(store.members(edgeIndex), i => store.nodeIds.ids[i] ?? `#${i}`);
+          this.tooltip.show(screenX, screenY, this.edgeLabel(edgeIndex), members, this.originalEdgeIds(edgeIndex).map(String));
         }
       },
     });
@@ -269,6 +341,8 @@ export class HyperblobEngine {
         { binding: 2, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },
         { binding: 3, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },
         { binding: 4, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },
+        { binding: 5, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },
+        { binding: 6, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },
       ],
     });
 
@@ -299,7 +373,10 @@ export class HyperblobEngine {
   private createNodeBindGroup(): void {
     if (!this.nodeRenderPipeline || !this.cameraBuffer || !this.paramsBuffer || !this.paletteBuffer) return;
     if (!this.buffers.hasBuffer('node-positions') || !this.buffers.hasBuffer('node-metadata')) return;
+    if (!this.buffers.hasBuffer('node-weights')) return;
 
+    this.nodeCuller.reserve(this.nodeCount, this.nodeCount);
+    this.nodeCullVersion = this.nodeCuller.version;
     this.nodeBindGroup = this.gpu.device.createBindGroup({
       label: 'node-render-bind-group',
       layout: this.nodeRenderPipeline.getBindGroupLayout(0),
@@ -309,74 +386,231 @@ export class HyperblobEngine {
         { binding: 2, resource: { buffer: this.buffers.getBuffer('node-metadata') } },
         { binding: 3, resource: { buffer: this.paramsBuffer } },
         { binding: 4, resource: { buffer: this.paletteBuffer } },
+        { binding: 5, resource: { buffer: this.buffers.getBuffer('node-weights') } },
+        { binding: 6, resource: { buffer: this.nodeCuller.visibleBuffer } },
       ],
     });
+    this.picker.setNodeBuffers(
+      this.buffers.getBuffer('node-positions'), this.buffers.getBuffer('node-metadata'),
+      this.paramsBuffer, this.buffers.getBuffer('node-weights'),
+      this.nodeCuller.visibleBuffer, this.nodeCuller.argsBuffer,
+    );
   }
 
   // ── Public API ──
 
-  setData(data: HypergraphData): void {
-    this.graphData = data;
-    this.nodeCount = data.nodes.length;
+  /**
+   * Load a graph. With `positions` ([x, y, vx, vy] per node, e.g. a saved
+   * layout) nodes start there and the simulation stays paused.
+   */
+  setData(data: HypergraphData | HypergraphStore, positions?: Float32Array | null): void {
+    const store = data instanceof HypergraphStore ? data : HypergraphStore.fromHypergraph(data);
+    this.loadGraph(store, positions ?? null, null);
+  }
+
+  /**
+   * Load a `.hblob` container (src/data/binary-format.ts). CSR, node metadata
+   * and saved positions go to the GPU straight from views into `buffer`; when
+   * the file carries positions the layout is not re-run.
+   */
+  loadBinary(buffer: ArrayBuffer): HypergraphStore {
+    const bin = decodeHypergraphBinary(buffer);
+    const store = storeFromBinary(bin);
+    this.loadGraph(store, bin.positions, bin.metadata);
+    return store;
+  }
+
+  /**
+   * Stream a HIF document into the engine, drawing and laying out the graph
+   * while bytes are still arriving: each parsed batch goes through
+   * `applyDelta`, so placed nodes keep settling and new ones land beside
+   * their neighbors. The camera follows the growing layout until the stream
+   * ends. Resolves with the loaded store; rejects if another load replaces
+   * the graph first.
+   */
+  async loadHIFStream(source: ReadableStream<Uint8Array>, options: HIFStreamOptions = {}): Promise<HypergraphStore> {
+    const { streamHIFBatches } = await import('./data/hif-stream');
+    this.setData(HypergraphStore.empty());
+    const store = this.store!;
+    await streamHIFBatches(source, {
+      ...options,
+      onBatch: (delta) => {
+        if (this.store !== store || this.disposed) throw new Error('HIF stream superseded by another load');
+        this.applyDelta(delta);
+        if (this.nodeCount === 0) return;
+        const [cx, cy, size] = this.layoutExtent(this.nodeCount);
+        this.camera.fitBounds(cx - size / 2, cy - size / 2, cx + size / 2, cy + size / 2);
+      },
+    });
+    // The structure is complete: its converged layout can be cached like a one-shot load
+    if (this.store === store && this.layoutCache && this.nodeCount > 0) {
+      this.layoutKey = layoutKey(store);
+      this.layoutSaved = false;
+    }
+    return store;
+  }
+
+  /** Serialize the current graph and its layout as a `.hblob` container. */
+  async exportBinary(): Promise<ArrayBuffer> {
+    if (!this.store) throw new Error('No graph loaded');
+    const positions = this.nodeCount > 0
+      ? await this.buffers.readBuffer('node-positions', this.nodeCount * 16)
+      : null;
+    return encodeHypergraphBinary(this.store, positions);
+  }
+
+  private loadGraph(
+    store: HypergraphStore,
+    savedPositions: Float32Array | null,
+    savedMetadata: Uint32Array | null,
+  ): void {
+    this.checkCapacity(store.nodeCount, store.memberCount);
+    this.store = store;
+    this.nodeCount = store.nodeCount;
     this.selectedNode = null;
     this.visibleNodes = null;
     this.highlightedNodes = null;
+    this.pendingNodes.clear();
     // dimmed state is tracked by edge/hull renderers
 
-    // Upload positions: [x, y, vx, vy] per node — random initial positions
-    const positions = new Float32Array(data.nodes.length * 4);
-    const spread = Math.sqrt(data.nodes.length) * 10;
-    for (let i = 0; i < data.nodes.length; i++) {
-      positions[i * 4 + 0] = (Math.random() - 0.5) * spread;
-      positions[i * 4 + 1] = (Math.random() - 0.5) * spread;
-      positions[i * 4 + 2] = 0;
-      positions[i * 4 + 3] = 0;
+    // Upload positions: [x, y, vx, vy] per node — saved layout or random initial positions
+    const n = store.nodeCount;
+    this.rng = rngFor(this.options.seed);
+    let positions: Float32Array;
+    let minX: number, minY: number, maxX: number, maxY: number;
+    if (savedPositions) {
+      if (savedPositions.length < n * 4) throw new Error(`positions holds ${savedPositions.length / 4} nodes, expected ${n}`);
+      positions = savedPositions.subarray(0, n * 4);
+      minX = minY = Infinity;
+      maxX = maxY = -Infinity;
+      for (let i = 0; i < n; i++) {
+        minX = Math.min(minX, positions[i * 4]); maxX = Math.max(maxX, positions[i * 4]);
+        minY = Math.min(minY, positions[i * 4 + 1]); maxY = Math.max(maxY, positions[i * 4 + 1]);
+      }
+    } else {
+      positions = new Float32Array(n * 4);
+      const spread = Math.sqrt(n) * 10;
+      for (let i = 0; i < n; i++) {
+        positions[i * 4 + 0] = (this.rng() - 0.5) * spread;
+        positions[i * 4 + 1] = (this.rng() - 0.5) * spread;
+        positions[i * 4 + 2] = 0;
+        positions[i * 4 + 3] = 0;
+      }
+      minX = minY = -spread / 2;
+      maxX = maxY = spread / 2;
     }
-    this.buffers.createBuffer('node-positions', positions.byteLength,
+    // Buffers are pooled across loads: only reallocated when the new graph outgrows them
+    this.buffers.ensureCapacity('node-positions', positions.byteLength,
       GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC, 'node-positions');
     this.buffers.uploadData('node-positions', positions);
 
     this.cpuPositions = new Float32Array(positions);
+    this.positionsEpoch++;
 
     // Upload metadata: [group, flags] per node
-    const metadata = new Uint32Array(data.nodes.length * 2);
-    for (let i = 0; i < data.nodes.length; i++) {
-      metadata[i * 2 + 0] = data.nodes[i].group;
-      metadata[i * 2 + 1] = 0;
+    let metadata = savedMetadata;
+    if (!metadata) {
+      metadata = new Uint32Array(n * 2);
+      for (let i = 0; i < n; i++) {
+        metadata[i * 2 + 0] = store.groups[i];
+        metadata[i * 2 + 1] = 0;
+      }
     }
-    this.buffers.createBuffer('node-metadata', metadata.byteLength,
+    this.buffers.ensureCapacity('node-metadata', metadata.byteLength,
       GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'node-metadata');
     this.buffers.uploadData('node-metadata', metadata);
 
-    this.uploadHyperedgeBuffers(data);
+    this.uploadHyperedgeBuffers(true);
+    this.syncWeights();
     this.createNodeBindGroup();
 
     // Setup edge renderer
     if (!this.edgeRendererInstance) {
       this.edgeRendererInstance = new EdgeRenderer(this.gpu, this.buffers, this.camera);
     }
-    this.edgeRendererInstance.setData(data);
+    this.edgeRendererInstance.setData(store);
 
     // Setup hull renderer
     if (!this.hullRendererInstance) {
       this.hullRendererInstance = new HullRenderer(this.gpu, this.buffers, this.camera);
     }
-    this.hullRendererInstance.setData(data);
+    this.hullRendererInstance.setData(store);
 
     // Setup boundary renderer
     if (!this.boundaryRendererInstance) {
       this.boundaryRendererInstance = new BoundaryRenderer(this.gpu, this.camera);
     }
 
-    // Setup force simulation
-    this.simulation = new ForceSimulation(this.gpu.device, this.buffers, data, this.simParams, this.profiler, this.gpu.features);
+    // Pins are per-dataset; the integrate pass binds their buffers
+    this.pins.reset(n);
 
-    this.simParams.energy = 1.0;
-    this.simParams.running = true;
+    // Setup force simulation — reused across loads so a dataset switch costs uploads only
+    if (this.simulation) {
+      this.simulation.setGraphSize(n, store.edgeCount);
+      this.simulation.resetBounds();
+    } else {
+      this.simulation = new ForceSimulation(
+        this.gpu.device, this.buffers, { nodeCount: n, edgeCount: store.edgeCount },
+        this.simParams, this.profiler, this.gpu.features,
+      );
+    }
+
+    // A saved layout is already settled — show it as-is until the user reheats
+    this.simParams.energy = savedPositions ? this.simParams.idleEnergy : 1.0;
+    this.simParams.running = !savedPositions;
+
+    if (n > 0) this.camera.fitBounds(minX, minY, maxX, maxY);
+
+    // Identical structure seen before → restore its converged layout once the lookup lands
+    const request = ++this.layoutRequest;
+    this.layoutKey = this.layoutCache && n > 0 ? layoutKey(store) : null;
+    this.layoutSaved = savedPositions !== null;
+    if (this.layoutKey && !savedPositions) this.restoreLayout(this.layoutKey, request);
+  }
 
-    this.camera.fitBounds(-spread / 2, -spread / 2, spread / 2, spread / 2);
+  /** Replace the random start with a cached layout, unless the user or a new load got there first. */
+  private async restoreLayout(key: string, request: number): Promise<void> {
+    let positions: Float32Array | null = null;
+    try {
+      positions = await this.layoutCache!.load(key, this.nodeCount);
+    } catch (e) {
+      console.warn('Layout cache lookup failed:', e);
+    }
+    if (!positions || request !== this.layoutRequest || this.disposed) return;
+
+    this.buffers.uploadData('node-positions', positions);
+    this.cpuPositions = positions;
+    this.positionsEpoch++;
+    this.layoutSaved = true;
+    this.simParams.energy = this.simParams.idleEnergy;
+    this.simParams.running = false;
+    this.simulation?.resetBounds();
+    this.hullRendererInstance?.forceRecompute();
+    this.boundaryRendererInstance?.updateFromPositions(positions, this.nodeCount, this.renderParams.nodeBaseSize);
+    const [cx, cy, size] = this.layoutExtent(this.nodeCount);
+    this.camera.fitBounds(cx - size / 2, cy - size / 2, cx + size / 2, cy + size / 2);
   }
 
+  /** Persist the converged layout of the loaded dataset (once per load). */
+  private saveLayout(): void {
+    const key = this.layoutKey;
+    if (!key || this.layoutSaved || !this.layoutCache || this.nodeCount === 0) return;
+    this.layoutSaved = true;
+    const cache = this.layoutCache;
+    this.buffers.readBuffer('node-positions', this.nodeCount * 16)
+      .then(positions => key === this.layoutKey ? cache.save(key, positions) : undefined)
+      .catch(e => console.warn('Layout cache write failed:', e));
+  }
+
+  /** Use a different layout cache, or null to stop reading and writing cached layouts. */
+  setLayoutCache(cache: LayoutCache | null): void {
+    this.layoutCache = cache;
+    this.layoutRequest++;
+    this.layoutKey = cache && this.store && this.nodeCount > 0 ? layoutKey(this.store) : null;
+  }
+
+  getLayoutCache(): LayoutCache | null { return this.layoutCache; }
+
   start(): void {
     if (this.running) return;
     this.running = true;
@@ -388,15 +622,60 @@ export class HyperblobEngine {
     this.running = false;
     this.inputHandlerInstance?.dispose();
     this.profiler.destroy();
+    this.renderProfiler.destroy();
+    this.picker.destroy();
+    this.indexBuilder.dispose();
     this.buffers.destroyAll();
   }
 
+  /**
+   * Most incidences a graph can have on this device. Edge draw indices take
+   * 8 bytes per incidence and node positions 16 bytes per node; a sample can
+   * have as many nodes as incidences, so this is the binding limit / 16.
+   * Use it as the budget of `sampleHIFStream` previews.
+   */
+  maxIncidences(): number {
+    return Math.floor(this.storageBindingLimit() / 16);
+  }
+
+  getSelectedNode(): number | null { return this.selectedNode; }
   getCamera(): Camera { return this.camera; }
   getNodeCount(): number { return this.nodeCount; }
-  getGraphData(): HypergraphData | null { return this.graphData; }
+  /** Object view of the graph — built on first access; prefer getStore() for large graphs. */
+  getGraphData(): HypergraphData | null { return this.store?.toHypergraph() ?? null; }
+  getStore(): HypergraphStore | null { return this.store; }
+
+  /** IDs of the original nodes node `i` stands for after structural reduction (just its own ID otherwise). */
+  originalNodeIds(i: number): string[] {
+    const store = this.store;
+    if (!store || i < 0 || i >= this.nodeCount) return [];
+    const collapsed = store.nodeAttrs.get(i, COLLAPSED_NODES);
+    return Array.isArray(collapsed) ? collapsed : [store.nodeIds.ids[i]];
+  }
+
+  /** IDs of the original hyperedges hyperedge `e` stands for after structural reduction. */
+  originalEdgeIds(e: number): (string | number)[] {
+    const store = this.store;
+    if (!store || e < 0 || e >= store.edgeCount) return [];
+    const collapsed = store.edgeAttrs.get(e, COLLAPSED_EDGES);
+    return Array.isArray(collapsed) ? collapsed : [store.edgeIds[e]];
+  }
   getBufferManager(): BufferManager { return this.buffers; }
   getGPU(): GPUContext { return this.gpu; }
   getGPUTimings(): GPUStageTiming[] | null { return this.profiler.getLatestTimings(); }
+  /** GPU time of the last profiled frame's render passes ('metaball-field' below full resolution, 'render'). */
+  getRenderTimings(): GPUStageTiming[] | null { return this.renderProfiler.getLatestTimings(); }
+
+  /** Seed for initial placement on the next setData/resetSimulation (undefined = Math.random). */
+  setSeed(seed: number | undefined): void {
+    this.options.seed = seed;
+  }
+
+  /** Live GPU buffer count/bytes and compiled compute pipelines — should stay flat across dataset switches. */
+  getResourceStats(): { buffers: number; bufferBytes: number; pipelines: number } {
+    const { count, bytes } = this.buffers.getStats();
+    return { buffers: count, bufferBytes: bytes, pipelines: getPipelineCache(this.gpu.device).pipelineCount };
+  }
 
   handleResize(): void {
     const canvas = this.gpu.canvas;
@@ -426,32 +705,30 @@ export class HyperblobEngine {
   // ── Highlight API (dim-based: non-highlighted → 12% alpha) ──
 
   highlightNodes(indices: number[]): void {
-    if (!this.graphData || !this.buffers.hasBuffer('node-metadata')) return;
+    const store = this.store;
+    if (!store || !this.buffers.hasBuffer('node-metadata')) return;
 
     const highlightSet = new Set(indices);
     this.highlightedNodes = highlightSet;
 
-    // Find edges containing any highlighted node
-    const activeEdges = new Set<number>();
+    // Dim edges with no highlighted member
+    const activeEdges = new Uint8Array(store.edgeCount);
+    for (const i of highlightSet) {
+      if (i >= 0 && i < this.nodeCount) for (const e of store.edgesOf(i)) activeEdges[e] = 1;
+    }
     const dimmedEdges = new Set<number>();
-
-    for (const he of this.graphData.hyperedges) {
-      const hasHighlighted = he.memberIndices.some(idx => highlightSet.has(idx));
-      if (hasHighlighted) {
-        activeEdges.add(he.index);
-      } else {
-        dimmedEdges.add(he.index);
-      }
+    for (let e = 0; e < store.edgeCount; e++) {
+      if (!activeEdges[e]) dimmedEdges.add(e);
     }
     // dimmedEdges state is tracked by edge/hull renderers below
 
     // Update node metadata: bit 1 = dimmed
     const metadata = new Uint32Array(this.nodeCount * 2);
     for (let i = 0; i < this.nodeCount; i++) {
-      metadata[i * 2] = this.graphData.nodes[i].group;
+      metadata[i * 2] = store.groups[i];
       // Preserve bit 0 (hidden from filter), set/clear bit 1 (dimmed)
       let flags = 0;
-      if (this.nodeFilterPredicate && !this.nodeFilterPredicate(this.graphData.nodes[i], i)) {
+      if (this.nodeFilterPredicate && !this.nodeFilterPredicate(store.node(i), i)) {
         flags |= 1; // hidden
       }
       if (!highlightSet.has(i)) {
@@ -473,14 +750,13 @@ export class HyperblobEngine {
   }
 
   highlightEdge(edgeIndex: number): void {
-    if (!this.graphData) return;
-    const he = this.graphData.hyperedges[edgeIndex];
-    if (!he) return;
-    this.highlightNodes(he.memberIndices);
+    if (!this.store || edgeIndex < 0 || edgeIndex >= this.store.edgeCount) return;
+    this.highlightNodes(Array.from(this.store.members(edgeIndex)));
   }
 
   clearHighlight(): void {
-    if (!this.graphData || !this.buffers.hasBuffer('node-metadata')) return;
+    const store = this.store;
+    if (!store || !this.buffers.hasBuffer('node-metadata')) return;
 
     this.highlightedNodes = null;
     // dimmed state is tracked by edge/hull renderers
@@ -488,9 +764,9 @@ export class HyperblobEngine {
     // Reset all metadata flags (preserving filter state)
     const metadata = new Uint32Array(this.nodeCount * 2);
     for (let i = 0; i < this.nodeCount; i++) {
-      metadata[i * 2] = this.graphData.nodes[i].group;
+      metadata[i * 2] = store.groups[i];
       let flags = 0;
-      if (this.nodeFilterPredicate && !this.nodeFilterPredicate(this.graphData.nodes[i], i)) {
+      if (this.nodeFilterPredicate && !this.nodeFilterPredicate(store.node(i), i)) {
         flags |= 1; // hidden
       }
       metadata[i * 2 + 1] = flags;
@@ -508,7 +784,8 @@ export class HyperblobEngine {
   // ── Search/Filter API ──
 
   setNodeFilter(predicate: ((node: NodeData, index: number) => boolean) | null): void {
-    if (!this.graphData || !this.buffers.hasBuffer('node-metadata')) return;
+    const store = this.store;
+    if (!store || !this.buffers.hasBuffer('node-metadata')) return;
 
     this.nodeFilterPredicate = predicate;
 
@@ -517,7 +794,7 @@ export class HyperblobEngine {
       this.visibleNodes = null;
       const metadata = new Uint32Array(this.nodeCount * 2);
       for (let i = 0; i < this.nodeCount; i++) {
-        metadata[i * 2] = this.graphData.nodes[i].group;
+        metadata[i * 2] = store.groups[i];
         let flags = 0;
         if (this.highlightedNodes && !this.highlightedNodes.has(i)) {
           flags |= 2; // dimmed
@@ -527,7 +804,7 @@ export class HyperblobEngine {
       this.buffers.uploadData('node-metadata', metadata);
 
       if (this.edgeRendererInstance) {
-        this.edgeRendererInstance.setVisibleEdges(this.graphData, null);
+        this.edgeRendererInstance.setVisibleEdges(store, null);
       }
       if (this.hullRendererInstance) {
         this.hullRendererInstance.setVisibleEdges(null);
@@ -536,7 +813,7 @@ export class HyperblobEngine {
       // Apply filter
       const visibleNodes = new Set<number>();
       for (let i = 0; i < this.nodeCount; i++) {
-        if (predicate(this.graphData.nodes[i], i)) {
+        if (predicate(store.node(i), i)) {
           visibleNodes.add(i);
         }
       }
@@ -544,15 +821,13 @@ export class HyperblobEngine {
 
       // Determine visible edges (at least one member visible)
       const visibleEdges = new Set<number>();
-      for (const he of this.graphData.hyperedges) {
-        if (he.memberIndices.some(idx => visibleNodes.has(idx))) {
-          visibleEdges.add(he.index);
-        }
+      for (const i of visibleNodes) {
+        for (const e of store.edgesOf(i)) visibleEdges.add(e);
       }
 
       const metadata = new Uint32Array(this.nodeCount * 2);
       for (let i = 0; i < this.nodeCount; i++) {
-        metadata[i * 2] = this.graphData.nodes[i].group;
+        metadata[i * 2] = store.groups[i];
         let flags = 0;
         if (!visibleNodes.has(i)) flags |= 1; // hidden
         if (this.highlightedNodes && !this.highlightedNodes.has(i)) flags |= 2; // dimmed
@@ -561,7 +836,7 @@ export class HyperblobEngine {
       this.buffers.uploadData('node-metadata', metadata);
 
       if (this.edgeRendererInstance) {
-        this.edgeRendererInstance.setVisibleEdges(this.graphData, visibleEdges);
+        this.edgeRendererInstance.setVisibleEdges(store, visibleEdges);
       }
       if (this.hullRendererInstance) {
         this.hullRendererInstance.setVisibleEdges(visibleEdges);
@@ -569,6 +844,191 @@ export class HyperblobEngine {
     }
   }
 
+  // ── Incremental mutation API ──
+  // Patches buffers in place instead of rebuilding through setData: existing
+  // nodes keep their positions and velocities, new nodes are seeded next to
+  // their hyperedge neighbors, and the energy bump scales with the share of
+  // the graph that changed.
+
+  /** Append nodes. Returns their indices. Nodes without hyperedges are placed provisionally and re-seeded when an edge references them. */
+  addNodes(nodes: NodeInput[]): number[] {
+    if (!this.store) this.setData(HypergraphStore.empty());
+    const added = this.placeNodes(nodes);
+    if (added.length === 0) return added;
+    this.syncTopology();
+    this.reheatEdited(added.length);
+    return added;
+  }
+
+  /**
+   * Apply a batch of additions with a single topology sync: new nodes, new
+   * hyperedges, members appended to existing hyperedges and attribute
+   * updates. Used by progressive loading (`loadHIFStream`).
+   */
+  applyDelta(delta: GraphDelta): void {
+    if (!this.store) this.setData(HypergraphStore.empty());
+    const store = this.store!;
+    let incoming = 0;
+    for (const edge of delta.edges) incoming += edge.memberIndices.length;
+    for (const { memberIndices } of delta.extendedEdges) incoming += memberIndices.length;
+    this.checkCapacity(this.nodeCount + delta.nodes.length, store.memberCount + incoming);
+    const addedNodes = this.placeNodes(delta.nodes);
+    const addedEdges = store.insertHyperedges(delta.edges);
+    store.extendHyperedges(delta.extendedEdges);
+    for (const { index, attrs } of delta.nodeAttrs) store.setNodeAttrs(index, attrs);
+    for (const { index, attrs } of delta.edgeAttrs) store.setEdgeAttrs(index, attrs);
+
+    let touched = addedNodes.length;
+    for (const e of addedEdges) touched += store.edgeSize(e);
+    for (const { memberIndices } of delta.extendedEdges) touched += memberIndices.length;
+    if (touched === 0) return;
+
+    // Extended edges precede the appended ones, so this stays in ascending (first-edge) order
+    this.seedPendingNodes([...delta.extendedEdges.map(x => x.index), ...addedEdges]);
+    this.syncTopology();
+    this.reheatEdited(touched);
+  }
+
+  /** Remove nodes (and their memberships). Remaining node indices are compacted. */
+  removeNodes(indices: number[]): void {
+    if (!this.store) return;
+    const prevCount = this.nodeCount;
+    const remap = this.store.deleteNodes(indices);
+    this.nodeCount = this.store.nodeCount;
+    if (this.nodeCount === prevCount) return;
+
+    // Compact positions on the GPU, one copy per surviving run
+    const ranges: [number, number, number][] = [];
+    for (let i = 0; i < prevCount;) {
+      if (remap[i] < 0) { i++; continue; }
+      const start = i;
+      while (i < prevCount && remap[i] >= 0) i++;
+      ranges.push([start * 16, remap[start] * 16, (i - start) * 16]);
+    }
+    this.buffers.compactRanges('node-positions', ranges);
+
+    if (this.cpuPositions) {
+      const compacted = new Float32Array(this.nodeCount * 4);
+      for (const [src, dst, size] of ranges) {
+        compacted.set(this.cpuPositions.subarray(src / 4, (src + size) / 4), dst / 4);
+      }
+      this.cpuPositions = compacted;
+    }
+    this.positionsEpoch++;
+
+    // Remap index-keyed interaction state
+    const mapIndex = (i: number | null): number | null => (i === null || i >= prevCount || remap[i] < 0 ? null : remap[i]);
+    this.selectedNode = mapIndex(this.selectedNode);
+    if (this.highlightedNodes) {
+      const next = new Set<number>();
+      for (const i of this.highlightedNodes) {
+        const m = mapIndex(i);
+        if (m !== null) next.add(m);
+      }
+      this.highlightedNodes = next;
+    }
+    const pending = new Map<number, boolean>();
+    for (const [i, autoGroup] of this.pendingNodes) {
+      const m = mapIndex(i);
+      if (m !== null) pending.set(m, autoGroup);
+    }
+    this.pendingNodes = pending;
+    if (this.draggedNodeIndex !== null) {
+      // Indices shifted under the cursor — drop the drag rather than move the wrong node
+      this.inputHandlerInstance?.cancelDrag();
+      if (!this.dragWasPinned && remap[this.draggedNodeIndex] >= 0) {
+        this.pins.unpin([this.draggedNodeIndex]);
+      }
+      this.draggedNodeIndex = null;
+      this.dragWasPinned = false;
+    }
+    this.pins.remap(remap, this.nodeCount);
+    this.lastHoveredNode = null;
+
+    this.syncTopology();
+    this.reheatEdited(prevCount - this.nodeCount);
+  }
+
+  /** Append hyperedges over existing node indices. Returns their indices. */
+  addHyperedges(edges: HyperedgeInput[]): number[] {
+    if (!this.store) return [];
+    const added = this.store.insertHyperedges(edges);
+    if (added.length === 0) return added;
+
+    let touched = 0;
+    for (const e of added) touched += this.store.edgeSize(e);
+    this.seedPendingNodes(added);
+    this.syncTopology();
+    this.reheatEdited(touched);
+    return added;
+  }
+
+  /** Remove hyperedges. Remaining hyperedge indices are compacted. */
+  removeHyperedges(indices: number[]): void {
+    const store = this.store;
+    if (!store) return;
+    const prevEdgeCount = store.edgeCount;
+    let touched = 0;
+    for (const e of indices) if (e >= 0 && e < prevEdgeCount) touched += store.edgeSize(e);
+    store.deleteHyperedges(indices);
+    if (store.edgeCount === prevEdgeCount) return;
+
+    this.lastHoveredEdge = null;
+    this.syncTopology();
+    this.reheatEdited(touched);
+  }
+
+  /** Replace the member list of one hyperedge. */
+  updateMembers(edgeIndex: number, memberIndices: number[]): void {
+    if (!this.store) return;
+    const before = edgeIndex >= 0 && edgeIndex < this.store.edgeCount ? this.store.edgeSize(edgeIndex) : 0;
+    this.store.setHyperedgeMembers(edgeIndex, memberIndices);
+
+    this.seedPendingNodes([edgeIndex]);
+    this.syncTopology();
+    this.reheatEdited(Math.max(before, memberIndices.length));
+  }
+
+  // ── Pin API ──
+  // Pinned nodes ignore forces and ease toward their target inside the
+  // integrate pass; changing pins costs one small buffer write, not per-frame uploads.
+
+  /** Pin nodes at `targets` (interleaved [x0, y0, x1, y1, ...]) or, if omitted, where they are now. */
+  pinNodes(indices: number[], targets?: ArrayLike<number>): void {
+    if (!this.store || indices.length === 0) return;
+    if (targets) {
+      if (targets.length < indices.length * 2) throw new Error(`pinNodes: expected ${indices.length * 2} target coordinates, got ${targets.length}`);
+      this.pins.pin(indices, targets);
+    } else {
+      const xy = new Float32Array(indices.length * 2);
+      for (let k = 0; k < indices.length; k++) {
+        const i = indices[k];
+        if (!this.cpuPositions || i < 0 || i >= this.nodeCount) continue;
+        xy[k * 2] = this.cpuPositions[i * 4];
+        xy[k * 2 + 1] = this.cpuPositions[i * 4 + 1];
+      }
+      this.pins.pin(indices, xy);
+    }
+    this.reheat(indices.length);
+  }
+
+  unpinNodes(indices: number[]): void {
+    if (!this.store || indices.length === 0) return;
+    this.pins.unpin(indices);
+    this.reheat(indices.length);
+  }
+
+  clearPins(): void {
+    if (this.pins.pinnedCount === 0) return;
+    const count = this.pins.pinnedCount;
+    this.pins.clear();
+    this.reheat(count);
+  }
+
+  getPinnedNodes(): number[] {
+    return this.pins.pinnedIndices();
+  }
+
   // ── Palette API ──
 
   setPalette(palette: Float32Array): void {
@@ -585,7 +1045,7 @@ export class HyperblobEngine {
    * then updates CPU positions and fits the camera.
    */
   async converge(): Promise<void> {
-    if (!this.simulation || !this.graphData) return;
+    if (!this.simulation || !this.store) return;
 
     // Calculate iterations: solve for n where energy ≈ idleEnergy
     // energy_n = (energy_0 - idle) * (1 - rate)^n + idle
@@ -600,14 +1060,23 @@ export class HyperblobEngine {
     }
     iterations = Math.min(Math.max(iterations, 50), 1000);
 
+    // A cached layout arriving mid-run would clobber the result
+    this.layoutRequest++;
+
     // Pause normal render-loop simulation during convergence
     const wasRunning = this.simParams.running;
     this.simParams.running = false;
 
     // Run simulation ticks — GPU queue serializes them
-    for (let i = 0; i < iterations; i++) {
-      this.simulation.tick(this.simParams);
-      this.simParams.energy += (this.simParams.idleEnergy - this.simParams.energy) * this.simParams.coolingRate;
+    this.syncNodeIncidence();
+    for (let i = 0; i < iterations;) {
+      if (this.simulation.tick(this.simParams)) {
+        this.simParams.energy += (this.simParams.idleEnergy - this.simParams.energy) * this.simParams.coolingRate;
+        i++;
+      } else {
+        // Deterministic mode: wait for the bounds readback instead of skipping the step
+        await this.simulation.whenReady();
+      }
     }
 
     // Wait for all GPU work to finish
@@ -628,27 +1097,33 @@ export class HyperblobEngine {
 
     // Fit camera to converged layout
     await this.fitToScreen();
+    this.saveLayout();
 
     // Restore simulation state (energy is now at idle)
     this.simParams.running = wasRunning;
   }
 
   resetSimulation(): void {
-    if (!this.graphData) return;
+    if (!this.store) return;
+    this.layoutRequest++;
+    this.layoutSaved = false;
     this.simParams.energy = 1.0;
     this.simParams.running = true;
-    const spread = Math.sqrt(this.graphData.nodes.length) * 10;
-    const positions = new Float32Array(this.graphData.nodes.length * 4);
-    for (let i = 0; i < this.graphData.nodes.length; i++) {
-      positions[i * 4 + 0] = (Math.random() - 0.5) * spread;
-      positions[i * 4 + 1] = (Math.random() - 0.5) * spread;
+    this.simulation?.resetBounds();
+    this.rng = rngFor(this.options.seed);
+    const spread = Math.sqrt(this.nodeCount) * 10;
+    const positions = new Float32Array(this.nodeCount * 4);
+    for (let i = 0; i < this.nodeCount; i++) {
+      positions[i * 4 + 0] = (this.rng() - 0.5) * spread;
+      positions[i * 4 + 1] = (this.rng() - 0.5) * spread;
     }
     this.buffers.uploadData('node-positions', positions);
     this.cpuPositions = new Float32Array(positions);
+    this.positionsEpoch++;
   }
 
   async fitToScreen(): Promise<void> {
-    if (!this.graphData || this.nodeCount === 0) return;
+    if (!this.store || this.nodeCount === 0) return;
     const posData = await this.buffers.readBuffer('node-positions', this.nodeCount * 16);
     let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
     for (let i = 0; i < this.nodeCount; i++) {
@@ -660,6 +1135,36 @@ export class HyperblobEngine {
     this.camera.fitBounds(minX, minY, maxX, maxY);
   }
 
+  // ── Spatial queries (world coordinates, over the CPU position cache) ──
+
+  /**
+   * Visible nodes inside the world-space rectangle. Positions are the CPU
+   * cache, refreshed every few frames; the grid index behind this and
+   * `queryRadius` / `nearest` visits only the cells the query overlaps.
+   */
+  queryRect(minX: number, minY: number, maxX: number, maxY: number): number[] {
+    const index = this.currentSpatialIndex();
+    return index ? this.filterQueryable(index.queryRect(minX, minY, maxX, maxY)) : [];
+  }
+
+  /** Visible nodes within `radius` world units of (x, y). */
+  queryRadius(x: number, y: number, radius: number): number[] {
+    const index = this.currentSpatialIndex();
+    return index ? this.filterQueryable(index.queryRadius(x, y, radius)) : [];
+  }
+
+  /** Up to `k` visible nodes nearest (x, y), closest first, at most `maxDistance` away. */
+  nearest(x: number, y: number, k = 1, maxDistance = Infinity): number[] {
+    const index = this.currentSpatialIndex();
+    if (!index || k <= 0) return [];
+    // Hidden nodes take candidate slots: widen the search until k visible ones are found
+    for (let want = k; ; want *= 2) {
+      const candidates = index.nearest(x, y, want, maxDistance);
+      const found = this.filterQueryable(candidates);
+      if (found.length >= k || candidates.length < want) return found.slice(0, k);
+    }
+  }
+
   // ── Internal: per-frame loop ──
 
   private tick = (): void => {
@@ -670,42 +1175,34 @@ export class HyperblobEngine {
       this.simParams.running = true;
     }
 
-    if (this.draggedNodeIndex !== null && this.dragSmoothPos && this.buffers.hasBuffer('node-positions')) {
-      this.dragUploadArray[0] = this.dragSmoothPos[0];
-      this.dragUploadArray[1] = this.dragSmoothPos[1];
-      this.dragUploadArray[2] = 0;
-      this.dragUploadArray[3] = 0;
-      this.buffers.uploadData('node-positions', this.dragUploadArray, this.draggedNodeIndex * 16);
-    }
-
     if (this.simulation && this.simParams.running && this.simParams.energy > this.simParams.stopThreshold) {
-      this.simulation.tick(this.simParams);
-      this.simParams.energy += (this.simParams.idleEnergy - this.simParams.energy) * this.simParams.coolingRate;
-    }
-
-    if (this.draggedNodeIndex !== null && this.dragTargetPos && this.dragSmoothPos && this.buffers.hasBuffer('node-positions')) {
-      this.dragPrevPos = [this.dragSmoothPos[0], this.dragSmoothPos[1]];
-      const t = 0.55;
-      this.dragSmoothPos[0] += (this.dragTargetPos[0] - this.dragSmoothPos[0]) * t;
-      this.dragSmoothPos[1] += (this.dragTargetPos[1] - this.dragSmoothPos[1]) * t;
-      this.dragUploadArray[0] = this.dragSmoothPos[0];
-      this.dragUploadArray[1] = this.dragSmoothPos[1];
-      this.buffers.uploadData('node-positions', this.dragUploadArray, this.draggedNodeIndex * 16);
+      this.syncNodeIncidence();
+      // Cool only on ticks that stepped, so deterministic runs take identical tick counts
+      if (this.simulation.tick(this.simParams)) {
+        this.simParams.energy += (this.simParams.idleEnergy - this.simParams.energy) * this.simParams.coolingRate;
+        if (this.simParams.energy < this.simParams.idleEnergy + SETTLED_ENERGY) this.saveLayout();
+      }
     }
 
     this.positionCacheCounter++;
     if (this.positionCacheCounter >= 10 && this.nodeCount > 0 && !this.cpuPositionsPending && this.buffers.hasBuffer('node-positions')) {
       this.positionCacheCounter = 0;
       this.cpuPositionsPending = true;
+      const epoch = this.positionsEpoch;
       this.buffers.readBuffer('node-positions', this.nodeCount * 16).then(data => {
-        this.cpuPositions = data;
         this.cpuPositionsPending = false;
+        // Positions were replaced (new dataset, reset, mutation) while the readback was in flight
+        if (epoch !== this.positionsEpoch || data.length !== this.nodeCount * 4) return;
+        this.cpuPositions = data;
         this.boundaryRendererInstance?.updateFromPositions(data, this.nodeCount, this.renderParams.nodeBaseSize);
       });
     }
 
-    if (this.hullRendererInstance && (this.draggedNodeIndex !== null || this.simParams.energy > 0.05)) {
-      this.hullRendererInstance.forceRecompute();
+    // The spatial index follows every new position cache, rebuilt off-thread
+    const cached = this.cpuPositions;
+    if (cached && cached !== this.indexedPositions) {
+      this.indexedPositions = cached;
+      this.indexBuilder.build(cached, Math.min(this.nodeCount, cached.length / 4), this.positionsEpoch);
     }
 
     try {
@@ -744,6 +1241,24 @@ export class HyperblobEngine {
     const textureView = texture.createView();
     const bg = this.renderParams.backgroundColor;
     const commandEncoder = device.createCommandEncoder();
+    this.renderProfiler.beginFrame();
+
+    // Hulls (convex) and metaball instances are built and binned on the GPU, ahead of the pass that draws them
+    if (this.hullRendererInstance && this.renderParams.hullAlpha > 0) {
+      this.hullRendererInstance.update(commandEncoder, this.renderParams, this.renderProfiler);
+    }
+
+    // Cull nodes and star edges to the view; their draws below are indirect
+    const drawNodes = this.nodeRenderPipeline !== null && this.nodeBindGroup !== null && this.nodeCount > 0;
+    if (drawNodes) {
+      this.nodeCuller.encode(commandEncoder, this.camera, this.renderParams.nodeBaseSize, this.nodeCount, this.nodeCount, [
+        this.buffers.getBuffer('node-positions'), this.buffers.getBuffer('node-metadata'), this.buffers.getBuffer('node-weights'),
+      ]);
+      if (this.nodeCuller.version !== this.nodeCullVersion) this.createNodeBindGroup();
+    }
+    if (this.edgeRendererInstance && this.renderParams.edgeOpacity > 0) {
+      this.edgeRendererInstance.encodeCulling(commandEncoder);
+    }
 
     const renderPass = commandEncoder.beginRenderPass({
       colorAttachments: [{
@@ -752,6 +1267,7 @@ export class HyperblobEngine {
         loadOp: 'clear',
         storeOp: 'store',
       }],
+      timestampWrites: this.renderProfiler.timestampWrites('render'),
     });
 
     // Boundary circle (behind everything)
@@ -760,39 +1276,50 @@ export class HyperblobEngine {
     }
 
     if (this.hullRendererInstance && this.renderParams.hullAlpha > 0) {
-      this.hullRendererInstance.render(renderPass, this.renderParams, this.cpuPositions);
+      this.hullRendererInstance.render(renderPass, this.renderParams);
     }
 
     if (this.edgeRendererInstance && this.renderParams.edgeOpacity > 0) {
       this.edgeRendererInstance.render(renderPass, this.renderParams);
     }
 
-    if (this.nodeRenderPipeline && this.nodeBindGroup && this.nodeCount > 0) {
-      renderPass.setPipeline(this.nodeRenderPipeline);
-      renderPass.setBindGroup(0, this.nodeBindGroup);
-      renderPass.draw(this.nodeCount * 6);
+    if (drawNodes) {
+      renderPass.setPipeline(this.nodeRenderPipeline!);
+      renderPass.setBindGroup(0, this.nodeBindGroup!);
+      renderPass.drawIndirect(this.nodeCuller.argsBuffer, 0);
     }
 
     renderPass.end();
+
+    // Node and top-most hyperedge under the cursor, if it moved since the last pick
+    const hulls = this.hullRendererInstance;
+    this.picker.encode(commandEncoder, this.camera, texture.width, texture.height, this.nodeCount, (pass, pickCamera) => {
+      if (hulls && this.renderParams.hullAlpha > 0) hulls.renderPick(pass, this.renderParams, pickCamera);
+    });
+
+    this.renderProfiler.resolve(commandEncoder);
     device.queue.submit([commandEncoder.finish()]);
+    this.renderProfiler.readback();
+    this.picker.readback();
   }
 
   // ── Internal: neighborhood selection (default click behavior) ──
 
   private applySelection(): void {
-    if (!this.graphData || !this.buffers.hasBuffer('node-metadata')) return;
+    const store = this.store;
+    if (!store || !this.buffers.hasBuffer('node-metadata')) return;
 
     if (this.selectedNode === null) {
       this.visibleNodes = null;
       const metadata = new Uint32Array(this.nodeCount * 2);
       for (let i = 0; i < this.nodeCount; i++) {
-        metadata[i * 2] = this.graphData.nodes[i].group;
+        metadata[i * 2] = store.groups[i];
         metadata[i * 2 + 1] = 0;
       }
       this.buffers.uploadData('node-metadata', metadata);
 
       if (this.edgeRendererInstance) {
-        this.edgeRendererInstance.setVisibleEdges(this.graphData, null);
+        this.edgeRendererInstance.setVisibleEdges(store, null);
       }
       if (this.hullRendererInstance) {
         this.hullRendererInstance.setVisibleEdges(null);
@@ -802,25 +1329,23 @@ export class HyperblobEngine {
       const visibleNodes = new Set<number>();
       visibleNodes.add(this.selectedNode);
 
-      for (const he of this.graphData.hyperedges) {
-        if (he.memberIndices.includes(this.selectedNode)) {
-          visibleEdges.add(he.index);
-          for (const idx of he.memberIndices) {
-            visibleNodes.add(idx);
-          }
+      for (const e of store.edgesOf(this.selectedNode)) {
+        visibleEdges.add(e);
+        for (const idx of store.members(e)) {
+          visibleNodes.add(idx);
         }
       }
       this.visibleNodes = visibleNodes;
 
       const metadata = new Uint32Array(this.nodeCount * 2);
       for (let i = 0; i < this.nodeCount; i++) {
-        metadata[i * 2] = this.graphData.nodes[i].group;
+        metadata[i * 2] = store.groups[i];
         metadata[i * 2 + 1] = visibleNodes.has(i) ? 0 : 1;
       }
       this.buffers.uploadData('node-metadata', metadata);
 
       if (this.edgeRendererInstance) {
-        this.edgeRendererInstance.setVisibleEdges(this.graphData, visibleEdges);
+        this.edgeRendererInstance.setVisibleEdges(store, visibleEdges);
       }
       if (this.hullRendererInstance) {
         this.hullRendererInstance.setVisibleEdges(visibleEdges);
@@ -833,59 +1358,259 @@ export class HyperblobEngine {
     }
   }
 
-  // ── Internal: hyperedge buffer upload ──
+  // ── Internal: incremental mutation helpers ──
+
+  /** Re-sync every consumer of the graph topology after a mutation. */
+  private syncTopology(): void {
+    const store = this.store!;
+
+    this.buffers.ensureCapacity('node-metadata', this.nodeCount * 8,
+      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'node-metadata');
+    this.uploadHyperedgeBuffers(false);
+    this.syncWeights();
+    this.createNodeBindGroup();
+
+    this.edgeRendererInstance?.setData(store);
+    this.hullRendererInstance?.setData(store);
+    this.pins.resize(this.nodeCount);
+    this.simulation?.setGraphSize(this.nodeCount, store.edgeCount);
+
+    this.reapplyViewState();
+    if (this.cpuPositions) {
+      this.boundaryRendererInstance?.updateFromPositions(this.cpuPositions, this.nodeCount, this.renderParams.nodeBaseSize);
+    }
+  }
+
+  /** Rewrite node metadata and edge visibility from the current selection/filter/highlight state. */
+  private reapplyViewState(): void {
+    const store = this.store!;
+    if (this.selectedNode !== null) {
+      this.applySelection();
+    } else if (this.nodeFilterPredicate) {
+      this.setNodeFilter(this.nodeFilterPredicate);
+    } else {
+      this.visibleNodes = null;
+      const metadata = new Uint32Array(this.nodeCount * 2);
+      for (let i = 0; i < this.nodeCount; i++) {
+        metadata[i * 2] = store.groups[i];
+      }
+      this.buffers.uploadData('node-metadata', metadata);
+      this.edgeRendererInstance?.setVisibleEdges(store, null);
+      this.hullRendererInstance?.setVisibleEdges(null);
+    }
+    if (this.highlightedNodes) {
+      this.highlightNodes([...this.highlightedNodes]);
+    }
+  }
+
+  private storageBindingLimit(): number {
+    const limits = this.gpu.device.limits;
+    return Math.min(limits.maxStorageBufferBindingSize, limits.maxBufferSize);
+  }
 
-  private uploadHyperedgeBuffers(data: HypergraphData): void {
-    const offsets = new Uint32Array(data.hyperedges.length + 1);
-    let totalMembers = 0;
-    for (let i = 0; i < data.hyperedges.length; i++) {
-      offsets[i] = totalMembers;
-      totalMembers += data.hyperedges[i].memberIndices.length;
+  /** Throw before allocating when a graph's per-node or per-incidence buffers would exceed the device limits. */
+  private checkCapacity(nodeCount: number, memberCount: number): void {
+    const limit = this.storageBindingLimit();
+    if (nodeCount * 16 <= limit && memberCount * 8 <= limit) return;
+    throw new Error(
+      `Graph with ${nodeCount} nodes and ${memberCount} incidences exceeds the device's ` +
+      `${limit}-byte storage buffer limit; load a sample instead (sampleHIFStream, budget ${this.maxIncidences()})`,
+    );
+  }
+
+  /** Insert nodes into the store and give them provisional positions (pending until an edge references them). */
+  private placeNodes(nodes: NodeInput[]): number[] {
+    const store = this.store!;
+    const prevCount = this.nodeCount;
+
+    const added = store.insertNodes(nodes);
+    if (added.length === 0) return added;
+    this.nodeCount = store.nodeCount;
+
+    this.buffers.ensureCapacity('node-positions', this.nodeCount * 16,
+      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC,
+      'node-positions', prevCount * 16);
+
+    // Provisional positions: scattered around the current layout center
+    const positions = new Float32Array(this.nodeCount * 4);
+    if (this.cpuPositions) positions.set(this.cpuPositions.subarray(0, prevCount * 4));
+    const [cx, cy, extent] = this.layoutExtent(prevCount);
+    for (let k = 0; k < added.length; k++) {
+      const i = added[k];
+      positions[i * 4 + 0] = cx + (this.rng() - 0.5) * extent;
+      positions[i * 4 + 1] = cy + (this.rng() - 0.5) * extent;
+      this.pendingNodes.set(i, nodes[k].group === undefined);
     }
-    offsets[data.hyperedges.length] = totalMembers;
+    this.cpuPositions = positions;
+    this.positionsEpoch++;
+    this.buffers.uploadData('node-positions', positions.subarray(prevCount * 4), prevCount * 16);
+    return added;
+  }
 
-    const members = new Uint32Array(totalMembers);
-    let offset = 0;
-    for (const he of data.hyperedges) {
-      for (const idx of he.memberIndices) {
-        members[offset++] = idx;
+  /**
+   * Place pending (edge-less) nodes that the given hyperedges now reference
+   * next to their already-placed co-members. Edges made entirely of pending
+   * nodes are anchored at a random point inside the current layout.
+   */
+  private seedPendingNodes(edgeIndices: number[]): void {
+    const store = this.store;
+    if (this.pendingNodes.size === 0 || !store || !this.cpuPositions) return;
+    const positions = this.cpuPositions;
+    const jitter = this.simParams.linkDistance * 0.5;
+    const seeded: number[] = [];
+
+    for (const e of edgeIndices) {
+      if (e < 0 || e >= store.edgeCount) continue;
+      const members = store.members(e);
+
+      let sx = 0, sy = 0, placed = 0;
+      for (const i of members) {
+        if (this.pendingNodes.has(i)) continue;
+        sx += positions[i * 4];
+        sy += positions[i * 4 + 1];
+        placed++;
+      }
+      if (placed === 0) {
+        const [cx, cy, extent] = this.layoutExtent(this.nodeCount);
+        sx = cx + (this.rng() - 0.5) * extent;
+        sy = cy + (this.rng() - 0.5) * extent;
+        placed = 1;
+      }
+      const ax = sx / placed;
+      const ay = sy / placed;
+
+      for (const i of members) {
+        const autoGroup = this.pendingNodes.get(i);
+        if (autoGroup === undefined) continue;
+        if (autoGroup) store.setGroup(i, e % 16);
+        positions[i * 4 + 0] = ax + (this.rng() - 0.5) * jitter;
+        positions[i * 4 + 1] = ay + (this.rng() - 0.5) * jitter;
+        positions[i * 4 + 2] = 0;
+        positions[i * 4 + 3] = 0;
+        this.pendingNodes.delete(i);
+        seeded.push(i);
       }
     }
 
-    this.buffers.createBuffer('he-offsets', offsets.byteLength,
-      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'he-offsets');
-    this.buffers.uploadData('he-offsets', offsets);
+    if (seeded.length > 0) this.positionsEpoch++;
 
-    this.buffers.createBuffer('he-members', Math.max(members.byteLength, 4),
-      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'he-members');
-    if (members.byteLength > 0) {
-      this.buffers.uploadData('he-members', members);
+    // Upload seeded slots, coalescing contiguous runs into one write each
+    seeded.sort((a, b) => a - b);
+    for (let k = 0; k < seeded.length;) {
+      const start = seeded[k];
+      let end = start + 1;
+      while (k + 1 < seeded.length && seeded[k + 1] === end) { k++; end++; }
+      k++;
+      this.buffers.uploadData('node-positions', positions.subarray(start * 4, end * 4), start * 16);
     }
   }
 
-  // ── Internal: hit testing ──
+  /** Center and extent of the first `count` cached positions (or a default box when empty). */
+  private layoutExtent(count: number): [number, number, number] {
+    const positions = this.cpuPositions;
+    if (!positions || count === 0) return [0, 0, Math.max(Math.sqrt(this.nodeCount) * 10, 10)];
+    let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
+    for (let i = 0; i < count; i++) {
+      const x = positions[i * 4];
+      const y = positions[i * 4 + 1];
+      if (x < minX) minX = x;
+      if (x > maxX) maxX = x;
+      if (y < minY) minY = y;
+      if (y > maxY) maxY = y;
+    }
+    return [(minX + maxX) / 2, (minY + maxY) / 2, Math.max(maxX - minX, maxY - minY, 10)];
+  }
+
+  /** Wake the simulation in proportion to how much of the graph changed. */
+  private reheat(affected: number): void {
+    this.layoutRequest++;
+    const share = affected / Math.max(this.nodeCount, 1);
+    const target = Math.min(1, 0.05 + share);
+    if (this.simParams.energy < target) this.simParams.energy = target;
+    this.simParams.running = true;
+  }
 
-  private hitTestEdge(worldX: number, worldY: number): number | null {
-    return this.hullRendererInstance?.hitTest(worldX, worldY, this.renderParams.hullMode) ?? null;
+  /** `reheat` after a structural edit: the graph no longer matches the loaded dataset's cache key. */
+  private reheatEdited(affected: number): void {
+    this.layoutKey = null;
+    this.reheat(affected);
   }
 
+  // ── Internal: hyperedge buffer upload ──
+
+  /** Upload the hyperedge CSR. Incremental calls only write the slots the store's mutations touched. */
+  private uploadHyperedgeBuffers(full: boolean): void {
+    const store = this.store!;
+    const dirty = store.takeCSRDirty();
+    this.incidenceStale = true;
+    const { offsets, members, edgeCount, memberCount } = store.csr;
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST;
+
+    const offsetsGrew = this.buffers.ensureCapacity('he-offsets', (edgeCount + 1) * 4, usage, 'he-offsets');
+    const offsetsStart = full || offsetsGrew ? 0 : dirty.offsetsStart;
+    if (offsetsStart <= edgeCount) {
+      this.buffers.uploadData('he-offsets', offsets.subarray(offsetsStart, edgeCount + 1), offsetsStart * 4);
+    }
+
+    const membersGrew = this.buffers.ensureCapacity('he-members', Math.max(memberCount * 4, 4), usage, 'he-members');
+    const membersStart = full || membersGrew ? 0 : dirty.membersStart;
+    if (membersStart < memberCount) {
+      this.buffers.uploadData('he-members', members.subarray(membersStart, memberCount), membersStart * 4);
+    }
+  }
+
+  /** Upload the node→edge CSR before a deterministic tick if the topology changed since the last one. */
+  private syncNodeIncidence(): void {
+    if (!this.simParams.deterministic || !this.incidenceStale || !this.store) return;
+    const { offsets, edges } = this.store.nodeEdges();
+    const memberCount = this.store.memberCount;
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST;
+
+    this.buffers.ensureCapacity('node-edge-offsets', (this.nodeCount + 1) * 4, usage, 'node-edge-offsets');
+    this.buffers.ensureCapacity('node-edge-ids', Math.max(memberCount * 4, 4), usage, 'node-edge-ids');
+    this.buffers.uploadData('node-edge-offsets', offsets.subarray(0, this.nodeCount + 1));
+    if (memberCount > 0) this.buffers.uploadData('node-edge-ids', edges.subarray(0, memberCount));
+
+    this.simulation?.refreshBindGroups();
+    this.incidenceStale = false;
+  }
+
+  /** Upload node/edge weights from the store's collapsed-ID columns (all 1 when not reduced). */
+  private syncWeights(): void {
+    const store = this.store!;
+    this.weights.update(
+      collapsedWeights(store.nodeAttrs, COLLAPSED_NODES, this.nodeCount), this.nodeCount,
+      collapsedWeights(store.edgeAttrs, COLLAPSED_EDGES, store.edgeCount), store.edgeCount,
+    );
+  }
+
+  /** Tooltip label for hyperedge `e`: its name/label attribute, else its ID. */
+  private edgeLabel(e: number): string {
+    const { edgeAttrs, edgeIds } = this.store!;
+    return String(edgeAttrs.get(e, 'name') ?? edgeAttrs.get(e, 'label') ?? `Edge ${edgeIds[e]}`);
+  }
+
+  // ── Internal: hit testing (synchronous fallback — hover and presses go through the GPU picker) ──
+
   private hitTestNode(worldX: number, worldY: number): number | null {
-    if (!this.cpuPositions || this.nodeCount === 0) return null;
     const hitRadius = (this.renderParams.nodeBaseSize * 1.5) / this.camera.zoom;
-    let bestDist = hitRadius;
-    let bestIndex: number | null = null;
-    for (let i = 0; i < this.nodeCount; i++) {
-      if (this.visibleNodes !== null && !this.visibleNodes.has(i)) continue;
-      const nx = this.cpuPositions[i * 4];
-      const ny = this.cpuPositions[i * 4 + 1];
-      const dx = worldX - nx;
-      const dy = worldY - ny;
-      const dist = Math.sqrt(dx * dx + dy * dy);
-      if (dist < bestDist) {
-        bestDist = dist;
-        bestIndex = i;
-      }
-    }
-    return bestIndex;
+    return this.nearest(worldX, worldY, 1, hitRadius)[0] ?? null;
+  }
+
+  /** Spatial index of the current position cache; built here if the worker's has not arrived yet. */
+  private currentSpatialIndex(): SpatialIndex | null {
+    if (this.spatialIndex && this.spatialIndexEpoch === this.positionsEpoch) return this.spatialIndex;
+    const positions = this.cpuPositions;
+    if (!positions) return null;
+    this.spatialIndex = SpatialIndex.fromPositions(positions, Math.min(this.nodeCount, positions.length / 4));
+    this.spatialIndexEpoch = this.positionsEpoch;
+    return this.spatialIndex;
+  }
+
+  /** Keep the nodes that exist and are not hidden by the neighborhood selection. */
+  private filterQueryable(nodes: number[]): number[] {
+    const visible = this.visibleNodes;
+    const count = this.nodeCount;
+    return nodes.filter(i => i < count && (visible === null || visible.has(i)));
   }
 }
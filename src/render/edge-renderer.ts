@@ -1,11 +1,15 @@
 // Edge renderer — renders lines connecting hyperedge members using star topology
 // For each hyperedge: compute centroid, draw line from centroid to each member
-// Uses pre-computed edge-draw-indices buffer mapping vertex pairs to (he_index, member_node_index)
+// Each frame the visible-edge slots are culled to the view on the GPU
+// (gpu-culling.ts), which also computes the centroids, into a list of
+// (he_index, member_node_index) pairs drawn indirectly, one instance per line
 
 import type { GPUContext } from '../gpu/device';
 import type { BufferManager } from '../gpu/buffer-manager';
 import type { Camera } from './camera';
-import type { HypergraphData, RenderParams } from '../data/types';
+import type { RenderParams } from '../data/types';
+import type { HypergraphStore } from '../data/hypergraph-store';
+import { GPUCuller, EDGE_CULL } from './gpu-culling';
 import edgeShaderCode from '../shaders/edge-render.wgsl?raw';
 
 export class EdgeRenderer {
@@ -15,10 +19,14 @@ export class EdgeRenderer {
 
   private pipeline: GPURenderPipeline | null = null;
   private bindGroup: GPUBindGroup | null = null;
+  private bindGroupVersion = -1; // culler version the bind group was built with
+  private culler: GPUCuller;
   private cameraBuffer: GPUBuffer | null = null;
   private edgeParamsBuffer: GPUBuffer | null = null;
 
-  // Total number of line segments (each = 2 vertices)
+  // Visible hyperedges (with members), grown 2×, and their line segments (each = 2 vertices)
+  private slots = new Uint32Array(0);
+  private slotCount = 0;
   private totalLineSegments = 0;
   private lastCameraVersion = -1;
   private edgeParamsArray = new Float32Array(4);
@@ -29,6 +37,7 @@ export class EdgeRenderer {
     this.buffers = buffers;
     this.camera = camera;
 
+    this.culler = new GPUCuller(gpu.device, buffers, EDGE_CULL);
     this.initPipeline();
   }
 
@@ -45,11 +54,11 @@ export class EdgeRenderer {
       entries: [
         { binding: 0, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },           // camera
         { binding: 1, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // positions
-        { binding: 2, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // edge_draw indices
-        { binding: 3, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // he_offsets
-        { binding: 4, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // he_members
+        { binding: 2, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // edge_draw (culled pairs)
+        { binding: 3, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // centroids
         { binding: 5, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },            // edge params
         { binding: 6, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // edge_flags
+        { binding: 7, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },  // edge_weights
       ],
     });
 
@@ -93,86 +102,60 @@ export class EdgeRenderer {
   }
 
   /**
-   * Build the edge-draw-indices buffer from hypergraph data.
-   * Each entry is a pair: (hyperedge_index, member_node_index).
-   * One pair per line segment (centroid -> member).
+   * Set up the edge buffers for a (new or mutated) hypergraph, with every
+   * edge visible. The culled (he_index, member_node_index) pairs, one per
+   * line segment (centroid -> member), are built on the GPU each frame.
    */
-  setData(data: HypergraphData): void {
-    this.edgeCount = data.hyperedges.length;
+  setData(store: HypergraphStore): void {
+    this.edgeCount = store.edgeCount;
 
-    // Count total line segments: sum of member counts across all hyperedges
-    let totalSegments = 0;
-    for (const he of data.hyperedges) {
-      totalSegments += he.memberIndices.length;
-    }
-
-    this.totalLineSegments = totalSegments;
-
-    if (totalSegments === 0) return;
-
-    // Build edge-draw buffer: [he_index, member_node_index] pairs
-    const drawData = new Uint32Array(totalSegments * 2);
-    let offset = 0;
-
-    for (const he of data.hyperedges) {
-      for (const memberIdx of he.memberIndices) {
-        drawData[offset++] = he.index;      // hyperedge index
-        drawData[offset++] = memberIdx;      // member node index
-      }
-    }
-
-    this.buffers.createBuffer(
-      'edge-draw-indices', drawData.byteLength,
-      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'edge-draw-indices',
-    );
-    this.buffers.uploadData('edge-draw-indices', drawData);
-
-    // Create edge-flags buffer (one u32 per hyperedge, all zeros = no dimming)
-    const flagsSize = Math.max(data.hyperedges.length * 4, 4);
-    this.buffers.createBuffer(
+    // Edge-flags buffer (one u32 per hyperedge, all zeros = no dimming)
+    const flagsSize = Math.max(this.edgeCount * 4, 4);
+    this.buffers.ensureCapacity(
       'edge-flags', flagsSize,
       GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'edge-flags',
     );
-    this.buffers.uploadData('edge-flags', new Uint32Array(data.hyperedges.length));
+    this.buffers.uploadData('edge-flags', new Uint32Array(this.edgeCount));
+
+    // Centroids (vec2 per hyperedge), written by the cull pass
+    this.buffers.ensureCapacity(
+      'edge-centroids', Math.max(this.edgeCount * 8, 8),
+      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC, 'edge-centroids',
+    );
 
-    // Recreate bind group with new buffers
-    this.recreateBindGroup();
+    // Recreate bind group (node-positions / CSR buffers may have changed too)
+    this.bindGroup = null;
+    this.setVisibleEdges(store, null);
   }
 
   /**
-   * Rebuild edge-draw-indices with only the visible edges.
-   * When visibleEdges is null, all edges are shown (same as setData).
+   * Restrict the drawn edges to `visibleEdges` (null = all edges). O(edges):
+   * only the slot list is rebuilt; culling picks the segments per frame.
    */
-  setVisibleEdges(data: HypergraphData, visibleEdges: Set<number> | null): void {
-    let totalSegments = 0;
-    for (const he of data.hyperedges) {
-      if (visibleEdges === null || visibleEdges.has(he.index)) {
-        totalSegments += he.memberIndices.length;
-      }
+  setVisibleEdges(store: HypergraphStore, visibleEdges: Set<number> | null): void {
+    const { offsets } = store.csr;
+    if (store.edgeCount > this.slots.length) {
+      this.slots = new Uint32Array(Math.max(store.edgeCount, this.slots.length * 2));
     }
 
-    this.totalLineSegments = totalSegments;
-    if (totalSegments === 0) return;
-
-    const drawData = new Uint32Array(totalSegments * 2);
-    let offset = 0;
-    for (const he of data.hyperedges) {
-      if (visibleEdges !== null && !visibleEdges.has(he.index)) continue;
-      for (const memberIdx of he.memberIndices) {
-        drawData[offset++] = he.index;
-        drawData[offset++] = memberIdx;
-      }
+    let count = 0;
+    let totalSegments = 0;
+    for (let e = 0; e < store.edgeCount; e++) {
+      const size = offsets[e + 1] - offsets[e];
+      if (size === 0 || (visibleEdges !== null && !visibleEdges.has(e))) continue;
+      this.slots[count++] = e;
+      totalSegments += size;
     }
+    this.slotCount = count;
+    this.totalLineSegments = totalSegments;
+    if (count === 0) return;
 
-    // Reuse existing buffer if large enough, otherwise recreate
-    if (!this.buffers.hasBuffer('edge-draw-indices') || drawData.byteLength > this.buffers.getBuffer('edge-draw-indices').size) {
-      this.buffers.createBuffer(
-        'edge-draw-indices', drawData.byteLength,
-        GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'edge-draw-indices',
-      );
-      this.recreateBindGroup();
-    }
-    this.buffers.uploadData('edge-draw-indices', drawData);
+    this.buffers.ensureCapacity(
+      'edge-slots', count * 4,
+      GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'edge-slots',
+    );
+    this.buffers.uploadData('edge-slots', this.slots.subarray(0, count));
+    this.culler.reserve(count, totalSegments);
   }
 
   /** Set dimmed edges — dimmed edges render at 12% alpha. Pass null to clear. */
@@ -190,29 +173,44 @@ export class EdgeRenderer {
   private recreateBindGroup(): void {
     if (!this.pipeline || !this.cameraBuffer || !this.edgeParamsBuffer) return;
     if (!this.buffers.hasBuffer('node-positions')) return;
-    if (!this.buffers.hasBuffer('edge-draw-indices')) return;
-    if (!this.buffers.hasBuffer('he-offsets')) return;
-    if (!this.buffers.hasBuffer('he-members')) return;
+    if (!this.buffers.hasBuffer('edge-centroids')) return;
     if (!this.buffers.hasBuffer('edge-flags')) return;
+    if (!this.buffers.hasBuffer('edge-weights')) return;
 
+    this.bindGroupVersion = this.culler.version;
     this.bindGroup = this.gpu.device.createBindGroup({
       label: 'edge-bind-group',
       layout: this.pipeline.getBindGroupLayout(0),
       entries: [
         { binding: 0, resource: { buffer: this.cameraBuffer } },
         { binding: 1, resource: { buffer: this.buffers.getBuffer('node-positions') } },
-        { binding: 2, resource: { buffer: this.buffers.getBuffer('edge-draw-indices') } },
-        { binding: 3, resource: { buffer: this.buffers.getBuffer('he-offsets') } },
-        { binding: 4, resource: { buffer: this.buffers.getBuffer('he-members') } },
+        { binding: 2, resource: { buffer: this.culler.visibleBuffer } },
+        { binding: 3, resource: { buffer: this.buffers.getBuffer('edge-centroids') } },
         { binding: 5, resource: { buffer: this.edgeParamsBuffer } },
         { binding: 6, resource: { buffer: this.buffers.getBuffer('edge-flags') } },
+        { binding: 7, resource: { buffer: this.buffers.getBuffer('edge-weights') } },
       ],
     });
   }
 
+  /**
+   * Encode this frame's culling (before the render pass that draws the
+   * edges): the centroids, and the segments of slots whose bounds overlap the
+   * view, from the live GPU positions.
+   */
+  encodeCulling(encoder: GPUCommandEncoder): void {
+    if (this.slotCount === 0 || !this.buffers.hasBuffer('node-positions') || !this.buffers.hasBuffer('he-members')) return;
+    const get = (name: string) => this.buffers.getBuffer(name);
+    this.culler.encode(encoder, this.camera, 1, this.slotCount, this.totalLineSegments, [
+      get('node-positions'), get('he-offsets'), get('he-members'), get('edge-slots'), get('edge-centroids'),
+    ]);
+  }
+
   render(renderPass: GPURenderPassEncoder, renderParams: RenderParams): void {
-    if (!this.pipeline || !this.bindGroup || !this.cameraBuffer || !this.edgeParamsBuffer) return;
+    if (!this.pipeline || !this.cameraBuffer || !this.edgeParamsBuffer) return;
     if (this.totalLineSegments === 0) return;
+    if (!this.bindGroup || this.bindGroupVersion !== this.culler.version) this.recreateBindGroup();
+    if (!this.bindGroup) return;
 
     // Update camera uniform (only when camera has changed)
     if (this.camera.version !== this.lastCameraVersion) {
@@ -226,7 +224,7 @@ export class EdgeRenderer {
 
     renderPass.setPipeline(this.pipeline);
     renderPass.setBindGroup(0, this.bindGroup);
-    // 2 vertices per line segment
-    renderPass.draw(this.totalLineSegments * 2);
+    // One instance of 2 vertices per culled line segment
+    renderPass.drawIndirect(this.culler.argsBuffer, 0);
   }
 }
@@ -0,0 +1,185 @@
+// GPU visibility culling — compacts a draw list to what the camera can see.
+// A flag pass tests every item (node, hyperedge, metaball tile) against the
+// world-space view rectangle and its visibility flags, a prefix sum turns the
+// flags into output offsets, and an emit pass writes the survivors in their
+// input order (so draw order, and with it the top-most pick, is unchanged).
+// The survivor count is copied into the instance count of an indirect draw:
+// the CPU never learns it, and nothing waits on a readback.
+
+import type { BufferManager } from '../gpu/buffer-manager';
+import type { Camera } from './camera';
+import { getPipelineCache } from '../gpu/pipeline-cache';
+import { PrefixSum } from '../gpu/prefix-sum';
+import cullShader from '../shaders/cull.wgsl?raw';
+
+const WORKGROUP = 64;
+const MAX_GROUPS_X = 65535;
+
+/** A draw list culled by cull.wgsl: its entry points, inputs and output shape. */
+export interface CullList {
+  name: string;                               // label and buffer prefix
+  flagEntry: string;
+  emitEntry: string;
+  inputs: [number, GPUBufferBindingType][];   // owner-supplied bindings (4+), in `encode` order
+  stride: number;                             // u32s per survivor
+  vertices: number;                           // vertices per drawn instance (one instance per survivor)
+}
+
+export const NODE_CULL: CullList = {
+  name: 'node-cull', flagEntry: 'flag_nodes', emitEntry: 'emit_nodes',
+  inputs: [[4, 'read-only-storage'], [5, 'read-only-storage'], [6, 'read-only-storage']], // positions, metadata, weights
+  stride: 1, vertices: 6,
+};
+
+export const EDGE_CULL: CullList = {
+  name: 'edge-cull', flagEntry: 'flag_edges', emitEntry: 'emit_edges',
+  inputs: [
+    [4, 'read-only-storage'], [7, 'read-only-storage'], [8, 'read-only-storage'], // positions, he_offsets, he_members
+    [9, 'read-only-storage'], [10, 'storage'],                                    // edge slots, centroids
+  ],
+  stride: 2, vertices: 2,
+};
+
+export const TILE_CULL: CullList = {
+  name: 'metaball-cull', flagEntry: 'flag_tiles', emitEntry: 'emit_tiles',
+  inputs: [[11, 'read-only-storage'], [12, 'read-only-storage']], // instances, tiles
+  stride: 2, vertices: 6,
+};
+
+export class GPUCuller {
+  private device: GPUDevice;
+  private buffers: BufferManager;
+  private list: CullList;
+  private prefixSum: PrefixSum;
+
+  private flagPipeline: GPUComputePipeline;
+  private emitPipeline: GPUComputePipeline;
+  private layout: GPUBindGroupLayout;
+  private bindGroup: GPUBindGroup | null = null;
+  private boundBuffers: GPUBuffer[] = []; // what the bind group was built from
+
+  // view min/max, pixel, pad (f32) · count, capacity (u32)
+  private params = new Float32Array(8);
+  private paramsU32 = new Uint32Array(this.params.buffer);
+
+  /** Bumped whenever the survivor buffer is replaced (draw bind groups must be rebuilt). */
+  version = 0;
+
+  constructor(device: GPUDevice, buffers: BufferManager, list: CullList) {
+    this.device = device;
+    this.buffers = buffers;
+    this.list = list;
+    this.prefixSum = new PrefixSum(device, buffers, `${list.name}-counts`);
+
+    const cache = getPipelineCache(device);
+    const module = cache.shaderModule('cull-shader', cullShader);
+    const entry = (binding: number, type: GPUBufferBindingType): GPUBindGroupLayoutEntry =>
+      ({ binding, visibility: GPUShaderStage.COMPUTE, buffer: { type } });
+    this.layout = cache.bindGroupLayout(`${list.name}-bgl`, [
+      entry(0, 'uniform'),           // params
+      entry(1, 'storage'),           // counts → offsets
+      entry(2, 'read-only-storage'), // total
+      entry(3, 'storage'),           // visible
+      ...list.inputs.map(([binding, type]) => entry(binding, type)),
+    ]);
+    this.flagPipeline = cache.computePipeline(`${list.name}-flag`, module, list.flagEntry, this.layout);
+    this.emitPipeline = cache.computePipeline(`${list.name}-emit`, module, list.emitEntry, this.layout);
+    this.reserve(0, 0);
+  }
+
+  /** Survivors (`stride` u32s each, in input order), for the draw's bind group. */
+  get visibleBuffer(): GPUBuffer { return this.buffers.getBuffer(`${this.list.name}-visible`); }
+
+  /** Indirect draw arguments: `vertices` per survivor, one instance each. */
+  get argsBuffer(): GPUBuffer { return this.buffers.getBuffer(`${this.list.name}-args`); }
+
+  /**
+   * Grow the buffers for `count` items with up to `capacity` survivors (the
+   * owner's draw bind groups should then use the new `visibleBuffer`).
+   * Returns true when the survivor buffer was replaced.
+   */
+  reserve(count: number, capacity: number): boolean {
+    const { name, stride, vertices } = this.list;
+    this.buffers.ensureCapacity(`${name}-params`, 32, GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, `${name}-params`);
+    // [vertices, instances, first vertex, first instance]; the instance count is filled on the GPU
+    if (this.buffers.ensureCapacity(`${name}-args`, 16, GPUBufferUsage.INDIRECT | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC, `${name}-args`)) {
+      this.buffers.uploadData(`${name}-args`, new Uint32Array([vertices, 0, 0, 0]));
+    }
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC;
+    this.buffers.ensureCapacity(`${name}-counts`, Math.max(count * 4, 4), usage | GPUBufferUsage.COPY_DST, `${name}-counts`);
+    const replaced = this.buffers.ensureCapacity(`${name}-visible`, Math.max(capacity * stride * 4, 4), usage, `${name}-visible`);
+    if (replaced) this.version++;
+    return replaced;
+  }
+
+  /**
+   * Encode flag → prefix sum → emit for `count` items against the current
+   * view, each grown by `pad` screen pixels, and copy the survivor count into
+   * `argsBuffer`. `inputs` are the buffers of `list.inputs`, in order.
+   */
+  encode(encoder: GPUCommandEncoder, camera: Camera, pad: number, count: number, capacity: number, inputs: GPUBuffer[]): void {
+    this.reserve(count, capacity);
+    this.prefixSum.configure(this.buffers.getBuffer(`${this.list.name}-counts`), count);
+
+    if (count > 0) {
+      const [x0, y0] = camera.screenToWorld(0, camera.getViewportHeight());
+      const [x1, y1] = camera.screenToWorld(camera.getViewportWidth(), 0);
+      this.params[0] = x0;
+      this.params[1] = y0;
+      this.params[2] = x1;
+      this.params[3] = y1;
+      this.params[4] = 1 / camera.zoom;
+      this.params[5] = pad;
+      this.paramsU32[6] = count;
+      this.paramsU32[7] = capacity;
+      this.device.queue.writeBuffer(this.buffers.getBuffer(`${this.list.name}-params`), 0, this.params);
+      this.ensureBindGroup(inputs);
+
+      const groups = Math.ceil(count / WORKGROUP);
+      const flagPass = encoder.beginComputePass({ label: `${this.list.name}-flag` });
+      flagPass.setPipeline(this.flagPipeline);
+      flagPass.setBindGroup(0, this.bindGroup!);
+      dispatchGroups(flagPass, groups);
+      flagPass.end();
+
+      this.prefixSum.encode(encoder);
+
+      const emitPass = encoder.beginComputePass({ label: `${this.list.name}-emit` });
+      emitPass.setPipeline(this.emitPipeline);
+      emitPass.setBindGroup(0, this.bindGroup!);
+      dispatchGroups(emitPass, groups);
+      emitPass.end();
+    } else {
+      this.prefixSum.encode(encoder); // clears the total
+    }
+    encoder.copyBufferToBuffer(this.prefixSum.totalBuffer, 0, this.argsBuffer, 4, 4);
+  }
+
+  /** Rebuild the bind group when any buffer behind it was reallocated. */
+  private ensureBindGroup(inputs: GPUBuffer[]): void {
+    const get = (name: string) => this.buffers.getBuffer(`${this.list.name}-${name}`);
+    const bound = [get('params'), get('counts'), this.prefixSum.totalBuffer, get('visible'), ...inputs];
+    if (bound.length === this.boundBuffers.length && bound.every((b, i) => b === this.boundBuffers[i])) return;
+    this.boundBuffers = bound;
+
+    const bindings = [0, 1, 2, 3, ...this.list.inputs.map(([binding]) => binding)];
+    this.bindGroup = this.device.createBindGroup({
+      label: `${this.list.name}-bg`,
+      layout: this.layout,
+      entries: bindings.map((binding, i) => ({ binding, resource: { buffer: bound[i] } })),
+    });
+  }
+
+  destroy(): void {
+    const { name } = this.list;
+    this.prefixSum.destroy();
+    for (const suffix of ['params', 'args', 'counts', 'visible']) this.buffers.destroyBuffer(`${name}-${suffix}`);
+    this.bindGroup = null;
+    this.boundBuffers = [];
+  }
+}
+
+function dispatchGroups(pass: GPUComputePassEncoder, groups: number): void {
+  const x = Math.min(groups, MAX_GROUPS_X);
+  pass.dispatchWorkgroups(x, Math.ceil(groups / x));
+}
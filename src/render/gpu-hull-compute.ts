@@ -0,0 +1,205 @@
+// GPU convex hull computation — the compute-shader counterpart of HullCompute.
+// Builds the raw member hull and bounds of every visible hyperedge straight
+// from `node-positions` and the CSR buffers, packed by a prefix sum, so hulls
+// track the layout every frame without reading positions back. Only slots
+// whose members moved since their last build are re-wrapped. Rounding by the
+// margin happens per fragment in hull-render.wgsl.
+
+import type { BufferManager } from '../gpu/buffer-manager';
+import type { HypergraphStore } from '../data/hypergraph-store';
+import { getPipelineCache } from '../gpu/pipeline-cache';
+import { PrefixSum } from '../gpu/prefix-sum';
+import hullBuildShader from '../shaders/hull-build.wgsl?raw';
+
+const WORKGROUP = 64;
+const MAX_GROUPS_X = 65535;
+const DIMMED_BIT = 0x80000000;
+
+export class GPUHullCompute {
+  private device: GPUDevice;
+  private buffers: BufferManager;
+  private prefixSum: PrefixSum;
+
+  private countPipeline: GPUComputePipeline;
+  private emitPipeline: GPUComputePipeline;
+  private countLayout: GPUBindGroupLayout;
+  private emitLayout: GPUBindGroupLayout;
+
+  private countBindGroup: GPUBindGroup | null = null;
+  private emitBindGroup: GPUBindGroup | null = null;
+  private boundBuffers: GPUBuffer[] = []; // what the bind groups were built from
+
+  // Visible-edge slots (edge index | dimmed bit) and scratch offsets, grown 2×
+  private slots = new Uint32Array(0);
+  private scratchOffsets = new Uint32Array(0);
+  private _slotCount = 0;
+  private scratchPoints = 0; // Σ size over slots (a hull has at most one vertex per member)
+  private params = new Uint32Array(8);
+  private paramsF32 = new Float32Array(this.params.buffer);
+  private rebuildAll = true; // snapshots invalid (new slots or reallocated buffers)
+  private staleTolerance = 0; // largest tolerance hulls were kept under since the last full rebuild
+
+  /** Bumped whenever a buffer the renderer binds (points, info, slots) is replaced. */
+  version = 0;
+
+  constructor(device: GPUDevice, buffers: BufferManager) {
+    this.device = device;
+    this.buffers = buffers;
+    this.prefixSum = new PrefixSum(device, buffers, 'hull-counts');
+
+    const cache = getPipelineCache(device);
+    const module = cache.shaderModule('hull-build-shader', hullBuildShader);
+    const storage = (binding: number, type: GPUBufferBindingType): GPUBindGroupLayoutEntry =>
+      ({ binding, visibility: GPUShaderStage.COMPUTE, buffer: { type } });
+    const params = storage(9, 'uniform');
+
+    this.countLayout = cache.bindGroupLayout('hull-count-bgl', [
+      storage(0, 'read-only-storage'), // positions
+      storage(1, 'read-only-storage'), // he_offsets
+      storage(2, 'read-only-storage'), // he_members
+      storage(3, 'read-only-storage'), // slots
+      storage(4, 'read-only-storage'), // scratch_offsets
+      storage(5, 'storage'),           // scratch
+      storage(6, 'storage'),           // counts
+      storage(7, 'storage'),           // infos
+      params,
+      storage(10, 'storage'),          // snapshot
+    ]);
+    this.emitLayout = cache.bindGroupLayout('hull-emit-bgl', [
+      storage(4, 'read-only-storage'), // scratch_offsets
+      storage(5, 'storage'),           // scratch
+      storage(6, 'storage'),           // counts (scanned)
+      storage(7, 'storage'),           // infos
+      storage(8, 'storage'),           // points
+      params,
+    ]);
+    this.countPipeline = cache.computePipeline('hull-count', module, 'count_hulls', this.countLayout);
+    this.emitPipeline = cache.computePipeline('hull-emit', module, 'emit_hulls', this.emitLayout);
+
+    this.buffers.ensureCapacity(
+      'hull-build-params', 32,
+      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'hull-build-params',
+    );
+  }
+
+  /** Hull slots, i.e. instances to draw (slots whose hull was skipped draw nothing). */
+  get slotCount(): number { return this._slotCount; }
+
+  /**
+   * Rebuild the slot list: one per hyperedge with 2+ members (in `visible`
+   * when given), flagged when in `dimmed`. O(edges), run on topology,
+   * visibility and dimming changes only.
+   */
+  setEdges(store: HypergraphStore, visible: Set<number> | null, dimmed: Set<number> | null): void {
+    const { offsets } = store.csr;
+    if (store.edgeCount > this.slots.length) {
+      const size = Math.max(store.edgeCount, this.slots.length * 2);
+      this.slots = new Uint32Array(size);
+      this.scratchOffsets = new Uint32Array(size);
+    }
+
+    let count = 0;
+    let scratch = 0;
+    for (let e = 0; e < store.edgeCount; e++) {
+      const size = offsets[e + 1] - offsets[e];
+      if (size < 2 || (visible !== null && !visible.has(e))) continue;
+      this.slots[count] = (dimmed !== null && dimmed.has(e)) ? (e | DIMMED_BIT) >>> 0 : e;
+      this.scratchOffsets[count] = scratch;
+      scratch += size;
+      count++;
+    }
+    this._slotCount = count;
+    this.scratchPoints = scratch;
+    this.rebuildAll = true;
+    if (count === 0) return;
+
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC;
+    this.buffers.ensureCapacity('hull-slots', count * 4, usage, 'hull-slots');
+    this.buffers.ensureCapacity('hull-scratch-offsets', count * 4, usage, 'hull-scratch-offsets');
+    this.buffers.uploadData('hull-slots', this.slots.subarray(0, count));
+    this.buffers.uploadData('hull-scratch-offsets', this.scratchOffsets.subarray(0, count));
+  }
+
+  /**
+   * Encode count → prefix sum → emit for the current positions. Hulls whose
+   * members all moved less than `tolerance` (world units) since they were
+   * last built are kept. Returns false when there is nothing to draw.
+   */
+  encode(encoder: GPUCommandEncoder, tolerance: number): boolean {
+    const count = this._slotCount;
+    if (count === 0 || !this.buffers.hasBuffer('node-positions') || !this.buffers.hasBuffer('he-members')) {
+      return false;
+    }
+
+    // Worst case is every member on its hull; beyond the binding limit the
+    // shader skips hulls that do not fit
+    const limits = this.device.limits;
+    const maxPoints = Math.floor(Math.min(limits.maxStorageBufferBindingSize, limits.maxBufferSize) / 8);
+    const capacity = Math.min(this.scratchPoints, maxPoints);
+
+    const usage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC;
+    this.buffers.ensureCapacity('hull-scratch', capacity * 8, usage, 'hull-scratch');
+    this.buffers.ensureCapacity('hull-snapshot', capacity * 8, usage, 'hull-snapshot');
+    this.buffers.ensureCapacity('hull-counts', count * 4, usage | GPUBufferUsage.COPY_DST, 'hull-counts');
+    this.buffers.ensureCapacity('hull-info', count * 32, usage, 'hull-info');
+    this.buffers.ensureCapacity('hull-points', capacity * 8, usage, 'hull-points');
+    this.prefixSum.configure(this.buffers.getBuffer('hull-counts'), count);
+    this.ensureBindGroups();
+
+    this.params[0] = count;
+    this.params[1] = capacity;
+    this.params[2] = capacity;
+    // Hulls kept under a looser tolerance (e.g. before zooming in) may now be visibly stale
+    if (tolerance < this.staleTolerance * 0.5) this.rebuildAll = true;
+    this.staleTolerance = this.rebuildAll ? tolerance : Math.max(this.staleTolerance, tolerance);
+    this.paramsF32[3] = tolerance;
+    this.params[4] = this.rebuildAll ? 1 : 0;
+    this.rebuildAll = false;
+    this.device.queue.writeBuffer(this.buffers.getBuffer('hull-build-params'), 0, this.params);
+
+    const groups = Math.ceil(count / WORKGROUP);
+    const countPass = encoder.beginComputePass({ label: 'hull-count' });
+    countPass.setPipeline(this.countPipeline);
+    countPass.setBindGroup(0, this.countBindGroup!);
+    dispatchGroups(countPass, groups);
+    countPass.end();
+
+    this.prefixSum.encode(encoder);
+
+    const emitPass = encoder.beginComputePass({ label: 'hull-emit' });
+    emitPass.setPipeline(this.emitPipeline);
+    emitPass.setBindGroup(0, this.emitBindGroup!);
+    dispatchGroups(emitPass, groups);
+    emitPass.end();
+    return true;
+  }
+
+  /** Rebuild bind groups when any buffer behind them was reallocated. */
+  private ensureBindGroups(): void {
+    const get = (name: string) => this.buffers.getBuffer(name);
+    const bound = [
+      get('node-positions'), get('he-offsets'), get('he-members'), get('hull-slots'),
+      get('hull-scratch-offsets'), get('hull-scratch'), get('hull-counts'), get('hull-info'),
+      get('hull-points'), get('hull-build-params'), get('hull-snapshot'),
+    ];
+    if (bound.length === this.boundBuffers.length && bound.every((b, i) => b === this.boundBuffers[i])) return;
+    this.boundBuffers = bound;
+    this.version++;
+    this.rebuildAll = true; // a replaced scratch / snapshot / info buffer lost its hulls
+
+    const entries = (bindings: number[]): GPUBindGroupEntry[] =>
+      bindings.map(binding => ({ binding, resource: { buffer: bound[binding] } }));
+    this.countBindGroup = this.device.createBindGroup({
+      label: 'hull-count-bg', layout: this.countLayout, entries: entries([0, 1, 2, 3, 4, 5, 6, 7, 9, 10]),
+    });
+    this.emitBindGroup = this.device.createBindGroup({
+      label: 'hull-emit-bg', layout: this.emitLayout, entries: entries([4, 5, 6, 7, 8, 9]),
+    });
+  }
+}
+
+/** Dispatch `groups` workgroups, spilling into y past the per-dimension limit. */
+function dispatchGroups(pass: GPUComputePassEncoder, groups: number): void {
+  const x = Math.min(groups, MAX_GROUPS_X);
+  pass.dispatchWorkgroups(x, Math.ceil(groups / x));
+}
@@ -2,7 +2,7 @@
 // Computes padded convex hulls for each hyperedge, smoothed with Chaikin subdivision
 
 import type { Vec2 } from '../utils/math';
-import type { HyperedgeData } from '../data/types';
+import type { EdgeMembers } from '../data/types';
 
 export interface HullData {
   /** Hull polygon vertices (smoothed) */
@@ -162,7 +162,7 @@ export class HullCompute {
    */
   computeHulls(
     positions: Float32Array,
-    hyperedges: HyperedgeData[],
+    hyperedges: readonly EdgeMembers[],
     margin: number,
     smoothIterations = 0,
   ): HullData[] {
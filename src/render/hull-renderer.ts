@@ -1,21 +1,26 @@
 // Hull renderer — renders semi-transparent hull polygons for hyperedges
-// Convex mode: fan-triangulated geometry computed by HullCompute
-// Metaball mode: screen-space fragment shader via MetaballRenderer
-// Recomputes periodically (not every frame) for performance
+// Convex mode: raw hulls built on the GPU every frame by GPUHullCompute (no
+// position readback), drawn as instanced quads whose fragment shader rounds
+// them by the margin analytically
+// Both modes also draw edge IDs into the GPU pick pass (renderPick)
+// Metaball mode: screen-space fragment shader via MetaballRenderer, whose
+// per-edge bounds and MST bridges are rebuilt on the GPU as members move
 
 import type { GPUContext } from '../gpu/device';
 import type { BufferManager } from '../gpu/buffer-manager';
+import type { GPUProfiler } from '../gpu/gpu-profiler';
 import type { Camera } from './camera';
-import type { HypergraphData, RenderParams, HullMode } from '../data/types';
-import type { HullData } from './hull-compute';
-import { HullCompute } from './hull-compute';
+import type { RenderParams, EdgeMembers } from '../data/types';
+import type { HypergraphStore } from '../data/hypergraph-store';
+import { GPUHullCompute } from './gpu-hull-compute';
 import { MetaballRenderer } from './metaball-renderer';
-import { getPaletteColor } from '../utils/color';
+import { PICK_FORMAT } from '../interaction/gpu-picker';
+import { getPaletteColors, getPaletteSize } from '../utils/color';
 import hullShaderCode from '../shaders/hull-render.wgsl?raw';
 
-// Vertex layout: [x, y, r, g, b, a] per vertex = 6 floats = 24 bytes
-const FLOATS_PER_VERTEX = 6;
-const BYTES_PER_VERTEX = FLOATS_PER_VERTEX * 4;
+const OUTLINE_ALPHA = 0.5;
+// Convex hulls are re-wrapped once a member moved this many screen pixels
+const HULL_TOLERANCE_PX = 0.25;
 
 export class HullRenderer {
   private gpu: GPUContext;
@@ -23,34 +28,29 @@ export class HullRenderer {
   private camera: Camera;
 
   private pipeline: GPURenderPipeline | null = null;
-  private outlinePipeline: GPURenderPipeline | null = null;
+  private pickPipeline: GPURenderPipeline | null = null;
   private bindGroup: GPUBindGroup | null = null;
+  private pickBindGroup: GPUBindGroup | null = null; // bindGroup with the pick camera
+  private pickCamera: GPUBuffer | null = null;
+  private bindGroupVersion = -1;
   private cameraBuffer: GPUBuffer | null = null;
+  private hullParamsBuffer: GPUBuffer | null = null;
+  private hullParams = new DataView(new ArrayBuffer(32)); // fill alpha, outline alpha, radius, pixel, palette size
 
-  private hullCompute = new HullCompute();
+  private gpuHulls: GPUHullCompute;
+  private slotsDirty = true;
   private metaballRenderer: MetaballRenderer | null = null;
-  private hypergraphData: HypergraphData | null = null;
-
-  // Hull vertex buffers (pre-allocated, grown as needed)
-  private fillVertexBuffer: GPUBuffer | null = null;
-  private fillBufferCapacity = 0; // in bytes
-  private fillVertexCount = 0;
-  private outlineVertexBuffer: GPUBuffer | null = null;
-  private outlineBufferCapacity = 0; // in bytes
-  private outlineVertexCount = 0;
+  private store: HypergraphStore | null = null;
+  private edgeViews: EdgeMembers[] | null = null; // visible edges as CSR views; rebuilt after setData/setVisibleEdges
 
   // Edge visibility filter (null = show all)
   private visibleEdges: Set<number> | null = null;
   // Dimmed edges (render at reduced alpha)
   private dimmedEdgeSet: Set<number> | null = null;
 
-  // Cached hull polygons for hit testing (convex mode only)
-  private lastHulls: HullData[] = [];
+  private radius = 1;
+  private drawable = false; // hulls were built this frame
 
-  // Recompute throttling
-  private frameCounter = 0;
-  private readonly recomputeInterval = 10;
-  private needsRecompute = true;
   private lastCameraVersion = -1;
 
   constructor(gpu: GPUContext, buffers: BufferManager, camera: Camera) {
@@ -58,6 +58,7 @@ export class HullRenderer {
     this.buffers = buffers;
     this.camera = camera;
 
+    this.gpuHulls = new GPUHullCompute(gpu.device, buffers);
     this.initPipelines();
   }
 
@@ -69,10 +70,16 @@ export class HullRenderer {
       code: hullShaderCode,
     });
 
+    const both = GPUShaderStage.VERTEX | GPUShaderStage.FRAGMENT;
     const bindGroupLayout = device.createBindGroupLayout({
       label: 'hull-bind-group-layout',
       entries: [
-        { binding: 0, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },
+        { binding: 0, visibility: GPUShaderStage.VERTEX, buffer: { type: 'uniform' } },           // camera
+        { binding: 1, visibility: both, buffer: { type: 'uniform' } },                            // hull params
+        { binding: 2, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } }, // points
+        { binding: 3, visibility: both, buffer: { type: 'read-only-storage' } },                  // infos
+        { binding: 4, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } }, // slots
+        { binding: 5, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } }, // palette
       ],
     });
 
@@ -81,23 +88,11 @@ export class HullRenderer {
       bindGroupLayouts: [bindGroupLayout],
     });
 
-    const vertexBufferLayout: GPUVertexBufferLayout = {
-      arrayStride: BYTES_PER_VERTEX,
-      attributes: [
-        { shaderLocation: 0, offset: 0, format: 'float32x2' },   // position
-        { shaderLocation: 1, offset: 8, format: 'float32x4' },   // color
-      ],
-    };
-
-    // Fill pipeline (triangles with alpha blending)
+    // One quad per hull instance; fill and outline both come from the SDF
     this.pipeline = device.createRenderPipeline({
-      label: 'hull-fill-pipeline',
+      label: 'hull-pipeline',
       layout: pipelineLayout,
-      vertex: {
-        module: shaderModule,
-        entryPoint: 'vs_main',
-        buffers: [vertexBufferLayout],
-      },
+      vertex: { module: shaderModule, entryPoint: 'vs_main' },
       fragment: {
         module: shaderModule,
         entryPoint: 'fs_main',
@@ -112,27 +107,17 @@ export class HullRenderer {
       primitive: { topology: 'triangle-list' },
     });
 
-    // Outline pipeline (line-strip with alpha blending)
-    this.outlinePipeline = device.createRenderPipeline({
-      label: 'hull-outline-pipeline',
+    // Same quads, edge index wherever the rounded hull covers the pixel
+    this.pickPipeline = device.createRenderPipeline({
+      label: 'hull-pick-pipeline',
       layout: pipelineLayout,
-      vertex: {
-        module: shaderModule,
-        entryPoint: 'vs_main',
-        buffers: [vertexBufferLayout],
-      },
+      vertex: { module: shaderModule, entryPoint: 'vs_main' },
       fragment: {
         module: shaderModule,
-        entryPoint: 'fs_main',
-        targets: [{
-          format,
-          blend: {
-            color: { srcFactor: 'src-alpha', dstFactor: 'one-minus-src-alpha', operation: 'add' },
-            alpha: { srcFactor: 'one', dstFactor: 'one-minus-src-alpha', operation: 'add' },
-          },
-        }],
+        entryPoint: 'fs_pick',
+        targets: [{ format: PICK_FORMAT, writeMask: GPUColorWrite.GREEN }],
       },
-      primitive: { topology: 'line-list' },
+      primitive: { topology: 'triangle-list' },
     });
 
     // Create camera uniform buffer for hull rendering
@@ -140,269 +125,171 @@ export class HullRenderer {
       'hull-camera-uniform', 64,
       GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'hull-camera-uniform',
     );
-
-    this.updateBindGroup();
+    this.hullParamsBuffer = this.buffers.createBuffer(
+      'hull-render-params', 32,
+      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'hull-render-params',
+    );
+    const palette = getPaletteColors();
+    this.buffers.createBuffer('hull-palette', palette.byteLength, GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'hull-palette');
+    this.buffers.uploadData('hull-palette', palette);
   }
 
+  /** Bind the GPU hull buffers; rebuilt whenever GPUHullCompute reallocates them. */
   private updateBindGroup(): void {
-    if (!this.pipeline || !this.cameraBuffer) return;
+    if (!this.pipeline || !this.cameraBuffer || !this.hullParamsBuffer) return;
+    if (this.bindGroupVersion === this.gpuHulls.version && this.bindGroup) return;
+    if (!this.buffers.hasBuffer('hull-points') || !this.buffers.hasBuffer('hull-slots')) return;
+
+    this.bindGroupVersion = this.gpuHulls.version;
+    this.bindGroup = this.createBindGroup('hull-bind-group', this.cameraBuffer);
+    this.pickBindGroup = null;
+  }
 
-    this.bindGroup = this.gpu.device.createBindGroup({
-      label: 'hull-bind-group',
-      layout: this.pipeline.getBindGroupLayout(0),
+  private createBindGroup(label: string, camera: GPUBuffer): GPUBindGroup {
+    return this.gpu.device.createBindGroup({
+      label,
+      layout: this.pipeline!.getBindGroupLayout(0),
       entries: [
-        { binding: 0, resource: { buffer: this.cameraBuffer } },
+        { binding: 0, resource: { buffer: camera } },
+        { binding: 1, resource: { buffer: this.hullParamsBuffer! } },
+        { binding: 2, resource: { buffer: this.buffers.getBuffer('hull-points') } },
+        { binding: 3, resource: { buffer: this.buffers.getBuffer('hull-info') } },
+        { binding: 4, resource: { buffer: this.buffers.getBuffer('hull-slots') } },
+        { binding: 5, resource: { buffer: this.buffers.getBuffer('hull-palette') } },
       ],
     });
   }
 
-  setData(data: HypergraphData): void {
-    this.hypergraphData = data;
+  setData(store: HypergraphStore): void {
+    this.store = store;
+    this.edgeViews = null;
     this.visibleEdges = null;
-    this.needsRecompute = true;
-    this.frameCounter = 0;
+    this.slotsDirty = true;
     // Invalidate metaball renderer bind group (buffers may have changed)
     this.metaballRenderer?.invalidateBindGroup();
+    this.forceRecompute();
   }
 
   setVisibleEdges(visibleEdges: Set<number> | null): void {
     this.visibleEdges = visibleEdges;
+    this.edgeViews = null;
+    this.slotsDirty = true;
     this.forceRecompute();
   }
 
   /** Set dimmed edges — dimmed hulls render at reduced alpha. Pass null to clear. */
   setDimmedEdges(dimmedSet: Set<number> | null): void {
     this.dimmedEdgeSet = dimmedSet;
+    this.slotsDirty = true;
     this.forceRecompute();
   }
 
-  /** Synchronous convex-hull recompute using CPU-side positions (no GPU readback). */
-  private recomputeHullsSync(positions: Float32Array, renderParams: RenderParams): void {
-    if (!this.hypergraphData) return;
-
-    const edges = this.visibleEdges !== null
-      ? this.hypergraphData.hyperedges.filter(he => this.visibleEdges!.has(he.index))
-      : this.hypergraphData.hyperedges;
-
-    const hulls = this.hullCompute.computeHulls(
-      positions,
-      edges,
-      renderParams.hullMargin,
-      renderParams.hullSmoothing,
-    );
+  /**
+   * Encode this frame's convex hull build, or the metaball instance build,
+   * tile binning and tile culling (and field pass when below full
+   * resolution, timed by `profiler`). Must run on the frame's command encoder before the render
+   * pass that calls `render`.
+   */
+  update(encoder: GPUCommandEncoder, renderParams: RenderParams, profiler: GPUProfiler | null = null): void {
+    if (!this.store) return;
+    if (renderParams.hullMode === 'metaball') {
+      this.updateMetaballs(renderParams);
+      this.metaballRenderer?.encodeBuild(encoder);
+      this.metaballRenderer?.encodeBinning(encoder);
+      this.metaballRenderer?.encodeCulling(encoder);
+      this.metaballRenderer?.encodeLowRes(encoder, renderParams.hullMetaballScale, profiler);
+      return;
+    }
 
-    this.lastHulls = hulls;
-    this.buildFillVertices(hulls, renderParams.hullAlpha);
-    if (renderParams.hullOutline) {
-      this.buildOutlineVertices(hulls);
-    } else {
-      this.outlineVertexCount = 0;
+    if (this.slotsDirty) {
+      this.gpuHulls.setEdges(this.store, this.visibleEdges, this.dimmedEdgeSet);
+      this.slotsDirty = false;
     }
-    this.needsRecompute = false;
+    this.radius = hullRadius(renderParams.hullMargin);
+    this.drawable = this.gpuHulls.encode(encoder, HULL_TOLERANCE_PX / this.camera.zoom);
   }
 
-  /** Synchronous metaball instance update — fragment shader evaluates field per-pixel. */
-  private recomputeMetaballs(positions: Float32Array, renderParams: RenderParams): void {
-    if (!this.hypergraphData) return;
+  /**
+   * Metaball instance layout — a no-op until edges or parameters change.
+   * Bounds and MST bridges follow the positions on the GPU.
+   */
+  private updateMetaballs(renderParams: RenderParams): void {
+    if (!this.store) return;
 
     this.metaballRenderer ??= new MetaballRenderer(this.gpu, this.buffers, this.camera);
 
-    const edges = this.visibleEdges !== null
-      ? this.hypergraphData.hyperedges.filter(he => this.visibleEdges!.has(he.index))
-      : this.hypergraphData.hyperedges;
+    const edges = this.edgeViews ??= this.store.edgeMembers(this.visibleEdges);
 
     const sigma = Math.max(renderParams.hullMargin, 5);
     this.metaballRenderer.updateInstances(
-      positions,
       edges,
       sigma,
       renderParams.hullMetaballThreshold,
       renderParams.hullAlpha,
       this.dimmedEdgeSet,
     );
-    this.needsRecompute = false;
   }
 
-  private buildFillVertices(hulls: HullData[], alpha: number): void {
-    // Count total triangle vertices
-    let totalVertices = 0;
-    for (const hull of hulls) {
-      totalVertices += hull.triangles.length;
-    }
-
-    if (totalVertices === 0) {
-      this.fillVertexCount = 0;
-      return;
-    }
-
-    const data = new Float32Array(totalVertices * FLOATS_PER_VERTEX);
-    let offset = 0;
-
-    for (const hull of hulls) {
-      const color = getPaletteColor(hull.hyperedgeIndex);
-      // Dimmed edges render at 8% of normal alpha (matching BSM's SVG behavior)
-      const isDimmed = this.dimmedEdgeSet !== null && this.dimmedEdgeSet.has(hull.hyperedgeIndex);
-      const hullAlpha = isDimmed ? alpha * 0.08 : alpha;
-
-      for (const vertex of hull.triangles) {
-        data[offset++] = vertex[0]; // x
-        data[offset++] = vertex[1]; // y
-        data[offset++] = color[0];  // r
-        data[offset++] = color[1];  // g
-        data[offset++] = color[2];  // b
-        data[offset++] = hullAlpha; // a
-      }
-    }
-
-    this.fillVertexCount = totalVertices;
-
-    // Grow buffer only when capacity is exceeded (amortized 2× growth)
-    if (data.byteLength > this.fillBufferCapacity) {
-      if (this.fillVertexBuffer) this.fillVertexBuffer.destroy();
-      this.fillBufferCapacity = data.byteLength * 2;
-      this.fillVertexBuffer = this.gpu.device.createBuffer({
-        label: 'hull-fill-vertices',
-        size: this.fillBufferCapacity,
-        usage: GPUBufferUsage.VERTEX | GPUBufferUsage.COPY_DST,
-      });
-    }
-    this.gpu.device.queue.writeBuffer(this.fillVertexBuffer!, 0, data);
+  /** Rebuild every metaball instance on the next frame (convex hulls track motion on their own). */
+  forceRecompute(): void {
+    this.metaballRenderer?.invalidateInstances();
   }
 
-  private buildOutlineVertices(hulls: HullData[]): void {
-    // Count total outline line segments (each hull edge = 2 vertices for line-list)
-    let totalVertices = 0;
-    for (const hull of hulls) {
-      totalVertices += hull.vertices.length * 2; // line-list: 2 verts per segment
-    }
+  render(renderPass: GPURenderPassEncoder, renderParams: RenderParams): void {
+    if (!this.store) return;
 
-    if (totalVertices === 0) {
-      this.outlineVertexCount = 0;
+    if (renderParams.hullMode === 'metaball') {
+      // Instances were built and binned by `update`
+      this.metaballRenderer?.render(renderPass);
       return;
     }
 
-    const data = new Float32Array(totalVertices * FLOATS_PER_VERTEX);
-    let offset = 0;
-    const outlineAlpha = 0.5;
-
-    for (const hull of hulls) {
-      const color = getPaletteColor(hull.hyperedgeIndex);
-      const isDimmed = this.dimmedEdgeSet !== null && this.dimmedEdgeSet.has(hull.hyperedgeIndex);
-      const hullOutlineAlpha = isDimmed ? outlineAlpha * 0.15 : outlineAlpha;
-      const n = hull.vertices.length;
-
-      for (let i = 0; i < n; i++) {
-        const next = (i + 1) % n;
-        // Start vertex of line segment
-        data[offset++] = hull.vertices[i][0];
-        data[offset++] = hull.vertices[i][1];
-        data[offset++] = color[0];
-        data[offset++] = color[1];
-        data[offset++] = color[2];
-        data[offset++] = hullOutlineAlpha;
-
-        // End vertex of line segment
-        data[offset++] = hull.vertices[next][0];
-        data[offset++] = hull.vertices[next][1];
-        data[offset++] = color[0];
-        data[offset++] = color[1];
-        data[offset++] = color[2];
-        data[offset++] = hullOutlineAlpha;
-      }
-    }
+    // Convex mode: draw the hulls built by `update` this frame
+    this.updateBindGroup();
+    if (!this.pipeline || !this.bindGroup || !this.cameraBuffer || !this.hullParamsBuffer) return;
+    if (!this.drawable) return;
 
-    this.outlineVertexCount = totalVertices;
-
-    // Grow buffer only when capacity is exceeded (amortized 2× growth)
-    if (data.byteLength > this.outlineBufferCapacity) {
-      if (this.outlineVertexBuffer) this.outlineVertexBuffer.destroy();
-      this.outlineBufferCapacity = data.byteLength * 2;
-      this.outlineVertexBuffer = this.gpu.device.createBuffer({
-        label: 'hull-outline-vertices',
-        size: this.outlineBufferCapacity,
-        usage: GPUBufferUsage.VERTEX | GPUBufferUsage.COPY_DST,
-      });
+    // Update camera uniform (only when camera has changed)
+    if (this.camera.version !== this.lastCameraVersion) {
+      this.lastCameraVersion = this.camera.version;
+      this.gpu.device.queue.writeBuffer(this.cameraBuffer, 0, this.camera.getProjection());
     }
-    this.gpu.device.queue.writeBuffer(this.outlineVertexBuffer!, 0, data);
-  }
 
-  forceRecompute(): void {
-    this.needsRecompute = true;
-  }
-
-  /** Point-in-polygon hit test against cached hulls (ray-casting algorithm).
-   *  Tests in reverse order so the topmost (last-rendered) hull wins. */
-  hitTest(worldX: number, worldY: number, hullMode: HullMode = 'convex'): number | null {
-    // Metaball mode: delegate to field evaluation
-    if (hullMode === 'metaball' && this.metaballRenderer) {
-      return this.metaballRenderer.hitTest(worldX, worldY);
-    }
+    this.hullParams.setFloat32(0, renderParams.hullAlpha, true);
+    this.hullParams.setFloat32(4, renderParams.hullOutline ? OUTLINE_ALPHA : 0, true);
+    this.hullParams.setFloat32(8, this.radius, true);
+    this.hullParams.setFloat32(12, 1 / this.camera.zoom, true);
+    this.hullParams.setUint32(16, getPaletteSize(), true);
+    this.gpu.device.queue.writeBuffer(this.hullParamsBuffer, 0, this.hullParams.buffer);
 
-    // Convex mode: point-in-polygon
-    for (let h = this.lastHulls.length - 1; h >= 0; h--) {
-      const verts = this.lastHulls[h].vertices;
-      const n = verts.length;
-      if (n < 3) continue;
-
-      let inside = false;
-      for (let i = 0, j = n - 1; i < n; j = i++) {
-        const xi = verts[i][0], yi = verts[i][1];
-        const xj = verts[j][0], yj = verts[j][1];
-        if ((yi > worldY) !== (yj > worldY) &&
-            worldX < (xj - xi) * (worldY - yi) / (yj - yi) + xi) {
-          inside = !inside;
-        }
-      }
-      if (inside) return this.lastHulls[h].hyperedgeIndex;
-    }
-    return null;
+    renderPass.setPipeline(this.pipeline);
+    renderPass.setBindGroup(0, this.bindGroup);
+    renderPass.draw(6, this.gpuHulls.slotCount);
   }
 
-  render(renderPass: GPURenderPassEncoder, renderParams: RenderParams, positions: Float32Array | null): void {
-    if (!this.hypergraphData) return;
-
-    const isMetaball = renderParams.hullMode === 'metaball';
-
-    // Throttled recompute
-    this.frameCounter++;
-    if (positions && (this.needsRecompute || this.frameCounter >= this.recomputeInterval)) {
-      this.frameCounter = 0;
-
-      if (isMetaball) {
-        this.recomputeMetaballs(positions, renderParams);
-      } else {
-        this.recomputeHullsSync(positions, renderParams);
-      }
+  /**
+   * Draw edge IDs into the pick pass (see GPUPicker); later edges overwrite
+   * earlier ones, so the top-most hull or blob wins. Uses the state `render`
+   * set up this frame, seen through the picker's `camera`.
+   */
+  renderPick(pass: GPURenderPassEncoder, renderParams: RenderParams, camera: GPUBuffer): void {
+    if (!this.store) return;
+    if (renderParams.hullMode === 'metaball') {
+      this.metaballRenderer?.renderPick(pass, camera);
+      return;
     }
-
-    if (isMetaball) {
-      // Metaball mode: delegate to fragment shader renderer
-      this.metaballRenderer?.render(renderPass);
-    } else {
-      // Convex mode: draw pre-computed hull geometry
-      if (!this.pipeline || !this.bindGroup || !this.cameraBuffer) return;
-
-      // Update camera uniform (only when camera has changed)
-      if (this.camera.version !== this.lastCameraVersion) {
-        this.lastCameraVersion = this.camera.version;
-        this.gpu.device.queue.writeBuffer(this.cameraBuffer, 0, this.camera.getProjection());
-      }
-
-      // Draw filled hulls
-      if (this.fillVertexCount > 0 && this.fillVertexBuffer) {
-        renderPass.setPipeline(this.pipeline);
-        renderPass.setBindGroup(0, this.bindGroup);
-        renderPass.setVertexBuffer(0, this.fillVertexBuffer);
-        renderPass.draw(this.fillVertexCount);
-      }
-
-      // Draw hull outlines
-      if (renderParams.hullOutline && this.outlineVertexCount > 0 && this.outlineVertexBuffer && this.outlinePipeline) {
-        renderPass.setPipeline(this.outlinePipeline);
-        renderPass.setBindGroup(0, this.bindGroup);
-        renderPass.setVertexBuffer(0, this.outlineVertexBuffer);
-        renderPass.draw(this.outlineVertexCount);
-      }
+    if (!this.pickPipeline || !this.bindGroup || !this.drawable) return;
+    if (!this.pickBindGroup || this.pickCamera !== camera) {
+      this.pickBindGroup = this.createBindGroup('hull-pick-bind-group', camera);
+      this.pickCamera = camera;
     }
+    pass.setPipeline(this.pickPipeline);
+    pass.setBindGroup(0, this.pickBindGroup);
+    pass.draw(6, this.gpuHulls.slotCount);
   }
 }
+
+/** Rounding radius of a hull: the margin, at least 1 world unit (as HullCompute). */
+function hullRadius(margin: number): number {
+  return Math.max(margin, 1);
+}
@@ -1,27 +1,82 @@
 // Screen-space metaball renderer — evaluates Gaussian field per-pixel in fragment shader
 // Replaces the GPU compute → CPU readback → marching squares → triangulation pipeline
-// Each hyperedge rendered as a bounding-box quad with instanced draw
+// Each hyperedge's bounding box is drawn as a grid of tile quads (instanced);
+// compute pre-passes rebuild the bounding boxes and MST bridges of hyperedges
+// whose members moved (metaball-build.wgsl) and bin the field primitives into
+// the tiles they reach, all from live GPU positions (see encodeBuild); tiles
+// off screen are then culled, and the rest drawn indirectly (encodeCulling)
+// Below full resolution the field is drawn offscreen, then upsampled by the
+// main pass with full-resolution refinement along the contours (encodeLowRes)
+// Hit testing is the GPU pick pass (renderPick), at full resolution
 
 import type { GPUContext } from '../gpu/device';
 import type { BufferManager } from '../gpu/buffer-manager';
 import type { Camera } from './camera';
-import type { HyperedgeData } from '../data/types';
-import { computeMST, distToSegmentSq } from './metaball-hull';
+import type { EdgeMembers } from '../data/types';
+import type { GPUProfiler } from '../gpu/gpu-profiler';
+import { PICK_FORMAT } from '../interaction/gpu-picker';
+import { GPUCuller, TILE_CULL } from './gpu-culling';
 import { getPaletteColor } from '../utils/color';
 import shaderCode from '../shaders/metaball-render.wgsl?raw';
+import binShaderCode from '../shaders/metaball-bin.wgsl?raw';
+import buildShaderCode from '../shaders/metaball-build.wgsl?raw';
 
-// Instance layout: 12 floats/u32s = 48 bytes per edge (matches WGSL EdgeInstance struct)
-const FLOATS_PER_INSTANCE = 12;
+// Instance layout: 16 floats/u32s = 64 bytes per edge (matches WGSL EdgeInstance struct)
+const FLOATS_PER_INSTANCE = 16;
 const BYTES_PER_INSTANCE = FLOATS_PER_INSTANCE * 4;
 
+// Tile grid per hyperedge: tiles about 2× the 3σ cutoff radius wide, so a node
+// reaches at most 2×2 tiles; at most MAX_TILE_GRID per axis. The grid is sized
+// on the GPU within a budget of one tile per member reserved here. Each tile
+// lists up to LIST_CAPACITY primitives (matches WGSL), beyond which it
+// evaluates them all
+const TILE_SIGMAS = 6;
+const MAX_TILE_GRID = 16;
+const LIST_CAPACITY = 32;
+const WORKGROUP = 64;
+const MAX_GROUPS_X = 65535;
+
+// Per member slot of the GPU build: component, link, best edge, snapshot
+// (matches WGSL Slot), and KNN candidate neighbours
+const SLOT_BYTES = 24;
+const KNN = 4;
+
+// An edge is rebuilt once a member moved this many σ: well inside the 3σ
+// bbox padding, and the MST (an approximation anyway) stays a close fit
+const DIRTY_FRACTION = 0.25;
+
 export class MetaballRenderer {
   private gpu: GPUContext;
   private buffers: BufferManager;
   private camera: Camera;
 
   private pipeline: GPURenderPipeline;
+  private pickPipeline: GPURenderPipeline;
   private bindGroupLayout: GPUBindGroupLayout;
   private bindGroup: GPUBindGroup | null = null;
+  private bindGroupVersion = -1; // culler version the render bind group was built with
+  private pickBindGroup: GPUBindGroup | null = null; // bindGroup with the pick camera
+  private pickSource: GPUBindGroup | null = null;
+  private pickCamera: GPUBuffer | null = null;
+  private culler: GPUCuller;     // on-screen tiles in use → indirect tile draws
+  private binPipeline: GPUComputePipeline;
+  private binBindGroupLayout: GPUBindGroupLayout;
+  private binBindGroup: GPUBindGroup | null = null;
+  private buildPipeline: GPUComputePipeline;
+  private buildBindGroupLayout: GPUBindGroupLayout;
+  private buildBindGroup: GPUBindGroup | null = null;
+  private buildParamsBuffer: GPUBuffer;
+  private rebuildAll = true; // GPU snapshots invalid (new layout or reallocated buffers)
+
+  // Reduced-resolution field: offscreen image, composite + contour refine pipelines
+  private compositePipeline: GPURenderPipeline;
+  private refinePipeline: GPURenderPipeline;
+  private lowResBindGroupLayout: GPUBindGroupLayout;
+  private lowResBindGroup: GPUBindGroup | null = null;
+  private lowResTexture: GPUTexture | null = null;
+  private lowResParamsBuffer: GPUBuffer;
+  private lowResFactor = 1; // canvas pixels per texel; 1 = drawn directly in the main pass
+  private lowResTextureFactor = 0; // factor the texture and its params were made for
 
   private cameraBuffer: GPUBuffer;
   private paramsBuffer: GPUBuffer;
@@ -31,14 +86,32 @@ export class MetaballRenderer {
 
   private lastCameraVersion = -1;
 
-  // Cached for hit testing
-  private lastEdges: HyperedgeData[] = [];
+  // Inputs of the last build (instances and MSTs below match these)
+  private lastEdges: readonly EdgeMembers[] = [];
   private lastSigma = 5;
   private lastThreshold = 0.5;
-  private lastPositions: Float32Array | null = null;
-
-  // Pre-allocated params backing (16 bytes: sigma, threshold, band, pad)
+  private lastAlpha = 0;
+  private lastDimmed: Set<number> | null = null;
+  private layoutValid = false;
+
+  // Grow-only CPU mirror of the instance layout; bounds, MST count and tile
+  // grid are filled in on the GPU
+  private instF32 = new Float32Array(0);
+  private instU32 = new Uint32Array(0);
+  private instanceEdge = new Uint32Array(0); // instance → index into lastEdges
+
+  // Tile layout, fixed per full build: tile → instance + index, primitive → instance
+  private tileData = new Uint32Array(0);     // instance, tile index within its budget
+  private primInstance = new Uint32Array(0);
+  private tileCount = 0;
+  private binnedTiles = 0;                   // tiles of multi-tile budgets (with a list)
+  private primCount = 0;
+
+  // Pre-allocated params backing (16 bytes: sigma, threshold, band, primitive count)
   private paramsArray = new Float32Array(4);
+  private paramsU32 = new Uint32Array(this.paramsArray.buffer);
+  private buildParams = new Uint32Array(8);
+  private buildParamsF32 = new Float32Array(this.buildParams.buffer);
 
   constructor(gpu: GPUContext, buffers: BufferManager, camera: Camera) {
     this.gpu = gpu;
@@ -46,6 +119,7 @@ export class MetaballRenderer {
     this.camera = camera;
 
     const { device, format } = gpu;
+    this.culler = new GPUCuller(device, buffers, TILE_CULL);
 
     const module = device.createShaderModule({
       label: 'metaball-render-shader',
@@ -62,26 +136,115 @@ export class MetaballRenderer {
         { binding: 4, visibility: GPUShaderStage.VERTEX | GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } },   // instances
         { binding: 5, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } },  // mst_edges
         { binding: 6, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'uniform' } },            // params
+        { binding: 7, visibility: GPUShaderStage.VERTEX, buffer: { type: 'read-only-storage' } },    // tiles (culled)
+        { binding: 8, visibility: GPUShaderStage.VERTEX | GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } },   // tile_counts
+        { binding: 9, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'read-only-storage' } },  // tile_lists
+      ],
+    });
+
+    const binModule = device.createShaderModule({
+      label: 'metaball-bin-shader',
+      code: binShaderCode,
+    });
+    const compute = (binding: number, type: GPUBufferBindingType): GPUBindGroupLayoutEntry =>
+      ({ binding, visibility: GPUShaderStage.COMPUTE, buffer: { type } });
+    this.binBindGroupLayout = device.createBindGroupLayout({
+      label: 'metaball-bin-bgl',
+      entries: [
+        compute(0, 'read-only-storage'), // positions
+        compute(1, 'read-only-storage'), // he_offsets
+        compute(2, 'read-only-storage'), // he_members
+        compute(3, 'read-only-storage'), // instances
+        compute(4, 'read-only-storage'), // mst_edges
+        compute(5, 'read-only-storage'), // prim_instance
+        compute(6, 'storage'),           // tile_counts
+        compute(7, 'storage'),           // tile_lists
+        compute(8, 'uniform'),           // params
       ],
     });
+    this.binPipeline = device.createComputePipeline({
+      label: 'metaball-bin-pipeline',
+      layout: device.createPipelineLayout({ bindGroupLayouts: [this.binBindGroupLayout] }),
+      compute: { module: binModule, entryPoint: 'bin_primitives' },
+    });
 
+    const buildModule = device.createShaderModule({
+      label: 'metaball-build-shader',
+      code: buildShaderCode,
+    });
+    this.buildBindGroupLayout = device.createBindGroupLayout({
+      label: 'metaball-build-bgl',
+      entries: [
+        compute(0, 'read-only-storage'), // positions
+        compute(1, 'read-only-storage'), // he_offsets
+        compute(2, 'read-only-storage'), // he_members
+        compute(3, 'storage'),           // instances
+        compute(4, 'storage'),           // mst_edges
+        compute(5, 'storage'),           // scratch
+        compute(6, 'storage'),           // knn
+        compute(7, 'uniform'),           // params
+      ],
+    });
+    this.buildPipeline = device.createComputePipeline({
+      label: 'metaball-build-pipeline',
+      layout: device.createPipelineLayout({ bindGroupLayouts: [this.buildBindGroupLayout] }),
+      compute: { module: buildModule, entryPoint: 'build_instances' },
+    });
+
+    const blend: GPUBlendState = {
+      color: { srcFactor: 'src-alpha', dstFactor: 'one-minus-src-alpha', operation: 'add' },
+      alpha: { srcFactor: 'one', dstFactor: 'one-minus-src-alpha', operation: 'add' },
+    };
     this.pipeline = device.createRenderPipeline({
       label: 'metaball-render-pipeline',
       layout: device.createPipelineLayout({ bindGroupLayouts: [this.bindGroupLayout] }),
       vertex: { module, entryPoint: 'vs_main' },
+      fragment: { module, entryPoint: 'fs_main', targets: [{ format, blend }] },
+      primitive: { topology: 'triangle-list' },
+    });
+    this.pickPipeline = device.createRenderPipeline({
+      label: 'metaball-pick-pipeline',
+      layout: device.createPipelineLayout({ bindGroupLayouts: [this.bindGroupLayout] }),
+      vertex: { module, entryPoint: 'vs_main' },
+      fragment: { module, entryPoint: 'fs_pick', targets: [{ format: PICK_FORMAT, writeMask: GPUColorWrite.GREEN }] },
+      primitive: { topology: 'triangle-list' },
+    });
+
+    this.lowResBindGroupLayout = device.createBindGroupLayout({
+      label: 'metaball-low-res-bgl',
+      entries: [
+        { binding: 0, visibility: GPUShaderStage.FRAGMENT, texture: { sampleType: 'float' } }, // low_res
+        { binding: 1, visibility: GPUShaderStage.FRAGMENT, buffer: { type: 'uniform' } },      // factor
+      ],
+    });
+    const lowResLayout = device.createPipelineLayout({
+      bindGroupLayouts: [this.bindGroupLayout, this.lowResBindGroupLayout],
+    });
+    // The offscreen image holds premultiplied color (blended over transparent)
+    this.compositePipeline = device.createRenderPipeline({
+      label: 'metaball-composite-pipeline',
+      layout: lowResLayout,
+      vertex: { module, entryPoint: 'vs_composite' },
       fragment: {
         module,
-        entryPoint: 'fs_main',
+        entryPoint: 'fs_composite',
         targets: [{
           format,
           blend: {
-            color: { srcFactor: 'src-alpha', dstFactor: 'one-minus-src-alpha', operation: 'add' },
+            color: { srcFactor: 'one', dstFactor: 'one-minus-src-alpha', operation: 'add' },
             alpha: { srcFactor: 'one', dstFactor: 'one-minus-src-alpha', operation: 'add' },
           },
         }],
       },
       primitive: { topology: 'triangle-list' },
     });
+    this.refinePipeline = device.createRenderPipeline({
+      label: 'metaball-refine-pipeline',
+      layout: lowResLayout,
+      vertex: { module, entryPoint: 'vs_main' },
+      fragment: { module, entryPoint: 'fs_refine', targets: [{ format, blend }] },
+      primitive: { topology: 'triangle-list' },
+    });
 
     this.cameraBuffer = buffers.createBuffer(
       'metaball-camera', 64,
@@ -92,123 +255,77 @@ export class MetaballRenderer {
       'metaball-render-params', 16,
       GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'metaball-render-params',
     );
+
+    this.lowResParamsBuffer = buffers.createBuffer(
+      'metaball-low-res-params', 16,
+      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'metaball-low-res-params',
+    );
+
+    this.buildParamsBuffer = buffers.createBuffer(
+      'metaball-build-params', 32,
+      GPUBufferUsage.UNIFORM | GPUBufferUsage.COPY_DST, 'metaball-build-params',
+    );
   }
 
   /**
-   * Recompute instance data (bounding boxes + MSTs) from CPU positions.
-   * Called every N frames — the fragment shader reads live GPU positions each frame.
+   * Lay out the instances of `edges`: one per hyperedge with 2+ members, with
+   * its color, reserved MST range, member slots, tiles and primitives. A
+   * no-op while edges and parameters are unchanged; bounds and MSTs follow
+   * the positions on the GPU (`encodeBuild`), not here.
    */
   updateInstances(
-    positions: Float32Array,
-    edges: HyperedgeData[],
+    edges: readonly EdgeMembers[],
     sigma: number,
     threshold: number,
     alpha: number,
     dimmedEdges: Set<number> | null,
   ): void {
-    // Cache for hit testing
+    if (this.layoutValid && edges === this.lastEdges && sigma === this.lastSigma &&
+        threshold === this.lastThreshold && alpha === this.lastAlpha && dimmedEdges === this.lastDimmed) {
+      return;
+    }
+
+    // Inputs the GPU build works from
     this.lastEdges = edges;
     this.lastSigma = sigma;
     this.lastThreshold = threshold;
-    this.lastPositions = positions;
-
-    // Filter to edges with 2+ members
-    const validEdges: HyperedgeData[] = [];
+    this.lastAlpha = alpha;
+    this.lastDimmed = dimmedEdges;
+    this.layoutValid = true;
+    this.rebuildAll = true;
+
+    // Size the arenas: one instance per edge with 2+ members, a fixed range of
+    // size - 1 MST edges each (and `size` member slots at mst_offset + instance)
+    let edgeCount = 0;
+    let mstReserved = 0;
     for (const he of edges) {
-      if (he.memberIndices.length >= 2) validEdges.push(he);
+      const size = he.memberIndices.length;
+      if (size < 2) continue;
+      edgeCount++;
+      mstReserved += size - 1;
     }
-
-    if (validEdges.length === 0) {
-      this.instanceCount = 0;
-      return;
-    }
-
-    const padding = sigma * 3;
-    const edgeCount = validEdges.length;
-
-    // Build instance data + MST edges
-    const instanceBuf = new ArrayBuffer(edgeCount * BYTES_PER_INSTANCE);
-    const instF32 = new Float32Array(instanceBuf);
-    const instU32 = new Uint32Array(instanceBuf);
-
-    // First pass: compute MSTs to know total MST edge count
-    const allMstEdges: [number, number][][] = [];
-    let totalMstEdges = 0;
-    for (const he of validEdges) {
-      const pts = he.memberIndices.map(ni => [
-        positions[ni * 4], positions[ni * 4 + 1],
-      ] as [number, number]);
-      const mst = computeMST(pts);
-      // Remap MST indices (local → global node indices)
-      const globalMst: [number, number][] = mst.map(([a, b]) => [
-        he.memberIndices[a], he.memberIndices[b],
-      ]);
-      allMstEdges.push(globalMst);
-      totalMstEdges += globalMst.length;
+    this.instanceCount = edgeCount;
+    if (edgeCount === 0) return;
+
+    if (edgeCount * FLOATS_PER_INSTANCE > this.instF32.length) {
+      const capacity = Math.max(edgeCount, (this.instF32.length / FLOATS_PER_INSTANCE) * 2);
+      const instanceBuf = new ArrayBuffer(capacity * BYTES_PER_INSTANCE);
+      this.instF32 = new Float32Array(instanceBuf);
+      this.instU32 = new Uint32Array(instanceBuf);
+      this.instanceEdge = new Uint32Array(capacity);
     }
 
-    // Build flat MST edges array
-    const mstData = new Uint32Array(Math.max(totalMstEdges * 2, 1));
     let mstOffset = 0;
-
-    for (let i = 0; i < edgeCount; i++) {
-      const he = validEdges[i];
-      const globalMst = allMstEdges[i];
-      const color = getPaletteColor(he.index);
-      const isDimmed = dimmedEdges !== null && dimmedEdges.has(he.index);
-      const a = isDimmed ? alpha * 0.08 : alpha;
-
-      // Compute bounding box from member positions + bridge endpoints
-      let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
-      for (const ni of he.memberIndices) {
-        const x = positions[ni * 4];
-        const y = positions[ni * 4 + 1];
-        if (x < minX) minX = x;
-        if (y < minY) minY = y;
-        if (x > maxX) maxX = x;
-        if (y > maxY) maxY = y;
-      }
-
-      // Expand bbox for bridge sigma (bridges can be wider than node sigma)
-      let maxBridgeSigma = sigma;
-      for (const [ai, bi] of globalMst) {
-        const ax = positions[ai * 4], ay = positions[ai * 4 + 1];
-        const bx = positions[bi * 4], by = positions[bi * 4 + 1];
-        const dx = bx - ax, dy = by - ay;
-        const edgeLen = Math.sqrt(dx * dx + dy * dy);
-        maxBridgeSigma = Math.max(maxBridgeSigma, edgeLen * 0.12);
-      }
-      const effectivePadding = Math.max(padding, maxBridgeSigma * 3);
-
-      minX -= effectivePadding;
-      minY -= effectivePadding;
-      maxX += effectivePadding;
-      maxY += effectivePadding;
-
-      // Pack instance data (12 values = 48 bytes)
-      const base = i * FLOATS_PER_INSTANCE;
-      instF32[base + 0] = minX;           // bbox_min.x
-      instF32[base + 1] = minY;           // bbox_min.y
-      instF32[base + 2] = maxX;           // bbox_max.x
-      instF32[base + 3] = maxY;           // bbox_max.y
-      instF32[base + 4] = color[0];       // color.r
-      instF32[base + 5] = color[1];       // color.g
-      instF32[base + 6] = color[2];       // color.b
-      instF32[base + 7] = a;              // color.a
-      instU32[base + 8] = he.index;       // edge_index (into he_offsets/he_members)
-      instU32[base + 9] = mstOffset;      // mst_offset
-      instU32[base + 10] = globalMst.length; // mst_count
-      instU32[base + 11] = 0;             // _pad
-
-      // Pack MST edges
-      for (const [ai, bi] of globalMst) {
-        mstData[mstOffset * 2] = ai;
-        mstData[mstOffset * 2 + 1] = bi;
-        mstOffset++;
-      }
+    let i = 0;
+    for (let e = 0; e < edges.length; e++) {
+      const size = edges[e].memberIndices.length;
+      if (size < 2) continue;
+      this.instanceEdge[i] = e;
+      this.packInstance(i, mstOffset);
+      mstOffset += size - 1;
+      i++;
     }
-
-    this.instanceCount = edgeCount;
+    this.layoutTiles(edges);
 
     // Upload instance buffer (grow with 2× amortization)
     const instanceBytes = edgeCount * BYTES_PER_INSTANCE;
@@ -217,30 +334,47 @@ export class MetaballRenderer {
       this.buffers.destroyBuffer('metaball-instances');
       this.buffers.createBuffer(
         'metaball-instances', this.instanceCapacity,
-        GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'metaball-instances',
+        GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST | GPUBufferUsage.COPY_SRC, 'metaball-instances',
       );
       this.bindGroup = null; // force rebind
     }
-    this.buffers.uploadData('metaball-instances', new Uint8Array(instanceBuf));
+    this.buffers.uploadData('metaball-instances', this.instF32, 0, instanceBytes);
 
-    // Upload MST buffer
-    const mstBytes = Math.max(mstData.byteLength, 4);
+    // MST buffer, written by the GPU build only
+    const mstBytes = mstReserved * 8;
     if (mstBytes > this.mstCapacity) {
       this.mstCapacity = Math.max(mstBytes * 2, 16);
       this.buffers.destroyBuffer('metaball-mst');
       this.buffers.createBuffer(
         'metaball-mst', this.mstCapacity,
-        GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST, 'metaball-mst',
+        GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC, 'metaball-mst',
       );
       this.bindGroup = null; // force rebind
     }
-    this.buffers.uploadData('metaball-mst', mstData);
+
+    // Build scratch: member slots and their candidate neighbours, clamped to
+    // the binding limit (the shader skips MSTs, or candidates, beyond it)
+    const limit = this.gpu.device.limits.maxStorageBufferBindingSize;
+    const slots = mstReserved + edgeCount;
+    const storage = GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_DST;
+    let replaced = this.buffers.ensureCapacity('metaball-build-scratch', Math.min(slots * SLOT_BYTES, limit), storage);
+    replaced = this.buffers.ensureCapacity('metaball-knn', Math.min(slots * KNN * 4, limit), storage) || replaced;
+
+    // Tile layout and bin targets (lists are rebuilt on the GPU every frame)
+    replaced = this.buffers.ensureCapacity('metaball-tiles', this.tileCount * 8, storage) || replaced;
+    replaced = this.buffers.ensureCapacity('metaball-prim-instance', Math.max(this.primCount * 4, 4), storage) || replaced;
+    replaced = this.buffers.ensureCapacity('metaball-tile-counts', Math.max(this.binnedTiles * 4, 4), storage | GPUBufferUsage.COPY_SRC) || replaced;
+    replaced = this.buffers.ensureCapacity('metaball-tile-lists', Math.max(this.binnedTiles * LIST_CAPACITY * 4, 4), storage) || replaced;
+    replaced = this.culler.reserve(this.tileCount, this.tileCount) || replaced;
+    if (replaced) this.bindGroup = null;
+    this.buffers.uploadData('metaball-tiles', this.tileData, 0, this.tileCount * 8);
+    this.buffers.uploadData('metaball-prim-instance', this.primInstance, 0, this.primCount * 4);
 
     // Upload params
     this.paramsArray[0] = sigma;
     this.paramsArray[1] = threshold;
     this.paramsArray[2] = threshold * 0.15; // smoothing band
-    this.paramsArray[3] = 0;
+    this.paramsU32[3] = this.primCount;
     this.gpu.device.queue.writeBuffer(this.paramsBuffer, 0, this.paramsArray);
 
     // Rebuild bind group if needed
@@ -249,121 +383,316 @@ export class MetaballRenderer {
     }
   }
 
+  /** Force every instance to be rebuilt on the next `encodeBuild` (e.g. after a layout jump). */
+  invalidateInstances(): void {
+    this.rebuildAll = true;
+  }
+
+  /**
+   * Reserve each instance's tiles (one per member, a single tile when the
+   * lists would not fit the binding limit), tile lists and primitives
+   * (members, then MST edges). The GPU build picks the grid within them.
+   */
+  private layoutTiles(edges: readonly EdgeMembers[]): void {
+    const maxBinned = Math.floor(this.gpu.device.limits.maxStorageBufferBindingSize / (LIST_CAPACITY * 4));
+    const instU32 = this.instU32;
+
+    let tiles = 0;
+    let binned = 0;
+    let prims = 0;
+    for (let i = 0; i < this.instanceCount; i++) {
+      const base = i * FLOATS_PER_INSTANCE;
+      const size = edges[this.instanceEdge[i]].memberIndices.length;
+      let budget = Math.min(size, MAX_TILE_GRID * MAX_TILE_GRID);
+      if (binned + budget > maxBinned) budget = 1;
+      instU32[base + 11] = tiles;   // tile_offset
+      instU32[base + 12] = 1;       // tile_dims (1 × 1 until built)
+      instU32[base + 13] = binned;  // list_offset
+      instU32[base + 14] = prims;   // prim_offset
+      instU32[base + 15] = budget;  // tile_budget
+      tiles += budget;
+      if (budget > 1) binned += budget;
+      prims += size * 2 - 1; // members + reserved MST edges
+    }
+
+    if (tiles * 2 > this.tileData.length) {
+      this.tileData = new Uint32Array(Math.max(tiles * 2, this.tileData.length * 2));
+    }
+    if (prims > this.primInstance.length) {
+      this.primInstance = new Uint32Array(Math.max(prims, this.primInstance.length * 2));
+    }
+    for (let i = 0; i < this.instanceCount; i++) {
+      const base = i * FLOATS_PER_INSTANCE;
+      const first = instU32[base + 11];
+      for (let t = 0; t < instU32[base + 15]; t++) {
+        this.tileData[(first + t) * 2] = i;
+        this.tileData[(first + t) * 2 + 1] = t;
+      }
+      const primEnd = i + 1 < this.instanceCount ? instU32[base + FLOATS_PER_INSTANCE + 14] : prims;
+      this.primInstance.fill(i, instU32[base + 14], primEnd);
+    }
+    this.tileCount = tiles;
+    this.binnedTiles = binned;
+    this.primCount = prims;
+  }
+
+  /**
+   * Encode this frame's instance build (before `encodeBinning`): one
+   * workgroup per instance rebuilds the bounds, tile grid and MST bridges of
+   * instances whose members moved more than DIRTY_FRACTION·σ since their
+   * last build, from the live GPU positions.
+   */
+  encodeBuild(encoder: GPUCommandEncoder): void {
+    if (this.instanceCount === 0) return;
+    if (!this.bindGroup) this.rebuildBindGroup();
+    if (!this.buildBindGroup) return;
+
+    const sigma = this.lastSigma;
+    this.buildParams[0] = this.instanceCount;
+    this.buildParams[1] = Math.floor(this.buffers.getBuffer('metaball-build-scratch').size / SLOT_BYTES);
+    this.buildParams[2] = Math.floor(this.buffers.getBuffer('metaball-knn').size / (KNN * 4));
+    this.buildParams[3] = this.rebuildAll ? 1 : 0;
+    this.buildParamsF32[4] = sigma;
+    this.buildParamsF32[5] = sigma * DIRTY_FRACTION;
+    this.buildParamsF32[6] = TILE_SIGMAS * sigma;
+    this.rebuildAll = false;
+    this.gpu.device.queue.writeBuffer(this.buildParamsBuffer, 0, this.buildParams);
+
+    const pass = encoder.beginComputePass({ label: 'metaball-build' });
+    pass.setPipeline(this.buildPipeline);
+    pass.setBindGroup(0, this.buildBindGroup);
+    const x = Math.min(this.instanceCount, MAX_GROUPS_X);
+    pass.dispatchWorkgroups(x, Math.ceil(this.instanceCount / x));
+    pass.end();
+  }
+
+  /**
+   * Encode this frame's tile binning (before the render pass that draws the
+   * metaballs): clears the tile lists and re-bins every primitive from the
+   * live GPU positions.
+   */
+  encodeBinning(encoder: GPUCommandEncoder): void {
+    if (this.instanceCount === 0 || this.binnedTiles === 0) return;
+    if (!this.bindGroup) this.rebuildBindGroup();
+    if (!this.binBindGroup) return;
+
+    encoder.clearBuffer(this.buffers.getBuffer('metaball-tile-counts'), 0, this.binnedTiles * 4);
+    const pass = encoder.beginComputePass({ label: 'metaball-bin' });
+    pass.setPipeline(this.binPipeline);
+    pass.setBindGroup(0, this.binBindGroup);
+    const groups = Math.ceil(this.primCount / WORKGROUP);
+    const x = Math.min(groups, MAX_GROUPS_X);
+    pass.dispatchWorkgroups(x, Math.ceil(groups / x));
+    pass.end();
+  }
+
+  /**
+   * Encode this frame's tile culling (after `encodeBuild`, before the field
+   * is drawn): the tiles of the current grids that overlap the view, in
+   * order, for the indirect tile draws.
+   */
+  encodeCulling(encoder: GPUCommandEncoder): void {
+    if (this.instanceCount === 0 || !this.buffers.hasBuffer('metaball-tiles')) return;
+    this.culler.encode(encoder, this.camera, 1, this.tileCount, this.tileCount, [
+      this.buffers.getBuffer('metaball-instances'), this.buffers.getBuffer('metaball-tiles'),
+    ]);
+  }
+
+  /**
+   * Encode this frame's reduced-resolution field pass (after `encodeCulling`,
+   * before the main render pass): the tiles are drawn into an offscreen image
+   * `scale` times the canvas size, which `render` then upsamples. A scale of
+   * 1 (or anything that rounds to it) draws the field directly in `render`.
+   */
+  encodeLowRes(encoder: GPUCommandEncoder, scale: number, profiler: GPUProfiler | null = null): void {
+    this.lowResFactor = scale > 0 && scale < 1 ? Math.round(1 / scale) : 1;
+    if (this.lowResFactor === 1 || this.instanceCount === 0) return;
+    if (!this.bindGroup || this.bindGroupVersion !== this.culler.version) this.rebuildBindGroup();
+    if (!this.bindGroup) return;
+
+    const { canvas } = this.gpu;
+    const width = Math.max(Math.ceil(canvas.width / this.lowResFactor), 1);
+    const height = Math.max(Math.ceil(canvas.height / this.lowResFactor), 1);
+    const texture = this.ensureLowResTexture(width, height);
+    this.updateCamera();
+
+    const pass = encoder.beginRenderPass({
+      label: 'metaball-field',
+      colorAttachments: [{
+        view: texture.createView(),
+        clearValue: { r: 0, g: 0, b: 0, a: 0 },
+        loadOp: 'clear',
+        storeOp: 'store',
+      }],
+      timestampWrites: profiler?.timestampWrites('metaball-field'),
+    });
+    pass.setPipeline(this.pipeline);
+    pass.setBindGroup(0, this.bindGroup);
+    pass.drawIndirect(this.culler.argsBuffer, 0);
+    pass.end();
+  }
+
+  /** (Re)create the offscreen field image on size or factor change. */
+  private ensureLowResTexture(width: number, height: number): GPUTexture {
+    const current = this.lowResTexture;
+    if (current && current.width === width && current.height === height &&
+        this.lowResTextureFactor === this.lowResFactor && this.lowResBindGroup) {
+      return current;
+    }
+    current?.destroy();
+    const texture = this.gpu.device.createTexture({
+      label: 'metaball-low-res',
+      size: [width, height],
+      format: this.gpu.format,
+      usage: GPUTextureUsage.RENDER_ATTACHMENT | GPUTextureUsage.TEXTURE_BINDING,
+    });
+    this.lowResTexture = texture;
+    this.lowResTextureFactor = this.lowResFactor;
+    this.gpu.device.queue.writeBuffer(this.lowResParamsBuffer, 0, new Uint32Array([this.lowResFactor, 0, 0, 0]));
+    this.lowResBindGroup = this.gpu.device.createBindGroup({
+      label: 'metaball-low-res-bind-group',
+      layout: this.lowResBindGroupLayout,
+      entries: [
+        { binding: 0, resource: texture.createView() },
+        { binding: 1, resource: { buffer: this.lowResParamsBuffer } },
+      ],
+    });
+    return texture;
+  }
+
+  /** Pack the CPU-owned fields of instance `i`: color, edge index and reserved MST range. */
+  private packInstance(i: number, mstOffset: number): void {
+    const he = this.lastEdges[this.instanceEdge[i]];
+    const base = i * FLOATS_PER_INSTANCE;
+    const color = getPaletteColor(he.index);
+    const isDimmed = this.lastDimmed !== null && this.lastDimmed.has(he.index);
+
+    this.instF32.fill(0, base, base + 4);                                     // bbox (GPU)
+    this.instF32[base + 4] = color[0];                                        // color.r
+    this.instF32[base + 5] = color[1];                                        // color.g
+    this.instF32[base + 6] = color[2];                                        // color.b
+    this.instF32[base + 7] = isDimmed ? this.lastAlpha * 0.08 : this.lastAlpha; // color.a
+    this.instU32[base + 8] = he.index;   // edge_index (into he_offsets/he_members)
+    this.instU32[base + 9] = mstOffset;  // mst_offset
+    this.instU32[base + 10] = 0;         // mst_count (GPU; tile fields: layoutTiles)
+  }
+
+  /** Recreate the bind groups; the GPU build's snapshots may be gone with a replaced buffer. */
   private rebuildBindGroup(): void {
     if (!this.buffers.hasBuffer('node-positions') ||
         !this.buffers.hasBuffer('he-offsets') ||
         !this.buffers.hasBuffer('he-members') ||
         !this.buffers.hasBuffer('metaball-instances') ||
-        !this.buffers.hasBuffer('metaball-mst')) {
+        !this.buffers.hasBuffer('metaball-mst') ||
+        !this.buffers.hasBuffer('metaball-tiles')) {
       return;
     }
 
-    this.bindGroup = this.gpu.device.createBindGroup({
-      label: 'metaball-render-bind-group',
+    this.rebuildAll = true;
+    this.bindGroupVersion = this.culler.version;
+    const get = (name: string) => ({ buffer: this.buffers.getBuffer(name) });
+    this.buildBindGroup = this.gpu.device.createBindGroup({
+      label: 'metaball-build-bind-group',
+      layout: this.buildBindGroupLayout,
+      entries: [
+        { binding: 0, resource: get('node-positions') },
+        { binding: 1, resource: get('he-offsets') },
+        { binding: 2, resource: get('he-members') },
+        { binding: 3, resource: get('metaball-instances') },
+        { binding: 4, resource: get('metaball-mst') },
+        { binding: 5, resource: get('metaball-build-scratch') },
+        { binding: 6, resource: get('metaball-knn') },
+        { binding: 7, resource: { buffer: this.buildParamsBuffer } },
+      ],
+    });
+    this.binBindGroup = this.gpu.device.createBindGroup({
+      label: 'metaball-bin-bind-group',
+      layout: this.binBindGroupLayout,
+      entries: [
+        { binding: 0, resource: get('node-positions') },
+        { binding: 1, resource: get('he-offsets') },
+        { binding: 2, resource: get('he-members') },
+        { binding: 3, resource: get('metaball-instances') },
+        { binding: 4, resource: get('metaball-mst') },
+        { binding: 5, resource: get('metaball-prim-instance') },
+        { binding: 6, resource: get('metaball-tile-counts') },
+        { binding: 7, resource: get('metaball-tile-lists') },
+        { binding: 8, resource: { buffer: this.paramsBuffer } },
+      ],
+    });
+    this.bindGroup = this.createRenderBindGroup('metaball-render-bind-group', this.cameraBuffer);
+  }
+
+  private createRenderBindGroup(label: string, camera: GPUBuffer): GPUBindGroup {
+    const get = (name: string) => ({ buffer: this.buffers.getBuffer(name) });
+    return this.gpu.device.createBindGroup({
+      label,
       layout: this.bindGroupLayout,
       entries: [
-        { binding: 0, resource: { buffer: this.cameraBuffer } },
+        { binding: 0, resource: { buffer: camera } },
         { binding: 1, resource: { buffer: this.buffers.getBuffer('node-positions') } },
         { binding: 2, resource: { buffer: this.buffers.getBuffer('he-offsets') } },
         { binding: 3, resource: { buffer: this.buffers.getBuffer('he-members') } },
         { binding: 4, resource: { buffer: this.buffers.getBuffer('metaball-instances') } },
         { binding: 5, resource: { buffer: this.buffers.getBuffer('metaball-mst') } },
         { binding: 6, resource: { buffer: this.paramsBuffer } },
+        { binding: 7, resource: { buffer: this.culler.visibleBuffer } },
+        { binding: 8, resource: get('metaball-tile-counts') },
+        { binding: 9, resource: get('metaball-tile-lists') },
       ],
     });
   }
 
-  render(renderPass: GPURenderPassEncoder): void {
-    if (this.instanceCount === 0 || !this.bindGroup) return;
-
-    // Update camera uniform
+  private updateCamera(): void {
     if (this.camera.version !== this.lastCameraVersion) {
       this.lastCameraVersion = this.camera.version;
       this.gpu.device.queue.writeBuffer(this.cameraBuffer, 0, this.camera.getProjection());
     }
+  }
+
+  render(renderPass: GPURenderPassEncoder): void {
+    if (this.instanceCount === 0) return;
+    if (!this.bindGroup || this.bindGroupVersion !== this.culler.version) this.rebuildBindGroup();
+    if (!this.bindGroup) return;
+    this.updateCamera();
 
-    renderPass.setPipeline(this.pipeline);
     renderPass.setBindGroup(0, this.bindGroup);
-    renderPass.draw(6, this.instanceCount);
+    if (this.lowResFactor > 1 && this.lowResBindGroup) {
+      // Upsampled image where flat, then the field again along its contours
+      renderPass.setBindGroup(1, this.lowResBindGroup);
+      renderPass.setPipeline(this.compositePipeline);
+      renderPass.draw(3);
+      renderPass.setPipeline(this.refinePipeline);
+    } else {
+      renderPass.setPipeline(this.pipeline);
+    }
+    renderPass.drawIndirect(this.culler.argsBuffer, 0);
   }
 
   /**
-   * CPU-side field evaluation at a single point for hit testing.
-   * Evaluates Gaussian field + MST bridge field for each visible edge.
+   * Draw edge IDs into the pick pass (see GPUPicker) wherever the field
+   * reaches the threshold, seen through the picker's `camera`.
    */
-  hitTest(worldX: number, worldY: number): number | null {
-    const positions = this.lastPositions;
-    if (!positions || this.lastEdges.length === 0) return null;
-
-    const sigma = this.lastSigma;
-    const threshold = this.lastThreshold;
-    const invTwoSigmaSq = 1 / (2 * sigma * sigma);
-    const cutoffSq = 9 * sigma * sigma;
-
-    // Test in reverse order (topmost = last rendered)
-    for (let e = this.lastEdges.length - 1; e >= 0; e--) {
-      const edge = this.lastEdges[e];
-      if (edge.memberIndices.length < 2) continue;
-
-      // Compute MST early so we can account for bridge sigma in bbox rejection
-      const pts = edge.memberIndices.map(ni => [
-        positions[ni * 4], positions[ni * 4 + 1],
-      ] as [number, number]);
-      const mstEdges = computeMST(pts);
-
-      // Quick bounding-box rejection
-      let minX = Infinity, minY = Infinity, maxX = -Infinity, maxY = -Infinity;
-      for (const ni of edge.memberIndices) {
-        const x = positions[ni * 4], y = positions[ni * 4 + 1];
-        if (x < minX) minX = x;
-        if (y < minY) minY = y;
-        if (x > maxX) maxX = x;
-        if (y > maxY) maxY = y;
-      }
-      let maxBridgeSigma = sigma;
-      for (const [ai, bi] of mstEdges) {
-        const dx = pts[bi][0] - pts[ai][0], dy = pts[bi][1] - pts[ai][1];
-        const edgeLen = Math.sqrt(dx * dx + dy * dy);
-        maxBridgeSigma = Math.max(maxBridgeSigma, edgeLen * 0.12);
-      }
-      const pad = Math.max(sigma * 3, maxBridgeSigma * 3);
-      if (worldX < minX - pad || worldX > maxX + pad ||
-          worldY < minY - pad || worldY > maxY + pad) {
-        continue;
-      }
-
-      // Evaluate Gaussian field
-      let fieldVal = 0;
-      for (const ni of edge.memberIndices) {
-        const nx = positions[ni * 4], ny = positions[ni * 4 + 1];
-        const dx = worldX - nx, dy = worldY - ny;
-        const dSq = dx * dx + dy * dy;
-        if (dSq < cutoffSq) {
-          fieldVal += Math.exp(-dSq * invTwoSigmaSq);
-        }
-      }
-      for (const [ai, bi] of mstEdges) {
-        const ax = pts[ai][0], ay = pts[ai][1];
-        const bx = pts[bi][0], by = pts[bi][1];
-        const edgeLen = Math.sqrt((bx - ax) ** 2 + (by - ay) ** 2);
-        const bridgeSigma = Math.max(sigma, edgeLen * 0.12);
-        const bridgeInv = 1 / (2 * bridgeSigma * bridgeSigma);
-        const bridgeCutoff = 9 * bridgeSigma * bridgeSigma;
-        const dSq = distToSegmentSq(worldX, worldY, ax, ay, bx, by);
-        if (dSq < bridgeCutoff) {
-          fieldVal += Math.exp(-dSq * bridgeInv);
-        }
-      }
-
-      if (fieldVal >= threshold) return edge.index;
+  renderPick(pass: GPURenderPassEncoder, camera: GPUBuffer): void {
+    if (this.instanceCount === 0) return;
+    if (!this.bindGroup || this.bindGroupVersion !== this.culler.version) this.rebuildBindGroup();
+    if (!this.bindGroup) return;
+    if (!this.pickBindGroup || this.pickSource !== this.bindGroup || this.pickCamera !== camera) {
+      this.pickBindGroup = this.createRenderBindGroup('metaball-pick-bind-group', camera);
+      this.pickSource = this.bindGroup;
+      this.pickCamera = camera;
     }
 
-    return null;
+    pass.setPipeline(this.pickPipeline);
+    pass.setBindGroup(0, this.pickBindGroup);
+    pass.drawIndirect(this.culler.argsBuffer, 0);
   }
 
   /** Force bind group recreation (e.g. when graph data changes) */
   invalidateBindGroup(): void {
     this.bindGroup = null;
+    this.binBindGroup = null;
+    this.buildBindGroup = null;
   }
 
   destroy(): void {
@@ -371,8 +700,22 @@ export class MetaballRenderer {
     this.buffers.destroyBuffer('metaball-mst');
     this.buffers.destroyBuffer('metaball-camera');
     this.buffers.destroyBuffer('metaball-render-params');
+    this.buffers.destroyBuffer('metaball-tiles');
+    this.buffers.destroyBuffer('metaball-prim-instance');
+    this.buffers.destroyBuffer('metaball-tile-counts');
+    this.buffers.destroyBuffer('metaball-tile-lists');
+    this.buffers.destroyBuffer('metaball-low-res-params');
+    this.buffers.destroyBuffer('metaball-build-params');
+    this.buffers.destroyBuffer('metaball-build-scratch');
+    this.buffers.destroyBuffer('metaball-knn');
+    this.culler.destroy();
+    this.lowResTexture?.destroy();
+    this.lowResTexture = null;
+    this.lowResBindGroup = null;
     this.instanceCount = 0;
+    this.tileCount = 0;
     this.instanceCapacity = 0;
     this.mstCapacity = 0;
+    this.layoutValid = false;
   }
 }
@@ -1,6 +1,6 @@
 // Node renderer — lightweight wrapper for node highlight/selection state
-// The core node rendering pipeline lives in app.ts; this module manages
-// highlight state and provides a future extension point for frustum culling
+// The core node rendering pipeline lives in app.ts (culled to the view by
+// gpu-culling.ts); this module manages highlight state
 
 export class NodeRenderer {
   private highlightedNode: number | null = null;
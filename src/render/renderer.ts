@@ -4,7 +4,8 @@
 import type { GPUContext } from '../gpu/device';
 import type { BufferManager } from '../gpu/buffer-manager';
 import type { Camera } from './camera';
-import type { HypergraphData, RenderParams } from '../data/types';
+import type { RenderParams } from '../data/types';
+import type { HypergraphStore } from '../data/hypergraph-store';
 import { EdgeRenderer } from './edge-renderer';
 import { HullCompute } from './hull-compute';
 import { HullRenderer } from './hull-renderer';
@@ -21,7 +22,7 @@ export class Renderer {
   private hullRenderer: HullRenderer;
   private nodeRenderer: NodeRenderer;
 
-  private graphData: HypergraphData | null = null;
+  private graphData: HypergraphStore | null = null;
 
   constructor(gpu: GPUContext, buffers: BufferManager, camera: Camera) {
     this.gpu = gpu;
@@ -37,7 +38,7 @@ export class Renderer {
   /**
    * Set the hypergraph data for all sub-renderers.
    */
-  setData(data: HypergraphData): void {
+  setData(data: HypergraphStore): void {
     this.graphData = data;
     this.edgeRenderer.setData(data);
     this.hullRenderer.setData(data);
@@ -64,6 +65,16 @@ export class Renderer {
     const bg = renderParams.backgroundColor;
     const commandEncoder = device.createCommandEncoder();
 
+    // Convex hulls are built on the GPU ahead of the pass that draws them
+    if (renderParams.hullAlpha > 0) {
+      this.hullRenderer.update(commandEncoder, renderParams);
+    }
+
+    // Star edges are culled to the view on the GPU, then drawn indirectly
+    if (renderParams.edgeOpacity > 0) {
+      this.edgeRenderer.encodeCulling(commandEncoder);
+    }
+
     const renderPass = commandEncoder.beginRenderPass({
       colorAttachments: [{
         view: textureView,
@@ -75,7 +86,7 @@ export class Renderer {
 
     // 1. Draw hulls (back layer)
     if (renderParams.hullAlpha > 0) {
-      this.hullRenderer.render(renderPass, renderParams, null);
+      this.hullRenderer.render(renderPass, renderParams);
     }
 
     // 2. Draw edges
@@ -97,7 +108,7 @@ export class Renderer {
     if (!this.graphData || !this.buffers.hasBuffer('node-positions')) return null;
 
     const worldPos = this.camera.screenToWorld(x, y);
-    const nodeCount = this.graphData.nodes.length;
+    const nodeCount = this.graphData.nodeCount;
     const positions = await this.buffers.readBuffer('node-positions', nodeCount * 16);
 
     // Pick radius in world space (based on node size and zoom)
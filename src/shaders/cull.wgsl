@@ -0,0 +1,218 @@
+// Visibility culling — compacts draw lists to what the camera can see (see
+// gpu-culling.ts). Each culled list has a pair of entry points: flag_* writes
+// the number of outputs of every item (0 when culled) into `counts`, which a
+// prefix sum turns into output offsets in place; emit_* then writes each
+// survivor's outputs at its offset, so survivors keep their input order.
+//
+//   nodes: one output per node that is not hidden and whose quad (at pick
+//          size, the larger one) overlaps the view
+//   edges: one [he_index, member] pair per member of every visible-edge slot
+//          whose bounds overlap the view; writes the centroid it tested with
+//   tiles: one [instance, tile] pair per metaball tile in use that overlaps
+//          the view
+//
+// Only the bindings of the list being culled are bound.
+
+struct CullParams {
+  view_min: vec2<f32>, // world-space view rectangle
+  view_max: vec2<f32>,
+  pixel: f32,          // world units per screen pixel
+  pad: f32,            // screen pixels added around every item (node base size for nodes)
+  count: u32,          // items
+  capacity: u32,       // outputs the survivor buffer holds
+};
+
+struct EdgeInstance {
+  bbox_min: vec2<f32>,
+  bbox_max: vec2<f32>,
+  color: vec4<f32>,
+  edge_index: u32,
+  mst_offset: u32,
+  mst_count: u32,
+  tile_offset: u32,
+  tile_dims: u32,   // columns | rows << 16
+  list_offset: u32,
+  prim_offset: u32,
+  tile_budget: u32,
+};
+
+const WORKGROUP = 64u;
+const PICK_SCALE = 1.5; // matches node-pick.wgsl
+
+@group(0) @binding(0) var<uniform> params: CullParams;
+@group(0) @binding(1) var<storage, read_write> counts: array<u32>;   // outputs per item, then their offsets
+@group(0) @binding(2) var<storage, read> total: array<u32>;          // [0] = sum of counts (after the scan)
+@group(0) @binding(3) var<storage, read_write> visible: array<u32>;  // survivors, in input order
+
+// Nodes
+@group(0) @binding(4) var<storage, read> positions: array<f32>;      // [x, y, vx, vy] per node
+@group(0) @binding(5) var<storage, read> metadata: array<u32>;       // [group, flags] per node
+@group(0) @binding(6) var<storage, read> node_weights: array<f32>;
+
+// Edges
+@group(0) @binding(7) var<storage, read> he_offsets: array<u32>;
+@group(0) @binding(8) var<storage, read> he_members: array<u32>;
+@group(0) @binding(9) var<storage, read> edge_slots: array<u32>;     // visible hyperedges
+@group(0) @binding(10) var<storage, read_write> centroids: array<vec2<f32>>; // per hyperedge
+
+// Metaball tiles
+@group(0) @binding(11) var<storage, read> instances: array<EdgeInstance>;
+@group(0) @binding(12) var<storage, read> tiles: array<vec2<u32>>;   // instance, tile index within its budget
+
+fn item_index(wid: vec3<u32>, groups: vec3<u32>, lid: vec3<u32>) -> u32 {
+  return (wid.y * groups.x + wid.x) * WORKGROUP + lid.x;
+}
+
+// Whether the rectangle [lo, hi], grown by `pad_px` screen pixels, overlaps the view (false for NaN).
+fn overlaps_view(lo: vec2<f32>, hi: vec2<f32>, pad_px: f32) -> bool {
+  let pad = vec2<f32>(pad_px * params.pixel);
+  return all(lo - pad <= params.view_max) && all(hi + pad >= params.view_min);
+}
+
+// First output slot and output count of item `i` (after the scan).
+fn emitted(i: u32) -> vec2<u32> {
+  let first = counts[i];
+  var end = total[0];
+  if (i + 1u < params.count) {
+    end = counts[i + 1u];
+  }
+  return vec2<u32>(first, end - first);
+}
+
+fn node_position(ni: u32) -> vec2<f32> {
+  return vec2<f32>(positions[ni * 4u], positions[ni * 4u + 1u]);
+}
+
+// ── Nodes ──
+
+@compute @workgroup_size(64)
+fn flag_nodes(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  // Hidden nodes (bit 0 of flags) are neither drawn nor picked
+  var keep = (metadata[i * 2u + 1u] & 1u) == 0u;
+  if (keep) {
+    let p = node_position(i);
+    let radius = params.pad * min(sqrt(max(node_weights[i], 1.0)), 4.0) * PICK_SCALE;
+    keep = overlaps_view(p, p, radius);
+  }
+  counts[i] = select(0u, 1u, keep);
+}
+
+@compute @workgroup_size(64)
+fn emit_nodes(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  let out = emitted(i);
+  if (out.y > 0u && out.x < params.capacity) {
+    visible[out.x] = i;
+  }
+}
+
+// ── Edges ──
+
+@compute @workgroup_size(64)
+fn flag_edges(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  let he = edge_slots[i];
+  let start = he_offsets[he];
+  let end = he_offsets[he + 1u];
+
+  // Bounds and centroid in one pass; every line lies inside the bounds
+  var lo = vec2<f32>(3.4e38);
+  var hi = vec2<f32>(-3.4e38);
+  var sum = vec2<f32>(0.0);
+  for (var m = start; m < end; m++) {
+    let p = node_position(he_members[m]);
+    lo = min(lo, p);
+    hi = max(hi, p);
+    sum += p;
+  }
+  let size = end - start;
+  centroids[he] = sum / f32(max(size, 1u));
+  counts[i] = select(0u, size, size > 0u && overlaps_view(lo, hi, params.pad));
+}
+
+@compute @workgroup_size(64)
+fn emit_edges(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  let out = emitted(i);
+  let he = edge_slots[i];
+  let start = he_offsets[he];
+  for (var k = 0u; k < out.y && out.x + k < params.capacity; k++) {
+    visible[(out.x + k) * 2u] = he;
+    visible[(out.x + k) * 2u + 1u] = he_members[start + k];
+  }
+}
+
+// ── Metaball tiles ──
+
+@compute @workgroup_size(64)
+fn flag_tiles(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  let tile = tiles[i];
+  let inst = instances[tile.x];
+  let cols = inst.tile_dims & 0xffffu;
+  let rows = inst.tile_dims >> 16u;
+
+  // Reserved tiles the current grid does not use draw nothing
+  var keep = tile.y < cols * rows;
+  if (keep) {
+    let dims = vec2<f32>(f32(cols), f32(rows));
+    let cell = vec2<f32>(f32(tile.y % cols), f32(tile.y / cols));
+    let lo = mix(inst.bbox_min, inst.bbox_max, cell / dims);
+    let hi = mix(inst.bbox_min, inst.bbox_max, (cell + 1.0) / dims);
+    keep = overlaps_view(lo, hi, params.pad);
+  }
+  counts[i] = select(0u, 1u, keep);
+}
+
+@compute @workgroup_size(64)
+fn emit_tiles(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = item_index(wid, groups, lid);
+  if (i >= params.count) {
+    return;
+  }
+  let out = emitted(i);
+  if (out.y > 0u && out.x < params.capacity) {
+    visible[out.x * 2u] = tiles[i].x;
+    visible[out.x * 2u + 1u] = tiles[i].y;
+  }
+}
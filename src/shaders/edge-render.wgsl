@@ -1,6 +1,8 @@
 // Edge rendering shader — star topology lines for hyperedges
 // Each line segment connects a hyperedge centroid to a member node
-// Vertex pairs: even vertex = centroid, odd vertex = member node
+// One instance per segment that survived culling (edge_draw, see
+// gpu-culling.ts, which also computes the centroids), drawn indirectly:
+// vertex 0 = centroid, vertex 1 = member node
 
 struct Camera {
   projection: mat4x4<f32>,
@@ -16,10 +18,10 @@ struct EdgeParams {
 @group(0) @binding(0) var<uniform> camera: Camera;
 @group(0) @binding(1) var<storage, read> positions: array<f32>;       // [x, y, vx, vy] per node
 @group(0) @binding(2) var<storage, read> edge_draw: array<u32>;       // pairs: [he_index, member_node_index, ...]
-@group(0) @binding(3) var<storage, read> he_offsets: array<u32>;      // CSR offsets
-@group(0) @binding(4) var<storage, read> he_members: array<u32>;      // CSR members
+@group(0) @binding(3) var<storage, read> centroids: array<vec2<f32>>; // per hyperedge, from the cull pass
 @group(0) @binding(5) var<uniform> edge_params: EdgeParams;
 @group(0) @binding(6) var<storage, read> edge_flags: array<u32>;  // per-hyperedge flags (bit 0 = dimmed)
+@group(0) @binding(7) var<storage, read> edge_weights: array<f32>; // identical hyperedges this one stands for
 
 struct VertexOutput {
   @builtin(position) position: vec4<f32>,
@@ -27,11 +29,10 @@ struct VertexOutput {
 };
 
 @vertex
-fn vs_main(@builtin(vertex_index) vertex_index: u32) -> VertexOutput {
-  // Each line = 2 vertices. Pair index = vertex_index / 2, sub = vertex_index % 2
-  let pair_index = vertex_index / 2u;
-  let is_member = vertex_index % 2u; // 0 = centroid endpoint, 1 = member endpoint
-
+fn vs_main(
+  @builtin(vertex_index) is_member: u32, // 0 = centroid endpoint, 1 = member endpoint
+  @builtin(instance_index) pair_index: u32,
+) -> VertexOutput {
   let he_index = edge_draw[pair_index * 2u];
   let member_node_index = edge_draw[pair_index * 2u + 1u];
 
@@ -42,20 +43,8 @@ fn vs_main(@builtin(vertex_index) vertex_index: u32) -> VertexOutput {
     let base = member_node_index * 4u;
     world_pos = vec2<f32>(positions[base], positions[base + 1u]);
   } else {
-    // Centroid: average of all members in this hyperedge
-    let start = he_offsets[he_index];
-    let end = he_offsets[he_index + 1u];
-    let count = end - start;
-    var cx = 0.0;
-    var cy = 0.0;
-    for (var i = start; i < end; i = i + 1u) {
-      let node_idx = he_members[i];
-      let base = node_idx * 4u;
-      cx = cx + positions[base];
-      cy = cy + positions[base + 1u];
-    }
-    let fc = f32(count);
-    world_pos = vec2<f32>(cx / fc, cy / fc);
+    // Centroid: average of all members, computed once per hyperedge by the cull pass
+    world_pos = centroids[he_index];
   }
 
   let clip_pos = camera.projection * vec4<f32>(world_pos, 0.0, 1.0);
@@ -63,6 +52,9 @@ fn vs_main(@builtin(vertex_index) vertex_index: u32) -> VertexOutput {
   // Compute base alpha — centroid endpoints slightly more transparent
   var base_alpha = select(edge_params.opacity * 0.5, edge_params.opacity, is_member == 1u);
 
+  // Collapsed duplicates draw a heavier stroke (lines are 1px, so via opacity)
+  base_alpha = min(base_alpha * (1.0 + 0.5 * log2(max(edge_weights[he_index], 1.0))), 1.0);
+
   // Per-edge dim flag: reduce alpha for dimmed edges
   let flags = edge_flags[he_index];
   if ((flags & 1u) != 0u) {
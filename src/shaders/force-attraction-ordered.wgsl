@@ -0,0 +1,91 @@
+// Link spring force (attraction) — deterministic variant
+//
+// Same star-topology model as force-attraction.wgsl, but without atomics:
+// 1. `centroids`: one thread per hyperedge writes the member centroid.
+// 2. `gather`: one thread per node walks its incident hyperedges (node→edge
+//    CSR, ascending edge order) and sums the spring forces in a fixed order.
+// Every node's force is therefore a pure function of the positions, so
+// identical inputs give bit-identical results run to run.
+// Node/edge weights apply as in force-attraction.wgsl.
+
+struct AttractionParams {
+  attraction_strength: f32,
+  link_distance: f32,
+  energy: f32,
+  node_count: u32,
+  edge_count: u32,
+  _pad0: u32,
+  _pad1: u32,
+  _pad2: u32,
+};
+
+@group(0) @binding(0) var<storage, read> positions: array<f32>;             // [x, y, vx, vy]
+@group(0) @binding(1) var<storage, read_write> forces: array<i32>;          // fixed-point [fx, fy] per node
+@group(0) @binding(2) var<storage, read> he_offsets: array<u32>;            // CSR offsets
+@group(0) @binding(3) var<storage, read> he_members: array<u32>;            // CSR member indices
+@group(0) @binding(4) var<uniform> params: AttractionParams;
+@group(0) @binding(5) var<storage, read> node_edge_offsets: array<u32>;     // node→edge CSR offsets
+@group(0) @binding(6) var<storage, read> node_edge_ids: array<u32>;         // incident edge per slot
+@group(0) @binding(7) var<storage, read_write> edge_centroids: array<vec2<f32>>;
+@group(0) @binding(8) var<storage, read> node_weights: array<f32>;          // originals per node
+@group(0) @binding(9) var<storage, read> edge_weights: array<f32>;          // originals per hyperedge
+
+const FP_SCALE: f32 = 65536.0;
+
+@compute @workgroup_size(256)
+fn centroids(@builtin(global_invocation_id) gid: vec3<u32>) {
+  let edge_idx = gid.x;
+  if (edge_idx >= params.edge_count) {
+    return;
+  }
+
+  let start = he_offsets[edge_idx];
+  let end = he_offsets[edge_idx + 1u];
+  if (end - start < 2u) {
+    return;
+  }
+
+  var c = vec2<f32>(0.0, 0.0);
+  var total_weight: f32 = 0.0;
+  for (var i = start; i < end; i++) {
+    let ni = he_members[i];
+    let w = node_weights[ni];
+    c += vec2<f32>(positions[ni * 4u + 0u], positions[ni * 4u + 1u]) * w;
+    total_weight += w;
+  }
+  edge_centroids[edge_idx] = c / total_weight;
+}
+
+@compute @workgroup_size(256)
+fn gather(@builtin(global_invocation_id) gid: vec3<u32>) {
+  let ni = gid.x;
+  if (ni >= params.node_count) {
+    return;
+  }
+
+  let base = ni * 4u;
+  let p = vec2<f32>(positions[base + 0u], positions[base + 1u]);
+  let strength = params.attraction_strength * params.energy;
+
+  var f = vec2<f32>(0.0, 0.0);
+  for (var k = node_edge_offsets[ni]; k < node_edge_offsets[ni + 1u]; k++) {
+    let e = node_edge_ids[k];
+    let member_count = he_offsets[e + 1u] - he_offsets[e];
+    if (member_count < 2u) {
+      continue;
+    }
+
+    let d = edge_centroids[e] - p;
+    let dist = length(d);
+    if (dist < 1e-6) {
+      continue;
+    }
+
+    let displacement = dist - params.link_distance / f32(member_count);
+    f += d * (strength * edge_weights[e] * displacement / dist);
+  }
+
+  // Plain stores — this thread is the only writer for node ni
+  forces[ni * 2u + 0u] = i32(f.x * FP_SCALE);
+  forces[ni * 2u + 1u] = i32(f.y * FP_SCALE);
+}
@@ -7,6 +7,10 @@
 // Each thread processes one member-pair from the CSR edge list.
 // Uses atomic fixed-point accumulation since multiple edges may write to the
 // same node concurrently.
+//
+// Weights (1 unless the graph was structurally reduced): the centroid is
+// weighted by how many original nodes each member stands for, and the spring
+// is scaled by how many identical hyperedges this one stands for.
 
 struct AttractionParams {
   attraction_strength: f32,
@@ -24,6 +28,8 @@ struct AttractionParams {
 @group(0) @binding(2) var<storage, read> he_offsets: array<u32>;        // CSR offsets
 @group(0) @binding(3) var<storage, read> he_members: array<u32>;        // CSR member indices
 @group(0) @binding(4) var<uniform> params: AttractionParams;
+@group(0) @binding(5) var<storage, read> node_weights: array<f32>;      // originals per node
+@group(0) @binding(6) var<storage, read> edge_weights: array<f32>;      // originals per hyperedge
 
 const FP_SCALE: f32 = 65536.0;
 
@@ -42,21 +48,24 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
     return;
   }
 
-  // Compute centroid of hyperedge members
+  // Compute (weighted) centroid of hyperedge members
   var cx: f32 = 0.0;
   var cy: f32 = 0.0;
+  var total_weight: f32 = 0.0;
   for (var i = start; i < end; i++) {
     let ni = he_members[i];
     let base = ni * 4u;
-    cx += positions[base + 0u];
-    cy += positions[base + 1u];
+    let w = node_weights[ni];
+    cx += positions[base + 0u] * w;
+    cy += positions[base + 1u] * w;
+    total_weight += w;
   }
   let inv_count = 1.0 / f32(member_count);
-  cx *= inv_count;
-  cy *= inv_count;
+  cx /= total_weight;
+  cy /= total_weight;
 
   // Apply spring force from each member toward centroid
-  let strength = params.attraction_strength * params.energy;
+  let strength = params.attraction_strength * params.energy * edge_weights[edge_idx];
 
   for (var i = start; i < end; i++) {
     let ni = he_members[i];
@@ -0,0 +1,56 @@
+// Centering force — deterministic variant
+// The mean position is reduced by a single workgroup in a fixed order
+// (strided per-thread sums, then a tree reduction) instead of fixed-point
+// atomics, so the result does not depend on thread scheduling.
+
+struct CenterParams {
+  center_strength: f32,
+  energy: f32,
+  node_count: u32,
+  _pad: u32,
+};
+
+@group(0) @binding(0) var<storage, read_write> positions: array<f32>;  // [x, y, vx, vy]
+@group(0) @binding(1) var<storage, read_write> center_mean: array<f32>; // [mean_x, mean_y]
+@group(0) @binding(2) var<uniform> params: CenterParams;
+
+var<workgroup> partial: array<vec2<f32>, 256>;
+
+// Pass 1: mean position — dispatch exactly one workgroup
+@compute @workgroup_size(256)
+fn accumulate(@builtin(local_invocation_id) lid: vec3<u32>) {
+  var sum = vec2<f32>(0.0, 0.0);
+  for (var i = lid.x; i < params.node_count; i += 256u) {
+    sum += vec2<f32>(positions[i * 4u + 0u], positions[i * 4u + 1u]);
+  }
+  partial[lid.x] = sum;
+  workgroupBarrier();
+
+  for (var stride = 128u; stride > 0u; stride >>= 1u) {
+    if (lid.x < stride) {
+      partial[lid.x] += partial[lid.x + stride];
+    }
+    workgroupBarrier();
+  }
+
+  if (lid.x == 0u) {
+    let mean = partial[0] / f32(max(params.node_count, 1u));
+    center_mean[0] = mean.x;
+    center_mean[1] = mean.y;
+  }
+}
+
+// Pass 2: apply centering force
+@compute @workgroup_size(256)
+fn apply(@builtin(global_invocation_id) gid: vec3<u32>) {
+  let idx = gid.x;
+  if (idx >= params.node_count) {
+    return;
+  }
+
+  let strength = params.center_strength * params.energy;
+
+  let base = idx * 4u;
+  positions[base + 2u] -= center_mean[0] * strength;
+  positions[base + 3u] -= center_mean[1] * strength;
+}
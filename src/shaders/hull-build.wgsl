@@ -0,0 +1,177 @@
+// GPU convex hulls for hyperedges: the raw hull of the member positions
+// (gift wrapping, counter-clockwise, collinear points dropped) plus its
+// bounds. The rounded outline — the hull inflated by the margin — is not
+// tessellated; hull-render.wgsl evaluates it analytically per fragment.
+//
+// One thread per visible-edge slot. Per frame:
+//   count_hulls  raw hull → scratch, vertex count → counts
+//   (prefix sum of counts → start of each hull in `points`)
+//   emit_hulls   copy each hull to its packed range of `points`
+//
+// Hulls are only rebuilt for dirty slots: each slot keeps a snapshot of its
+// member positions from its last build, and a slot whose members have all
+// moved less than `tolerance` since then keeps its hull in `scratch`.
+
+struct Params {
+  slot_count: u32,
+  capacity: u32,         // points that fit `points`
+  scratch_capacity: u32, // points that fit `scratch` (and `snapshot`)
+  tolerance: f32,        // member displacement that makes a slot dirty, world units
+  rebuild_all: u32,      // 1 after slots or buffers changed (snapshots invalid)
+  _pad0: u32,
+  _pad1: u32,
+  _pad2: u32,
+};
+
+struct HullInfo {
+  bounds_min: vec2<f32>,
+  bounds_max: vec2<f32>,
+  start: u32, // first point in `points`
+  count: u32, // hull vertices drawn (0 = not drawn)
+  built: u32, // hull vertices in `scratch` from the last build (kept when `points` overflows)
+  _pad: u32,
+};
+
+const WORKGROUP = 64u;
+
+@group(0) @binding(0) var<storage, read> positions: array<vec4<f32>>;
+@group(0) @binding(1) var<storage, read> he_offsets: array<u32>;
+@group(0) @binding(2) var<storage, read> he_members: array<u32>;
+@group(0) @binding(3) var<storage, read> slots: array<u32>;           // edge index | dimmed << 31
+@group(0) @binding(4) var<storage, read> scratch_offsets: array<u32>; // per slot, room for `size` points
+@group(0) @binding(5) var<storage, read_write> scratch: array<vec2<f32>>;
+@group(0) @binding(6) var<storage, read_write> counts: array<u32>;     // vertex counts, then (scanned) starts
+@group(0) @binding(7) var<storage, read_write> infos: array<HullInfo>;
+@group(0) @binding(8) var<storage, read_write> points: array<vec2<f32>>;
+@group(0) @binding(9) var<uniform> params: Params;
+@group(0) @binding(10) var<storage, read_write> snapshot: array<vec2<f32>>; // per slot, members at last build
+
+fn slot_index(wid: vec3<u32>, groups: vec3<u32>, lid: vec3<u32>) -> u32 {
+  return (wid.y * groups.x + wid.x) * WORKGROUP + lid.x;
+}
+
+fn member_point(first: u32, m: u32) -> vec2<f32> {
+  return positions[he_members[first + m]].xy;
+}
+
+fn cross2(o: vec2<f32>, a: vec2<f32>, b: vec2<f32>) -> f32 {
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+fn dist2(a: vec2<f32>, b: vec2<f32>) -> f32 {
+  let d = b - a;
+  return dot(d, d);
+}
+
+@compute @workgroup_size(64)
+fn count_hulls(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let s = slot_index(wid, groups, lid);
+  if (s >= params.slot_count) {
+    return;
+  }
+  let e = slots[s] & 0x7fffffffu;
+  let first = he_offsets[e];
+  let size = he_offsets[e + 1u] - first;
+  let base = scratch_offsets[s];
+  if (size < 2u || base + size > params.scratch_capacity) {
+    counts[s] = 0u;
+    infos[s].count = 0u;
+    infos[s].built = 0u;
+    return;
+  }
+
+  // Clean slot: keep last build's hull (still in scratch) and bounds
+  if (params.rebuild_all == 0u) {
+    var moved = 0.0;
+    for (var m = 0u; m < size; m++) {
+      moved = max(moved, distance(member_point(first, m), snapshot[base + m]));
+    }
+    if (moved < params.tolerance) {
+      let built = infos[s].built;
+      counts[s] = built;
+      infos[s].count = built;
+      return;
+    }
+  }
+  for (var m = 0u; m < size; m++) {
+    snapshot[base + m] = member_point(first, m);
+  }
+
+  // Start at the lowest-x (then lowest-y) member, which is on the hull
+  var start_p = member_point(first, 0u);
+  var lo = start_p;
+  var hi = start_p;
+  for (var m = 1u; m < size; m++) {
+    let p = member_point(first, m);
+    lo = min(lo, p);
+    hi = max(hi, p);
+    if (p.x < start_p.x || (p.x == start_p.x && p.y < start_p.y)) {
+      start_p = p;
+    }
+  }
+
+  // Gift wrapping: the next vertex has every member on its left; among
+  // collinear candidates the farthest wins. Coincident members collapse to
+  // one vertex, so 1 (all coincident) and 2 (collinear) are valid hulls.
+  var current = start_p;
+  var h = 0u;
+  loop {
+    scratch[base + h] = current;
+    h++;
+    var next = current;
+    var next_d = 0.0;
+    for (var m = 0u; m < size; m++) {
+      let p = member_point(first, m);
+      let d = dist2(current, p);
+      if (d == 0.0) {
+        continue;
+      }
+      let c = cross2(current, next, p);
+      if (next_d == 0.0 || c < 0.0 || (c == 0.0 && d > next_d)) {
+        next = p;
+        next_d = d;
+      }
+    }
+    current = next;
+    if (next_d == 0.0 || all(current == start_p) || h >= size) {
+      break;
+    }
+  }
+
+  counts[s] = h;
+  infos[s].bounds_min = lo;
+  infos[s].bounds_max = hi;
+  infos[s].count = h;
+  infos[s].built = h;
+}
+
+@compute @workgroup_size(64)
+fn emit_hulls(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let s = slot_index(wid, groups, lid);
+  if (s >= params.slot_count) {
+    return;
+  }
+  let h = infos[s].count;
+  if (h == 0u) {
+    return;
+  }
+  let start = counts[s];
+  infos[s].start = start;
+  if (start + h > params.capacity) {
+    infos[s].count = 0u; // out of room this frame; `built` keeps the hull for the next
+    return;
+  }
+
+  let base = scratch_offsets[s];
+  for (var k = 0u; k < h; k++) {
+    points[start + k] = scratch[base + k];
+  }
+}
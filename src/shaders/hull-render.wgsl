@@ -1,32 +1,115 @@
-// Hull rendering shader — semi-transparent convex hull polygons
-// Triangles are pre-computed (fan-triangulated from centroid)
-// Vertices come from a vertex buffer: [x, y, r, g, b, a] per vertex
+// Hull rendering shader — semi-transparent rounded convex hulls
+// One instanced quad per hull slot covers the hull bounds plus the margin; the
+// fragment shader evaluates the signed distance to the raw hull polygon
+// (built on the GPU by hull-build.wgsl) minus the margin, so the shape is the
+// hull inflated by a disc: exact round corners, no tessellation, and every
+// pixel of a hull is shaded once.
 
 struct Camera {
   projection: mat4x4<f32>,
 };
 
-struct VertexInput {
-  @location(0) position: vec2<f32>,
-  @location(1) color: vec4<f32>,
+struct HullParams {
+  fill_alpha: f32,
+  outline_alpha: f32, // 0 = no outline
+  radius: f32,        // hull margin, world units
+  pixel: f32,         // world units per pixel (anti-aliasing width)
+  palette_size: u32,
+};
+
+struct HullInfo {
+  bounds_min: vec2<f32>,
+  bounds_max: vec2<f32>,
+  start: u32,
+  count: u32,
+  built: u32,
+  _pad: u32,
 };
 
 struct VertexOutput {
   @builtin(position) clip_position: vec4<f32>,
-  @location(0) color: vec4<f32>,
+  @location(0) world: vec2<f32>,
+  @location(1) @interpolate(flat) slot: u32,
 };
 
 @group(0) @binding(0) var<uniform> camera: Camera;
+@group(0) @binding(1) var<uniform> hull: HullParams;
+@group(0) @binding(2) var<storage, read> points: array<vec2<f32>>;
+@group(0) @binding(3) var<storage, read> infos: array<HullInfo>;
+@group(0) @binding(4) var<storage, read> slots: array<u32>;
+@group(0) @binding(5) var<storage, read> palette: array<vec4<f32>>;
 
 @vertex
-fn vs_main(in: VertexInput) -> VertexOutput {
+fn vs_main(@builtin(vertex_index) vid: u32, @builtin(instance_index) slot: u32) -> VertexOutput {
   var out: VertexOutput;
-  out.clip_position = camera.projection * vec4<f32>(in.position, 0.0, 1.0);
-  out.color = in.color;
+  out.slot = slot;
+  let info = infos[slot];
+  if (info.count == 0u) {
+    out.clip_position = vec4<f32>(2.0, 2.0, 0.0, 1.0); // degenerate, clipped
+    out.world = vec2<f32>(0.0);
+    return out;
+  }
+
+  // Two triangles over the bounds, padded by the radius and an AA pixel
+  var corners = array<vec2<f32>, 6>(
+    vec2<f32>(0.0, 0.0), vec2<f32>(1.0, 0.0), vec2<f32>(0.0, 1.0),
+    vec2<f32>(0.0, 1.0), vec2<f32>(1.0, 0.0), vec2<f32>(1.0, 1.0),
+  );
+  let pad = vec2<f32>(hull.radius + hull.pixel);
+  let world = mix(info.bounds_min - pad, info.bounds_max + pad, corners[vid]);
+  out.clip_position = camera.projection * vec4<f32>(world, 0.0, 1.0);
+  out.world = world;
   return out;
 }
 
+// Signed distance to the convex polygon (CCW) of `count` points; a segment or
+// a point when the hull is degenerate. Negative inside.
+fn polygon_distance(p: vec2<f32>, start: u32, count: u32) -> f32 {
+  var d = 1e30;
+  var inside = count >= 3u;
+  for (var k = 0u; k < count; k++) {
+    let a = points[start + k];
+    let b = points[start + (k + 1u) % count];
+    let e = b - a;
+    let w = p - a;
+    let t = clamp(dot(w, e) / max(dot(e, e), 1e-12), 0.0, 1.0);
+    d = min(d, length(w - e * t));
+    if (e.x * w.y - e.y * w.x < 0.0) {
+      inside = false;
+    }
+  }
+  return select(d, -d, inside);
+}
+
 @fragment
 fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
-  return in.color;
+  let info = infos[in.slot];
+  let d = polygon_distance(in.world, info.start, info.count) - hull.radius;
+
+  let fill = clamp(0.5 - d / hull.pixel, 0.0, 1.0) * hull.fill_alpha;
+  let outline = clamp(1.0 - abs(d) / hull.pixel, 0.0, 1.0) * hull.outline_alpha;
+  // Outline composited over the fill (same color, so only alpha combines)
+  var alpha = outline + fill * (1.0 - outline);
+
+  let slot = slots[in.slot];
+  // Dimmed edges render at 8% (fill) / 15% (outline) of normal alpha (matching BSM's SVG behavior)
+  if ((slot >> 31u) != 0u) {
+    alpha = outline * 0.15 + fill * 0.08 * (1.0 - outline * 0.15);
+  }
+  if (alpha <= 0.0) {
+    discard;
+  }
+  let rgb = palette[(slot & 0x7fffffffu) % hull.palette_size].rgb;
+  return vec4<f32>(rgb, alpha);
+}
+
+// Picking: the hull's edge index + 1 into the green channel of the rg32uint
+// pick target (see gpu-picker.ts) wherever the rounded hull covers the pixel
+@fragment
+fn fs_pick(in: VertexOutput) -> @location(0) vec2<u32> {
+  let info = infos[in.slot];
+  if (polygon_distance(in.world, info.start, info.count) > hull.radius) {
+    discard;
+  }
+  return vec2<u32>(0u, (slots[in.slot] & 0x7fffffffu) + 1u);
 }
@@ -1,17 +1,20 @@
 // Velocity Verlet integration
 // Updates positions from velocities, applies velocity decay and
 // accumulates fixed-point attraction forces into velocities.
+// Pinned nodes ignore the forces and ease toward their pin target instead.
 
 struct IntegrateParams {
   velocity_decay: f32,
   energy: f32,
   node_count: u32,
-  _pad: u32,
+  pin_follow: f32,  // fraction of the remaining distance a pinned node covers per tick
 };
 
 @group(0) @binding(0) var<storage, read_write> positions: array<f32>;       // [x, y, vx, vy]
 @group(0) @binding(1) var<storage, read> attraction_forces: array<i32>;     // fixed-point [fx, fy] per node
 @group(0) @binding(2) var<uniform> params: IntegrateParams;
+@group(0) @binding(3) var<storage, read> pin_flags: array<u32>;             // bit 0 = pinned
+@group(0) @binding(4) var<storage, read> pin_targets: array<vec2<f32>>;     // target position per node
 
 const FP_SCALE_INV: f32 = 1.0 / 65536.0;
 
@@ -23,6 +26,21 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
   }
 
   let base = idx * 4u;
+
+  if ((pin_flags[idx] & 1u) != 0u) {
+    // Velocity = last step, so an unpinned node carries its release momentum
+    let pin_target = pin_targets[idx];
+    let px = positions[base + 0u];
+    let py = positions[base + 1u];
+    let step_x = (pin_target.x - px) * params.pin_follow;
+    let step_y = (pin_target.y - py) * params.pin_follow;
+    positions[base + 0u] = px + step_x;
+    positions[base + 1u] = py + step_y;
+    positions[base + 2u] = step_x;
+    positions[base + 3u] = step_y;
+    return;
+  }
+
   var vx = positions[base + 2u];
   var vy = positions[base + 3u];
 
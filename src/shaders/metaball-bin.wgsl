@@ -0,0 +1,104 @@
+// Metaball tile binning — runs each frame between metaball-build.wgsl and
+// metaball-render.wgsl. Each hyperedge's bounding box is split into a grid of
+// tiles (sized by the build within the tiles reserved per instance, see
+// metaball-renderer.ts). One thread per field
+// primitive (member node or MST bridge capsule) appends the primitive to the
+// list of every tile its cutoff rectangle overlaps, from live positions, so
+// the field pass only evaluates the primitives that can reach its tile.
+// A tile whose list overflows LIST_CAPACITY falls back to all primitives.
+
+struct MetaballParams {
+  sigma: f32,
+  threshold: f32,
+  smoothing_band: f32,
+  prim_count: u32,
+};
+
+struct EdgeInstance {
+  bbox_min: vec2<f32>,
+  bbox_max: vec2<f32>,
+  color: vec4<f32>,
+  edge_index: u32,
+  mst_offset: u32,
+  mst_count: u32,
+  tile_offset: u32, // first tile (draw instance)
+  tile_dims: u32,   // columns | rows << 16
+  list_offset: u32, // first binned tile list (unused for a 1×1 grid)
+  prim_offset: u32, // first primitive: members, then MST edges
+  tile_budget: u32, // tiles reserved (tile_dims is sized on the GPU within it)
+};
+
+const LIST_CAPACITY = 32u;
+const WORKGROUP = 64u;
+
+@group(0) @binding(0) var<storage, read> positions: array<f32>;
+@group(0) @binding(1) var<storage, read> he_offsets: array<u32>;
+@group(0) @binding(2) var<storage, read> he_members: array<u32>;
+@group(0) @binding(3) var<storage, read> instances: array<EdgeInstance>;
+@group(0) @binding(4) var<storage, read> mst_edges: array<u32>;
+@group(0) @binding(5) var<storage, read> prim_instance: array<u32>;
+@group(0) @binding(6) var<storage, read_write> tile_counts: array<atomic<u32>>;
+@group(0) @binding(7) var<storage, read_write> tile_lists: array<u32>;
+@group(0) @binding(8) var<uniform> params: MetaballParams;
+
+fn node_position(ni: u32) -> vec2<f32> {
+  return vec2<f32>(positions[ni * 4u], positions[ni * 4u + 1u]);
+}
+
+@compute @workgroup_size(64)
+fn bin_primitives(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let prim = (wid.y * groups.x + wid.x) * WORKGROUP + lid.x;
+  if (prim >= params.prim_count) {
+    return;
+  }
+  let inst = instances[prim_instance[prim]];
+  let cols = inst.tile_dims & 0xffffu;
+  let rows = inst.tile_dims >> 16u;
+  if (cols * rows <= 1u) {
+    return; // single tile: the field pass evaluates everything anyway
+  }
+
+  // Cutoff rectangle of the primitive (3σ around a node or a bridge segment)
+  let start = he_offsets[inst.edge_index];
+  let size = he_offsets[inst.edge_index + 1u] - start;
+  let local = prim - inst.prim_offset;
+  var lo: vec2<f32>;
+  var hi: vec2<f32>;
+  if (local < size) {
+    let p = node_position(he_members[start + local]);
+    lo = p - vec2<f32>(3.0 * params.sigma);
+    hi = p + vec2<f32>(3.0 * params.sigma);
+  } else {
+    if (local - size >= inst.mst_count) {
+      return; // reserved MST slot left empty (degenerate positions)
+    }
+    let m = (inst.mst_offset + local - size) * 2u;
+    let a = node_position(mst_edges[m]);
+    let b = node_position(mst_edges[m + 1u]);
+    let reach = 3.0 * max(params.sigma, length(b - a) * 0.12);
+    lo = min(a, b) - vec2<f32>(reach);
+    hi = max(a, b) + vec2<f32>(reach);
+  }
+
+  // Overlapped tiles (clamped: primitives that drifted outside the box
+  // still reach its border tiles)
+  let dims = vec2<f32>(f32(cols), f32(rows));
+  let tile_size = max((inst.bbox_max - inst.bbox_min) / dims, vec2<f32>(1e-6));
+  let max_cell = vec2<i32>(i32(cols) - 1, i32(rows) - 1);
+  let c0 = clamp(vec2<i32>(floor((lo - inst.bbox_min) / tile_size)), vec2<i32>(0), max_cell);
+  let c1 = clamp(vec2<i32>(floor((hi - inst.bbox_min) / tile_size)), vec2<i32>(0), max_cell);
+
+  for (var y = c0.y; y <= c1.y; y++) {
+    for (var x = c0.x; x <= c1.x; x++) {
+      let tile = inst.list_offset + u32(y) * cols + u32(x);
+      let slot = atomicAdd(&tile_counts[tile], 1u);
+      if (slot < LIST_CAPACITY) {
+        tile_lists[tile * LIST_CAPACITY + slot] = local;
+      }
+    }
+  }
+}
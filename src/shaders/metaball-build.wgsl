@@ -0,0 +1,361 @@
+// Metaball instance build — runs each frame before metaball-bin.wgsl
+// One workgroup per hyperedge instance rebuilds, from the live GPU positions,
+// its MST bridges, padded bounding box and tile grid, so metaball mode never
+// reads positions back. Only instances whose members moved more than
+// `tolerance` since their last build are rebuilt: each member slot in
+// `scratch` keeps the member's position at that build.
+//
+// MST: Borůvka rounds. Every member first lists its KNN nearest fellow
+// members; each round then merges every component along its lightest incident
+// candidate edge (ties broken by endpoint code, so the picks form a forest).
+// Once the candidates connect no more components, rounds continue over all
+// member pairs, so the result always spans the hyperedge.
+
+struct BuildParams {
+  instance_count: u32,
+  scratch_capacity: u32, // member slots that fit `scratch`
+  knn_capacity: u32,     // member slots that fit `knn` (beyond: all pairs from the start)
+  rebuild_all: u32,      // 1 after the layout or buffers changed (snapshots invalid)
+  sigma: f32,
+  tolerance: f32,        // member displacement that makes an instance dirty, world units
+  tile_size: f32,        // target tile edge, world units
+  _pad: u32,
+};
+
+struct EdgeInstance {
+  bbox_min: vec2<f32>,
+  bbox_max: vec2<f32>,
+  color: vec4<f32>,
+  edge_index: u32,
+  mst_offset: u32,  // first reserved MST edge; member slots start at mst_offset + instance
+  mst_count: u32,
+  tile_offset: u32,
+  tile_dims: u32,   // columns | rows << 16, at most tile_budget tiles
+  list_offset: u32,
+  prim_offset: u32,
+  tile_budget: u32, // tiles reserved for the instance
+};
+
+struct Slot {
+  comp: u32,                 // component (local member index of its root)
+  link: u32,                 // hook target, then pointer-jumping double buffer
+  best_weight: atomic<u32>,  // lightest incident edge of the component rooted here
+  best_code: atomic<u32>,    // ... and its endpoint code among equal weights
+  snapshot: vec2<f32>,       // member position at the last build
+};
+
+const WORKGROUP = 64u;
+const KNN = 4u;
+const NONE = 0xffffffffu;
+const MAX_TILE_GRID = 16u;
+const MAX_ROUNDS = 64u;
+const MAX_MST_MEMBERS = 65536u; // endpoint codes are a * size + b in a u32
+
+@group(0) @binding(0) var<storage, read> positions: array<f32>;
+@group(0) @binding(1) var<storage, read> he_offsets: array<u32>;
+@group(0) @binding(2) var<storage, read> he_members: array<u32>;
+@group(0) @binding(3) var<storage, read_write> instances: array<EdgeInstance>;
+@group(0) @binding(4) var<storage, read_write> mst_edges: array<u32>;
+@group(0) @binding(5) var<storage, read_write> scratch: array<Slot>;
+@group(0) @binding(6) var<storage, read_write> knn: array<u32>;
+@group(0) @binding(7) var<uniform> params: BuildParams;
+
+var<workgroup> wg_flag: atomic<u32>;
+var<workgroup> wg_edges: atomic<u32>;
+var<workgroup> wg_uniform: u32;
+var<workgroup> wg_lo: array<vec2<f32>, WORKGROUP>;
+var<workgroup> wg_hi: array<vec2<f32>, WORKGROUP>;
+var<workgroup> wg_reach: array<f32, WORKGROUP>;
+
+fn node_position(ni: u32) -> vec2<f32> {
+  return vec2<f32>(positions[ni * 4u], positions[ni * 4u + 1u]);
+}
+
+fn member_pos(start: u32, m: u32) -> vec2<f32> {
+  return node_position(he_members[start + m]);
+}
+
+// Squared length as u32 bits (order-preserving for non-negative floats)
+fn weight(a: vec2<f32>, b: vec2<f32>) -> u32 {
+  let d = b - a;
+  return bitcast<u32>(dot(d, d));
+}
+
+fn pair_code(a: u32, b: u32, size: u32) -> u32 {
+  return min(a, b) * size + max(a, b);
+}
+
+// Barrier for both the scratch/output buffers and workgroup memory
+fn sync() {
+  storageBarrier();
+  workgroupBarrier();
+}
+
+// Workgroup-uniform value of `p` once every invocation's updates landed
+fn uniform_load(p: ptr<workgroup, atomic<u32>>, l: u32) -> u32 {
+  workgroupBarrier();
+  if (l == 0u) {
+    wg_uniform = atomicLoad(p);
+  }
+  return workgroupUniformLoad(&wg_uniform);
+}
+
+// The KNN nearest other members of member m (NONE-padded), nearest first
+fn find_neighbours(start: u32, base: u32, size: u32, m: u32) {
+  var near: array<u32, KNN>;
+  var near_d: array<f32, KNN>;
+  for (var k = 0u; k < KNN; k++) {
+    near[k] = NONE;
+    near_d[k] = 3.4e38;
+  }
+  let p = member_pos(start, m);
+  for (var v = 0u; v < size; v++) {
+    if (v == m) {
+      continue;
+    }
+    let d = p - member_pos(start, v);
+    let dd = dot(d, d);
+    if (dd >= near_d[KNN - 1u]) {
+      continue;
+    }
+    var j = KNN - 1u;
+    while (j > 0u && near_d[j - 1u] > dd) {
+      near[j] = near[j - 1u];
+      near_d[j] = near_d[j - 1u];
+      j--;
+    }
+    near[j] = v;
+    near_d[j] = dd;
+  }
+  for (var k = 0u; k < KNN; k++) {
+    knn[(base + m) * KNN + k] = near[k];
+  }
+}
+
+// Offer edge `code` of weight `w` to the component rooted at c: phase 0
+// lowers its best weight, phase 1 its best code among edges of that weight
+fn offer(base: u32, c: u32, w: u32, code: u32, phase: u32) {
+  if (phase == 0u) {
+    atomicMin(&scratch[base + c].best_weight, w);
+  } else if (atomicLoad(&scratch[base + c].best_weight) == w) {
+    atomicMin(&scratch[base + c].best_code, code);
+  }
+}
+
+// Offer member m's edges that leave its component: its candidates (to both
+// components, as candidate lists are one-sided) or, in `all_pairs` mode,
+// every member of another component (the pair is also seen from the other side)
+fn offer_edges(start: u32, base: u32, size: u32, m: u32, all_pairs: bool, phase: u32) {
+  let cm = scratch[base + m].comp;
+  let p = member_pos(start, m);
+  if (all_pairs) {
+    for (var v = 0u; v < size; v++) {
+      if (scratch[base + v].comp != cm) {
+        offer(base, cm, weight(p, member_pos(start, v)), pair_code(m, v, size), phase);
+      }
+    }
+    return;
+  }
+  for (var k = 0u; k < KNN; k++) {
+    let v = knn[(base + m) * KNN + k];
+    if (v == NONE) {
+      break;
+    }
+    let cv = scratch[base + v].comp;
+    if (cv != cm) {
+      let w = weight(p, member_pos(start, v));
+      let code = pair_code(m, v, size);
+      offer(base, cm, w, code, phase);
+      offer(base, cv, w, code, phase);
+    }
+  }
+}
+
+@compute @workgroup_size(64)
+fn build_instances(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let i = wid.y * groups.x + wid.x;
+  if (i >= params.instance_count) {
+    return;
+  }
+  let l = lid.x;
+  let inst = instances[i];
+  let start = he_offsets[inst.edge_index];
+  let size = he_offsets[inst.edge_index + 1u] - start;
+  let base = inst.mst_offset + i;
+  let has_scratch = base + size <= params.scratch_capacity;
+
+  // Dirty test against the snapshot of the last build (no snapshot: always rebuilt)
+  if (l == 0u) {
+    atomicStore(&wg_flag, select(params.rebuild_all, 1u, !has_scratch));
+    atomicStore(&wg_edges, 0u);
+  }
+  workgroupBarrier();
+  if (has_scratch) {
+    for (var m = l; m < size; m += WORKGROUP) {
+      if (distance(member_pos(start, m), scratch[base + m].snapshot) > params.tolerance) {
+        atomicStore(&wg_flag, 1u);
+      }
+    }
+  }
+  if (uniform_load(&wg_flag, l) == 0u) {
+    return;
+  }
+
+  // Snapshot, singleton components, candidate neighbours
+  let use_knn = has_scratch && base + size <= params.knn_capacity;
+  if (has_scratch) {
+    for (var m = l; m < size; m += WORKGROUP) {
+      scratch[base + m].comp = m;
+      scratch[base + m].snapshot = member_pos(start, m);
+      if (use_knn) {
+        find_neighbours(start, base, size, m);
+      }
+    }
+  }
+  if (l == 0u) {
+    atomicStore(&wg_flag, select(0u, 1u, has_scratch && size <= MAX_MST_MEMBERS) | select(2u, 0u, use_knn));
+  }
+  let mode = uniform_load(&wg_flag, l);
+  var all_pairs = (mode & 2u) != 0u;
+  if (l == 0u) {
+    atomicStore(&wg_flag, size);
+  }
+  let member_count = uniform_load(&wg_flag, l); // `size`, workgroup-uniform for the exits below
+
+  if ((mode & 1u) != 0u) {
+    var last_edges = 0u;
+    for (var iter = 0u; iter < MAX_ROUNDS; iter++) {
+      for (var m = l; m < size; m += WORKGROUP) {
+        atomicStore(&scratch[base + m].best_weight, NONE);
+        atomicStore(&scratch[base + m].best_code, NONE);
+      }
+      sync();
+      for (var m = l; m < size; m += WORKGROUP) {
+        offer_edges(start, base, size, m, all_pairs, 0u);
+      }
+      sync();
+      for (var m = l; m < size; m += WORKGROUP) {
+        offer_edges(start, base, size, m, all_pairs, 1u);
+      }
+      sync();
+
+      // Each root hooks onto the component across its best edge and emits
+      // it; of two roots that picked the same edge only the larger hooks
+      for (var r = l; r < size; r += WORKGROUP) {
+        var hook = scratch[base + r].comp;
+        let code = atomicLoad(&scratch[base + r].best_code);
+        if (hook == r && code != NONE) {
+          let a = code / size;
+          let b = code % size;
+          let ca = scratch[base + a].comp;
+          let other = select(ca, scratch[base + b].comp, ca == r);
+          let mutual = atomicLoad(&scratch[base + other].best_code) == code;
+          if (!mutual || r > other) {
+            hook = other;
+            let e = (inst.mst_offset + atomicAdd(&wg_edges, 1u)) * 2u;
+            mst_edges[e] = he_members[start + a];
+            mst_edges[e + 1u] = he_members[start + b];
+          }
+        }
+        scratch[base + r].link = hook;
+      }
+      sync();
+      for (var m = l; m < size; m += WORKGROUP) {
+        scratch[base + m].comp = scratch[base + m].link;
+      }
+      if (l == 0u) {
+        atomicStore(&wg_flag, 0u);
+      }
+
+      // Pointer jumping until every member points at its root
+      loop {
+        sync();
+        for (var m = l; m < size; m += WORKGROUP) {
+          let c = scratch[base + m].comp;
+          let g = scratch[base + c].comp;
+          scratch[base + m].link = g;
+          if (g != c) {
+            atomicStore(&wg_flag, 1u);
+          }
+        }
+        sync();
+        for (var m = l; m < size; m += WORKGROUP) {
+          scratch[base + m].comp = scratch[base + m].link;
+        }
+        if (uniform_load(&wg_flag, l) == 0u) {
+          break;
+        }
+        if (l == 0u) {
+          atomicStore(&wg_flag, 0u);
+        }
+      }
+
+      let edges = uniform_load(&wg_edges, l);
+      if (edges + 1u >= member_count) {
+        break;
+      }
+      if (edges == last_edges) {
+        if (all_pairs) {
+          break;
+        }
+        all_pairs = true; // candidates exhausted
+      }
+      last_edges = edges;
+    }
+  }
+
+  // Bounds of the members, padded by the widest field reach (node or bridge)
+  sync();
+  let edge_count = uniform_load(&wg_edges, l);
+  var lo = vec2<f32>(3.4e38);
+  var hi = vec2<f32>(-3.4e38);
+  for (var m = l; m < size; m += WORKGROUP) {
+    let p = member_pos(start, m);
+    lo = min(lo, p);
+    hi = max(hi, p);
+  }
+  var reach = params.sigma;
+  for (var k = l; k < edge_count; k += WORKGROUP) {
+    let e = (inst.mst_offset + k) * 2u;
+    let len = distance(node_position(mst_edges[e]), node_position(mst_edges[e + 1u]));
+    reach = max(reach, len * 0.12);
+  }
+  wg_lo[l] = lo;
+  wg_hi[l] = hi;
+  wg_reach[l] = reach;
+  for (var stride = WORKGROUP / 2u; stride > 0u; stride >>= 1u) {
+    workgroupBarrier();
+    if (l < stride) {
+      wg_lo[l] = min(wg_lo[l], wg_lo[l + stride]);
+      wg_hi[l] = max(wg_hi[l], wg_hi[l + stride]);
+      wg_reach[l] = max(wg_reach[l], wg_reach[l + stride]);
+    }
+  }
+  workgroupBarrier();
+  if (l != 0u) {
+    return;
+  }
+
+  let pad = vec2<f32>(3.0 * wg_reach[0]);
+  let bbox_min = wg_lo[0] - pad;
+  let bbox_max = wg_hi[0] + pad;
+  instances[i].bbox_min = bbox_min;
+  instances[i].bbox_max = bbox_max;
+  instances[i].mst_count = edge_count;
+
+  // Tile grid sized to the cutoff, shrunk to fit the reserved tiles
+  let budget = max(inst.tile_budget, 1u);
+  let extent = (bbox_max - bbox_min) / params.tile_size;
+  var cols = clamp(u32(ceil(extent.x)), 1u, min(MAX_TILE_GRID, budget));
+  var rows = clamp(u32(ceil(extent.y)), 1u, MAX_TILE_GRID);
+  if (cols * rows > budget) {
+    let shrink = sqrt(f32(budget) / f32(cols * rows));
+    cols = max(u32(f32(cols) * shrink), 1u);
+    rows = clamp(u32(f32(rows) * shrink), 1u, max(budget / cols, 1u));
+  }
+  instances[i].tile_dims = cols | (rows << 16u);
+}
@@ -1,6 +1,12 @@
 // Screen-space metaball rendering — evaluates Gaussian field per-pixel
-// Each hyperedge rendered as a bounding-box quad (instanced)
-// Fragment shader evaluates field from node positions + MST bridge capsules
+// Each hyperedge's bounding box is drawn as a grid of tile quads (one
+// instance per on-screen tile, culled by cull.wgsl); the fragment shader evaluates the field from the node
+// and MST bridge capsule primitives binned to its tile by metaball-bin.wgsl
+//
+// At reduced resolution the tiles are first drawn (fs_main) into an offscreen
+// image 1/2 or 1/4 the canvas size; the main pass then composites that image
+// (fs_composite) wherever its 2×2 footprint is flat and re-evaluates the
+// field at full resolution (fs_refine) only where it straddles a contour.
 
 struct Camera {
   projection: mat4x4<f32>,
@@ -10,7 +16,7 @@ struct MetaballParams {
   sigma: f32,
   threshold: f32,
   smoothing_band: f32,
-  _pad: u32,
+  prim_count: u32,
 };
 
 struct EdgeInstance {
@@ -20,7 +26,11 @@ struct EdgeInstance {
   edge_index: u32,
   mst_offset: u32,
   mst_count: u32,
-  _pad: u32,
+  tile_offset: u32,
+  tile_dims: u32,   // columns | rows << 16
+  list_offset: u32,
+  prim_offset: u32,
+  tile_budget: u32,
 };
 
 struct VertexOutput {
@@ -28,8 +38,12 @@ struct VertexOutput {
   @location(0) world_pos: vec2<f32>,
   @location(1) color: vec4<f32>,
   @location(2) @interpolate(flat) instance_idx: u32,
+  @location(3) @interpolate(flat) list: u32, // binned tile list, or NO_LIST
 };
 
+const LIST_CAPACITY = 32u;
+const NO_LIST = 0xffffffffu;
+
 @group(0) @binding(0) var<uniform> camera: Camera;
 @group(0) @binding(1) var<storage, read> positions: array<f32>;
 @group(0) @binding(2) var<storage, read> he_offsets: array<u32>;
@@ -37,6 +51,23 @@ struct VertexOutput {
 @group(0) @binding(4) var<storage, read> instances: array<EdgeInstance>;
 @group(0) @binding(5) var<storage, read> mst_edges: array<u32>;
 @group(0) @binding(6) var<uniform> params: MetaballParams;
+@group(0) @binding(7) var<storage, read> tiles: array<vec2<u32>>; // culled: instance, tile index within its budget
+@group(0) @binding(8) var<storage, read> tile_counts: array<u32>;
+@group(0) @binding(9) var<storage, read> tile_lists: array<u32>;
+
+// Reduced-resolution image, bound for composite/refine only
+struct LowResParams {
+  factor: u32, // canvas pixels per low-res texel, per axis
+  _pad0: u32,
+  _pad1: u32,
+  _pad2: u32,
+};
+
+@group(1) @binding(0) var low_res: texture_2d<f32>;
+@group(1) @binding(1) var<uniform> low: LowResParams;
+
+// Largest per-channel spread of a flat 2×2 footprint (~2/255)
+const EDGE_EPSILON = 0.008;
 
 // Quad vertices: 2 triangles = 6 vertices per instance
 const QUAD_UV = array<vec2<f32>, 6>(
@@ -47,18 +78,37 @@ const QUAD_UV = array<vec2<f32>, 6>(
 @vertex
 fn vs_main(
   @builtin(vertex_index) vertex_id: u32,
-  @builtin(instance_index) instance_id: u32,
+  @builtin(instance_index) tile_id: u32,
 ) -> VertexOutput {
-  let inst = instances[instance_id];
-  let uv = QUAD_UV[vertex_id];
+  let tile = tiles[tile_id];
+  let inst = instances[tile.x];
+  let cols = inst.tile_dims & 0xffffu;
+  let rows = inst.tile_dims >> 16u;
+
+  var out: VertexOutput;
+  if (tile.y >= cols * rows) {
+    // Reserved tile the current grid does not use (culled already): degenerate, clipped
+    out.clip_position = vec4<f32>(2.0, 2.0, 0.0, 1.0);
+    out.instance_idx = tile.x;
+    out.list = NO_LIST;
+    return out;
+  }
+  let cell = vec2<u32>(tile.y % cols, tile.y / cols);
+  let uv = (vec2<f32>(cell) + QUAD_UV[vertex_id]) / vec2<f32>(f32(cols), f32(rows));
 
   let world = mix(inst.bbox_min, inst.bbox_max, uv);
 
-  var out: VertexOutput;
   out.clip_position = camera.projection * vec4<f32>(world, 0.0, 1.0);
   out.world_pos = world;
   out.color = inst.color;
-  out.instance_idx = instance_id;
+  out.instance_idx = tile.x;
+  out.list = NO_LIST;
+  if (cols * rows > 1u) {
+    let list = inst.list_offset + cell.y * cols + cell.x;
+    if (tile_counts[list] <= LIST_CAPACITY) {
+      out.list = list;
+    }
+  }
   return out;
 }
 
@@ -76,59 +126,130 @@ fn dist_to_segment_sq(p: vec2<f32>, a: vec2<f32>, b: vec2<f32>) -> f32 {
   return dot(d, d);
 }
 
-@fragment
-fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
-  let inst = instances[in.instance_idx];
+// Field contribution of primitive `local` of an instance: a member node
+// (local < size) or an MST bridge capsule
+fn primitive_field(p: vec2<f32>, inst: EdgeInstance, start: u32, size: u32, local: u32) -> f32 {
   let sigma = params.sigma;
-  let inv_two_sigma_sq = 1.0 / (2.0 * sigma * sigma);
-  let cutoff_sq = 9.0 * sigma * sigma;
-
-  let p = in.world_pos;
-
-  // Evaluate Gaussian field from member nodes
-  let start = he_offsets[inst.edge_index];
-  let end = he_offsets[inst.edge_index + 1u];
-
-  var field_val = 0.0;
-  for (var i = start; i < end; i = i + 1u) {
-    let ni = he_members[i];
-    let nx = positions[ni * 4u];
-    let ny = positions[ni * 4u + 1u];
-    let dx = p.x - nx;
-    let dy = p.y - ny;
+  if (local < size) {
+    let ni = he_members[start + local];
+    let dx = p.x - positions[ni * 4u];
+    let dy = p.y - positions[ni * 4u + 1u];
     let dist_sq = dx * dx + dy * dy;
-    if (dist_sq < cutoff_sq) {
-      field_val += exp(-dist_sq * inv_two_sigma_sq);
+    if (dist_sq < 9.0 * sigma * sigma) {
+      return exp(-dist_sq / (2.0 * sigma * sigma));
     }
+    return 0.0;
   }
 
-  // Evaluate bridge field along MST edges (capsule Gaussians)
-  for (var m = 0u; m < inst.mst_count; m = m + 1u) {
-    let mst_idx = (inst.mst_offset + m) * 2u;
-    let ai = mst_edges[mst_idx];
-    let bi = mst_edges[mst_idx + 1u];
-
-    let a = vec2<f32>(positions[ai * 4u], positions[ai * 4u + 1u]);
-    let b = vec2<f32>(positions[bi * 4u], positions[bi * 4u + 1u]);
+  let mst_idx = (inst.mst_offset + local - size) * 2u;
+  let ai = mst_edges[mst_idx];
+  let bi = mst_edges[mst_idx + 1u];
+  let a = vec2<f32>(positions[ai * 4u], positions[ai * 4u + 1u]);
+  let b = vec2<f32>(positions[bi * 4u], positions[bi * 4u + 1u]);
+
+  let edge_len = length(b - a);
+  let bridge_sigma = max(sigma, edge_len * 0.12);
+  let d_sq = dist_to_segment_sq(p, a, b);
+  if (d_sq < 9.0 * bridge_sigma * bridge_sigma) {
+    return exp(-d_sq / (2.0 * bridge_sigma * bridge_sigma));
+  }
+  return 0.0;
+}
 
-    let edge_len = length(b - a);
-    let bridge_sigma = max(sigma, edge_len * 0.12);
-    let bridge_inv = 1.0 / (2.0 * bridge_sigma * bridge_sigma);
-    let bridge_cutoff = 9.0 * bridge_sigma * bridge_sigma;
+// Coverage of the field threshold at this fragment (0 outside the blob)
+fn field_alpha(in: VertexOutput) -> f32 {
+  let inst = instances[in.instance_idx];
+  let p = in.world_pos;
+  let start = he_offsets[inst.edge_index];
+  let size = he_offsets[inst.edge_index + 1u] - start;
 
-    let d_sq = dist_to_segment_sq(p, a, b);
-    if (d_sq < bridge_cutoff) {
-      field_val += exp(-d_sq * bridge_inv);
+  var field_val = 0.0;
+  if (in.list != NO_LIST) {
+    // Only the primitives whose cutoff reaches this tile
+    let count = tile_counts[in.list];
+    for (var k = 0u; k < count; k = k + 1u) {
+      field_val += primitive_field(p, inst, start, size, tile_lists[in.list * LIST_CAPACITY + k]);
+    }
+  } else {
+    // Single tile or overflowed list: every member node and MST bridge
+    for (var local = 0u; local < size + inst.mst_count; local = local + 1u) {
+      field_val += primitive_field(p, inst, start, size, local);
     }
   }
 
   // Anti-aliased threshold via smoothstep
   let band = params.smoothing_band;
-  let alpha_mult = smoothstep(params.threshold - band, params.threshold + band, field_val);
+  return smoothstep(params.threshold - band, params.threshold + band, field_val);
+}
 
+@fragment
+fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
+  let alpha_mult = field_alpha(in);
   if (alpha_mult < 0.005) {
     discard;
   }
+  return vec4<f32>(in.color.rgb, in.color.a * alpha_mult);
+}
+
+struct LowResSample {
+  color: vec4<f32>, // bilinear, premultiplied
+  edge: bool,       // footprint straddles a contour or a blob border
+};
+
+// Upsample the low-res image at canvas pixel `frag` from its 2×2 texel footprint
+fn sample_low_res(frag: vec2<f32>) -> LowResSample {
+  let texel = frag / f32(low.factor) - 0.5;
+  let base = vec2<i32>(floor(texel));
+  let f = texel - floor(texel);
+  let hi = vec2<i32>(textureDimensions(low_res)) - 1;
+  let c00 = textureLoad(low_res, clamp(base, vec2<i32>(0), hi), 0);
+  let c10 = textureLoad(low_res, clamp(base + vec2<i32>(1, 0), vec2<i32>(0), hi), 0);
+  let c01 = textureLoad(low_res, clamp(base + vec2<i32>(0, 1), vec2<i32>(0), hi), 0);
+  let c11 = textureLoad(low_res, clamp(base + vec2<i32>(1, 1), vec2<i32>(0), hi), 0);
+
+  let spread = max(max(c00, c10), max(c01, c11)) - min(min(c00, c10), min(c01, c11));
+  var out: LowResSample;
+  out.color = mix(mix(c00, c10, f.x), mix(c01, c11, f.x), f.y);
+  out.edge = any(spread > vec4<f32>(EDGE_EPSILON));
+  return out;
+}
+
+// Fullscreen triangle for the composite
+@vertex
+fn vs_composite(@builtin(vertex_index) vid: u32) -> @builtin(position) vec4<f32> {
+  let uv = vec2<f32>(f32((vid << 1u) & 2u), f32(vid & 2u));
+  return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+
+// Flat regions: the upsampled image (edges are left to fs_refine)
+@fragment
+fn fs_composite(@builtin(position) frag: vec4<f32>) -> @location(0) vec4<f32> {
+  let s = sample_low_res(frag.xy);
+  if (s.edge || s.color.a < 0.002) {
+    discard;
+  }
+  return s.color;
+}
 
+// Contour regions: every tile covering the pixel re-evaluates its field
+@fragment
+fn fs_refine(in: VertexOutput) -> @location(0) vec4<f32> {
+  if (!sample_low_res(in.clip_position.xy).edge) {
+    discard;
+  }
+  let alpha_mult = field_alpha(in);
+  if (alpha_mult < 0.005) {
+    discard;
+  }
   return vec4<f32>(in.color.rgb, in.color.a * alpha_mult);
 }
+
+// Picking: the edge index + 1 into the green channel of the rg32uint pick
+// target (see gpu-picker.ts) wherever the field reaches the threshold
+@fragment
+fn fs_pick(in: VertexOutput) -> @location(0) vec2<u32> {
+  if (field_alpha(in) < 0.5) {
+    discard;
+  }
+  return vec2<u32>(0u, instances[in.instance_idx].edge_index + 1u);
+}
@@ -1,20 +1,28 @@
-// Node picking shader — renders node IDs as colors to an offscreen texture
-// Each node = 6 vertices (2 triangles forming a quad)
+// Node picking shader — renders node IDs into the red channel of the pick
+// target (rg32uint, see gpu-picker.ts); hyperedge IDs go to green.
+// Same quads and culled draw list as node-render.wgsl, enlarged by
+// PICK_SCALE for an easier hit (gpu-culling.ts culls at this size).
+// Each node = one instance of 6 vertices (2 triangles forming a quad)
 
+// Pick camera (gpu-picker.ts): the view projection blown up to the cursor pixel
 struct Camera {
   projection: mat4x4<f32>,
+  offset_scale: vec2<f32>, // clip-space scale of view offsets (the view size in pixels)
 };
 
 struct RenderParams {
   node_size: f32,
   viewport_width: f32,
   viewport_height: f32,
-  _pad: f32,
+  node_dark_mode: f32,
 };
 
 @group(0) @binding(0) var<uniform> camera: Camera;
 @group(0) @binding(1) var<storage, read> positions: array<f32>;    // [x, y, vx, vy] per node
-@group(0) @binding(2) var<uniform> params: RenderParams;
+@group(0) @binding(2) var<storage, read> metadata: array<u32>;      // [group, flags] per node
+@group(0) @binding(3) var<uniform> params: RenderParams;
+@group(0) @binding(4) var<storage, read> node_weights: array<f32>;  // originals per node (1 unless reduced)
+@group(0) @binding(5) var<storage, read> visible_nodes: array<u32>; // culled draw list (hidden nodes excluded)
 
 struct VertexOutput {
   @builtin(position) position: vec4<f32>,
@@ -22,6 +30,9 @@ struct VertexOutput {
   @location(1) @interpolate(flat) node_index: u32,
 };
 
+// Hit radius relative to the drawn radius
+const PICK_SCALE = 1.5;
+
 // Quad corners: 2 triangles forming a square [-1,-1] to [1,1]
 const QUAD_UVS = array<vec2<f32>, 6>(
   vec2<f32>(-1.0, -1.0),
@@ -33,43 +44,39 @@ const QUAD_UVS = array<vec2<f32>, 6>(
 );
 
 @vertex
-fn vs_main(@builtin(vertex_index) vertex_index: u32) -> VertexOutput {
-  let node_index = vertex_index / 6u;
-  let corner_index = vertex_index % 6u;
+fn vs_main(
+  @builtin(vertex_index) corner_index: u32,
+  @builtin(instance_index) instance_index: u32,
+) -> VertexOutput {
+  let node_index = visible_nodes[instance_index];
+
+  var out: VertexOutput;
+  out.node_index = node_index;
 
   let base = node_index * 4u; // 4 floats per node: x, y, vx, vy
   let world_pos = vec2<f32>(positions[base], positions[base + 1u]);
 
   let uv = QUAD_UVS[corner_index];
-  let size = params.node_size;
+  let size = params.node_size * min(sqrt(max(node_weights[node_index], 1.0)), 4.0) * PICK_SCALE;
 
-  // Offset in clip space (constant screen size)
+  // Offset in clip space (constant screen size), scaled like the pick projection
   let clip_pos = camera.projection * vec4<f32>(world_pos, 0.0, 1.0);
   let pixel_offset = uv * size;
   let ndc_offset = vec2<f32>(
     pixel_offset.x * 2.0 / params.viewport_width,
     pixel_offset.y * 2.0 / params.viewport_height,
-  );
+  ) * camera.offset_scale;
 
-  var out: VertexOutput;
   out.position = vec4<f32>(clip_pos.xy + ndc_offset, clip_pos.z, clip_pos.w);
   out.uv = uv;
-  out.node_index = node_index;
   return out;
 }
 
 @fragment
-fn fs_main(in: VertexOutput) -> @location(0) vec4<f32> {
-  let dist = length(in.uv);
-  if (dist > 1.0) {
+fn fs_main(in: VertexOutput) -> @location(0) vec2<u32> {
+  if (length(in.uv) > 1.0) {
     discard;
   }
-
-  // Encode node_index as RGB color
-  // +1 so that background (0,0,0,0) means "no node"
-  let id = in.node_index + 1u;
-  let r = f32(id & 0xFFu) / 255.0;
-  let g = f32((id >> 8u) & 0xFFu) / 255.0;
-  let b = f32((id >> 16u) & 0xFFu) / 255.0;
-  return vec4<f32>(r, g, b, 1.0);
+  // +1 so that the cleared background (0) means "no node"
+  return vec2<u32>(in.node_index + 1u, 0u);
 }
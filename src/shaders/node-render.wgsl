@@ -1,5 +1,6 @@
 // Node rendering shader — generates quads from point data
-// Each node = 6 vertices (2 triangles forming a quad)
+// One instance of 6 vertices (2 triangles forming a quad) per node that
+// survived culling (visible_nodes, see gpu-culling.ts), drawn indirectly
 // Positions stored in storage buffer, camera as uniform
 
 struct Camera {
@@ -18,6 +19,8 @@ struct RenderParams {
 @group(0) @binding(2) var<storage, read> metadata: array<u32>;      // [group, flags] per node
 @group(0) @binding(3) var<uniform> params: RenderParams;
 @group(0) @binding(4) var<storage, read> palette: array<vec4<f32>>; // color palette
+@group(0) @binding(5) var<storage, read> node_weights: array<f32>;  // originals per node (1 unless reduced)
+@group(0) @binding(6) var<storage, read> visible_nodes: array<u32>; // culled draw list (hidden nodes excluded)
 
 struct VertexOutput {
   @builtin(position) position: vec4<f32>,
@@ -37,28 +40,19 @@ const QUAD_UVS = array<vec2<f32>, 6>(
 );
 
 @vertex
-fn vs_main(@builtin(vertex_index) vertex_index: u32) -> VertexOutput {
-  let node_index = vertex_index / 6u;
-  let corner_index = vertex_index % 6u;
-
+fn vs_main(
+  @builtin(vertex_index) corner_index: u32,
+  @builtin(instance_index) instance_index: u32,
+) -> VertexOutput {
+  let node_index = visible_nodes[instance_index];
   let base = node_index * 4u; // 4 floats per node: x, y, vx, vy
-
-  // Check visibility flag (bit 0 of flags = hidden)
   let flags = metadata[node_index * 2u + 1u];
-  if ((flags & 1u) != 0u) {
-    // Hidden node — move offscreen to avoid fragment shader work
-    var out: VertexOutput;
-    out.position = vec4<f32>(10000.0, 10000.0, 0.0, 1.0);
-    out.uv = vec2<f32>(0.0, 0.0);
-    out.color = vec4<f32>(0.0, 0.0, 0.0, 0.0);
-    out.node_index = node_index;
-    return out;
-  }
 
   let world_pos = vec2<f32>(positions[base], positions[base + 1u]);
 
   let uv = QUAD_UVS[corner_index];
-  let size = params.node_size;
+  // Collapsed nodes grow with the square root of their class size (area ∝ count)
+  let size = params.node_size * min(sqrt(max(node_weights[node_index], 1.0)), 4.0);
 
   // Offset in clip space (constant screen size)
   let clip_pos = camera.projection * vec4<f32>(world_pos, 0.0, 1.0);
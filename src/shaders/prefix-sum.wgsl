@@ -0,0 +1,94 @@
+// Exclusive prefix sum over u32, in place, for arrays of any length.
+//
+// scan_blocks: each workgroup scans a 512-element block (Blelloch up/down
+// sweep in workgroup memory) and writes the block total to `sums`.
+// add_offsets: after `sums` has itself been scanned, adds each block's
+// offset to its elements. Levels are chained on the CPU side (prefix-sum.ts).
+// Workgroups are laid out 2D so more than 65535 blocks fit one dispatch.
+
+const BLOCK = 512u;
+
+struct Params {
+  count: u32,
+};
+
+@group(0) @binding(0) var<storage, read_write> data: array<u32>;
+@group(0) @binding(1) var<storage, read_write> sums: array<u32>;
+@group(0) @binding(2) var<uniform> params: Params;
+
+var<workgroup> tile: array<u32, 512>;
+
+@compute @workgroup_size(256)
+fn scan_blocks(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let block = wid.y * groups.x + wid.x;
+  let base = block * BLOCK;
+  if (base >= params.count) {
+    return;
+  }
+
+  let a = lid.x * 2u;
+  let b = a + 1u;
+  tile[a] = select(0u, data[base + a], base + a < params.count);
+  tile[b] = select(0u, data[base + b], base + b < params.count);
+
+  // Up-sweep: build partial sums in place
+  var offset = 1u;
+  for (var d = BLOCK >> 1u; d > 0u; d = d >> 1u) {
+    workgroupBarrier();
+    if (lid.x < d) {
+      let ai = offset * (a + 1u) - 1u;
+      let bi = offset * (a + 2u) - 1u;
+      tile[bi] = tile[bi] + tile[ai];
+    }
+    offset = offset << 1u;
+  }
+
+  workgroupBarrier();
+  if (lid.x == 0u) {
+    sums[block] = tile[BLOCK - 1u];
+    tile[BLOCK - 1u] = 0u;
+  }
+
+  // Down-sweep: distribute to an exclusive scan
+  for (var d = 1u; d < BLOCK; d = d << 1u) {
+    offset = offset >> 1u;
+    workgroupBarrier();
+    if (lid.x < d) {
+      let ai = offset * (a + 1u) - 1u;
+      let bi = offset * (a + 2u) - 1u;
+      let t = tile[ai];
+      tile[ai] = tile[bi];
+      tile[bi] = tile[bi] + t;
+    }
+  }
+  workgroupBarrier();
+
+  if (base + a < params.count) {
+    data[base + a] = tile[a];
+  }
+  if (base + b < params.count) {
+    data[base + b] = tile[b];
+  }
+}
+
+@compute @workgroup_size(256)
+fn add_offsets(
+  @builtin(local_invocation_id) lid: vec3<u32>,
+  @builtin(workgroup_id) wid: vec3<u32>,
+  @builtin(num_workgroups) groups: vec3<u32>,
+) {
+  let block = wid.y * groups.x + wid.x;
+  let base = block * BLOCK;
+  let offset = sums[block];
+  let a = base + lid.x * 2u;
+  if (a < params.count) {
+    data[a] = data[a] + offset;
+  }
+  if (a + 1u < params.count) {
+    data[a + 1u] = data[a + 1u] + offset;
+  }
+}
@@ -7,7 +7,7 @@
 //
 // We use a flat array representation. The tree is built by:
 // 1. Placing sorted nodes into leaf cells
-// 2. Each leaf stores: (node_index, mass=1, com_x, com_y, bbox)
+// 2. Each leaf stores: (node_index, mass=node weight, com_x, com_y, bbox, zero moments)
 // 3. Internal nodes are built bottom-up in the summarize pass
 
 struct BuildParams {
@@ -17,20 +17,23 @@ struct BuildParams {
   _pad: u32,
 };
 
-// Tree node layout: 8 floats per node
+// Tree node layout: 12 floats per node (mirrored by layout/barnes-hut-cpu.ts)
 // [0]: center_of_mass_x
 // [1]: center_of_mass_y
-// [2]: total_mass (number of nodes in subtree)
+// [2]: total_mass (summed node weights in subtree; 1 per node unless reduced)
 // [3]: cell_size (width of this cell's bounding region)
-// [4]: node_index (for leaves: original node index, for internal: 0xFFFFFFFF)
+// [4]: node_index (for leaves: original node index, for internal: -1)
 // [5]: child_mask (which children exist: bit 0-3)
 // [6]: min_x of bounding box
 // [7]: min_y of bounding box
+// [8..10]: second moments about the COM (sxx, sxy, syy) — quadrupole term
+// [11]: padding
 
 @group(0) @binding(0) var<storage, read> positions: array<f32>;         // node positions [x,y,vx,vy]
 @group(0) @binding(1) var<storage, read> sorted_indices: array<u32>;    // Morton-sorted node indices
 @group(0) @binding(2) var<storage, read_write> tree: array<f32>;        // quadtree nodes
 @group(0) @binding(3) var<uniform> params: BuildParams;
+@group(0) @binding(4) var<storage, read> node_weights: array<f32>;      // originals per node (mass)
 
 @compute @workgroup_size(256)
 fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
@@ -47,13 +50,16 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
   let px = positions[base_pos];
   let py = positions[base_pos + 1u];
 
-  let tree_base = leaf_idx * 8u;
+  let tree_base = leaf_idx * 12u;
   tree[tree_base + 0u] = px;        // com_x
   tree[tree_base + 1u] = py;        // com_y
-  tree[tree_base + 2u] = 1.0;       // mass
+  tree[tree_base + 2u] = node_weights[node_idx]; // mass
   tree[tree_base + 3u] = 0.0;       // cell_size (leaves have 0)
   tree[tree_base + 4u] = f32(node_idx);  // node_index for leaf
   tree[tree_base + 5u] = 0.0;       // child_mask = 0 (leaf)
   tree[tree_base + 6u] = px;        // min_x
   tree[tree_base + 7u] = py;        // min_y
+  tree[tree_base + 8u] = 0.0;       // sxx (a point mass has no spread)
+  tree[tree_base + 9u] = 0.0;       // sxy
+  tree[tree_base + 10u] = 0.0;      // syy
 }
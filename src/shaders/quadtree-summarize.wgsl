@@ -4,6 +4,7 @@
 //   com = weighted average of child COMs
 //   mass = sum of child masses
 //   cell_size = computed from bounding box
+//   second moments = child moments shifted to the parent COM (parallel axis)
 //
 // We process level by level, from leaves up to root.
 // Each dispatch handles one level of the tree.
@@ -15,7 +16,7 @@ struct SummarizeParams {
   root_size: f32,     // bounding box size of root
 };
 
-// Tree node layout: 8 floats per node (same as build shader)
+// Tree node layout: 12 floats per node (same as build shader)
 @group(0) @binding(0) var<storage, read_write> tree: array<f32>;
 @group(0) @binding(1) var<uniform> params: SummarizeParams;
 
@@ -27,7 +28,7 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
   }
 
   let node_idx = params.level_start + tid;
-  let node_base = node_idx * 8u;
+  let node_base = node_idx * 12u;
 
   // Children indices: 4*i+1, 4*i+2, 4*i+3, 4*i+4
   let first_child = 4u * node_idx + 1u;
@@ -47,7 +48,7 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
       continue;
     }
 
-    let child_base = child_idx * 8u;
+    let child_base = child_idx * 12u;
     let child_mass = tree[child_base + 2u];
 
     if (child_mass > 0.0) {
@@ -77,6 +78,23 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
 
   let cell_size = max(max_x - min_x, max_y - min_y);
 
+  // Second moments about this node's COM: sum of child moments plus m * d d^T
+  var sxx: f32 = 0.0;
+  var sxy: f32 = 0.0;
+  var syy: f32 = 0.0;
+  for (var c = 0u; c < 4u; c++) {
+    if ((child_mask & (1u << c)) == 0u) {
+      continue;
+    }
+    let child_base = (first_child + c) * 12u;
+    let child_mass = tree[child_base + 2u];
+    let dx = tree[child_base + 0u] - com_x;
+    let dy = tree[child_base + 1u] - com_y;
+    sxx += tree[child_base + 8u] + child_mass * dx * dx;
+    sxy += tree[child_base + 9u] + child_mass * dx * dy;
+    syy += tree[child_base + 10u] + child_mass * dy * dy;
+  }
+
   tree[node_base + 0u] = com_x;
   tree[node_base + 1u] = com_y;
   tree[node_base + 2u] = total_mass;
@@ -85,4 +103,7 @@ fn main(@builtin(global_invocation_id) gid: vec3<u32>) {
   tree[node_base + 5u] = f32(child_mask);
   tree[node_base + 6u] = select(0.0, min_x, total_mass > 0.0);
   tree[node_base + 7u] = select(0.0, min_y, total_mass > 0.0);
+  tree[node_base + 8u] = sxx;
+  tree[node_base + 9u] = sxy;
+  tree[node_base + 10u] = syy;
 }
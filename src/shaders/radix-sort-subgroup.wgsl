@@ -21,6 +21,7 @@ struct SortParams {
 @group(0) @binding(5) var<uniform> params: SortParams;
 
 var<workgroup> local_hist: array<atomic<u32>, 256>;
+var<workgroup> local_digits: array<u32, 256>;
 
 @compute @workgroup_size(256)
 fn histogram(@builtin(global_invocation_id) gid: vec3<u32>,
@@ -81,16 +82,24 @@ fn prefix_sum(@builtin(global_invocation_id) gid: vec3<u32>) {
 fn scatter(@builtin(global_invocation_id) gid: vec3<u32>,
            @builtin(local_invocation_id) lid: vec3<u32>,
            @builtin(workgroup_id) wgid: vec3<u32>) {
-  atomicStore(&local_hist[lid.x], 0u);
-  workgroupBarrier();
-
+  // Stable rank: count earlier lanes in this workgroup with the same digit.
+  // An atomicAdd rank would depend on thread scheduling, which breaks the
+  // LSD invariant (each pass must preserve the previous pass's order).
   let idx = gid.x;
+  var digit = 0xFFFFFFFFu; // out-of-range lanes never match a real digit
   if (idx < params.node_count) {
-    let key = keys_in[idx];
-    let digit = (key >> params.bit_offset) & 0xFFu;
+    digit = (keys_in[idx] >> params.bit_offset) & 0xFFu;
+  }
+  local_digits[lid.x] = digit;
+  workgroupBarrier();
 
-    let local_rank = atomicAdd(&local_hist[digit], 1u);
+  if (idx < params.node_count) {
+    var local_rank = 0u;
+    for (var j = 0u; j < lid.x; j++) {
+      local_rank += select(0u, 1u, local_digits[j] == digit);
+    }
 
+    // Global offset for this digit in this workgroup
     let num_workgroups = (params.node_count + 255u) / 256u;
     let global_offset = atomicLoad(&histograms[digit * num_workgroups + wgid.x]);
 
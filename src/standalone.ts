@@ -1,10 +1,11 @@
 import { HyperblobEngine } from './lib';
-import { parseCSV, type ParsedCSV } from './data/csv-parser';
-import { tabularToHypergraph, type ColumnMapping } from './data/tabular-to-hypergraph';
-import type { HypergraphData } from './data/types';
+import { scanCSV, buildCSVHypergraph } from './data/csv-pipeline';
+import { reduceHypergraph } from './data/reduction';
+import type { CSVTable, ColumnMapping } from './data/csv-stream';
+import type { HypergraphStore } from './data/hypergraph-store';
 
 let engine: HyperblobEngine | null = null;
-let csv: ParsedCSV | null = null;
+let csv: CSVTable | null = null;
 
 // ── Bootstrap ──
 
@@ -40,7 +41,7 @@ function buildPanel(): void {
 
   const dropZone = el('div', 'sa-drop-zone');
   const dropLabel = el('div', 'sa-drop-label', 'Drop CSV here or click to upload');
-  const dropHint = el('div', 'sa-drop-hint', 'Comma-separated with a header row');
+  const dropHint = el('div', 'sa-drop-hint', 'Comma- or tab-separated with a header row');
   const fileInput = document.createElement('input');
   fileInput.type = 'file';
   fileInput.accept = '.csv,.tsv,.txt';
@@ -55,10 +56,10 @@ function buildPanel(): void {
     e.preventDefault();
     dropZone.classList.remove('dragover');
     const file = e.dataTransfer?.files[0];
-    if (file) readFile(file);
+    if (file) loadCSV(file, dropHint);
   });
   fileInput.addEventListener('change', () => {
-    if (fileInput.files?.[0]) readFile(fileInput.files[0]);
+    if (fileInput.files?.[0]) loadCSV(fileInput.files[0], dropHint);
   });
 
   // Paste area
@@ -71,7 +72,7 @@ function buildPanel(): void {
   const pasteBtn = el('button', 'sa-btn sa-btn-default', 'Parse pasted data');
   pasteBtn.addEventListener('click', () => {
     if (pasteArea.value.trim()) {
-      loadCSV(pasteArea.value);
+      loadCSV(new Blob([pasteArea.value]), dropHint);
     }
   });
   scroll.appendChild(pasteBtn);
@@ -91,19 +92,24 @@ function buildPanel(): void {
   (panel as any).__ctrls = ctrlSection;
 }
 
-function readFile(file: File): void {
-  const reader = new FileReader();
-  reader.onload = () => {
-    if (typeof reader.result === 'string') {
-      loadCSV(reader.result);
-    }
-  };
-  reader.readAsText(file);
-}
-
-function loadCSV(text: string): void {
-  csv = parseCSV(text);
-  if (csv.headers.length === 0 || csv.rows.length === 0) {
+/** Scan a file or pasted text in a worker; `status` shows progress meanwhile. */
+async function loadCSV(source: Blob, status: HTMLElement): Promise<void> {
+  const hint = status.textContent;
+  try {
+    csv = await scanCSV(source, {
+      onProgress: (p) => {
+        const pct = Math.round((p.bytesRead / Math.max(p.totalBytes, 1)) * 100);
+        status.textContent = `Reading… ${pct}% · ${p.rows.toLocaleString()} rows`;
+      },
+    });
+  } catch (err) {
+    console.error('Failed to parse CSV:', err);
+    alert('Could not parse the CSV file.');
+    return;
+  } finally {
+    status.textContent = hint;
+  }
+  if (csv.headers.length === 0 || csv.rowCount === 0) {
     alert('No data found. Ensure CSV has a header row and at least one data row.');
     return;
   }
@@ -120,7 +126,7 @@ function buildMapper(): void {
   section.innerHTML = '';
   section.style.display = '';
 
-  section.appendChild(sectionHeader(`Columns (${csv.headers.length} cols, ${csv.rows.length} rows)`));
+  section.appendChild(sectionHeader(`Columns (${csv.headers.length} cols, ${csv.rowCount.toLocaleString()} rows)`));
 
   // Node ID selector
   const nodeRow = el('div', 'sa-field');
@@ -152,21 +158,35 @@ function buildMapper(): void {
     lbl.htmlFor = `col-${i}`;
     lbl.className = 'sa-check-label';
 
-    // Show sample unique values
-    const unique = new Set(csv!.rows.map(r => r[i]).filter(Boolean));
-    const sample = Array.from(unique).slice(0, 3).join(', ');
-    const more = unique.size > 3 ? ` +${unique.size - 3}` : '';
+    // Show sample unique values (code 0 is the empty cell)
+    const { values } = csv.columns[i];
+    const uniqueCount = values.length - 1;
+    const sample = values.slice(1, 4).join(', ');
+    const more = uniqueCount > 3 ? ` +${uniqueCount - 3}` : '';
     lbl.textContent = `${csv!.headers[i]}`;
 
-    const sampleSpan = el('span', 'sa-sample', `${unique.size} unique: ${sample}${more}`);
+    const sampleSpan = el('span', 'sa-sample', `${uniqueCount} unique: ${sample}${more}`);
 
     row.append(cb, lbl, sampleSpan);
     section.appendChild(row);
     checkboxes.push(cb);
   }
 
+  // Structural reduction
+  const collapseRow = el('div', 'sa-check-row');
+  const collapse = document.createElement('input');
+  collapse.type = 'checkbox';
+  collapse.id = 'collapse-duplicates';
+  const collapseLabel = document.createElement('label');
+  collapseLabel.htmlFor = collapse.id;
+  collapseLabel.className = 'sa-check-label';
+  collapseLabel.textContent = 'Collapse duplicates';
+  collapseRow.append(collapse, collapseLabel,
+    el('span', 'sa-sample', 'identical hyperedges and nodes with identical memberships'));
+  section.appendChild(collapseRow);
+
   // Visualize button
-  const vizBtn = el('button', 'sa-btn sa-btn-primary', 'Visualize');
+  const vizBtn = el('button', 'sa-btn sa-btn-primary', 'Visualize') as HTMLButtonElement;
   vizBtn.addEventListener('click', () => {
     const nodeCol = parseInt(nodeSelect.value);
     const edgeCols = checkboxes
@@ -180,24 +200,27 @@ function buildMapper(): void {
     }
 
     const mapping: ColumnMapping = { nodeColumn: nodeCol, edgeColumns: edgeCols };
-    const data = tabularToHypergraph(csv!, mapping);
-    visualize(data, ctrlSection);
+    vizBtn.disabled = true;
+    buildCSVHypergraph(csv!, mapping)
+      .then(store => visualize(collapse.checked ? reduceHypergraph(store).store : store, ctrlSection))
+      .catch(err => console.error('Failed to build hypergraph:', err))
+      .finally(() => { vizBtn.disabled = false; });
   });
   section.appendChild(vizBtn);
 }
 
 // ── Visualize ──
 
-async function visualize(data: HypergraphData, ctrlSection: HTMLElement): Promise<void> {
+async function visualize(store: HypergraphStore, ctrlSection: HTMLElement): Promise<void> {
   if (!engine) return;
 
-  engine.setData(data);
+  engine.setData(store);
   await engine.converge();
 
   // Show controls
   ctrlSection.innerHTML = '';
   ctrlSection.style.display = '';
-  ctrlSection.appendChild(sectionHeader(`Graph: ${data.nodes.length} nodes, ${data.hyperedges.length} edges`));
+  ctrlSection.appendChild(sectionHeader(`Graph: ${store.nodeCount} nodes, ${store.edgeCount} edges`));
 
   const btnRow = el('div', 'sa-btn-row');
 
@@ -6,7 +6,29 @@ export type {
   SimulationParams,
   RenderParams,
   HullMode,
+  EdgeMembers,
 } from './data/types';
 
 export type { HyperblobOptions } from './lib';
 export { HyperblobEngine } from './lib';
+
+export type { HypergraphBinary } from './data/binary-format';
+export {
+  encodeHypergraphBinary, decodeHypergraphBinary, hypergraphFromBinary, storeFromBinary,
+} from './data/binary-format';
+
+export type { AttributeColumn, HypergraphStoreParts } from './data/hypergraph-store';
+export { HypergraphStore, AttributeStore, IdTable } from './data/hypergraph-store';
+
+export type { LayoutCacheBackend, LayoutCacheEntry, LayoutCacheOptions } from './data/layout-cache';
+export {
+  LayoutCache, MemoryLayoutBackend, IndexedDBLayoutBackend, layoutKey,
+} from './data/layout-cache';
+
+export type { StructuralReduction, ReductionOptions } from './data/reduction';
+export { reduceHypergraph, collapsedWeights, COLLAPSED_NODES, COLLAPSED_EDGES } from './data/reduction';
+
+export type { NodeInput, HyperedgeInput, HyperedgeExtension, GraphDelta } from './data/graph-mutations';
+export type { HIFStreamOptions, HIFBatchOptions, HIFStreamProgress, HIFSampleOptions, HIFSample } from './data/hif-stream';
+export { parseHIFStream, streamHIFBatches, sampleHIFStream, loadHIFNeighborhood } from './data/hif-stream';
+export { EdgeSampler } from './data/edge-sampler';
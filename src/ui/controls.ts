@@ -198,7 +198,8 @@ export function createFileDropZone(opts: {
     container.classList.remove('dragover');
     if (e.dataTransfer?.files && e.dataTransfer.files.length > 0) {
       const file = e.dataTransfer.files[0];
-      if (file.name.endsWith('.json')) {
+      const extensions = opts.accept.split(',').map(ext => ext.trim());
+      if (extensions.some(ext => file.name.endsWith(ext))) {
         opts.onFile(file);
       }
     }
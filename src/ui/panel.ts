@@ -1,4 +1,6 @@
-import type { SimulationParams, RenderParams, HypergraphData } from '../data/types';
+import type { SimulationParams, RenderParams } from '../data/types';
+import type { HypergraphStore } from '../data/hypergraph-store';
+import type { GeneratorRequest } from '../data/generator-pipeline';
 import type { Camera } from '../render/camera';
 import { createSimulationTab } from './tabs/simulation-tab';
 import { createRenderingTab } from './tabs/rendering-tab';
@@ -9,8 +11,13 @@ export interface PanelConfig {
   simParams: SimulationParams;
   renderParams: RenderParams;
   camera: Camera;
-  onLoadFile: (data: HypergraphData) => void;
-  onGenerate: (nodeCount: number, heCount: number, maxSize: number) => void;
+  onLoadFile: (store: HypergraphStore) => void;
+  onStreamFile: (file: File) => Promise<void>;
+  onGenerate: (request: GeneratorRequest) => void;
+  onLoadBinary: (buffer: ArrayBuffer) => void;
+  onSaveBinary: () => void;
+  maxIncidences: number;
+  selectedNodeId: () => string | null;
   onSimulationToggle: (running: boolean) => void;
   onSimulationReset: () => void;
   onSimulationConverge: () => void;
@@ -25,7 +32,7 @@ interface SectionDef {
 
 export class Panel {
   private container: HTMLElement;
-  private dataTabHandle: { updateDataInfo(data: HypergraphData): void } | null = null;
+  private dataTabHandle: { updateDataInfo(store: HypergraphStore): void } | null = null;
   private disposers: Array<() => void> = [];
 
   constructor(container: HTMLElement, config: PanelConfig) {
@@ -59,7 +66,12 @@ export class Panel {
 
     const dataTabResult = createDataTab(
       config.onLoadFile,
+      config.onStreamFile,
       config.onGenerate,
+      config.onLoadBinary,
+      config.onSaveBinary,
+      config.maxIncidences,
+      config.selectedNodeId,
     );
     this.dataTabHandle = dataTabResult;
 
@@ -115,8 +127,8 @@ export class Panel {
     this.container.appendChild(scrollArea);
   }
 
-  updateDataInfo(data: HypergraphData): void {
-    this.dataTabHandle?.updateDataInfo(data);
+  updateDataInfo(store: HypergraphStore): void {
+    this.dataTabHandle?.updateDataInfo(store);
   }
 
   dispose(): void {
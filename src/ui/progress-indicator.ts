@@ -0,0 +1,62 @@
+/**
+ * Loading overlay for progressive loads: a thin bar along the top of the
+ * canvas (indeterminate when the total size is unknown) and a one-line
+ * status. It never takes pointer events, so the graph stays interactive
+ * while data is still arriving.
+ */
+export class ProgressIndicator {
+  private el: HTMLDivElement;
+  private bar: HTMLDivElement;
+  private label: HTMLDivElement;
+
+  constructor(parent: HTMLElement) {
+    this.el = document.createElement('div');
+    this.el.className = 'hg-progress';
+    this.el.style.cssText = `
+      position: absolute;
+      top: 0;
+      left: 0;
+      right: 0;
+      display: none;
+      pointer-events: none;
+      z-index: 20;
+    `;
+
+    const track = document.createElement('div');
+    track.style.cssText = 'height: 3px; background: rgba(102, 136, 255, 0.15);';
+    this.bar = document.createElement('div');
+    this.bar.style.cssText = 'height: 100%; width: 0; background: #6688ff; transition: width 0.15s linear;';
+    track.appendChild(this.bar);
+
+    this.label = document.createElement('div');
+    this.label.className = 'hg-progress-label';
+    this.label.style.cssText = `
+      position: absolute;
+      top: 10px;
+      right: 12px;
+      font-family: 'SF Mono', 'Fira Code', monospace;
+      font-size: 12px;
+      color: #666680;
+    `;
+
+    this.el.appendChild(track);
+    this.el.appendChild(this.label);
+    parent.appendChild(this.el);
+  }
+
+  /** Show progress: `fraction` in [0, 1], or null when the total is unknown. */
+  update(fraction: number | null, text: string): void {
+    this.el.style.display = 'block';
+    this.bar.style.width = fraction === null ? '100%' : `${Math.round(Math.min(Math.max(fraction, 0), 1) * 100)}%`;
+    this.bar.style.opacity = fraction === null ? '0.4' : '1';
+    this.label.textContent = fraction === null ? text : `${Math.round(fraction * 100)}% · ${text}`;
+  }
+
+  hide(): void {
+    this.el.style.display = 'none';
+  }
+
+  dispose(): void {
+    this.el.remove();
+  }
+}
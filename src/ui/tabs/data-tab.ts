@@ -1,16 +1,25 @@
-import type { HypergraphData } from '../../data/types';
+import type { HypergraphStore } from '../../data/hypergraph-store';
+import type { GeneratorRequest } from '../../data/generator-pipeline';
+import type { HIFSample } from '../../data/hif-stream';
 import {
   createSlider,
   createButton,
   createInfoDisplay,
   createFileDropZone,
   createSectionHeader,
+  createSelect,
+  createToggle,
 } from '../controls';
 
 export function createDataTab(
-  onLoadFile: (data: HypergraphData) => void,
-  onGenerate: (nodeCount: number, heCount: number, maxSize: number) => void,
-): { el: HTMLElement; updateDataInfo(data: HypergraphData): void } {
+  onLoadFile: (store: HypergraphStore) => void,
+  onStreamFile: (file: File) => Promise<void>,
+  onGenerate: (request: GeneratorRequest) => void,
+  onLoadBinary: (buffer: ArrayBuffer) => void,
+  onSaveBinary: () => void,
+  maxIncidences: number,
+  selectedNodeId: () => string | null,
+): { el: HTMLElement; updateDataInfo(store: HypergraphStore): void } {
   const tab = document.createElement('div');
   tab.className = 'panel-tab-content';
 
@@ -26,35 +35,153 @@ export function createDataTab(
   tab.appendChild(avgInfo.el);
 
   // -- Import section --
-  tab.appendChild(createSectionHeader('Import HIF JSON'));
+  tab.appendChild(createSectionHeader('Import HIF JSON / .hblob'));
+
+  const importInfo = createInfoDisplay('Import', '--');
+  let collapse = false;
+
+  // Preview: sample whole hyperedges down to an incidence budget (datasets beyond GPU limits)
+  const sampleInfo = createInfoDisplay('Sample', '--');
+  const totalInfo = createInfoDisplay('Full Dataset', '--');
+  let preview = false;
+  let budget = maxIncidences;
+  let previewFile: File | null = null;
+
+  const streamOptions = (file: File) => ({
+    totalBytes: file.size,
+    gzip: file.name.endsWith('.gz'),
+    onProgress: (p: { bytesRead: number; totalBytes: number | null; incidences: number }) => {
+      const pct = p.totalBytes ? Math.round((p.bytesRead / p.totalBytes) * 100) : 0;
+      importInfo.update(`${pct}% · ${p.incidences.toLocaleString()} incidences`);
+    },
+  });
+
+  const showSample = async (sample: HIFSample, label: string) => {
+    importInfo.update(label);
+    sampleInfo.update(sample.sampled
+      ? `${sample.store.memberCount.toLocaleString()} of ${sample.total.incidences.toLocaleString()} incidences`
+      : 'Complete');
+    totalInfo.update(`≈${sample.total.nodes.toLocaleString()} nodes · ≈${sample.total.edges.toLocaleString()} hyperedges`);
+    if (collapse) {
+      const { reduceHypergraph } = await import('../../data/reduction');
+      onLoadFile(reduceHypergraph(sample.store).store);
+    } else {
+      onLoadFile(sample.store);
+    }
+  };
 
   const dropZone = createFileDropZone({
-    label: 'HIF JSON File',
-    accept: '.json',
+    label: 'HIF JSON File (.json, .json.gz) or .hblob',
+    accept: '.json,.gz,.hblob',
     onFile: async (file: File) => {
       try {
-        const text = await file.text();
-        const json = JSON.parse(text);
-        // Dynamic import — module built by another agent, may not exist yet
-        const hifPath = '../../data/hif-loader';
-        // eslint-disable-next-line @typescript-eslint/no-explicit-any
-        const hifLoader: any = await import(/* @vite-ignore */ hifPath);
-        const parseHIF = hifLoader.parseHIF as (doc: unknown) => HypergraphData;
-        const data = parseHIF(json);
-        onLoadFile(data);
+        if (file.name.endsWith('.hblob')) {
+          // Binary container: typed arrays go to the GPU without parsing
+          onLoadBinary(await file.arrayBuffer());
+          importInfo.update(file.name);
+          return;
+        }
+        if (preview) {
+          previewFile = file;
+          const { sampleHIFStream } = await import('../../data/hif-stream');
+          const sample = await sampleHIFStream(file.stream(), { ...streamOptions(file), incidenceBudget: budget });
+          await showSample(sample, file.name);
+          return;
+        }
+        previewFile = null;
+        sampleInfo.update('--');
+        totalInfo.update('--');
+        if (!collapse) {
+          // Progressive: the graph is drawn and laid out while the file streams in
+          importInfo.update('Loading…');
+          await onStreamFile(file);
+          importInfo.update(file.name);
+          return;
+        }
+        // Reduction needs the whole graph: stream it in first, then collapse
+        const { parseHIFStream } = await import('../../data/hif-stream');
+        const store = await parseHIFStream(file.stream(), streamOptions(file));
+        importInfo.update(file.name);
+        const { reduceHypergraph } = await import('../../data/reduction');
+        onLoadFile(reduceHypergraph(store).store);
       } catch (err) {
+        importInfo.update('Failed');
         console.error('Failed to parse HIF file:', err);
       }
     },
   });
+  tab.appendChild(createToggle({
+    label: 'Collapse duplicates',
+    value: collapse,
+    onChange: (v) => { collapse = v; },
+  }));
+  tab.appendChild(createToggle({
+    label: 'Preview sample',
+    value: preview,
+    onChange: (v) => { preview = v; },
+  }));
+  tab.appendChild(createSlider({
+    label: 'Incidence Budget',
+    min: Math.min(10000, maxIncidences),
+    max: maxIncidences,
+    step: 1,
+    value: budget,
+    onChange: (v) => { budget = v; },
+    logarithmic: true,
+  }));
   tab.appendChild(dropZone);
+  tab.appendChild(importInfo.el);
+  tab.appendChild(sampleInfo.el);
+  tab.appendChild(totalInfo.el);
+
+  // Drill in: re-read the previewed file for every hyperedge around the selected node
+  tab.appendChild(createButton({
+    label: 'Full Detail Around Selection',
+    onClick: async () => {
+      const file = previewFile;
+      const id = selectedNodeId();
+      if (!file || id === null) {
+        sampleInfo.update(file ? 'Select a node first' : 'Load a preview first');
+        return;
+      }
+      try {
+        const { loadHIFNeighborhood } = await import('../../data/hif-stream');
+        const sample = await loadHIFNeighborhood(() => file.stream(), [id], {
+          ...streamOptions(file),
+          incidenceBudget: budget,
+        });
+        await showSample(sample, `${file.name} · around ${id}`);
+      } catch (err) {
+        importInfo.update('Failed');
+        console.error('Failed to load neighborhood:', err);
+      }
+    },
+  }));
+
+  tab.appendChild(createButton({
+    label: 'Save Graph + Layout (.hblob)',
+    onClick: onSaveBinary,
+  }));
 
   // -- Generate section --
   tab.appendChild(createSectionHeader('Generate Random'));
 
+  let model = 'realistic';
   let nodeCount = 500;
   let heCount = 100;
   let maxSize = 6;
+  let communities = 16;
+  let seed = 1;
+
+  tab.appendChild(createSelect({
+    label: 'Model',
+    options: [
+      { value: 'realistic', label: 'Power-law + communities' },
+      { value: 'uniform', label: 'Uniform' },
+    ],
+    value: model,
+    onChange: (v) => { model = v; },
+  }));
 
   tab.appendChild(createSlider({
     label: 'Node Count',
@@ -69,7 +196,7 @@ export function createDataTab(
   tab.appendChild(createSlider({
     label: 'Hyperedge Count',
     min: 10,
-    max: 100000,
+    max: 2000000,
     step: 1,
     value: heCount,
     onChange: (v) => { heCount = v; },
@@ -79,27 +206,49 @@ export function createDataTab(
   tab.appendChild(createSlider({
     label: 'Max Edge Size',
     min: 2,
-    max: 50,
+    max: 256,
     step: 1,
     value: maxSize,
     onChange: (v) => { maxSize = v; },
   }));
 
+  tab.appendChild(createSlider({
+    label: 'Communities',
+    min: 1,
+    max: 64,
+    step: 1,
+    value: communities,
+    onChange: (v) => { communities = v; },
+  }));
+
+  tab.appendChild(createSlider({
+    label: 'Seed',
+    min: 1,
+    max: 1000,
+    step: 1,
+    value: seed,
+    onChange: (v) => { seed = v; },
+  }));
+
   tab.appendChild(createButton({
     label: 'Generate',
     variant: 'primary',
-    onClick: () => onGenerate(nodeCount, heCount, maxSize),
+    onClick: () => onGenerate(model === 'uniform'
+      ? { type: 'uniform', nodeCount, edgeCount: heCount, maxEdgeSize: maxSize, seed }
+      : {
+        type: 'synthetic',
+        options: { nodeCount, edgeCount: heCount, maxEdgeSize: maxSize, communities, seed },
+      }),
   }));
 
   return {
     el: tab,
-    updateDataInfo(data: HypergraphData) {
-      nodeInfo.update(data.nodes.length.toLocaleString());
-      edgeInfo.update(data.hyperedges.length.toLocaleString());
+    updateDataInfo(store: HypergraphStore) {
+      nodeInfo.update(store.nodeCount.toLocaleString());
+      edgeInfo.update(store.edgeCount.toLocaleString());
 
-      if (data.hyperedges.length > 0) {
-        const totalSize = data.hyperedges.reduce((sum, he) => sum + he.memberIndices.length, 0);
-        const avg = totalSize / data.hyperedges.length;
+      if (store.edgeCount > 0) {
+        const avg = store.memberCount / store.edgeCount;
         avgInfo.update(avg.toFixed(1));
       } else {
         avgInfo.update('--');
@@ -60,6 +60,17 @@ export function createRenderingTab(renderParams: RenderParams): HTMLElement {
     tooltip: 'Field value cutoff for metaball blobs. Lower = larger blobs, higher = tighter around nodes.',
   }));
 
+  tab.appendChild(createSelect({
+    label: 'Blob Resolution',
+    options: [
+      { value: '1', label: 'Full' },
+      { value: '0.5', label: 'Half' },
+      { value: '0.25', label: 'Quarter' },
+    ],
+    value: String(renderParams.hullMetaballScale),
+    onChange: (v) => { renderParams.hullMetaballScale = Number(v); },
+  }));
+
   tab.appendChild(createSlider({
     label: 'Hull Alpha',
     min: 0,
@@ -80,16 +91,6 @@ export function createRenderingTab(renderParams: RenderParams): HTMLElement {
     tooltip: 'Padding around nodes for hull computation. In metaball mode, controls the Gaussian sigma.',
   }));
 
-  tab.appendChild(createSlider({
-    label: 'Hull Smoothing',
-    min: 0,
-    max: 5,
-    step: 1,
-    value: renderParams.hullSmoothing,
-    onChange: (v) => { renderParams.hullSmoothing = v; },
-    tooltip: 'Chaikin smoothing iterations for convex hull outlines. Only affects convex mode.',
-  }));
-
   tab.appendChild(createToggle({
     label: 'Hull Outline',
     value: renderParams.hullOutline,
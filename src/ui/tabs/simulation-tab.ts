@@ -1,5 +1,5 @@
 import type { SimulationParams } from '../../data/types';
-import { createSlider, createButton, createSectionHeader } from '../controls';
+import { createSlider, createToggle, createButton, createSectionHeader } from '../controls';
 
 export function createSimulationTab(
   simParams: SimulationParams,
@@ -151,7 +151,7 @@ export function createSimulationTab(
     step: 0.1,
     value: simParams.theta,
     onChange: (v) => { simParams.theta = v; },
-    tooltip: 'Barnes-Hut accuracy. Lower = more accurate forces but slower. 0.9 is a good balance.',
+    tooltip: 'Barnes-Hut accuracy. Lower = more accurate forces but slower. 1.0 is a good balance.',
   }));
 
   tab.appendChild(createSlider({
@@ -181,5 +181,11 @@ export function createSimulationTab(
     tooltip: 'Minimum energy the simulation settles to. Higher = nodes keep jiggling slightly.',
   }));
 
+  tab.appendChild(createToggle({
+    label: 'Deterministic',
+    value: simParams.deterministic,
+    onChange: (v) => { simParams.deterministic = v; },
+  }));
+
   return { el: tab, dispose };
 }
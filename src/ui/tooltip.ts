@@ -10,6 +10,15 @@ function escapeHtml(s: string): string {
     .replace(/'/g, '&#39;');
 }
 
+function collapsedLine(ids: string[] | undefined): string {
+  if (!ids || ids.length < 2) return '';
+  const escaped = ids.map(escapeHtml);
+  const text = escaped.length <= 5
+    ? escaped.join(', ')
+    : escaped.slice(0, 4).join(', ') + `, +${ids.length - 4} more`;
+  return `<div style="color:#999;margin-top:2px">×${ids.length}: ${text}</div>`;
+}
+
 export class Tooltip {
   private el: HTMLDivElement;
 
@@ -35,7 +44,8 @@ export class Tooltip {
     parent.appendChild(this.el);
   }
 
-  show(x: number, y: number, label: string, members: string[]): void {
+  /** `collapsed`: original IDs a reduced representative stands for (see data/reduction.ts). */
+  show(x: number, y: number, label: string, members: string[], collapsed?: string[]): void {
     const escaped = members.map(escapeHtml);
     const memberText = escaped.length <= 5
       ? escaped.join(', ')
@@ -43,13 +53,14 @@ export class Tooltip {
 
     this.el.innerHTML =
       `<div style="font-weight:600;margin-bottom:2px">${escapeHtml(label)}</div>` +
-      `<div style="color:#666680">${memberText}</div>`;
+      `<div style="color:#666680">${memberText}</div>` +
+      collapsedLine(collapsed);
 
     this.el.style.display = 'block';
     this.position(x, y);
   }
 
-  showNode(x: number, y: number, nodeLabel: string, edges: string[]): void {
+  showNode(x: number, y: number, nodeLabel: string, edges: string[], collapsed?: string[]): void {
     const escaped = edges.map(escapeHtml);
     const edgeText = escaped.length === 0
       ? '<span style="color:#999">no edges</span>'
@@ -59,7 +70,8 @@ export class Tooltip {
 
     this.el.innerHTML =
       `<div style="font-weight:600;margin-bottom:2px">${escapeHtml(nodeLabel)}</div>` +
-      `<div style="color:#666680">${edgeText}</div>`;
+      `<div style="color:#666680">${edgeText}</div>` +
+      collapsedLine(collapsed);
 
     this.el.style.display = 'block';
     this.position(x, y);
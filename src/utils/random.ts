@@ -0,0 +1,22 @@
+/** A source of uniform floats in [0, 1), interchangeable with Math.random. */
+export type Rng = () => number;
+
+/**
+ * Seeded PRNG (mulberry32). Same seed → same sequence on every platform,
+ * so layouts and generated graphs can be reproduced exactly.
+ */
+export function createRng(seed: number): Rng {
+  let state = seed >>> 0;
+  return () => {
+    state = (state + 0x6D2B79F5) >>> 0;
+    let t = state;
+    t = Math.imul(t ^ (t >>> 15), t | 1);
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+  };
+}
+
+/** Seeded PRNG when `seed` is given, Math.random otherwise. */
+export function rngFor(seed: number | undefined): Rng {
+  return seed === undefined ? Math.random : createRng(seed);
+}
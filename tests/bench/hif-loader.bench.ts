@@ -0,0 +1,39 @@
+/**
+ * parseHIF on single large hyperedges. Per-op time should grow linearly with
+ * the member count (2× members → ~2× time); the old `includes` de-dup was
+ * quadratic and took seconds at 40K members.
+ *
+ * Run: npm run bench:hif
+ */
+import { bench, describe } from 'vitest';
+import { parseHIF } from '../../src/data/hif-loader';
+import type { HIFDocument } from '../../src/data/types';
+
+/** One hyperedge of `members` distinct nodes, each listed twice (worst case for de-dup). */
+function bigEdgeDoc(members: number): HIFDocument {
+  const incidences: HIFDocument['incidences'] = [];
+  for (let pass = 0; pass < 2; pass++) {
+    for (let i = 0; i < members; i++) incidences.push({ node: `n${i}`, edge: 0 });
+  }
+  return { incidences };
+}
+
+describe('parseHIF — one hyperedge, duplicated incidences', () => {
+  for (const members of [10_000, 20_000, 40_000, 80_000]) {
+    const doc = bigEdgeDoc(members);
+    bench(`${members.toLocaleString('en-US')} members`, () => {
+      parseHIF(doc);
+    });
+  }
+});
+
+describe('parseHIF — 100 hyperedges of 10K members over 50K nodes', () => {
+  const incidences: HIFDocument['incidences'] = [];
+  for (let e = 0; e < 100; e++) {
+    for (let k = 0; k < 10_000; k++) incidences.push({ node: `n${(e * 7919 + k * 31) % 50_000}`, edge: e });
+  }
+  const doc: HIFDocument = { incidences };
+  bench('1M incidences', () => {
+    parseHIF(doc);
+  });
+});
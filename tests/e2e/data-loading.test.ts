@@ -82,4 +82,38 @@ test.describe('Data Loading', () => {
     });
     expect(nodeCount).toBe(101);
   });
+
+  test('progressive load lays out batches while the file streams in', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(() => (window as any).__app?.engine?.getNodeCount() === 101, { timeout: 15000 });
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const text = await (await fetch('/data/got.json')).text();
+      // Small chunks so the document arrives as many batches
+      const bytes = new TextEncoder().encode(text);
+      let offset = 0;
+      const source = new ReadableStream<Uint8Array>({
+        pull(controller) {
+          if (offset >= bytes.length) { controller.close(); return; }
+          controller.enqueue(bytes.slice(offset, offset + 2048));
+          offset += 2048;
+        },
+      });
+      const counts: number[] = [];
+      const original = engine.applyDelta.bind(engine);
+      engine.applyDelta = (delta: unknown) => { original(delta); counts.push(engine.getNodeCount()); };
+      const store = await engine.loadHIFStream(source);
+      engine.applyDelta = original;
+      return { counts, nodes: store.nodeCount, edges: store.edgeCount, running: engine.simParams.running };
+    });
+
+    expect(result.counts.length).toBeGreaterThan(2);
+    expect(result.counts[0]).toBeGreaterThan(0);
+    expect(result.counts[0]).toBeLessThan(101);
+    expect(result.counts[result.counts.length - 1]).toBe(101);
+    expect(result.nodes).toBe(101);
+    expect(result.edges).toBe(394);
+    expect(result.running).toBe(true);
+  });
 });
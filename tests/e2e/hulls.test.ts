@@ -122,4 +122,273 @@ test.describe('Convex Hulls', () => {
     // PNG compression of a diverse image will be larger than a mostly-solid one
     expect(screenshot.length).toBeGreaterThan(2000);
   });
+
+  test('GPU prefix sum matches a CPU exclusive scan across levels', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const { PrefixSum } = await import('/src/gpu/prefix-sum.ts');
+      const device = engine.getGPU().device;
+      const bm = engine.getBufferManager();
+
+      // > 512² elements, so the block sums are scanned in a third level
+      const n = 300_000;
+      const input = new Uint32Array(n);
+      for (let i = 0; i < n; i++) input[i] = (i * 2654435761) % 17;
+      bm.ensureCapacity('test-scan', n * 4, GPUBufferUsage.STORAGE | GPUBufferUsage.COPY_SRC | GPUBufferUsage.COPY_DST);
+      bm.uploadData('test-scan', input);
+
+      const scan = new PrefixSum(device, bm, 'test-scan');
+      scan.configure(bm.getBuffer('test-scan'), n);
+      const encoder = device.createCommandEncoder();
+      scan.encode(encoder);
+      device.queue.submit([encoder.finish()]);
+
+      const out = new Uint32Array((await bm.readBuffer('test-scan', n * 4)).buffer);
+      const totalName = scan.totalBuffer.label;
+      const total = new Uint32Array((await bm.readBuffer(totalName, 4)).buffer)[0];
+      let mismatches = 0;
+      let sum = 0;
+      for (let i = 0; i < n; i++) {
+        if (out[i] !== sum) mismatches++;
+        sum += input[i];
+      }
+      scan.destroy();
+      bm.destroyBuffer('test-scan');
+      return { mismatches, total, expected: sum };
+    });
+
+    expect(result.mismatches).toBe(0);
+    expect(result.total).toBe(result.expected);
+  });
+
+  test('GPU hulls match the CPU hull computation', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const { generateRandomHypergraph } = await import('/src/data/generator.ts');
+      const { hullCores } = await import('/tests/reference/hull-cores.ts');
+      const data = generateRandomHypergraph(400, 120, 8, 3);
+      engine.setData(data);
+      await new Promise(r => setTimeout(r, 500));
+      engine.simParams.running = false;
+      // Clearing the highlight resets the hull slots, so every hull is re-wrapped
+      // (not kept within the motion tolerance) from the now-static positions
+      engine.clearHighlight();
+      const frames = async () => {
+        for (let i = 0; i < 3; i++) await new Promise(r => requestAnimationFrame(r));
+      };
+      await frames();
+
+      const bm = engine.getBufferManager();
+      const store = engine.getStore();
+      const compare = async () => {
+        const positions = await bm.readBuffer('node-positions', store.nodeCount * 16);
+        const cpu = hullCores(positions, store.edgeMembers());
+
+        const slotCount = cpu.count; // every edge has 2+ members and is visible
+        const slots = new Uint32Array((await bm.readBuffer('hull-slots', slotCount * 4)).buffer);
+        const infoRaw = await bm.readBuffer('hull-info', slotCount * 32);
+        const infoU32 = new Uint32Array(infoRaw.buffer);
+        let pointCount = 0;
+        for (let s = 0; s < slotCount; s++) pointCount = Math.max(pointCount, infoU32[s * 8 + 4] + infoU32[s * 8 + 5]);
+        const points = await bm.readBuffer('hull-points', pointCount * 8);
+
+        const bySlot = new Map<number, number>();
+        for (let s = 0; s < slotCount; s++) bySlot.set(slots[s] & 0x7fffffff, s);
+        let sameCount = 0;
+        let maxDiff = 0;
+        for (let c = 0; c < cpu.count; c++) {
+          const s = bySlot.get(cpu.edgeIndex[c])!;
+          const start = infoU32[s * 8 + 4];
+          const count = infoU32[s * 8 + 5];
+          if (count !== cpu.length[c]) continue;
+          sameCount++;
+          for (let k = 0; k < count * 2; k++) {
+            maxDiff = Math.max(maxDiff, Math.abs(points[start * 2 + k] - cpu.points[cpu.start[c] * 2 + k]));
+          }
+        }
+        return { hulls: cpu.count, sameCount, maxDiff };
+      };
+      const initial = await compare();
+
+      // Move one node far out: only its hyperedges are dirty and re-wrapped
+      const moved = await bm.readBuffer('node-positions', 16);
+      moved[0] += 500;
+      bm.uploadData('node-positions', moved);
+      await frames();
+      const afterMove = await compare();
+      return { initial, afterMove };
+    });
+
+    for (const r of [result.initial, result.afterMove]) {
+      expect(r.hulls).toBeGreaterThan(0);
+      // Float32 vs float64 can differ on (near-)collinear points; nearly all must agree exactly
+      expect(r.sameCount).toBeGreaterThanOrEqual(Math.floor(r.hulls * 0.98));
+      expect(r.maxDiff).toBeLessThan(0.05);
+    }
+  });
+
+  test('metaball mode bins field primitives into tiles', async ({ page }) => {
+    const errors: string[] = [];
+    page.on('pageerror', (error) => {
+      errors.push(error.message);
+    });
+
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const binned = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      engine.renderParams.hullMode = 'metaball';
+      engine.renderParams.hullMargin = 5; // small σ → multi-tile grids on large hyperedges
+      // The CPU position cache refreshes every 10 frames
+      for (let i = 0; i < 30; i++) await new Promise(r => requestAnimationFrame(r));
+      const bm = engine.getBufferManager();
+      if (!bm.hasBuffer('metaball-tile-counts')) return -1;
+      const size = bm.getBuffer('metaball-tile-counts').size;
+      const counts = new Uint32Array((await bm.readBuffer('metaball-tile-counts', size)).buffer);
+      return counts.reduce((sum: number, c: number) => sum + c, 0);
+    });
+
+    expect(binned).toBeGreaterThan(0);
+    const relevantErrors = errors.filter(
+      (e) => !e.includes('ResizeObserver') && !e.includes('favicon')
+    );
+    expect(relevantErrors).toHaveLength(0);
+  });
+
+  test('GPU metaball MSTs span each hyperedge at near-minimum length', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const { generateRandomHypergraph } = await import('/src/data/generator.ts');
+      const { computeMST } = await import('/src/render/metaball-hull.ts');
+      engine.setData(generateRandomHypergraph(600, 150, 40, 5));
+      engine.renderParams.hullMode = 'metaball';
+      await new Promise(r => setTimeout(r, 500));
+      engine.simParams.running = false;
+      engine.clearHighlight(); // rebuild every instance from the now-static positions
+      for (let i = 0; i < 3; i++) await new Promise(r => requestAnimationFrame(r));
+
+      const bm = engine.getBufferManager();
+      const store = engine.getStore();
+      const positions = await bm.readBuffer('node-positions', store.nodeCount * 16);
+      const edges = store.edgeMembers();
+      const instanceCount = edges.filter((e: any) => e.memberIndices.length >= 2).length;
+      const inst = new Uint32Array((await bm.readBuffer('metaball-instances', instanceCount * 64)).buffer);
+      const instF32 = new Float32Array(inst.buffer);
+      const mst = new Uint32Array((await bm.readBuffer('metaball-mst', bm.getBuffer('metaball-mst').size)).buffer);
+
+      const length = (a: number, b: number) =>
+        Math.hypot(positions[a * 4] - positions[b * 4], positions[a * 4 + 1] - positions[b * 4 + 1]);
+      let spanning = 0;
+      let worstRatio = 1;
+      let inBounds = 0;
+      for (let i = 0; i < instanceCount; i++) {
+        const members: number[] = Array.from(edges[inst[i * 16 + 8]].memberIndices);
+        const offset = inst[i * 16 + 9];
+        const count = inst[i * 16 + 10];
+
+        // Spanning tree: size - 1 edges joining every member (union-find)
+        const parent = new Map(members.map(m => [m, m]));
+        const find = (x: number): number => (parent.get(x) === x ? x : find(parent.get(x)!));
+        let gpuLength = 0;
+        for (let k = 0; k < count; k++) {
+          const a = mst[(offset + k) * 2], b = mst[(offset + k) * 2 + 1];
+          parent.set(find(a), find(b));
+          gpuLength += length(a, b);
+        }
+        const roots = new Set(members.map(find));
+        if (count === members.length - 1 && roots.size === 1) spanning++;
+
+        const points = members.map(m => ({ x: positions[m * 4], y: positions[m * 4 + 1] }));
+        const cpuLength = computeMST(points).reduce((sum, [a, b]) => sum + length(members[a], members[b]), 0);
+        if (cpuLength > 0) worstRatio = Math.max(worstRatio, gpuLength / cpuLength);
+
+        if (points.every(p => p.x >= instF32[i * 16] && p.y >= instF32[i * 16 + 1] &&
+                              p.x <= instF32[i * 16 + 2] && p.y <= instF32[i * 16 + 3])) inBounds++;
+      }
+      return { instanceCount, spanning, worstRatio, inBounds };
+    });
+
+    expect(result.instanceCount).toBeGreaterThan(0);
+    expect(result.spanning).toBe(result.instanceCount);
+    expect(result.inBounds).toBe(result.instanceCount);
+    // Borůvka is exact on the candidate graph; a missed non-candidate edge costs little
+    expect(result.worstRatio).toBeLessThan(1.05);
+  });
+
+  test('metaball instance rebuilds reuse their arenas at steady state', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const { generateRandomHypergraph } = await import('/src/data/generator.ts');
+      engine.setData(generateRandomHypergraph(600, 150, 40, 5));
+      engine.renderParams.hullMode = 'metaball';
+      const frames = async (n: number) => {
+        for (let i = 0; i < n; i++) await new Promise(r => requestAnimationFrame(r));
+      };
+      await frames(3);
+
+      const bm = engine.getBufferManager();
+      const metaballs = engine.hullRendererInstance.metaballRenderer;
+      const arenas = () => [
+        metaballs.instF32, metaballs.instU32, metaballs.instanceEdge, metaballs.tileData, metaballs.primInstance,
+        bm.getBuffer('metaball-instances'), bm.getBuffer('metaball-mst'), bm.getBuffer('metaball-tiles'),
+      ];
+      const before = arenas();
+
+      // Every alpha change re-lays out all instances from the same edges
+      const alpha = engine.renderParams.hullAlpha;
+      for (let k = 0; k < 20; k++) {
+        engine.renderParams.hullAlpha = k % 2 ? alpha : alpha * 0.5;
+        await frames(1);
+      }
+      engine.renderParams.hullAlpha = alpha;
+      const after = arenas();
+      return { arenas: before.length, reused: before.filter((a, k) => a === after[k]).length };
+    });
+
+    expect(result.arenas).toBeGreaterThan(0);
+    expect(result.reused).toBe(result.arenas);
+  });
 });
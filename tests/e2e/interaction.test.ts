@@ -150,4 +150,67 @@ test.describe('Interaction', () => {
     );
     expect(relevantErrors).toHaveLength(0);
   });
+
+  test('GPU picking hovers and clicks the node under the cursor', async ({ page }) => {
+    const canvas = page.locator('#gpu-canvas');
+    const box = await canvas.boundingBox();
+    expect(box).not.toBeNull();
+
+    // Freeze the layout and find the node nearest the canvas center, in CSS pixels
+    const target = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      engine.simParams.running = false;
+      for (let i = 0; i < 3; i++) await new Promise(r => requestAnimationFrame(r));
+      const count = engine.getNodeCount();
+      const positions = await engine.getBufferManager().readBuffer('node-positions', count * 16);
+      const camera = engine.getCamera();
+      const dpr = window.devicePixelRatio;
+      const cx = camera.getViewportWidth() / 2;
+      const cy = camera.getViewportHeight() / 2;
+      let best = 0;
+      let bestDist = Infinity;
+      for (let i = 0; i < count; i++) {
+        const [sx, sy] = camera.worldToScreen(positions[i * 4], positions[i * 4 + 1]);
+        const d = Math.hypot(sx - cx, sy - cy);
+        if (d < bestDist) { bestDist = d; best = i; }
+      }
+      const [sx, sy] = camera.worldToScreen(positions[best * 4], positions[best * 4 + 1]);
+      return { node: best, x: sx / dpr, y: sy / dpr, radius: engine.renderParams.nodeBaseSize / dpr };
+    });
+
+    await page.mouse.move(box!.x + target.x, box!.y + target.y);
+    await page.waitForTimeout(300);
+    const hovered = await page.evaluate(async (t) => {
+      const engine = (window as any).__app.engine;
+      const node = engine.lastHoveredNode;
+      if (node === null) return null;
+      const positions = await engine.getBufferManager().readBuffer('node-positions', (node + 1) * 16);
+      const [sx, sy] = engine.getCamera().worldToScreen(positions[node * 4], positions[node * 4 + 1]);
+      const dpr = window.devicePixelRatio;
+      return { node, dist: Math.hypot(sx / dpr - t.x, sy / dpr - t.y) };
+    }, target);
+    // The top-most node whose (enlarged) disc covers the cursor: usually the target itself
+    expect(hovered).not.toBeNull();
+    expect(hovered!.dist).toBeLessThanOrEqual(target.radius * 1.5 * 4 + 1);
+
+    await page.mouse.down();
+    await page.mouse.up();
+    await page.waitForTimeout(300);
+    const selected = await page.evaluate(() => (window as any).__app.engine.selectedNode);
+    expect(selected).toBe(hovered!.node);
+
+    // Far outside the graph nothing is hovered
+    await page.mouse.move(box!.x + 2, box!.y + 2);
+    await page.evaluate(() => {
+      const camera = (window as any).__app.engine.getCamera();
+      camera.zoomAt(camera.getViewportWidth() / 2, camera.getViewportHeight() / 2, 0.01);
+    });
+    await page.mouse.move(box!.x + 3, box!.y + 3);
+    await page.waitForTimeout(300);
+    const cleared = await page.evaluate(() => {
+      const engine = (window as any).__app.engine;
+      return { node: engine.lastHoveredNode, edge: engine.lastHoveredEdge };
+    });
+    expect(cleared).toEqual({ node: null, edge: null });
+  });
 });
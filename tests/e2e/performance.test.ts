@@ -76,14 +76,18 @@ test.describe('Performance', () => {
       try {
         // Try importing the generator module directly
         const mod = await import('/src/data/generator.ts');
-        if (mod && mod.generateRandomHypergraph) {
+        if (mod && mod.generateSynthetic) {
+          const fixture = mod.SYNTHETIC_FIXTURES.medium;
           const start = performance.now();
-          const data = mod.generateRandomHypergraph(100000, 50000, 10);
+          const csr = mod.generateSynthetic(fixture);
+          const store = mod.syntheticToStore(csr);
           const elapsed = performance.now() - start;
           return {
             success: true,
-            nodeCount: data.nodes.length,
-            edgeCount: data.hyperedges.length,
+            nodeCount: store.nodeCount,
+            edgeCount: store.edgeCount,
+            expectedNodes: fixture.nodeCount,
+            expectedEdges: fixture.edgeCount,
             generationTimeMs: elapsed,
           };
         }
@@ -94,13 +98,35 @@ test.describe('Performance', () => {
     });
 
     if (result.success) {
-      expect(result.nodeCount).toBe(100000);
-      expect(result.edgeCount).toBe(50000);
+      expect(result.nodeCount).toBe(result.expectedNodes);
+      expect(result.edgeCount).toBe(result.expectedEdges);
       // Generation should complete in reasonable time
       expect(result.generationTimeMs).toBeLessThan(10000);
     }
   });
 
+  test('10M-incidence fixture generates in a worker within seconds', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForTimeout(3000);
+
+    const result = await page.evaluate(async () => {
+      const { SYNTHETIC_FIXTURES } = await import('/src/data/generator.ts');
+      const { generateInWorker } = await import('/src/data/generator-pipeline.ts');
+      const start = performance.now();
+      const store = await generateInWorker({ type: 'synthetic', options: SYNTHETIC_FIXTURES.large });
+      return {
+        nodeCount: store.nodeCount,
+        memberCount: store.memberCount,
+        elapsedMs: performance.now() - start,
+      };
+    });
+
+    console.log(`Large fixture: ${result.memberCount} incidences in ${result.elapsedMs.toFixed(0)} ms`);
+    expect(result.nodeCount).toBe(1_000_000);
+    expect(result.memberCount).toBeGreaterThan(9_000_000);
+    expect(result.elapsedMs).toBeLessThan(10000);
+  });
+
   test('FPS measurement over 5 seconds', async ({ page }) => {
     await page.goto('/');
     await page.waitForFunction(
@@ -199,3 +225,163 @@ test.describe('Performance', () => {
     }
   });
 });
+
+test.describe('Dataset switching', () => {
+  test('switching datasets 100 times reuses pipelines and pooled buffers', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const app = (window as any).__app;
+      const engine = app.engine;
+      const mod = await import('/src/data/generator.ts');
+      const small = mod.syntheticToStore(mod.generateSynthetic({ nodeCount: 2000, edgeCount: 800, seed: 1 }));
+      const large = mod.syntheticToStore(mod.generateSynthetic({ nodeCount: 5000, edgeCount: 2000, seed: 2 }));
+
+      // Warm up: both sizes once so pools reach their steady-state capacity
+      engine.setData(large);
+      engine.setData(small);
+      await engine.getGPU().device.queue.onSubmittedWorkDone();
+      const before = engine.getResourceStats();
+
+      const start = performance.now();
+      for (let i = 0; i < 100; i++) {
+        engine.setData(i % 2 === 0 ? large : small);
+      }
+      await engine.getGPU().device.queue.onSubmittedWorkDone();
+      const elapsed = performance.now() - start;
+
+      return { before, after: engine.getResourceStats(), msPerSwitch: elapsed / 100 };
+    });
+
+    console.log(`Dataset switch: ${result.msPerSwitch.toFixed(2)} ms/switch`);
+
+    // No pipeline recompilation and no buffer growth after warm-up
+    expect(result.after.pipelines).toBe(result.before.pipelines);
+    expect(result.after.buffers).toBe(result.before.buffers);
+    expect(result.after.bufferBytes).toBe(result.before.bufferBytes);
+    expect(result.msPerSwitch).toBeLessThan(50);
+  });
+});
+
+test.describe('Deterministic mode', () => {
+  test('same seed and data converge to identical layouts', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const app = (window as any).__app;
+      const engine = app.engine;
+      const mod = await import('/src/data/generator.ts');
+      engine.simParams.deterministic = true;
+      engine.setSeed(42);
+
+      const run = async () => {
+        engine.setData(mod.generateRandomHypergraph(3000, 1200, 6, 7));
+        await engine.converge();
+        const n = engine.getNodeCount();
+        return Array.from(await engine.getBufferManager().readBuffer('node-positions', n * 16) as Float32Array);
+      };
+
+      const a = await run();
+      const b = await run();
+      let mismatches = 0;
+      for (let i = 0; i < a.length; i++) {
+        if (a[i] !== b[i]) mismatches++;
+      }
+      return { length: a.length, mismatches };
+    });
+
+    expect(result.length).toBeGreaterThan(0);
+    expect(result.mismatches).toBe(0);
+  });
+});
+
+test.describe('Metaball resolution', () => {
+  test('half and quarter resolution stay close to full resolution', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const canvas = engine.getGPU().canvas as HTMLCanvasElement;
+      engine.renderParams.hullMode = 'metaball';
+      engine.simParams.running = false; // a still frame, so scales differ only by resolution
+
+      const frames = async (n: number) => {
+        for (let i = 0; i < n; i++) await new Promise(r => requestAnimationFrame(r));
+      };
+      const capture = () => {
+        const copy = document.createElement('canvas');
+        copy.width = canvas.width;
+        copy.height = canvas.height;
+        const ctx = copy.getContext('2d')!;
+        ctx.drawImage(canvas, 0, 0);
+        return ctx.getImageData(0, 0, copy.width, copy.height).data;
+      };
+
+      const runs: { scale: number; pixels: Uint8ClampedArray; fps: number; fieldMs: number | null }[] = [];
+      for (const scale of [1, 0.5, 0.25]) {
+        engine.renderParams.hullMetaballScale = scale;
+        await frames(30);
+        const pixels = capture();
+        const start = performance.now();
+        await frames(120);
+        const fps = 120 / ((performance.now() - start) / 1000);
+        const timings = engine.getRenderTimings() as { stage: string; ms: number }[] | null;
+        const fieldMs = timings
+          ? timings.filter(t => t.stage === 'metaball-field' || t.stage === 'render').reduce((s, t) => s + t.ms, 0)
+          : null;
+        runs.push({ scale, pixels, fps, fieldMs });
+      }
+
+      // Mean error per channel and share of visibly different pixels vs full resolution
+      const full = runs[0].pixels;
+      return runs.map(({ scale, pixels, fps, fieldMs }) => {
+        let sum = 0;
+        let differing = 0;
+        for (let i = 0; i < full.length; i += 4) {
+          let worst = 0;
+          for (let c = 0; c < 3; c++) {
+            const d = Math.abs(full[i + c] - pixels[i + c]);
+            sum += d;
+            worst = Math.max(worst, d);
+          }
+          if (worst > 24) differing++;
+        }
+        const pixelCount = full.length / 4;
+        return { scale, fps, fieldMs, meanError: sum / (pixelCount * 3), differing: differing / pixelCount };
+      });
+    });
+
+    for (const r of result) {
+      const gpu = r.fieldMs === null ? 'n/a' : `${r.fieldMs.toFixed(3)} ms`;
+      console.log(`Metaballs at ${r.scale}×: ${r.fps.toFixed(1)} FPS, GPU ${gpu}, ` +
+        `mean error ${r.meanError.toFixed(2)}, ${(r.differing * 100).toFixed(2)}% pixels differ`);
+    }
+
+    for (const r of result.slice(1)) {
+      // Contours are refined at full resolution, so only flat interiors are approximated
+      expect(r.meanError).toBeLessThan(2);
+      expect(r.differing).toBeLessThan(0.01);
+    }
+  });
+});
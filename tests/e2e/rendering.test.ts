@@ -93,4 +93,72 @@ test.describe('Rendering', () => {
     );
     expect(relevantErrors).toHaveLength(0);
   });
+
+  test('GPU culling draws only on-screen nodes and edges', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => (window as any).__app?.engine?.getNodeCount() > 0,
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const { generateRandomHypergraph } = await import('/src/data/generator.ts');
+      engine.setData(generateRandomHypergraph(2000, 400, 6, 7));
+      await new Promise(r => setTimeout(r, 500));
+      engine.simParams.running = false;
+      const frames = async () => {
+        for (let i = 0; i < 3; i++) await new Promise(r => requestAnimationFrame(r));
+      };
+      await frames();
+
+      const bm = engine.getBufferManager();
+      const camera = engine.getCamera();
+      const n = engine.getNodeCount();
+      const memberCount = engine.getStore().memberCount;
+      const inspect = async () => {
+        const positions = await bm.readBuffer('node-positions', n * 16);
+        const nodeArgs = new Uint32Array((await bm.readBuffer('node-cull-args', 16)).buffer);
+        const edgeArgs = new Uint32Array((await bm.readBuffer('edge-cull-args', 16)).buffer);
+        const drawn = nodeArgs[1];
+        const list = drawn > 0 ? Array.from(new Uint32Array((await bm.readBuffer('node-cull-visible', drawn * 4)).buffer)) : [];
+
+        // Everything strictly inside the view is drawn; nothing drawn lies
+        // beyond the view grown by the largest pick-size node radius
+        const [x0, y0] = camera.screenToWorld(0, camera.getViewportHeight());
+        const [x1, y1] = camera.screenToWorld(camera.getViewportWidth(), 0);
+        const pad = (engine.renderParams.nodeBaseSize * 6 + 1) / camera.zoom;
+        const drawnSet = new Set(list);
+        let missing = 0;
+        let outside = 0;
+        for (let i = 0; i < n; i++) {
+          const x = positions[i * 4], y = positions[i * 4 + 1];
+          if (x > x0 && x < x1 && y > y0 && y < y1 && !drawnSet.has(i)) missing++;
+        }
+        for (const i of list) {
+          const x = positions[i * 4], y = positions[i * 4 + 1];
+          if (x < x0 - pad || x > x1 + pad || y < y0 - pad || y > y1 + pad) outside++;
+        }
+        const ordered = list.every((v, k) => k === 0 || list[k - 1] < v);
+        return { drawn, vertices: nodeArgs[0], segments: edgeArgs[1], missing, outside, ordered };
+      };
+
+      const fitted = await inspect();
+      camera.zoomAt(camera.getViewportWidth() / 2, camera.getViewportHeight() / 2, 4);
+      await frames();
+      const zoomed = await inspect();
+      return { n, memberCount, fitted, zoomed };
+    });
+
+    for (const r of [result.fitted, result.zoomed]) {
+      expect(r.vertices).toBe(6);
+      expect(r.missing).toBe(0);
+      expect(r.outside).toBe(0);
+      expect(r.ordered).toBe(true);
+      expect(r.segments).toBeLessThanOrEqual(result.memberCount);
+    }
+    expect(result.zoomed.drawn).toBeGreaterThan(0);
+    expect(result.zoomed.drawn).toBeLessThan(result.fitted.drawn);
+    expect(result.zoomed.segments).toBeLessThanOrEqual(result.fitted.segments);
+  });
 });
@@ -125,4 +125,88 @@ test.describe('Force Simulation', () => {
 
     expect(energy).toBeLessThanOrEqual(0.001);
   });
+
+  test('reloading an identical dataset restores its cached layout at idle energy', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const app = (window as any).__app;
+      const engine = app.engine;
+      const mod = await import('/src/data/generator.ts');
+      const data = mod.generateRandomHypergraph(1500, 600, 6, 5);
+      const n = data.nodes.length;
+
+      engine.setData(data);
+      await engine.converge();
+      engine.simParams.running = false;
+      const converged = await engine.getBufferManager().readBuffer('node-positions', n * 16);
+      // The cache write is asynchronous — wait until it lands
+      for (let i = 0; i < 50 && (await engine.getLayoutCache().entries()).length === 0; i++) {
+        await new Promise(r => setTimeout(r, 50));
+      }
+
+      engine.setData(data);
+      for (let i = 0; i < 50 && engine.simParams.running; i++) {
+        await new Promise(r => setTimeout(r, 50));
+      }
+      const restored = await engine.getBufferManager().readBuffer('node-positions', n * 16);
+      let maxDiff = 0;
+      for (let i = 0; i < n; i++) {
+        maxDiff = Math.max(maxDiff, Math.abs(restored[i * 4] - converged[i * 4]), Math.abs(restored[i * 4 + 1] - converged[i * 4 + 1]));
+      }
+      return { running: engine.simParams.running, energy: engine.simParams.energy, idle: engine.simParams.idleEnergy, maxDiff };
+    });
+
+    expect(result.running).toBe(false);
+    expect(result.energy).toBe(result.idle);
+    expect(result.maxDiff).toBe(0);
+  });
+
+  test('a pinned node stays at its target while the simulation runs', async ({ page }) => {
+    await page.goto('/');
+    await page.waitForFunction(
+      () => {
+        const app = (window as any).__app;
+        return app?.engine?.getNodeCount() > 0;
+      },
+      { timeout: 15000 }
+    );
+
+    const result = await page.evaluate(async () => {
+      const engine = (window as any).__app.engine;
+      const bm = engine.getBufferManager();
+      const n = engine.getNodeCount();
+      const target = [400, -250];
+
+      engine.pinNodes([0], target);
+      const before = await bm.readBuffer('node-positions', n * 16);
+      await new Promise(r => setTimeout(r, 1500));
+      const after = await bm.readBuffer('node-positions', n * 16);
+
+      let othersMoved = 0;
+      for (let i = 1; i < n; i++) {
+        othersMoved = Math.max(othersMoved, Math.hypot(after[i * 4] - before[i * 4], after[i * 4 + 1] - before[i * 4 + 1]));
+      }
+      const pinned = engine.getPinnedNodes();
+      engine.unpinNodes([0]);
+      return {
+        offset: Math.hypot(after[0] - target[0], after[1] - target[1]),
+        othersMoved,
+        pinned,
+        afterUnpin: engine.getPinnedNodes(),
+      };
+    });
+
+    expect(result.pinned).toEqual([0]);
+    expect(result.offset).toBeLessThan(0.5);
+    expect(result.othersMoved).toBeGreaterThan(0);
+    expect(result.afterUnpin).toEqual([]);
+  });
 });
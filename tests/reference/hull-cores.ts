@@ -0,0 +1,102 @@
+// CPU reference for the GPU hull build (hull-build.wgsl), used as a test
+// oracle by unit and e2e tests: the unpadded member hull ("core") of every
+// hyperedge, which hull-render.wgsl rounds by the margin.
+
+import type { EdgeMembers } from '../../src/data/types';
+
+/**
+ * Packed hull cores: the convex hull of each hyperedge's member positions,
+ * CCW (2 vertices when collinear, 1 when coincident). Core `c` has `length[c]`
+ * vertices at `points[2 * start[c]...]`.
+ */
+export interface HullCores {
+  count: number;
+  /** Hyperedge index per core */
+  edgeIndex: Uint32Array;
+  /** First vertex per core */
+  start: Uint32Array;
+  /** Vertex count per core */
+  length: Uint32Array;
+  /** Vertex x, y pairs */
+  points: Float64Array;
+}
+
+/**
+ * Unpadded member hulls for hyperedges with 2+ members, by gift wrapping
+ * straight from `positions` (4 floats per node) like hull-build.wgsl.
+ */
+export function hullCores(positions: Float32Array, hyperedges: readonly EdgeMembers[]): HullCores {
+  const edges = hyperedges.filter(he => he.memberIndices.length >= 2);
+  const pointCount = edges.reduce((sum, he) => sum + he.memberIndices.length, 0);
+  const cores: HullCores = {
+    count: edges.length,
+    edgeIndex: new Uint32Array(edges.length),
+    start: new Uint32Array(edges.length),
+    length: new Uint32Array(edges.length),
+    points: new Float64Array(pointCount * 2),
+  };
+
+  const out = cores.points;
+  let next = 0;
+  edges.forEach((he, c) => {
+    const members = he.memberIndices;
+    const size = members.length;
+
+    // Start at the lowest-x (then lowest-y) member, which is on the hull
+    let sx = positions[members[0] * 4], sy = positions[members[0] * 4 + 1];
+    for (let m = 1; m < size; m++) {
+      const x = positions[members[m] * 4], y = positions[members[m] * 4 + 1];
+      if (x < sx || (x === sx && y < sy)) { sx = x; sy = y; }
+    }
+
+    // Gift wrapping: the next vertex has every member on its left; among
+    // collinear candidates the farthest wins
+    const start = next;
+    let cx = sx, cy = sy;
+    for (;;) {
+      out[next * 2] = cx;
+      out[next * 2 + 1] = cy;
+      next++;
+      let nx = cx, ny = cy, nd = 0;
+      for (let m = 0; m < size; m++) {
+        const px = positions[members[m] * 4], py = positions[members[m] * 4 + 1];
+        const d = (px - cx) * (px - cx) + (py - cy) * (py - cy);
+        if (d === 0) continue;
+        const turn = (nx - cx) * (py - cy) - (ny - cy) * (px - cx);
+        if (nd === 0 || turn < 0 || (turn === 0 && d > nd)) {
+          nx = px; ny = py; nd = d;
+        }
+      }
+      cx = nx; cy = ny;
+      if (nd === 0 || (cx === sx && cy === sy) || next - start >= size) break;
+    }
+
+    cores.edgeIndex[c] = he.index;
+    cores.start[c] = start;
+    cores.length[c] = next - start;
+  });
+  return cores;
+}
+
+/**
+ * Signed distance from (x, y) to the CCW convex polygon of `count` x, y pairs
+ * at `points[2 * start]`, or to the segment / point a degenerate hull reduces
+ * to. Negative inside. A rounded hull with radius r covers exactly the points
+ * where this is <= r.
+ */
+export function hullDistance(points: ArrayLike<number>, start: number, count: number, x: number, y: number): number {
+  let dist = Infinity;
+  let inside = count >= 3;
+  for (let i = 0; i < count; i++) {
+    const a = (start + i) * 2;
+    const b = (start + (i + 1) % count) * 2;
+    const ax = points[a], ay = points[a + 1];
+    const ex = points[b] - ax, ey = points[b + 1] - ay;
+    const wx = x - ax, wy = y - ay;
+    const len2 = ex * ex + ey * ey;
+    const t = len2 > 0 ? Math.min(Math.max((wx * ex + wy * ey) / len2, 0), 1) : 0;
+    dist = Math.min(dist, Math.hypot(wx - ex * t, wy - ey * t));
+    if (ex * wy - ey * wx < 0) inside = false;
+  }
+  return inside ? -dist : dist;
+}
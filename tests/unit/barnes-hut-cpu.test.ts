@@ -0,0 +1,88 @@
+import { describe, it, expect } from 'vitest';
+import {
+  buildQuadtree, repulsionBarnesHut, repulsionExact, relativeForceError, treeLayout, TREE_STRIDE,
+} from '../../src/layout/barnes-hut-cpu';
+import { createRng } from '../../src/utils/random';
+
+function randomPositions(n: number, seed: number): Float32Array {
+  const rng = createRng(seed);
+  const positions = new Float32Array(n * 4);
+  for (let i = 0; i < n; i++) {
+    positions[i * 4] = (rng() - 0.5) * 400;
+    positions[i * 4 + 1] = (rng() - 0.5) * 400;
+  }
+  return positions;
+}
+
+describe('treeLayout', () => {
+  it('sizes a complete 4-ary tree with enough leaves', () => {
+    expect(treeLayout(1)).toEqual({ numLevels: 1, leafOffset: 0, treeSize: 1 });
+    expect(treeLayout(4)).toEqual({ numLevels: 2, leafOffset: 1, treeSize: 5 });
+    expect(treeLayout(5)).toEqual({ numLevels: 3, leafOffset: 5, treeSize: 21 });
+  });
+});
+
+describe('buildQuadtree', () => {
+  it('root holds total mass, COM and second moments of all nodes', () => {
+    const n = 300;
+    const positions = randomPositions(n, 3);
+    const { tree } = buildQuadtree(positions, n);
+
+    let cx = 0, cy = 0;
+    for (let i = 0; i < n; i++) { cx += positions[i * 4]; cy += positions[i * 4 + 1]; }
+    cx /= n; cy /= n;
+    let sxx = 0, sxy = 0, syy = 0;
+    for (let i = 0; i < n; i++) {
+      const dx = positions[i * 4] - cx;
+      const dy = positions[i * 4 + 1] - cy;
+      sxx += dx * dx; sxy += dx * dy; syy += dy * dy;
+    }
+
+    expect(tree[2]).toBe(n);
+    expect(tree[0]).toBeCloseTo(cx, 6);
+    expect(tree[1]).toBeCloseTo(cy, 6);
+    expect(tree[8] / sxx).toBeCloseTo(1, 9);
+    expect(tree[9] / sxy).toBeCloseTo(1, 6);
+    expect(tree[10] / syy).toBeCloseTo(1, 9);
+    expect(tree.length % TREE_STRIDE).toBe(0);
+  });
+
+  it('uses node weights as leaf mass', () => {
+    const n = 64;
+    const positions = randomPositions(n, 5);
+    const weights = new Float32Array(n).fill(1);
+    weights[7] = 10;
+    const { tree } = buildQuadtree(positions, n, weights);
+    expect(tree[2]).toBe(n + 9);
+    const cx = Array.from({ length: n }, (_, i) => positions[i * 4] * weights[i]).reduce((a, v) => a + v) / (n + 9);
+    expect(tree[0]).toBeCloseTo(cx, 6);
+  });
+});
+
+describe('repulsionBarnesHut', () => {
+  const n = 1500;
+  const positions = randomPositions(n, 11);
+  const exact = repulsionExact(positions, n);
+  const { tree, layout } = buildQuadtree(positions, n);
+
+  it('matches the exact sum when no cell is approximated', () => {
+    const { forces } = repulsionBarnesHut(tree, layout, positions, n, 0, false);
+    expect(relativeForceError(forces, exact)).toBeLessThan(1e-9);
+  });
+
+  it('quadrupole term reduces the error at equal theta', () => {
+    for (const theta of [0.5, 0.9]) {
+      const mono = repulsionBarnesHut(tree, layout, positions, n, theta, false);
+      const quad = repulsionBarnesHut(tree, layout, positions, n, theta, true);
+      expect(quad.visits).toBe(mono.visits);
+      expect(relativeForceError(quad.forces, exact)).toBeLessThan(relativeForceError(mono.forces, exact));
+    }
+  });
+
+  it('quadrupole at theta 1.0 stays near monopole accuracy at 0.9 with fewer visits', () => {
+    const mono = repulsionBarnesHut(tree, layout, positions, n, 0.9, false);
+    const quad = repulsionBarnesHut(tree, layout, positions, n, 1.0, true);
+    expect(quad.visits).toBeLessThan(mono.visits);
+    expect(relativeForceError(quad.forces, exact)).toBeLessThan(relativeForceError(mono.forces, exact) * 1.25);
+  });
+});
@@ -0,0 +1,63 @@
+import { describe, it, expect } from 'vitest';
+import {
+  encodeHypergraphBinary, decodeHypergraphBinary, hypergraphFromBinary, HBLOB_MAGIC,
+} from '../../src/data/binary-format';
+import { parseHIF } from '../../src/data/hif-loader';
+import { generateRandomHypergraph } from '../../src/data/generator';
+
+const data = parseHIF({
+  nodes: [
+    { node: 'Ünïcødé', attrs: { label: 'multi-byte', score: 2.5 } },
+    { node: 'B', attrs: { score: -1, tags: ['x', 'y'] } },
+    { node: 'loner', attrs: { label: 'alone', flag: true } },
+  ],
+  edges: [{ edge: 0, attrs: { kind: 'family' } }, { edge: 'x', attrs: { weight: 3 } }],
+  incidences: [
+    { node: 'A', edge: 0 },
+    { node: 'B', edge: 0 },
+    { node: 'Ünïcødé', edge: 'x' },
+    { node: 'B', edge: 'x' },
+  ],
+});
+
+describe('binary hypergraph format', () => {
+  it('round-trips IDs, membership, groups and attributes', () => {
+    const buffer = encodeHypergraphBinary(data);
+    expect(new Uint32Array(buffer, 0, 1)[0]).toBe(HBLOB_MAGIC);
+
+    const decoded = hypergraphFromBinary(decodeHypergraphBinary(buffer));
+    expect(decoded.nodes).toEqual(data.nodes);
+    expect(decoded.hyperedges).toEqual(data.hyperedges);
+    expect([...decoded.nodeIdToIndex]).toEqual([...data.nodeIdToIndex]);
+  });
+
+  it('exposes GPU-layout sections as zero-copy views', () => {
+    const buffer = encodeHypergraphBinary(data);
+    const bin = decodeHypergraphBinary(buffer);
+    expect(bin.offsets.buffer).toBe(buffer);
+    expect(bin.members.buffer).toBe(buffer);
+    expect(bin.offsets.byteOffset % 8).toBe(0);
+    expect(bin.members.byteOffset % 8).toBe(0);
+    expect(Array.from(bin.offsets)).toEqual([0, 2, 4]);
+    expect(Array.from(bin.members)).toEqual([0, 1, 2, 1]);
+    expect(Array.from(bin.metadata)).toEqual([0, 0, 0, 0, 1, 0, 0, 0]);
+    expect(bin.positions).toBeNull();
+  });
+
+  it('stores positions when given', () => {
+    const g = generateRandomHypergraph(200, 40, 6, 7);
+    const positions = new Float32Array(200 * 4).map((_, i) => i * 0.5);
+    const bin = decodeHypergraphBinary(encodeHypergraphBinary(g, positions));
+    expect(bin.positions).not.toBeNull();
+    expect(bin.positions!.byteOffset % 8).toBe(0);
+    expect(Array.from(bin.positions!)).toEqual(Array.from(positions));
+    expect(hypergraphFromBinary(bin).hyperedges).toEqual(g.hyperedges);
+  });
+
+  it('rejects foreign and truncated buffers', () => {
+    expect(() => decodeHypergraphBinary(new ArrayBuffer(4))).toThrow('too short');
+    expect(() => decodeHypergraphBinary(new Uint32Array(8).buffer)).toThrow('bad magic');
+    const buffer = encodeHypergraphBinary(data);
+    expect(() => decodeHypergraphBinary(buffer.slice(0, 64))).toThrow('Truncated');
+  });
+});
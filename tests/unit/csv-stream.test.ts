@@ -0,0 +1,96 @@
+import { describe, it, expect } from 'vitest';
+import {
+  CSVTokenizer, CSVTableBuilder, scanCSVStream, columnPostings, csvTableToStore,
+  type CSVTable, type ColumnMapping,
+} from '../../src/data/csv-stream';
+
+function tokenize(text: string, chunkSize: number, delimiter?: ',' | '\t'): string[][] {
+  const rows: string[][] = [];
+  const tokenizer = new CSVTokenizer(fields => rows.push(fields), delimiter);
+  const bytes = new TextEncoder().encode(text);
+  for (let i = 0; i < bytes.length; i += chunkSize) tokenizer.push(bytes.subarray(i, i + chunkSize));
+  tokenizer.end();
+  return rows;
+}
+
+function table(text: string): CSVTable {
+  const builder = new CSVTableBuilder();
+  const tokenizer = new CSVTokenizer(fields => builder.addRow(fields));
+  tokenizer.push(new TextEncoder().encode(text));
+  tokenizer.end();
+  return builder.finish();
+}
+
+function build(t: CSVTable, mapping: ColumnMapping) {
+  const nodeColumn = t.columns[mapping.nodeColumn];
+  const postings = mapping.edgeColumns.map(c => columnPostings(
+    nodeColumn.codes, t.columns[c].codes, nodeColumn.values.length - 1, t.columns[c].values.length,
+  ));
+  return csvTableToStore(t, mapping, postings);
+}
+
+describe('CSVTokenizer', () => {
+  const text = 'id,"note",city\r\n"a, b","multi\nline ""quoted""", Paris \n\n  c ,ünï,\nd';
+
+  it('handles quotes, escaped quotes, quoted newlines and CRLF at any chunk size', () => {
+    for (const chunkSize of [1, 2, 5, 64]) {
+      expect(tokenize(text, chunkSize)).toEqual([
+        ['id', 'note', 'city'],
+        ['a, b', 'multi\nline "quoted"', 'Paris'],
+        ['c', 'ünï', ''],
+        ['d'],
+      ]);
+    }
+  });
+
+  it('detects tab-separated input', () => {
+    expect(tokenize('name\tteam\nx\t"a,b"\n', 3)).toEqual([['name', 'team'], ['x', 'a,b']]);
+  });
+});
+
+describe('CSV table → hypergraph', () => {
+  const csv = [
+    'name,team,city,age',
+    'alice,red,Paris,30',
+    'bob,red,Rome,',
+    'carol,blue,Paris,41',
+    'alice,blue,Oslo,30',
+    ',red,Paris,1',
+    'dave,green,Rome,22',
+    'erin,,Oslo,5',
+  ].join('\n');
+
+  it('dictionary-encodes columns in first-appearance order', () => {
+    const t = table(csv);
+    expect(t.rowCount).toBe(7);
+    expect(t.columns[0].values).toEqual(['', 'alice', 'bob', 'carol', 'dave', 'erin']);
+    expect(Array.from(t.columns[1].codes)).toEqual([1, 1, 2, 2, 1, 3, 0]);
+  });
+
+  it('groups rows per column, de-duplicates members and drops singletons', () => {
+    const store = build(table(csv), { nodeColumn: 0, edgeColumns: [1, 2] });
+    expect(store.nodeIds.ids).toEqual(['alice', 'bob', 'carol', 'dave', 'erin']);
+    expect(store.edgeIds).toEqual(['team:red', 'team:blue', 'city:Paris', 'city:Rome', 'city:Oslo']);
+    const members = Array.from({ length: store.edgeCount }, (_, e) => Array.from(store.members(e)));
+    expect(members).toEqual([[0, 1], [2, 0], [0, 2], [1, 3], [0, 4]]);
+    expect(store.edgeAttrs.row(2)).toEqual({ name: 'Paris', column: 'city' });
+    // Attributes come from each node's first row
+    expect(store.nodeAttrs.row(0)).toEqual({ team: 'red', city: 'Paris', age: '30' });
+    expect(store.nodeAttrs.row(1)).toEqual({ team: 'red', city: 'Rome', age: '' });
+    expect(Array.from(store.groups)).toEqual([0, 0, 1, 3, 4]);
+  });
+
+  it('scans a byte stream into the same table', async () => {
+    const bytes = new TextEncoder().encode(csv);
+    const stream = new ReadableStream<Uint8Array>({
+      start(controller) {
+        for (let i = 0; i < bytes.length; i += 7) controller.enqueue(bytes.slice(i, i + 7));
+        controller.close();
+      },
+    });
+    const seen: number[] = [];
+    const scanned = await scanCSVStream(stream, { onProgress: bytesRead => seen.push(bytesRead) });
+    expect(scanned).toEqual(table(csv));
+    expect(seen[seen.length - 1]).toBe(bytes.length);
+  });
+});
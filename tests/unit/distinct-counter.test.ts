@@ -0,0 +1,24 @@
+import { describe, it, expect } from 'vitest';
+import { DistinctCounter } from '../../src/data/distinct-counter';
+
+describe('DistinctCounter', () => {
+  it('counts small sets exactly and ignores repeats', () => {
+    const counter = new DistinctCounter();
+    expect(counter.estimate()).toBe(0);
+    for (let k = 0; k < 3; k++) for (let i = 0; i < 50; i++) counter.add(`n${i}`);
+    expect(counter.estimate()).toBe(50);
+  });
+
+  it('estimates large sets within a few percent', () => {
+    for (const n of [20_000, 300_000]) {
+      const counter = new DistinctCounter();
+      for (let i = 0; i < n; i++) counter.add(`edge-${i}`);
+      expect(Math.abs(counter.estimate() - n) / n).toBeLessThan(0.03);
+    }
+  });
+
+  it('rejects out-of-range precision', () => {
+    expect(() => new DistinctCounter(3)).toThrow();
+    expect(() => new DistinctCounter(17)).toThrow();
+  });
+});
@@ -0,0 +1,47 @@
+import { describe, it, expect } from 'vitest';
+import { EdgeSampler } from '../../src/data/edge-sampler';
+
+/** Feed `sizes[e]` incidences per edge, interleaved round-robin; returns the kept edges. */
+function run(sampler: EdgeSampler, sizes: number[], order: 'interleaved' | 'grouped'): number[] {
+  const feed = (e: number) => {
+    const p = sampler.priority(`e${e}`);
+    if (sampler.admits(p)) sampler.add(e, p);
+  };
+  if (order === 'grouped') {
+    for (let e = 0; e < sizes.length; e++) for (let k = 0; k < sizes[e]; k++) feed(e);
+  } else {
+    const max = Math.max(...sizes);
+    for (let k = 0; k < max; k++) for (let e = 0; e < sizes.length; e++) if (k < sizes[e]) feed(e);
+  }
+  return sizes.map((_, e) => e).filter(e => sampler.keeps(e));
+}
+
+describe('EdgeSampler', () => {
+  const sizes = Array.from({ length: 500 }, (_, e) => 2 + (e % 7));
+
+  it('keeps whole edges within the incidence budget', () => {
+    const sampler = new EdgeSampler(400);
+    const kept = run(sampler, sizes, 'grouped');
+    const total = kept.reduce((sum, e) => sum + sizes[e], 0);
+    expect(total).toBe(sampler.incidences);
+    expect(total).toBeLessThanOrEqual(400);
+    expect(total).toBeGreaterThan(300);
+  });
+
+  it('samples the lowest priorities regardless of incidence order', () => {
+    const grouped = run(new EdgeSampler(400, 7), sizes, 'grouped');
+    const interleaved = run(new EdgeSampler(400, 7), sizes, 'interleaved');
+    expect(interleaved).toEqual(grouped);
+
+    const sampler = new EdgeSampler(400, 7);
+    const maxKept = Math.max(...grouped.map(e => sampler.priority(`e${e}`)));
+    const dropped = sizes.map((_, e) => e).filter(e => !grouped.includes(e));
+    expect(Math.min(...dropped.map(e => sampler.priority(`e${e}`)))).toBeGreaterThan(maxKept);
+  });
+
+  it('varies with the seed and keeps everything under budget', () => {
+    expect(run(new EdgeSampler(400, 1), sizes, 'grouped')).not.toEqual(run(new EdgeSampler(400, 2), sizes, 'grouped'));
+    expect(run(new EdgeSampler(1e6), sizes, 'grouped').length).toBe(sizes.length);
+    expect(() => new EdgeSampler(0)).toThrow();
+  });
+});
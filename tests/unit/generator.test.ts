@@ -1,5 +1,5 @@
 import { describe, it, expect } from 'vitest';
-import { generateRandomHypergraph } from '../../src/data/generator';
+import { generateRandomHypergraph, generateSynthetic, syntheticToStore } from '../../src/data/generator';
 
 describe('generateRandomHypergraph', () => {
   it('generates correct number of nodes and edges', () => {
@@ -155,4 +155,72 @@ describe('generateRandomHypergraph', () => {
     expect(result.nodes).toHaveLength(5);
     expect(result.hyperedges).toHaveLength(20);
   });
+
+  it('is reproducible with a seed', () => {
+    const a = generateRandomHypergraph(200, 80, 6, 42);
+    const b = generateRandomHypergraph(200, 80, 6, 42);
+    expect(b.hyperedges.map(he => he.memberIndices)).toEqual(a.hyperedges.map(he => he.memberIndices));
+    expect(b.nodes.map(n => n.group)).toEqual(a.nodes.map(n => n.group));
+  });
+});
+
+describe('generateSynthetic', () => {
+  const options = { nodeCount: 5000, edgeCount: 2000, seed: 11, maxEdgeSize: 32, communities: 8 };
+
+  it('is reproducible with a seed', () => {
+    const a = generateSynthetic(options);
+    const b = generateSynthetic(options);
+    expect(b.offsets).toEqual(a.offsets);
+    expect(b.members).toEqual(a.members);
+    expect(generateSynthetic({ ...options, seed: 12 }).members).not.toEqual(a.members);
+  });
+
+  it('emits valid CSR with distinct members and sizes in range', () => {
+    const { offsets, members, nodeCount } = generateSynthetic(options);
+    expect(offsets.length).toBe(options.edgeCount + 1);
+    expect(offsets[offsets.length - 1]).toBe(members.length);
+    for (let e = 0; e < options.edgeCount; e++) {
+      const edge = Array.from(members.subarray(offsets[e], offsets[e + 1]));
+      expect(edge.length).toBeGreaterThanOrEqual(2);
+      expect(edge.length).toBeLessThanOrEqual(32);
+      expect(new Set(edge).size).toBe(edge.length);
+      for (const i of edge) expect(i).toBeLessThan(nodeCount);
+    }
+  });
+
+  it('has heavy-tailed degrees and mostly small hyperedges', () => {
+    const { offsets, members, nodeCount } = generateSynthetic(options);
+    const degree = new Uint32Array(nodeCount);
+    for (const i of members) degree[i]++;
+    const sorted = Array.from(degree).sort((x, y) => x - y);
+    expect(sorted[nodeCount - 1]).toBeGreaterThan(20 * Math.max(1, sorted[nodeCount >> 1]));
+
+    let small = 0;
+    for (let e = 0; e < options.edgeCount; e++) if (offsets[e + 1] - offsets[e] <= 3) small++;
+    expect(small / options.edgeCount).toBeGreaterThan(0.5);
+  });
+
+  it('draws members mostly from one planted community', () => {
+    const { offsets, members, groups } = generateSynthetic(options);
+    let inHome = 0;
+    for (let e = 0; e < options.edgeCount; e++) {
+      const counts = new Map<number, number>();
+      for (let k = offsets[e]; k < offsets[e + 1]; k++) {
+        const g = groups[members[k]];
+        counts.set(g, (counts.get(g) ?? 0) + 1);
+      }
+      inHome += Math.max(...counts.values());
+    }
+    expect(inHome / members.length).toBeGreaterThan(0.85);
+    expect(new Set(groups).size).toBe(8);
+  });
+
+  it('wraps into a store with community groups', () => {
+    const csr = generateSynthetic({ nodeCount: 100, edgeCount: 40, seed: 3, communities: 4 });
+    const store = syntheticToStore(csr);
+    expect(store.nodeCount).toBe(100);
+    expect(store.edgeCount).toBe(40);
+    expect(store.nodeIds.indexOf('n42')).toBe(42);
+    expect(store.node(99).group).toBe(3);
+  });
 });
@@ -0,0 +1,118 @@
+import { describe, it, expect } from 'vitest';
+import {
+  insertNodes, insertHyperedges, setHyperedgeMembers, deleteNodes, deleteHyperedges,
+} from '../../src/data/graph-mutations';
+import { HyperedgeCSR, NodeIncidenceCSR } from '../../src/data/csr';
+import { parseHIF } from '../../src/data/hif-loader';
+import type { HypergraphData } from '../../src/data/types';
+
+function sample(): HypergraphData {
+  return parseHIF({
+    incidences: [
+      { node: 'A', edge: 'e0' },
+      { node: 'B', edge: 'e0' },
+      { node: 'B', edge: 'e1' },
+      { node: 'C', edge: 'e1' },
+      { node: 'D', edge: 'e1' },
+    ],
+  });
+}
+
+describe('graph mutations', () => {
+  it('appends nodes with dense indices and rejects duplicate ids', () => {
+    const data = sample();
+    const added = insertNodes(data, [{ id: 'E' }, { id: 'F', group: 3 }]);
+    expect(added).toEqual([4, 5]);
+    expect(data.nodes[5].group).toBe(3);
+    expect(data.nodeIdToIndex.get('E')).toBe(4);
+    expect(() => insertNodes(data, [{ id: 'A' }])).toThrow();
+  });
+
+  it('appends hyperedges with de-duplicated, range-checked members', () => {
+    const data = sample();
+    const added = insertHyperedges(data, [{ id: 'e2', memberIndices: [0, 3, 0] }]);
+    expect(added).toEqual([2]);
+    expect(data.hyperedges[2].memberIndices).toEqual([0, 3]);
+    expect(() => insertHyperedges(data, [{ id: 'bad', memberIndices: [9] }])).toThrow();
+  });
+
+  it('replaces the members of one hyperedge', () => {
+    const data = sample();
+    setHyperedgeMembers(data, 0, [2, 3]);
+    expect(data.hyperedges[0].memberIndices).toEqual([2, 3]);
+  });
+
+  it('removes nodes, compacts indices and rewrites memberships', () => {
+    const data = sample();
+    const remap = deleteNodes(data, [1]);
+    expect(Array.from(remap)).toEqual([0, -1, 1, 2]);
+    expect(data.nodes.map(n => n.id)).toEqual(['A', 'C', 'D']);
+    expect(data.nodes.map(n => n.index)).toEqual([0, 1, 2]);
+    expect(data.nodeIdToIndex.has('B')).toBe(false);
+    expect(data.nodeIdToIndex.get('D')).toBe(2);
+    expect(data.hyperedges[0].memberIndices).toEqual([0]);
+    expect(data.hyperedges[1].memberIndices).toEqual([1, 2]);
+  });
+
+  it('removes hyperedges and compacts their indices', () => {
+    const data = sample();
+    insertHyperedges(data, [{ id: 'e2', memberIndices: [0] }]);
+    const remap = deleteHyperedges(data, [0]);
+    expect(Array.from(remap)).toEqual([-1, 0, 1]);
+    expect(data.hyperedges.map(he => he.id)).toEqual(['e1', 'e2']);
+    expect(data.hyperedges.map(he => he.index)).toEqual([0, 1]);
+  });
+});
+
+describe('HyperedgeCSR', () => {
+  it('packs offsets and members', () => {
+    const data = sample();
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    expect(Array.from(csr.offsets.subarray(0, csr.edgeCount + 1))).toEqual([0, 2, 5]);
+    expect(Array.from(csr.members.subarray(0, csr.memberCount))).toEqual([0, 1, 1, 2, 3]);
+  });
+
+  it('reports only the appended tail as dirty', () => {
+    const data = sample();
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    insertHyperedges(data, [{ id: 'e2', memberIndices: [3, 0] }]);
+    const dirty = csr.update(data.hyperedges);
+    expect(dirty.offsetsStart).toBe(3);
+    expect(dirty.membersStart).toBe(5);
+    expect(Array.from(csr.members.subarray(0, csr.memberCount))).toEqual([0, 1, 1, 2, 3, 3, 0]);
+  });
+
+  it('reports the first changed slot after a member edit', () => {
+    const data = sample();
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    setHyperedgeMembers(data, 1, [1, 3]);
+    const dirty = csr.update(data.hyperedges);
+    expect(dirty.offsetsStart).toBe(2);
+    expect(dirty.membersStart).toBe(3);
+  });
+
+  it('reports nothing dirty when unchanged', () => {
+    const data = sample();
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    const dirty = csr.update(data.hyperedges);
+    expect(dirty.offsetsStart).toBe(csr.edgeCount + 1);
+    expect(dirty.membersStart).toBe(csr.memberCount);
+  });
+});
+
+describe('NodeIncidenceCSR', () => {
+  it('lists each node\'s hyperedges in ascending edge order', () => {
+    const data = sample();
+    insertHyperedges(data, [{ id: 'e2', memberIndices: [3, 0] }]);
+    const csr = new HyperedgeCSR();
+    csr.update(data.hyperedges);
+    const incidence = new NodeIncidenceCSR();
+    incidence.build(csr, data.nodes.length);
+    expect(Array.from(incidence.offsets.subarray(0, data.nodes.length + 1))).toEqual([0, 2, 4, 5, 7]);
+    expect(Array.from(incidence.edges.subarray(0, csr.memberCount))).toEqual([0, 2, 0, 1, 1, 1, 2]);
+  });
+});
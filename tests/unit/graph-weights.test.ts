@@ -0,0 +1,61 @@
+import { describe, it, expect } from 'vitest';
+import { GraphWeights } from '../../src/layout/graph-weights';
+import type { BufferManager } from '../../src/gpu/buffer-manager';
+
+// Node has no WebGPU globals; GraphWeights only reads these two flags
+(globalThis as Record<string, unknown>).GPUBufferUsage ??= { STORAGE: 0x80, COPY_DST: 0x08 };
+
+/** CPU stand-in for BufferManager: power-of-two buffers that start zeroed when replaced. */
+class FakeBuffers {
+  bytes = new Map<string, Uint8Array>();
+  uploads = 0;
+
+  ensureCapacity(name: string, size: number): boolean {
+    const prev = this.bytes.get(name);
+    if (prev && prev.byteLength >= size) return false;
+    this.bytes.set(name, new Uint8Array(2 ** Math.ceil(Math.log2(size))));
+    return true;
+  }
+
+  uploadData(name: string, data: ArrayBufferView, offset = 0): void {
+    this.uploads++;
+    this.bytes.get(name)!.set(new Uint8Array(data.buffer, data.byteOffset, data.byteLength), offset);
+  }
+
+  floats(name: string, count: number): number[] {
+    return Array.from(new Float32Array(this.bytes.get(name)!.buffer, 0, count));
+  }
+}
+
+describe('GraphWeights', () => {
+  it('refills all-ones buffers from the start when they grow', () => {
+    const gpu = new FakeBuffers();
+    const weights = new GraphWeights(gpu as unknown as BufferManager);
+    weights.update(null, 3, null, 2);
+    expect(gpu.floats('node-weights', 3)).toEqual([1, 1, 1]);
+
+    // Past the size class (e.g. a larger dataset, or addNodes)
+    weights.update(null, 10, null, 5);
+    expect(gpu.floats('node-weights', 10)).toEqual(new Array(10).fill(1));
+    expect(gpu.floats('edge-weights', 5)).toEqual(new Array(5).fill(1));
+  });
+
+  it('uploads only the new tail while the buffer has room', () => {
+    const gpu = new FakeBuffers();
+    const weights = new GraphWeights(gpu as unknown as BufferManager);
+    weights.update(null, 5, null, 1);
+    const before = gpu.uploads;
+    weights.update(null, 6, null, 1); // 24 bytes still fit the 32-byte node buffer
+    expect(gpu.uploads).toBe(before + 1);
+    expect(gpu.floats('node-weights', 6)).toEqual(new Array(6).fill(1));
+  });
+
+  it('replaces explicit weights and returns to ones afterwards', () => {
+    const gpu = new FakeBuffers();
+    const weights = new GraphWeights(gpu as unknown as BufferManager);
+    weights.update(new Float32Array([3, 1, 2]), 3, null, 1);
+    expect(gpu.floats('node-weights', 3)).toEqual([3, 1, 2]);
+    weights.update(null, 3, null, 1);
+    expect(gpu.floats('node-weights', 3)).toEqual([1, 1, 1]);
+  });
+});
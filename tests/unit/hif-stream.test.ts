@@ -0,0 +1,183 @@
+import { describe, it, expect } from 'vitest';
+import { parseHIFStream, streamHIFBatches, sampleHIFStream, loadHIFNeighborhood } from '../../src/data/hif-stream';
+import { parseHIF } from '../../src/data/hif-loader';
+import { HypergraphStore } from '../../src/data/hypergraph-store';
+import type { HIFDocument } from '../../src/data/types';
+import type { GraphDelta } from '../../src/data/graph-mutations';
+
+/** Byte stream of `text` split into chunks of `chunkSize` bytes. */
+function streamOf(text: string | Uint8Array, chunkSize = 7): ReadableStream<Uint8Array> {
+  const bytes = typeof text === 'string' ? new TextEncoder().encode(text) : text;
+  let offset = 0;
+  return new ReadableStream<Uint8Array>({
+    pull(controller) {
+      if (offset >= bytes.length) {
+        controller.close();
+        return;
+      }
+      controller.enqueue(bytes.slice(offset, offset + chunkSize));
+      offset += chunkSize;
+    },
+  });
+}
+
+const doc: HIFDocument = {
+  'network-type': 'undirected',
+  metadata: { name: 'test', tags: ['a', { nested: [1, 2] }] },
+  nodes: [
+    { node: 'Ünïcødé', attrs: { label: 'multi-byte "quoted"\\n', weight: 2.5e-3 } },
+    { node: 'loner', attrs: { flags: [true, false, null] } },
+  ],
+  edges: [
+    { edge: 1, attrs: { kind: 'family' } },
+  ],
+  incidences: [
+    { node: 'A', edge: 0, weight: 1 },
+    { node: 'B', edge: 0 },
+    { node: 'A', edge: 0 },
+    { node: 'Ünïcødé', edge: 1 },
+    { node: 'C', edge: 1 },
+    { node: 'B', edge: 'x' },
+    { node: 'C', edge: 'x' },
+  ],
+};
+
+describe('parseHIFStream', () => {
+  it('matches parseHIF for any chunk size', async () => {
+    const expected = parseHIF(doc);
+    const text = JSON.stringify(doc, null, 1);
+    for (const chunkSize of [1, 3, 7, 64, 1 << 16]) {
+      const result = (await parseHIFStream(streamOf(text, chunkSize))).toHypergraph();
+      expect(result.nodes).toEqual(expected.nodes);
+      expect(result.hyperedges).toEqual(expected.hyperedges);
+      expect([...result.nodeIdToIndex]).toEqual([...expected.nodeIdToIndex]);
+    }
+  });
+
+  it('emits deduplicated CSR in incidence order', async () => {
+    const store = await parseHIFStream(streamOf(JSON.stringify(doc)));
+    expect(store.nodeIds.ids).toEqual(['A', 'B', 'Ünïcødé', 'C', 'loner']);
+    expect(store.edgeIds).toEqual([0, 1, 'x']);
+    expect(Array.from(store.csr.offsets.subarray(0, store.edgeCount + 1))).toEqual([0, 2, 4, 6]);
+    expect(Array.from(store.csr.members.subarray(0, store.memberCount))).toEqual([0, 1, 2, 3, 1, 3]);
+    expect(store.edgeAttrs.row(1)).toEqual({ kind: 'family' });
+    expect(store.nodeAttrs.row(4)).toEqual({ flags: [true, false, null] });
+  });
+
+  it('handles documents with incidences before nodes', async () => {
+    const reordered = { incidences: doc.incidences, nodes: doc.nodes, edges: doc.edges };
+    const result = (await parseHIFStream(streamOf(JSON.stringify(reordered), 5))).toHypergraph();
+    expect(result.nodes).toEqual(parseHIF(reordered).nodes);
+  });
+
+  it('reports progress per chunk', async () => {
+    const text = JSON.stringify(doc);
+    const seen: number[] = [];
+    await parseHIFStream(streamOf(text, 50), {
+      totalBytes: text.length,
+      onProgress: (p) => seen.push(p.bytesRead),
+    });
+    expect(seen.length).toBeGreaterThan(1);
+    expect(seen[seen.length - 1]).toBe(new TextEncoder().encode(text).length);
+  });
+
+  it('emits batches that replay to the same graph', async () => {
+    const reordered = { incidences: doc.incidences, nodes: doc.nodes, edges: doc.edges };
+    for (const source of [doc, reordered]) {
+      const text = JSON.stringify(source);
+      for (const chunkSize of [3, 40]) {
+        const deltas: GraphDelta[] = [];
+        await streamHIFBatches(streamOf(text, chunkSize), { onBatch: d => deltas.push(d) });
+        const expected = (await parseHIFStream(streamOf(text, chunkSize))).toHypergraph();
+        expect(deltas.length).toBeGreaterThan(1);
+
+        const replay = HypergraphStore.empty();
+        for (const delta of deltas) {
+          replay.insertNodes(delta.nodes);
+          replay.insertHyperedges(delta.edges);
+          replay.extendHyperedges(delta.extendedEdges);
+          for (const { index, attrs } of delta.nodeAttrs) replay.setNodeAttrs(index, attrs);
+          for (const { index, attrs } of delta.edgeAttrs) replay.setEdgeAttrs(index, attrs);
+        }
+        const result = replay.toHypergraph();
+        expect(result.hyperedges).toEqual(expected.hyperedges);
+        expect(result.nodes.map(n => [n.id, n.attrs])).toEqual(expected.nodes.map(n => [n.id, n.attrs]));
+      }
+    }
+  });
+
+  it('stops when a batch consumer throws', async () => {
+    const text = JSON.stringify(doc);
+    await expect(streamHIFBatches(streamOf(text, 3), {
+      onBatch: () => { throw new Error('superseded'); },
+    })).rejects.toThrow('superseded');
+  });
+
+  it('samples whole hyperedges within a budget and counts the full dataset', async () => {
+    const incidences: { node: string; edge: string }[] = [];
+    for (let e = 0; e < 200; e++) {
+      for (let k = 0; k < 3; k++) incidences.push({ node: `n${(e * 7 + k * 13) % 150}`, edge: `e${e}` });
+    }
+    const text = JSON.stringify({ incidences });
+    const sample = await sampleHIFStream(streamOf(text, 97), { incidenceBudget: 120 });
+    expect(sample.sampled).toBe(true);
+    expect(sample.total).toEqual({ nodes: 150, edges: 200, incidences: 600 });
+    expect(sample.store.memberCount).toBeLessThanOrEqual(120);
+    expect(sample.store.memberCount).toBeGreaterThan(90);
+    for (let e = 0; e < sample.store.edgeCount; e++) expect(sample.store.edgeSize(e)).toBe(3);
+    // Every sampled node belongs to a sampled edge
+    for (let i = 0; i < sample.store.nodeCount; i++) expect(sample.store.edgesOf(i).length).toBeGreaterThan(0);
+
+    const again = await sampleHIFStream(streamOf(text, 5), { incidenceBudget: 120 });
+    expect(again.store.edgeIds).toEqual(sample.store.edgeIds);
+
+    const whole = await sampleHIFStream(streamOf(text), { incidenceBudget: 1000 });
+    expect(whole.sampled).toBe(false);
+    expect(whole.store.toHypergraph().hyperedges).toEqual(parseHIF({ incidences }).hyperedges);
+  });
+
+  it('keeps the attributes of sampled items wherever they are listed', async () => {
+    const incidences: { node: string; edge: string }[] = [];
+    for (let e = 0; e < 100; e++) {
+      for (let k = 0; k < 2; k++) incidences.push({ node: `n${(e * 3 + k * 7) % 60}`, edge: `e${e}` });
+    }
+    const nodes = Array.from({ length: 60 }, (_, i) => ({ node: `n${i}`, attrs: { i } }));
+    const edges = Array.from({ length: 100 }, (_, e) => ({ edge: `e${e}`, attrs: { e } }));
+    for (const text of [
+      JSON.stringify({ nodes, edges, incidences }),
+      JSON.stringify({ incidences, nodes, edges }),
+    ]) {
+      const sample = await sampleHIFStream(streamOf(text, 64), { incidenceBudget: 50 });
+      expect(sample.sampled).toBe(true);
+      const { store } = sample;
+      for (let i = 0; i < store.nodeCount; i++) {
+        expect(store.nodeAttrs.row(i)).toEqual({ i: Number(store.nodeIds.ids[i].slice(1)) });
+      }
+      for (let e = 0; e < store.edgeCount; e++) {
+        expect(store.edgeAttrs.row(e)).toEqual({ e: Number(String(store.edgeIds[e]).slice(1)) });
+      }
+    }
+  });
+
+  it('reloads the hyperedges around chosen nodes at full detail', async () => {
+    const text = JSON.stringify(doc);
+    const sample = await loadHIFNeighborhood(() => streamOf(text), ['C'], { incidenceBudget: 100 });
+    expect(sample.sampled).toBe(false);
+    expect(sample.store.edgeIds).toEqual([1, 'x']);
+    expect(sample.store.nodeIds.ids).toEqual(['Ünïcødé', 'C', 'B']);
+    expect(sample.store.nodeAttrs.row(0)).toEqual(doc.nodes![0].attrs);
+    expect(sample.total.edges).toBe(3);
+  });
+
+  it('decompresses gzip input', async () => {
+    const gz = new Blob([JSON.stringify(doc)]).stream().pipeThrough(new CompressionStream('gzip'));
+    const bytes = new Uint8Array(await new Response(gz).arrayBuffer());
+    const result = (await parseHIFStream(streamOf(bytes, 11), { gzip: true })).toHypergraph();
+    expect(result.hyperedges).toEqual(parseHIF(doc).hyperedges);
+  });
+
+  it('rejects truncated and non-object documents', async () => {
+    await expect(parseHIFStream(streamOf('{"incidences": [{"node": "A"'))).rejects.toThrow();
+    await expect(parseHIFStream(streamOf('[1, 2]'))).rejects.toThrow('JSON object');
+  });
+});
@@ -1,5 +1,7 @@
 import { describe, it, expect, beforeEach } from 'vitest';
 import { HullCompute } from '../../src/render/hull-compute';
+import { hullCores, hullDistance } from '../reference/hull-cores';
+import type { HullCores } from '../reference/hull-cores';
 import type { HyperedgeData } from '../../src/data/types';
 
 function makeEdge(index: number, memberIndices: number[]): HyperedgeData {
@@ -260,10 +262,87 @@ describe('HullCompute', () => {
     expect(hulls[0].centroid[0]).toBeCloseTo(5, 1);
     expect(hulls[0].centroid[1]).toBeCloseTo(0, 1);
   });
+
+  it('cores are the unpadded CCW member hulls', () => {
+    const positions = makePositions([
+      [0, 0],
+      [10, 0],
+      [10, 10],
+      [0, 10],
+      [5, 5],
+      [3, 7],
+    ]);
+    const edges = [makeEdge(0, [0, 1, 2, 3, 4]), makeEdge(1, [5]), makeEdge(2, [4, 5])];
+    const cores = hullCores(positions, edges);
+
+    expect(cores.count).toBe(2);
+    expect(Array.from(cores.edgeIndex.subarray(0, 2))).toEqual([0, 2]);
+    const square = coreVertices(cores, 0);
+    expect(square).toEqual([[0, 0], [10, 0], [10, 10], [0, 10]]);
+    expect(signedArea(square)).toBeGreaterThan(0);
+    expect(cores.length[1]).toBe(2);
+  });
+
+  it('cores drop collinear points and collapse coincident ones', () => {
+    const positions = makePositions([
+      [0, 0],
+      [5, 0],
+      [10, 0],
+      [3, 3],
+      [3, 3],
+    ]);
+    const edges = [makeEdge(0, [0, 1, 2]), makeEdge(1, [3, 4])];
+    const cores = hullCores(positions, edges);
+
+    expect(coreVertices(cores, 0)).toEqual([[0, 0], [10, 0]]);
+    expect(coreVertices(cores, 1)).toEqual([[3, 3]]);
+  });
+
+  it('hullDistance is negative inside and the edge distance outside', () => {
+    const square = [0, 0, 10, 0, 10, 10, 0, 10];
+
+    expect(hullDistance(square, 0, 4, 5, 5)).toBeCloseTo(-5);
+    expect(hullDistance(square, 0, 4, 2, 5)).toBeCloseTo(-2);
+    expect(hullDistance(square, 0, 4, 15, 5)).toBeCloseTo(5);
+    // Beyond a corner the distance is to the vertex (rounded corners)
+    expect(hullDistance(square, 0, 4, 13, 14)).toBeCloseTo(5);
+  });
+
+  it('hullDistance treats degenerate cores as a segment or point', () => {
+    const packed = [0, 0, 10, 0, 2, 2];
+    expect(hullDistance(packed, 0, 2, 5, 3)).toBeCloseTo(3);
+    expect(hullDistance(packed, 0, 2, -4, 3)).toBeCloseTo(5);
+    expect(hullDistance(packed, 2, 1, 5, 6)).toBeCloseTo(5);
+  });
+
+  it('rounded core covers every vertex of the padded hull', () => {
+    const rand = seedRandom(7);
+    const points: [number, number][] = [];
+    for (let i = 0; i < 12; i++) points.push([rand() * 100, rand() * 100]);
+    const positions = makePositions(points);
+    const edges = [makeEdge(0, points.map((_, i) => i))];
+    const margin = 8;
+
+    const cores = hullCores(positions, edges);
+    const padded = hullCompute.computeHulls(positions, edges, margin)[0];
+    // The polygonal padding approximates the disc from inside
+    for (const [x, y] of padded.vertices) {
+      expect(hullDistance(cores.points, cores.start[0], cores.length[0], x, y)).toBeLessThanOrEqual(margin + 1e-3);
+    }
+  });
 });
 
 // --- Helper functions ---
 
+function coreVertices(cores: HullCores, c: number): [number, number][] {
+  const out: [number, number][] = [];
+  for (let k = 0; k < cores.length[c]; k++) {
+    const i = (cores.start[c] + k) * 2;
+    out.push([cores.points[i], cores.points[i + 1]]);
+  }
+  return out;
+}
+
 function seedRandom(seed: number): () => number {
   let s = seed;
   return () => {
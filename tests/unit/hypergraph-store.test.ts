@@ -0,0 +1,117 @@
+import { describe, it, expect } from 'vitest';
+import { HypergraphStore, AttributeStore } from '../../src/data/hypergraph-store';
+import { parseHIF } from '../../src/data/hif-loader';
+
+function sample(): HypergraphStore {
+  const data = parseHIF({
+    nodes: [{ node: 'A', attrs: { name: 'Alice', weight: 2 } }],
+    edges: [{ edge: 'e1', attrs: { label: 'team' } }],
+    incidences: [
+      { node: 'A', edge: 'e0' },
+      { node: 'B', edge: 'e0' },
+      { node: 'B', edge: 'e1' },
+      { node: 'C', edge: 'e1' },
+      { node: 'D', edge: 'e1' },
+    ],
+  });
+  // Rebuild from parts so the object view starts unmaterialized
+  const packed = HypergraphStore.fromHypergraph(data);
+  return HypergraphStore.fromParts({
+    nodeIds: [...packed.nodeIds.ids],
+    edgeIds: [...packed.edgeIds],
+    offsets: packed.csr.offsets.slice(0, packed.edgeCount + 1),
+    members: packed.csr.members.slice(0, packed.memberCount),
+    nodeAttrs: AttributeStore.fromRows(data.nodes.map(n => n.attrs)),
+    edgeAttrs: AttributeStore.fromRows(data.hyperedges.map(he => he.attrs)),
+  });
+}
+
+const membersOf = (store: HypergraphStore) =>
+  Array.from({ length: store.edgeCount }, (_, e) => Array.from(store.members(e)));
+
+describe('HypergraphStore', () => {
+  it('packs a graph into CSR, groups and attribute columns', () => {
+    const store = sample();
+    expect(store.nodeCount).toBe(4);
+    expect(membersOf(store)).toEqual([[0, 1], [1, 2, 3]]);
+    expect(Array.from(store.groups)).toEqual([0, 0, 1, 1]);
+    expect(store.nodeAttrs.get(0, 'name')).toBe('Alice');
+    expect(store.nodeAttrs.get(1, 'name')).toBeUndefined();
+    expect(store.edgeAttrs.row(1)).toEqual({ label: 'team' });
+    expect(Array.from(store.edgesOf(1))).toEqual([0, 1]);
+  });
+
+  it('builds the same object model as the loader', () => {
+    const store = sample();
+    const view = store.toHypergraph();
+    expect(view.nodes.map(n => n.id)).toEqual(['A', 'B', 'C', 'D']);
+    expect(view.nodes[0].attrs).toEqual({ name: 'Alice', weight: 2 });
+    expect(view.hyperedges[1].memberIndices).toEqual([1, 2, 3]);
+    expect(view.nodeIdToIndex.get('C')).toBe(2);
+    expect(store.node(0)).toBe(view.nodes[0]);
+  });
+
+  it('appends nodes and hyperedges, marking only the tail dirty', () => {
+    const store = sample();
+    store.takeCSRDirty();
+    expect(store.insertNodes([{ id: 'E', attrs: { weight: 5 } }])).toEqual([4]);
+    expect(store.insertHyperedges([{ id: 'e2', memberIndices: [4, 0, 4] }])).toEqual([2]);
+    expect(Array.from(store.members(2))).toEqual([4, 0]);
+    expect(store.nodeAttrs.get(4, 'weight')).toBe(5);
+    expect(Array.from(store.edgesOf(4))).toEqual([2]);
+    expect(store.takeCSRDirty()).toEqual({ offsetsStart: 3, membersStart: 5 });
+    expect(store.takeCSRDirty()).toEqual({ offsetsStart: 4, membersStart: 7 }); // nothing dirty
+    expect(() => store.insertNodes([{ id: 'A' }])).toThrow();
+    expect(() => store.insertHyperedges([{ id: 'bad', memberIndices: [9] }])).toThrow();
+  });
+
+  it('replaces members in place', () => {
+    const store = sample();
+    store.takeCSRDirty();
+    store.setHyperedgeMembers(0, [2, 3, 0]);
+    expect(membersOf(store)).toEqual([[2, 3, 0], [1, 2, 3]]);
+    expect(store.takeCSRDirty().membersStart).toBe(0);
+    expect(Array.from(store.edgesOf(3))).toEqual([0, 1]);
+  });
+
+  it('extends several hyperedges in one pass', () => {
+    const store = sample();
+    store.insertNodes([{ id: 'E' }, { id: 'F' }]);
+    store.takeCSRDirty();
+    store.extendHyperedges([{ index: 1, memberIndices: [5, 2] }, { index: 0, memberIndices: [4, 0, 4] }]);
+    expect(membersOf(store)).toEqual([[0, 1, 4], [1, 2, 3, 5]]);
+    expect(store.takeCSRDirty()).toEqual({ offsetsStart: 1, membersStart: 2 });
+    expect(Array.from(store.edgesOf(4))).toEqual([0]);
+    expect(() => store.extendHyperedges([{ index: 2, memberIndices: [0] }])).toThrow();
+  });
+
+  it('deletes nodes and hyperedges with compacted indices and columns', () => {
+    const store = sample();
+    const remap = store.deleteNodes([1]);
+    expect(Array.from(remap)).toEqual([0, -1, 1, 2]);
+    expect(store.nodeIds.ids).toEqual(['A', 'C', 'D']);
+    expect(store.nodeIds.indexOf('B')).toBe(-1);
+    expect(store.nodeIds.indexOf('D')).toBe(2);
+    expect(membersOf(store)).toEqual([[0], [1, 2]]);
+    expect(Array.from(store.groups.subarray(0, 3))).toEqual([0, 1, 1]);
+
+    store.deleteHyperedges([0]);
+    expect(store.edgeIds).toEqual(['e1']);
+    expect(store.edgeAttrs.row(0)).toEqual({ label: 'team' });
+    expect(membersOf(store)).toEqual([[1, 2]]);
+    expect(store.edgesOf(0).length).toBe(0);
+  });
+
+  it('mirrors mutations into a materialized object view', () => {
+    const store = sample();
+    const view = store.toHypergraph();
+    const nodeC = view.nodes[2];
+    store.deleteNodes([1]);
+    store.insertHyperedges([{ id: 'e2', memberIndices: [0, 1] }]);
+    store.setGroup(0, 7);
+    expect(view.nodes.map(n => n.id)).toEqual(['A', 'C', 'D']);
+    expect(nodeC.index).toBe(1);
+    expect(view.hyperedges.map(he => he.memberIndices)).toEqual(membersOf(store));
+    expect(view.nodes[0].group).toBe(7);
+  });
+});
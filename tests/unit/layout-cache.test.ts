@@ -0,0 +1,67 @@
+import { describe, it, expect } from 'vitest';
+import { LayoutCache, MemoryLayoutBackend, layoutKey } from '../../src/data/layout-cache';
+import { HypergraphStore } from '../../src/data/hypergraph-store';
+
+function store(members: number[][], nodeCount = 4): HypergraphStore {
+  const offsets = [0];
+  for (const m of members) offsets.push(offsets[offsets.length - 1] + m.length);
+  return HypergraphStore.fromParts({
+    nodeIds: Array.from({ length: nodeCount }, (_, i) => `n${i}`),
+    edgeIds: members.map((_, e) => e),
+    offsets: new Uint32Array(offsets),
+    members: new Uint32Array(members.flat()),
+  });
+}
+
+function positions(nodeCount: number, base: number): Float32Array {
+  const p = new Float32Array(nodeCount * 4);
+  for (let i = 0; i < nodeCount; i++) {
+    p[i * 4] = base + i;
+    p[i * 4 + 1] = -base - i;
+    p[i * 4 + 2] = 9; // velocity is not persisted
+  }
+  return p;
+}
+
+describe('layoutKey', () => {
+  it('depends on structure only', () => {
+    const a = store([[0, 1], [1, 2, 3]]);
+    const renamed = HypergraphStore.fromParts({
+      nodeIds: ['w', 'x', 'y', 'z'],
+      edgeIds: ['p', 'q'],
+      offsets: new Uint32Array([0, 2, 5]),
+      members: new Uint32Array([0, 1, 1, 2, 3]),
+    });
+    expect(layoutKey(renamed)).toBe(layoutKey(a));
+    expect(layoutKey(store([[0, 1], [1, 2, 3]], 5))).not.toBe(layoutKey(a));
+    expect(layoutKey(store([[0, 1], [1, 3, 2]]))).not.toBe(layoutKey(a));
+    expect(layoutKey(store([[0, 1, 1], [2, 3]]))).not.toBe(layoutKey(a));
+  });
+});
+
+describe('LayoutCache', () => {
+  it('round-trips x/y and rejects mismatched node counts', async () => {
+    const cache = new LayoutCache({ backend: new MemoryLayoutBackend() });
+    await cache.save('k', positions(3, 10));
+    const restored = await cache.load('k', 3);
+    expect(Array.from(restored!)).toEqual([10, -10, 0, 0, 11, -11, 0, 0, 12, -12, 0, 0]);
+    expect(await cache.load('k', 4)).toBeNull();
+    expect(await cache.load('missing', 3)).toBeNull();
+  });
+
+  it('evicts least recently used entries past maxBytes', async () => {
+    const backend = new MemoryLayoutBackend();
+    const cache = new LayoutCache({ backend, maxBytes: 2 * 10 * 8 }); // two 10-node layouts
+    await cache.save('a', positions(10, 0));
+    await new Promise(r => setTimeout(r, 2));
+    await cache.save('b', positions(10, 1));
+    await new Promise(r => setTimeout(r, 2));
+    await cache.load('a', 10); // a is now more recent than b
+    await new Promise(r => setTimeout(r, 2));
+    await cache.save('c', positions(10, 2));
+    expect((await cache.entries()).map(e => e.key).sort()).toEqual(['a', 'c']);
+
+    await cache.save('huge', positions(100, 0)); // larger than the whole cache: skipped
+    expect((await cache.entries()).map(e => e.key).sort()).toEqual(['a', 'c']);
+  });
+});
@@ -0,0 +1,102 @@
+import { describe, it, expect } from 'vitest';
+import { NodePins, PIN_FLAG } from '../../src/layout/node-pins';
+import type { BufferManager } from '../../src/gpu/buffer-manager';
+
+/** CPU stand-in for the two buffers NodePins keeps on the GPU: sizes and uploaded bytes. */
+class FakeBuffers {
+  bytes = new Map<string, Uint8Array>();
+
+  ensureCapacity(name: string, size: number): boolean {
+    const prev = this.bytes.get(name);
+    if (prev && prev.byteLength >= size) return false;
+    const next = new Uint8Array(size);
+    if (prev) next.set(prev);
+    this.bytes.set(name, next);
+    return true;
+  }
+
+  uploadData(name: string, data: ArrayBufferView, offset = 0): void {
+    this.bytes.get(name)!.set(new Uint8Array(data.buffer, data.byteOffset, data.byteLength), offset);
+  }
+
+  flags(count: number): number[] {
+    return Array.from(new Uint32Array(this.bytes.get('pin-flags')!.buffer, 0, count));
+  }
+
+  targets(count: number): number[] {
+    return Array.from(new Float32Array(this.bytes.get('pin-targets')!.buffer, 0, count * 2));
+  }
+}
+
+// Node has no WebGPU globals; NodePins only reads these two flags
+(globalThis as Record<string, unknown>).GPUBufferUsage ??= { STORAGE: 0x80, COPY_DST: 0x08 };
+
+function setup(nodeCount: number): { pins: NodePins; gpu: FakeBuffers } {
+  const gpu = new FakeBuffers();
+  const pins = new NodePins(gpu as unknown as BufferManager);
+  pins.resize(nodeCount);
+  return { pins, gpu };
+}
+
+describe('NodePins', () => {
+  it('tracks pinned indices through pin, re-pin and unpin', () => {
+    const { pins, gpu } = setup(5);
+    pins.pin([3, 1], [30, 31, 10, 11]);
+    pins.pin([3], [32, 33]); // moving a pin does not count it twice
+    expect(pins.pinnedIndices()).toEqual([1, 3]);
+    expect(pins.pinnedCount).toBe(2);
+    expect(pins.isPinned(3)).toBe(true);
+    expect(gpu.flags(5)).toEqual([0, PIN_FLAG, 0, PIN_FLAG, 0]);
+    expect(gpu.targets(5).slice(2, 8)).toEqual([10, 11, 0, 0, 32, 33]);
+
+    pins.unpin([1, 2, 9]); // unpinned and out-of-range indices are ignored
+    expect(pins.pinnedIndices()).toEqual([3]);
+    expect(pins.pinnedCount).toBe(1);
+    expect(gpu.flags(5)).toEqual([0, 0, 0, PIN_FLAG, 0]);
+
+    pins.clear();
+    expect(pins.pinnedCount).toBe(0);
+    expect(gpu.flags(5)).toEqual([0, 0, 0, 0, 0]);
+  });
+
+  it('remaps pins and targets after node removal', () => {
+    const { pins, gpu } = setup(5);
+    pins.pin([0, 2, 4], [0, 1, 20, 21, 40, 41]);
+    pins.pin([1], [10, 11]);
+
+    pins.remap(new Int32Array([0, -1, 1, -1, 2]), 3);
+    expect(pins.pinnedIndices()).toEqual([0, 1, 2]);
+    expect(pins.pinnedCount).toBe(3);
+    expect(gpu.flags(3)).toEqual([PIN_FLAG, PIN_FLAG, PIN_FLAG]);
+    expect(gpu.targets(3)).toEqual([0, 1, 20, 21, 40, 41]);
+
+    pins.remap(new Int32Array([-1, 0, 1]), 2);
+    expect(pins.pinnedIndices()).toEqual([0, 1]);
+    expect(pins.pinnedCount).toBe(2);
+    expect(gpu.targets(2)).toEqual([20, 21, 40, 41]);
+
+    // Slots freed by the removal come back unpinned
+    pins.resize(4);
+    expect(pins.pinnedIndices()).toEqual([0, 1]);
+    expect(gpu.flags(4)).toEqual([PIN_FLAG, PIN_FLAG, 0, 0]);
+  });
+
+  it('keeps pins across growth, drops them on shrink and reset', () => {
+    const { pins, gpu } = setup(2);
+    pins.pin([1], [5, 6]);
+    pins.resize(100);
+    expect(pins.pinnedIndices()).toEqual([1]);
+    expect(gpu.targets(2)).toEqual([0, 0, 5, 6]);
+
+    pins.pin([99], [7, 8]);
+    pins.resize(50);
+    expect(pins.pinnedIndices()).toEqual([1]);
+    pins.resize(100);
+    expect(pins.isPinned(99)).toBe(false);
+
+    pins.reset(3);
+    expect(pins.pinnedCount).toBe(0);
+    expect(pins.pinnedIndices()).toEqual([]);
+    expect(gpu.flags(3)).toEqual([0, 0, 0]);
+  });
+});
@@ -0,0 +1,34 @@
+import { describe, it, expect } from 'vitest';
+import { createRng, rngFor } from '../../src/utils/random';
+
+describe('createRng', () => {
+  it('produces the same sequence for the same seed', () => {
+    const a = createRng(1234);
+    const b = createRng(1234);
+    for (let i = 0; i < 100; i++) {
+      expect(a()).toBe(b());
+    }
+  });
+
+  it('produces different sequences for different seeds', () => {
+    const a = createRng(1);
+    const b = createRng(2);
+    const same = Array.from({ length: 20 }, () => a() === b()).filter(Boolean).length;
+    expect(same).toBeLessThan(20);
+  });
+
+  it('stays within [0, 1)', () => {
+    const rng = createRng(99);
+    for (let i = 0; i < 10000; i++) {
+      const v = rng();
+      expect(v).toBeGreaterThanOrEqual(0);
+      expect(v).toBeLessThan(1);
+    }
+  });
+});
+
+describe('rngFor', () => {
+  it('falls back to Math.random without a seed', () => {
+    expect(rngFor(undefined)).toBe(Math.random);
+  });
+});
@@ -0,0 +1,72 @@
+import { describe, it, expect } from 'vitest';
+import { reduceHypergraph, collapsedWeights, COLLAPSED_NODES, COLLAPSED_EDGES } from '../../src/data/reduction';
+import { HypergraphStore } from '../../src/data/hypergraph-store';
+import { parseHIF } from '../../src/data/hif-loader';
+
+// e0 = {A,B,C}, e1 = {C,B,A} (duplicate), e2 = {C,D}, e3 = {D,E}, F isolated, G isolated.
+// A and B share exactly {e0}; C is in {e0, e2}; D in {e2, e3}; E in {e3}.
+function sample(): HypergraphStore {
+  return HypergraphStore.fromHypergraph(parseHIF({
+    nodes: [{ node: 'A', attrs: { role: 'lead' } }, { node: 'F' }, { node: 'G' }],
+    edges: [{ edge: 'e1', attrs: { label: 'copy' } }],
+    incidences: [
+      { node: 'A', edge: 'e0' }, { node: 'B', edge: 'e0' }, { node: 'C', edge: 'e0' },
+      { node: 'C', edge: 'e1' }, { node: 'B', edge: 'e1' }, { node: 'A', edge: 'e1' },
+      { node: 'C', edge: 'e2' }, { node: 'D', edge: 'e2' },
+      { node: 'D', edge: 'e3' }, { node: 'E', edge: 'e3' },
+    ],
+  }));
+}
+
+describe('reduceHypergraph', () => {
+  it('collapses duplicate edges and equivalent nodes with weights', () => {
+    const source = sample();
+    const { store, nodeWeights, edgeWeights } = reduceHypergraph(source);
+    expect(store.edgeIds).toEqual(['e0', 'e2', 'e3']);
+    expect(Array.from(edgeWeights)).toEqual([2, 1, 1]);
+    expect(store.nodeIds.ids).toEqual(['A', 'C', 'D', 'E', 'F', 'G']);
+    expect(Array.from(nodeWeights)).toEqual([2, 1, 1, 1, 1, 1]);
+    const members = Array.from({ length: store.edgeCount }, (_, e) => Array.from(store.members(e)));
+    expect(members).toEqual([[0, 1], [1, 2], [2, 3]]);
+  });
+
+  it('maps originals to representatives and keeps their IDs as attributes', () => {
+    const source = sample();
+    const { store, nodeClass, edgeClass } = reduceHypergraph(source);
+    for (let i = 0; i < source.nodeCount; i++) {
+      const id = source.nodeIds.ids[i];
+      const rep = nodeClass[i];
+      const collapsed = store.nodeAttrs.get(rep, COLLAPSED_NODES) as string[] | undefined;
+      expect(collapsed ? collapsed.includes(id) : store.nodeIds.ids[rep] === id).toBe(true);
+    }
+    expect(Array.from(edgeClass)).toEqual([0, 0, 1, 2]);
+    expect(store.edgeAttrs.get(0, COLLAPSED_EDGES)).toEqual(['e0', 'e1']);
+    expect(store.nodeAttrs.get(0, 'role')).toBe('lead');
+    expect(Array.from(collapsedWeights(store.nodeAttrs, COLLAPSED_NODES, store.nodeCount)!)).toEqual([2, 1, 1, 1, 1, 1]);
+    expect(collapsedWeights(source.nodeAttrs, COLLAPSED_NODES, source.nodeCount)).toBeNull();
+  });
+
+  it('can collapse only one kind', () => {
+    const source = sample();
+    const edgesOnly = reduceHypergraph(source, { nodes: false });
+    expect(edgesOnly.store.nodeCount).toBe(source.nodeCount);
+    expect(edgesOnly.store.edgeCount).toBe(3);
+    // With e1 kept, A and B still share {e0, e1}
+    const nodesOnly = reduceHypergraph(source, { edges: false });
+    expect(nodesOnly.store.edgeCount).toBe(4);
+    expect(Array.from(nodesOnly.nodeWeights)).toEqual([2, 1, 1, 1, 1, 1]);
+  });
+
+  it('is the identity on graphs without duplicates', () => {
+    const source = HypergraphStore.fromParts({
+      nodeIds: ['a', 'b', 'c'],
+      edgeIds: [0, 1],
+      offsets: new Uint32Array([0, 2, 4]),
+      members: new Uint32Array([0, 1, 1, 2]),
+    });
+    const { store } = reduceHypergraph(source);
+    expect(store.nodeIds.ids).toEqual(['a', 'b', 'c']);
+    expect(Array.from(store.csr.members.subarray(0, store.memberCount))).toEqual([0, 1, 1, 2]);
+    expect([...store.nodeAttrs.names]).toEqual([]);
+  });
+});
@@ -0,0 +1,112 @@
+import { describe, it, expect } from 'vitest';
+import { SpatialIndex, buildSpatialGrid } from '../../src/interaction/spatial-index';
+import { createRng } from '../../src/utils/random';
+
+function randomPositions(n: number, seed: number, spread = 400): Float32Array {
+  const rng = createRng(seed);
+  const positions = new Float32Array(n * 4);
+  for (let i = 0; i < n; i++) {
+    positions[i * 4] = (rng() - 0.5) * spread;
+    positions[i * 4 + 1] = (rng() - 0.5) * spread * 0.5;
+  }
+  return positions;
+}
+
+function distSq(positions: Float32Array, i: number, x: number, y: number): number {
+  const dx = positions[i * 4] - x;
+  const dy = positions[i * 4 + 1] - y;
+  return dx * dx + dy * dy;
+}
+
+function sorted(values: number[]): number[] {
+  return [...values].sort((a, b) => a - b);
+}
+
+describe('buildSpatialGrid', () => {
+  it('places every node in exactly one cell', () => {
+    const n = 1000;
+    const grid = buildSpatialGrid(randomPositions(n, 1), n);
+    expect(grid.cellStart[grid.cols * grid.rows]).toBe(n);
+    expect(sorted(Array.from(grid.items))).toEqual(Array.from({ length: n }, (_, i) => i));
+    // About two nodes per cell
+    expect(grid.cols * grid.rows).toBeLessThanOrEqual(n);
+  });
+
+  it('handles empty, coincident and collinear layouts', () => {
+    expect(buildSpatialGrid(new Float32Array(0), 0).cellStart[1]).toBe(0);
+
+    const same = new Float32Array(40).fill(3);
+    const grid = buildSpatialGrid(same, 10);
+    expect(grid.cols * grid.rows).toBe(1);
+    expect(new SpatialIndex(grid).queryRadius(3, 3, 0).length).toBe(10);
+
+    const line = new Float32Array(400);
+    for (let i = 0; i < 100; i++) line[i * 4] = i;
+    const index = SpatialIndex.fromPositions(line, 100);
+    expect(index.grid.rows).toBe(1);
+    expect(sorted(index.queryRect(10, -1, 19.5, 1))).toEqual([10, 11, 12, 13, 14, 15, 16, 17, 18, 19]);
+  });
+});
+
+describe('SpatialIndex', () => {
+  const n = 2000;
+  const positions = randomPositions(n, 7);
+  const index = SpatialIndex.fromPositions(positions, n);
+
+  it('queryRect matches a full scan', () => {
+    const rng = createRng(11);
+    for (let q = 0; q < 50; q++) {
+      const x0 = (rng() - 0.5) * 500, y0 = (rng() - 0.5) * 300;
+      const x1 = x0 + rng() * 120, y1 = y0 + rng() * 80;
+      const expected: number[] = [];
+      for (let i = 0; i < n; i++) {
+        const x = positions[i * 4], y = positions[i * 4 + 1];
+        if (x >= x0 && x <= x1 && y >= y0 && y <= y1) expected.push(i);
+      }
+      expect(sorted(index.queryRect(x0, y0, x1, y1))).toEqual(expected);
+    }
+  });
+
+  it('queryRadius matches a full scan, including queries outside the bounds', () => {
+    const rng = createRng(12);
+    for (let q = 0; q < 50; q++) {
+      const x = (rng() - 0.5) * 600, y = (rng() - 0.5) * 400, r = rng() * 60;
+      const expected: number[] = [];
+      for (let i = 0; i < n; i++) if (distSq(positions, i, x, y) <= r * r) expected.push(i);
+      expect(sorted(index.queryRadius(x, y, r))).toEqual(expected);
+    }
+  });
+
+  it('nearest returns the k closest nodes in order', () => {
+    const rng = createRng(13);
+    for (let q = 0; q < 50; q++) {
+      const x = (rng() - 0.5) * 800, y = (rng() - 0.5) * 400;
+      const k = 1 + Math.floor(rng() * 12);
+      const byDistance = Array.from({ length: n }, (_, i) => i)
+        .sort((a, b) => distSq(positions, a, x, y) - distSq(positions, b, x, y));
+      const result = index.nearest(x, y, k);
+      expect(result.length).toBe(k);
+      expect(result.map(i => distSq(positions, i, x, y)))
+        .toEqual(byDistance.slice(0, k).map(i => distSq(positions, i, x, y)));
+    }
+  });
+
+  it('nearest respects maxDistance and small graphs', () => {
+    const [closest] = index.nearest(0, 0, 1);
+    const d = Math.sqrt(distSq(positions, closest, 0, 0));
+    expect(index.nearest(0, 0, 1, d * 0.99)).toEqual([]);
+    expect(index.nearest(0, 0, 1, d * 1.01)).toEqual([closest]);
+
+    const tiny = SpatialIndex.fromPositions(new Float32Array([1, 1, 0, 0, 5, 5, 0, 0]), 2);
+    expect(tiny.nearest(0, 0, 5)).toEqual([0, 1]);
+    expect(tiny.nearest(0, 0, 0)).toEqual([]);
+  });
+
+  it('skips NaN positions', () => {
+    const withNaN = randomPositions(50, 3);
+    withNaN[4] = NaN;
+    const nanIndex = SpatialIndex.fromPositions(withNaN, 50);
+    expect(nanIndex.queryRect(-1e9, -1e9, 1e9, 1e9)).not.toContain(1);
+    expect(nanIndex.nearest(0, 0, 50)).toHaveLength(49);
+  });
+});